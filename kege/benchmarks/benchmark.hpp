@@ -0,0 +1,60 @@
+//
+//  benchmark.hpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef kege_benchmark_hpp
+#define kege_benchmark_hpp
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <algorithm>
+
+namespace kege::bench{
+
+    /**
+     * @brief Milliseconds on a steady clock, for timing spans.
+     */
+    inline double now()
+    {
+        return std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now().time_since_epoch() ).count();
+    }
+
+    /**
+     * @brief Runs `func` `repeat` times and gets the fastest run in milliseconds.
+     */
+    template< typename Func > double best( uint32_t repeat, Func&& func )
+    {
+        double fastest = 1e30;
+        for ( uint32_t i = 0; i < repeat; ++i )
+        {
+            const double start = now();
+            func();
+            fastest = std::min( fastest, now() - start );
+        }
+        return fastest;
+    }
+
+    /**
+     * @brief Gets command line argument `index` as a number, `fallback` when it is not given.
+     */
+    inline uint32_t argument( int argc, char** argv, int index, uint32_t fallback )
+    {
+        return ( index < argc ) ? uint32_t( std::strtoul( argv[ index ], nullptr, 10 ) ) : fallback;
+    }
+
+    /**
+     * @brief Gets environment variable `name` as a number, `fallback` when it is not set.
+     */
+    inline double environment( const char* name, double fallback )
+    {
+        const char* value = std::getenv( name );
+        return ( value ) ? std::strtod( value, nullptr ) : fallback;
+    }
+
+}
+#endif /* kege_benchmark_hpp */
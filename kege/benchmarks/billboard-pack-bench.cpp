@@ -0,0 +1,120 @@
+//
+//  billboard-pack-bench.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+//  Times packBillboardParticles() against the field by field copy the billboard renderer used
+//  before it, and against a memcpy of the same bytes, and checks the pack writes exactly the
+//  bytes the old loop wrote.
+//
+//  usage: billboard-pack-bench [particles = 1000000] [repeat = 20]
+//
+
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include "benchmark.hpp"
+#include "../src/core/task/parallel-for.hpp"
+#include "../src/systems/particle/systems/billboard-particle-data.hpp"
+
+namespace kege::bench{
+
+    /**
+     * @brief The per particle copy of the billboard renderer before packBillboardParticles().
+     */
+    void copyFields( const ParticleBuffer& particles, uint32_t first, uint32_t last, BillboardParticleData* data )
+    {
+        for ( uint32_t i = first; i < last; ++i )
+        {
+            BillboardParticleData& out = data[ i - first ];
+            out.size = particles[ ParticleBuffer::SIZE ][ i ];
+            out.color = vec4( particles[ ParticleBuffer::COLOR_R ][ i ], particles[ ParticleBuffer::COLOR_G ][ i ], particles[ ParticleBuffer::COLOR_B ][ i ], particles[ ParticleBuffer::COLOR_A ][ i ] );
+            out.position = vec3( particles[ ParticleBuffer::POSITION_X ][ i ], particles[ ParticleBuffer::POSITION_Y ][ i ], particles[ ParticleBuffer::POSITION_Z ][ i ] );
+            out.rotation = particles[ ParticleBuffer::ROTATION ][ i ];
+            out.sprite = vec4( particles[ ParticleBuffer::SPRITE_X ][ i ], particles[ ParticleBuffer::SPRITE_Y ][ i ], particles[ ParticleBuffer::SPRITE_Z ][ i ], particles[ ParticleBuffer::SPRITE_W ][ i ] );
+        }
+    }
+
+    /**
+     * @brief Checks two packs hold the same bytes.
+     */
+    bool same( const std::vector< BillboardParticleData >& a, const BillboardParticleData* b, uint32_t count )
+    {
+        return memcmp( a.data(), b, count * sizeof( BillboardParticleData ) ) == 0;
+    }
+
+    void run( uint32_t count, uint32_t repeat )
+    {
+        ParticleBuffer particles( count );
+        particles.particle_count = count;
+        for ( int s = 0; s < ParticleBuffer::MAX_STREAMS; ++s )
+        {
+            // every float distinct, so a field landing in the wrong place shows
+            for ( uint32_t i = 0; i < count; ++i )
+            {
+                particles[ ParticleBuffer::Stream( s ) ][ i ] = s * 1e6f + float( i );
+            }
+        }
+
+        std::vector< BillboardParticleData > old_loop( count );
+        std::vector< BillboardParticleData > packed( count );
+        std::vector< float > raw( sizeof( BillboardParticleData ) / sizeof( float ) * size_t( count ) );
+
+        // the renderer packs in batches of BillboardParticleRenderer::pack_grain
+        const uint32_t grain = 16384;
+
+        const double fields = best( repeat, [&](){ copyFields( particles, 0, count, old_loop.data() ); });
+        const double pack = best( repeat, [&](){ packBillboardParticles( particles, 0, count, packed.data() ); });
+        const bool pack_matches = same( old_loop, packed.data(), count );
+
+        std::fill( packed.begin(), packed.end(), BillboardParticleData() );
+        const double batches = best( repeat, [&]()
+        {
+            kege::parallelFor( 0, count, grain, [&]( uint32_t first, uint32_t last )
+            {
+                packBillboardParticles( particles, first, last, packed.data() + first );
+            });
+        });
+        const bool batches_match = same( old_loop, packed.data(), count );
+
+        const uint32_t streams = sizeof( BillboardParticleData ) / sizeof( float );
+        const double copy = best( repeat, [&]()
+        {
+            for ( uint32_t s = 0; s < streams; ++s )
+            {
+                memcpy( raw.data() + size_t( s ) * count, particles[ ParticleBuffer::Stream( s ) ], count * sizeof( float ) );
+            }
+        });
+
+        // a range that does not start on a lane boundary
+        const uint32_t first = std::min( 3u, count );
+        packBillboardParticles( particles, first, count, packed.data() );
+        const bool offset_matches = memcmp( old_loop.data() + first, packed.data(), ( count - first ) * sizeof( BillboardParticleData ) ) == 0;
+
+        const double megabytes = count * double( sizeof( BillboardParticleData ) ) * 1e-6;
+        printf( "%u particles, %.1f MB per pack\n", count, megabytes );
+        printf( "  old field copy:     %8.3f ms  %5.1f GB/s\n", fields, megabytes / fields );
+        printf( "  pack:               %8.3f ms  %5.1f GB/s\n", pack, megabytes / pack );
+        printf( "  pack in batches:    %8.3f ms  %5.1f GB/s\n", batches, megabytes / batches );
+        printf( "  memcpy same bytes:  %8.3f ms  %5.1f GB/s\n", copy, megabytes / copy );
+        printf( "  byte for byte against the old loop: pack %s, batches %s, offset range %s\n",
+               pack_matches ? "same" : "DIFFERENT", batches_match ? "same" : "DIFFERENT", offset_matches ? "same" : "DIFFERENT" );
+    }
+
+}
+
+int main( int argc, char** argv )
+{
+    using namespace kege::bench;
+
+    const uint32_t repeat = argument( argc, argv, 2, 20 );
+    if ( argc > 1 )
+    {
+        run( argument( argc, argv, 1, 1000000 ), repeat );
+        return 0;
+    }
+    run( 10000, repeat );
+    run( 1000000, repeat );
+    return 0;
+}
@@ -0,0 +1,48 @@
+//
+//  collision-detector-bench.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+//  Steps scenes of random spheres and boxes through the CollisionDetector, testing every pair,
+//  going through the TreeBroadphase and through the SweepAndPruneBroadphase, and prints the pairs
+//  each path hands to the narrowphase.
+//
+//  usage: collision-detector-bench [bodies = 2000] [steps = 60] [seed = 7]
+//
+
+#include "physics-scene.hpp"
+#include "../src/systems/physics/3d/collision/broadphase/tree-broadphase.hpp"
+#include "../src/systems/physics/3d/collision/broadphase/sweep-and-prune.hpp"
+
+int main( int argc, char** argv )
+{
+    using namespace kege;
+    using namespace kege::bench;
+
+    const uint32_t steps = argument( argc, argv, 2, 60 );
+    const uint32_t seed = argument( argc, argv, 3, 7 );
+
+    // the default size first, then the scaling when no size is given
+    std::vector< uint32_t > counts = { argument( argc, argv, 1, 2000 ) };
+    if ( argc < 2 ) counts = { 250, 1000, 2000, 4000 };
+
+    for ( uint32_t count : counts )
+    {
+        printf( "%u bodies, %u steps\n", count, steps );
+        PhysicsScene all_pairs, tree, sweep_and_prune;
+        const PhysicsScene::Result a = all_pairs.run( nullptr, count, steps, seed );
+        const PhysicsScene::Result b = tree.run( new physics::TreeBroadphase(), count, steps, seed );
+        const PhysicsScene::Result c = sweep_and_prune.run( new physics::SweepAndPruneBroadphase(), count, steps, seed );
+        print( "all pairs", a );
+        print( "tree", b );
+        print( "sweep and prune", c );
+
+        // a broadphase may only drop pairs that do not touch
+        if ( a.manifolds != b.manifolds || a.manifolds != c.manifolds )
+        {
+            printf( "  the paths found different contacts\n" );
+        }
+    }
+    return 0;
+}
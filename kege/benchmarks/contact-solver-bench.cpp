@@ -0,0 +1,188 @@
+//
+//  contact-solver-bench.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+//  Times one ContactImpulseSolver step over a lattice of touching boxes, on the calling thread
+//  and in colored batches on 1, 2, 4... job workers, and checks every worker count gives the
+//  same velocities.
+//
+//  usage: contact-solver-bench [side = 16] [layers = 6] [repeat = 10]
+//
+
+#include <thread>
+#include "benchmark.hpp"
+#include "../src/core/task/job-system.hpp"
+#include "../src/systems/physics/3d/simulation/physics-simulation.hpp"
+#include "../src/systems/physics/3d/simulators/collision-detector.hpp"
+#include "../src/systems/physics/3d/simulators/contact-impulse-solver.hpp"
+#include "../src/systems/physics/3d/collision/collider/rigid-shapes.hpp"
+
+namespace kege::bench{
+
+    /**
+     * @brief A side x side x layers lattice of unit boxes, each overlapping the 26 around it.
+     *
+     * The contacts are detected once, then every solve() starts from the same velocities, so
+     * each one does the same work.
+     */
+    class LatticeScene
+    {
+    public:
+
+        /**
+         * @brief Runs one solver step and gets its time in milliseconds.
+         */
+        double solve()
+        {
+            for ( uint32_t i = 0; i < _bodies.size(); ++i )
+            {
+                _bodies.at( i )->linear.velocity = _linear[ i ];
+                _bodies.at( i )->angular.velocity = _angular[ i ];
+            }
+            const double start = now();
+            _solver->simulate( 1.0 / 60.0 );
+            return now() - start;
+        }
+
+        /**
+         * @brief Hashes the velocities the last solve() left, to compare runs bit for bit.
+         */
+        uint64_t hash()const
+        {
+            uint64_t hash = 1469598103934665603ull;
+            for ( uint32_t i = 0; i < _bodies.size(); ++i )
+            {
+                const Rigidbody* body = _bodies.at( i );
+                const unsigned char* bytes[2] = { (const unsigned char*) &body->linear.velocity, (const unsigned char*) &body->angular.velocity };
+                for ( const unsigned char* b : bytes )
+                {
+                    for ( uint32_t k = 0; k < 3 * sizeof( float ); ++k )
+                    {
+                        hash = ( hash ^ b[ k ] ) * 1099511628211ull;
+                    }
+                }
+            }
+            return hash;
+        }
+
+        uint32_t manifolds()
+        {
+            return _simulation.getCollisionRegistry().count();
+        }
+
+        uint32_t colors()const
+        {
+            return _solver->getColorCount();
+        }
+
+        LatticeScene( uint32_t side, uint32_t layers, bool parallel )
+        :   _detector( new physics::CollisionDetector() )
+        ,   _solver( new physics::ContactImpulseSolver() )
+        {
+            // the detector and solver are driven directly, the rest of the pipeline installed here never runs
+            _simulation.initialize( &_bodies );
+            _simulation.addSimulator( physics::Simulation::ON_UPDATE, _detector );
+            _simulation.addSimulator( physics::Simulation::ON_UPDATE, _solver );
+            _solver->setParallel( parallel );
+
+            uint32_t entity = 1;
+            for ( uint32_t y = 0; y < layers; ++y )
+            for ( uint32_t z = 0; z < side; ++z )
+            for ( uint32_t x = 0; x < side; ++x )
+            {
+                Rigidbody* body = _bodies.get( _bodies.create( entity++ ) );
+                body->center = vec3( x * 0.98f, y * 0.98f, z * 0.98f );
+                body->prev = body->center;
+                body->orientation = quat();
+                body->linear.velocity = vec3( float( ( x * 7 + y ) % 5 ) - 2.f, float( ( z * 3 + x ) % 5 ) - 2.f, float( ( y * 5 + z ) % 5 ) - 2.f );
+                body->linear.invmass = 1.0;
+                body->angular.inertia_inverse = computeBoxInverseTensor( vec3( 1.f ), 1.f );
+                body->up = vec3( 0.f, 1.f, 0.f );
+                body->friction = 0.5f;
+                body->cor = 0.f;
+                body->immovable = false;
+                body->is_awake = true;
+                body->sleepable = false;
+
+                OBB box;
+                box.center = body->center;
+                box.extents = vec3( 0.5f );
+                box.axes = mat33( 1.f );
+                body->collider = new ColliderBox( box );
+                body->collider->integrate( body );
+            }
+
+            _detector->simulate( 1.0 / 60.0 );
+
+            _linear.resize( _bodies.size() );
+            _angular.resize( _bodies.size() );
+            for ( uint32_t i = 0; i < _bodies.size(); ++i )
+            {
+                _linear[ i ] = _bodies.at( i )->linear.velocity;
+                _angular[ i ] = _bodies.at( i )->angular.velocity;
+            }
+        }
+
+    private:
+
+        ComponentCacheT< Rigidbody > _bodies;
+        physics::Simulation _simulation;
+
+        /**
+         * owned by the simulation.
+         */
+        physics::CollisionDetector* _detector;
+        physics::ContactImpulseSolver* _solver;
+
+        std::vector< vec3 > _linear;
+        std::vector< vec3 > _angular;
+    };
+
+}
+
+int main( int argc, char** argv )
+{
+    using namespace kege;
+    using namespace kege::bench;
+
+    const uint32_t side = argument( argc, argv, 1, 16 );
+    const uint32_t layers = argument( argc, argv, 2, 6 );
+    const uint32_t repeat = argument( argc, argv, 3, 10 );
+
+    double sequential;
+    {
+        LatticeScene scene( side, layers, false );
+        sequential = scene.solve();
+        for ( uint32_t i = 1; i < repeat; ++i ) sequential = std::min( sequential, scene.solve() );
+        printf( "%u bodies, %u manifolds, best of %u\n", side * side * layers, scene.manifolds(), repeat );
+        printf( "  calling thread:  %8.3f ms\n", sequential );
+    }
+
+    const uint32_t hardware = std::max( std::thread::hardware_concurrency(), 1u );
+    uint64_t expected = 0;
+    for ( uint32_t workers = 1; ; workers = std::min( workers * 2, hardware ) )
+    {
+        JobSystem::instance().shutdown();
+        JobSystem::instance().start( workers );
+
+        // a fresh scene, so the first solve of every worker count starts from the same impulses
+        LatticeScene scene( side, layers, true );
+        double ms = scene.solve();
+        const uint64_t hash = scene.hash();
+        for ( uint32_t i = 1; i < repeat; ++i ) ms = std::min( ms, scene.solve() );
+
+        printf( "  %2u workers:      %8.3f ms  %5.2fx  %u colors\n", workers, ms, sequential / ms, scene.colors() );
+        if ( expected == 0 ) expected = hash;
+        else if ( hash != expected )
+        {
+            printf( "  %u workers gave different velocities\n", workers );
+        }
+
+        if ( workers == hardware ) break;
+    }
+
+    JobSystem::instance().shutdown();
+    return 0;
+}
@@ -0,0 +1,122 @@
+//
+//  entity-view-bench.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+//  Times one pass over the entities of a view, with the components kept in the caches and in
+//  archetype chunks, through Entity handles, EntityViewT::each and EntityViewT::eachChunk.
+//
+//  usage: entity-view-bench [entities = 100000] [repeat = 20]
+//
+
+#include <vector>
+#include "benchmark.hpp"
+#include "../src/core/ecs/entity-registry.hpp"
+#include "../src/core/ecs/entity-manager.hpp"
+
+namespace kege::bench{
+
+    struct Position
+    {
+        float x, y, z;
+    };
+
+    struct Velocity
+    {
+        float x, y, z;
+    };
+
+    enum Path{ ENTITY_GET, EACH, EACH_CHUNK };
+
+    inline void integrate( Position& p, const Velocity& v )
+    {
+        p.x += v.x * 0.016f;
+        p.y += v.y * 0.016f;
+        p.z += v.z * 0.016f;
+    }
+
+    double run( EntityRegistry::StorageMode mode, Path path, uint32_t count, uint32_t repeat )
+    {
+        EntityManager* manager = new EntityManager;
+        manager->initialize();
+        Entity::setManager( manager );
+
+        std::vector< Entity > entities( count );
+        for ( uint32_t i = 0; i < count; ++i )
+        {
+            entities[ i ] = Entity::create();
+            entities[ i ].add< Position >({ float( i ), 0.f, 0.f });
+            entities[ i ].add< Velocity >({ 1.f, 1.f, 1.f });
+        }
+
+        double ms;
+        {
+            EntityRegistry registry;
+            registry.setStorageMode( mode );
+            registry.insert( entities.data(), count );
+            EntityView* view = registry.getEntityView< Position, Velocity >();
+
+            ms = best( repeat, [&]()
+            {
+                switch ( path )
+                {
+                    case ENTITY_GET:
+                        for ( Entity entity : *view )
+                        {
+                            integrate( *entity.get< Position >(), *entity.get< Velocity >() );
+                        }
+                        break;
+
+                    case EACH:
+                        registry.view< Position, const Velocity >().each([]( Position& p, const Velocity& v )
+                        {
+                            integrate( p, v );
+                        });
+                        break;
+
+                    case EACH_CHUNK:
+                        registry.view< Position, const Velocity >().eachChunk([]( uint32_t n, Position* p, const Velocity* v )
+                        {
+                            for ( uint32_t r = 0; r < n; ++r ) integrate( p[ r ], v[ r ] );
+                        });
+                        break;
+                }
+            });
+
+            // every path has to do the same work, so they all end at the same place
+            const float expected = 1.f + repeat * 0.016f;
+            const Position* p = entities[ 1 ].get< Position >();
+            if ( p->x < expected - 1e-3f || p->x > expected + 1e-3f )
+            {
+                printf( "  position check failed: %f, expected %f\n", p->x, expected );
+            }
+        }
+
+        for ( Entity& entity : entities )
+        {
+            entity.destroy();
+        }
+        manager->shutdown();
+        delete manager;
+        Entity::setManager( nullptr );
+        return ms;
+    }
+
+}
+
+int main( int argc, char** argv )
+{
+    using namespace kege;
+    using namespace kege::bench;
+
+    const uint32_t count = argument( argc, argv, 1, 100000 );
+    const uint32_t repeat = argument( argc, argv, 2, 20 );
+    printf( "%u entities, Position += Velocity * dt, best of %u\n", count, repeat );
+    printf( "  cache storage,     Entity::get:  %8.3f ms\n", run( EntityRegistry::CACHE_STORAGE, ENTITY_GET, count, repeat ) );
+    printf( "  archetype storage, Entity::get:  %8.3f ms\n", run( EntityRegistry::ARCHETYPE_STORAGE, ENTITY_GET, count, repeat ) );
+    printf( "  cache storage,     each:         %8.3f ms\n", run( EntityRegistry::CACHE_STORAGE, EACH, count, repeat ) );
+    printf( "  archetype storage, each:         %8.3f ms\n", run( EntityRegistry::ARCHETYPE_STORAGE, EACH, count, repeat ) );
+    printf( "  archetype storage, eachChunk:    %8.3f ms\n", run( EntityRegistry::ARCHETYPE_STORAGE, EACH_CHUNK, count, repeat ) );
+    return 0;
+}
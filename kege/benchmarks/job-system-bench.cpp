@@ -0,0 +1,80 @@
+//
+//  job-system-bench.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+//  Times spawning and completing many empty tasks, through executeTask and through one batched
+//  JobSystem::schedule, then measures the CPU the parked workers burn while there is no work.
+//
+//  usage: job-system-bench [tasks = 200000] [idle ms = 1000]
+//
+
+#include <atomic>
+#include <thread>
+#include <sys/resource.h>
+#include "benchmark.hpp"
+#include "../src/core/task/task-manager-system.hpp"
+
+namespace kege::bench{
+
+    /**
+     * @brief Gets the user and system CPU time of the process in milliseconds.
+     */
+    double cpuTime()
+    {
+        rusage usage;
+        getrusage( RUSAGE_SELF, &usage );
+        return
+        ( usage.ru_utime.tv_sec + usage.ru_stime.tv_sec ) * 1e3 +
+        ( usage.ru_utime.tv_usec + usage.ru_stime.tv_usec ) * 1e-3;
+    }
+
+}
+
+int main( int argc, char** argv )
+{
+    using namespace kege;
+    using namespace kege::bench;
+
+    const uint32_t count = argument( argc, argv, 1, 200000 );
+    const uint32_t idle = argument( argc, argv, 2, 1000 );
+
+    TaskManagerSystem::initialize();
+    printf( "%u workers\n", JobSystem::instance().workerCount() );
+
+    // let the workers start up and park before anything is timed
+    std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+
+    std::atomic< uint32_t > done( 0 );
+    double start = now();
+    for ( uint32_t i = 0; i < count; ++i )
+    {
+        executeTask([&done]{ done.fetch_add( 1, std::memory_order_relaxed ); });
+    }
+    while ( done.load() < count )
+    {
+        std::this_thread::yield();
+    }
+    double ms = now() - start;
+    printf( "  executeTask,   %u tasks: %8.1f ms  %6.2f Mtasks/s\n", count, ms, count / ms * 1e-3 );
+
+    done = 0;
+    start = now();
+    JobSystem::instance().schedule( count, [&done]( uint32_t ){ done.fetch_add( 1, std::memory_order_relaxed ); }).wait();
+    ms = now() - start;
+    printf( "  schedule( n ), %u tasks: %8.1f ms  %6.2f Mtasks/s\n", count, ms, count / ms * 1e-3 );
+    if ( done.load() != count )
+    {
+        printf( "  only %u of %u tasks ran\n", done.load(), count );
+    }
+
+    const double cpu = cpuTime();
+    start = now();
+    std::this_thread::sleep_for( std::chrono::milliseconds( idle ) );
+    const double wall = now() - start;
+    printf( "  idle for %.0f ms: %.1f%% of one core\n", wall, ( cpuTime() - cpu ) / wall * 100.0 );
+
+    TaskManagerSystem::shutdown();
+    return 0;
+}
@@ -0,0 +1,212 @@
+//
+//  mesh-bvh-bench.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+//  Builds a rolling terrain mesh of about 100k triangles and times its MeshBVH: the build, rays
+//  cast down and grazing the surface, and sphere and box queries with their triangle contacts.
+//  Rays and box overlaps are checked against a scan of every triangle.
+//
+//  usage: mesh-bvh-bench [quads per side = 224] [queries = 100000]
+//
+
+#include <random>
+#include "benchmark.hpp"
+#include "../src/systems/physics/3d/collision/collider/rigid-shapes.hpp"
+#include "../src/systems/physics/3d/collision/algorithms/mesh-contacts.hpp"
+#include "../src/systems/physics/3d/collision/rayhit/rayhit-mesh.hpp"
+#include "../src/systems/physics/3d/collision/rayhit/rayhit-triangle.hpp"
+
+namespace kege::bench{
+
+    const float TERRAIN_SIZE = 200.f;
+    const float TERRAIN_AMPLITUDE = 3.f;
+
+    inline float terrainHeight( float x, float z )
+    {
+        return TERRAIN_AMPLITUDE * sinf( x * 0.3f ) * cosf( z * 0.2f );
+    }
+
+    /**
+     * @brief Makes an n x n grid of quads over the terrain, two triangles each.
+     */
+    ColliderMesh* terrain( uint32_t n )
+    {
+        std::vector< float > vertices;
+        std::vector< unsigned int > indices;
+        for ( uint32_t z = 0; z <= n; ++z )
+        for ( uint32_t x = 0; x <= n; ++x )
+        {
+            const float px = TERRAIN_SIZE * ( float( x ) / n - 0.5f );
+            const float pz = TERRAIN_SIZE * ( float( z ) / n - 0.5f );
+            vertices.insert( vertices.end(), { px, terrainHeight( px, pz ), pz } );
+        }
+        for ( uint32_t z = 0; z < n; ++z )
+        for ( uint32_t x = 0; x < n; ++x )
+        {
+            const unsigned int a = z * ( n + 1 ) + x;
+            const unsigned int b = a + 1;
+            const unsigned int c = a + n + 1;
+            const unsigned int d = c + 1;
+            indices.insert( indices.end(), { a, c, b, b, c, d } );
+        }
+        return new ColliderMesh( vertices, indices );
+    }
+
+    /**
+     * @brief Gets the nearest hit of a ray by testing every triangle, a negative distance for a miss.
+     */
+    float bruteForceRay( const Ray& ray, const ColliderMesh& mesh )
+    {
+        float nearest = -1.f;
+        for ( uint32_t t = 0; t < mesh.triangles.size(); ++t )
+        {
+            algo::RayHit hit;
+            if ( algo::rayhitTriangle( ray, mesh.getTriangle( t ), &hit ) && ( nearest < 0.f || hit.distance < nearest ) )
+            {
+                nearest = hit.distance;
+            }
+        }
+        return nearest;
+    }
+
+    /**
+     * @brief Casts the rays through the tree, checks the first `checks` against bruteForceRay().
+     */
+    void castRays( const char* name, const std::vector< Ray >& rays, const ColliderMesh& mesh, uint32_t checks )
+    {
+        uint32_t hits = 0;
+        double start = now();
+        for ( const Ray& ray : rays )
+        {
+            algo::RayHit hit;
+            hits += algo::rayhitMesh( ray, mesh, &hit );
+        }
+        const double tree = ( now() - start ) * 1e3 / rays.size();
+
+        uint32_t mismatches = 0;
+        start = now();
+        for ( uint32_t i = 0; i < checks; ++i )
+        {
+            algo::RayHit hit;
+            const bool found = algo::rayhitMesh( rays[ i ], mesh, &hit );
+            const float nearest = bruteForceRay( rays[ i ], mesh );
+            if ( found != ( nearest >= 0.f ) || ( found && fabsf( hit.distance - nearest ) > 1e-4f ) )
+            {
+                mismatches += 1;
+            }
+        }
+        const double brute_force = ( now() - start ) * 1e3 / checks;
+
+        printf( "  %-16s %8.3f us per ray, %u of %zu hit | brute force %8.1f us per ray, %u of %u mismatched\n",
+               name, tree, hits, rays.size(), brute_force, mismatches, checks );
+    }
+
+}
+
+int main( int argc, char** argv )
+{
+    using namespace kege;
+    using namespace kege::bench;
+
+    const uint32_t side = argument( argc, argv, 1, 224 );
+    const uint32_t count = argument( argc, argv, 2, 100000 );
+    const uint32_t checks = 300;
+
+    double start = now();
+    Ref< ColliderMesh > mesh = terrain( side );
+    const double build = now() - start;
+    printf( "%zu triangles, %zu nodes, depth %u, built in %.1f ms (active edges included)\n",
+           mesh->triangles.size(), mesh->bvh.nodes().size(), mesh->bvh.depth(), build );
+
+    Rigidbody body;
+    body.center = vec3( 0.f );
+    body.orientation = quat();
+    mesh->integrate( &body );
+
+    std::mt19937 random( 1 );
+    std::uniform_real_distribution< float > position( -0.475f * TERRAIN_SIZE, 0.475f * TERRAIN_SIZE );
+    std::uniform_real_distribution< float > spread( -1.f, 1.f );
+
+    std::vector< Ray > rays( count );
+    for ( Ray& ray : rays )
+    {
+        ray = Ray( vec3( position( random ), 20.f, position( random ) ), normalize( vec3( spread( random ) * 0.3f, -1.f, spread( random ) * 0.3f ) ) );
+    }
+    castRays( "down rays", rays, *mesh, checks );
+
+    // nearly parallel to the surface, these cross many nodes before they hit
+    for ( Ray& ray : rays )
+    {
+        ray = Ray( vec3( position( random ), 4.f, position( random ) ), normalize( vec3( spread( random ), -0.05f, spread( random ) ) ) );
+    }
+    castRays( "grazing rays", rays, *mesh, checks );
+
+    algo::TriangleContact contacts[ 8 ];
+    uint64_t triangles = 0;
+    uint64_t found = 0;
+    start = now();
+    for ( uint32_t i = 0; i < count; ++i )
+    {
+        const float radius = 0.5f;
+        vec3 center( position( random ), 0.f, position( random ) );
+        center.y = terrainHeight( center.x, center.z ) + 0.3f;
+        mesh->bvh.query( AABB( center - radius, center + radius ), [&]( uint32_t t )
+        {
+            triangles += 1;
+            found += algo::sphereTriangleContacts( algo::getMeshTriangle( *mesh, t ), center, radius, contacts );
+            return true;
+        });
+    }
+    double ms = now() - start;
+    printf( "  sphere query     %8.3f us per query, %.2f triangles, %.2f contacts\n", ms * 1e3 / count, double( triangles ) / count, double( found ) / count );
+
+    triangles = 0;
+    found = 0;
+    start = now();
+    for ( uint32_t i = 0; i < count; ++i )
+    {
+        OBB box;
+        box.center = vec3( position( random ), 0.f, position( random ) );
+        box.center.y = terrainHeight( box.center.x, box.center.z ) + 0.4f;
+        box.extents = vec3( 0.5f );
+        box.axes = quatToM33( normalize( quat( float( i % 90 ), normalize( vec3( 0.3f, 1.f, 0.2f ) ) ) ) );
+        mesh->bvh.query( AABB( box.center - 0.87f, box.center + 0.87f ), [&]( uint32_t t )
+        {
+            triangles += 1;
+            found += algo::boxTriangleContacts( algo::getMeshTriangle( *mesh, t ), box, contacts );
+            return true;
+        });
+    }
+    ms = now() - start;
+    printf( "  box query        %8.3f us per query, %.2f triangles, %.2f contacts\n", ms * 1e3 / count, double( triangles ) / count, double( found ) / count );
+
+    // the overlap the tree answers, found by scanning every triangle
+    uint32_t mismatches = 0;
+    start = now();
+    for ( uint32_t i = 0; i < checks; ++i )
+    {
+        const vec3 center( position( random ), 0.f, position( random ) );
+        const AABB bounds( center - vec3( 0.87f, 4.f, 0.87f ), center + vec3( 0.87f, 4.f, 0.87f ) );
+
+        uint32_t scanned = 0;
+        for ( uint32_t t = 0; t < mesh->triangles.size(); ++t )
+        {
+            const Triangle triangle = mesh->getTriangle( t );
+            const vec3 min( std::min({ triangle.a.x, triangle.b.x, triangle.c.x }), std::min({ triangle.a.y, triangle.b.y, triangle.c.y }), std::min({ triangle.a.z, triangle.b.z, triangle.c.z }) );
+            const vec3 max( std::max({ triangle.a.x, triangle.b.x, triangle.c.x }), std::max({ triangle.a.y, triangle.b.y, triangle.c.y }), std::max({ triangle.a.z, triangle.b.z, triangle.c.z }) );
+            scanned +=
+            bounds.min.x <= max.x && min.x <= bounds.max.x &&
+            bounds.min.y <= max.y && min.y <= bounds.max.y &&
+            bounds.min.z <= max.z && min.z <= bounds.max.z;
+        }
+
+        uint32_t queried = 0;
+        mesh->bvh.query( bounds, [&queried]( uint32_t ){ queried += 1; return true; });
+        mismatches += ( scanned != queried );
+    }
+    ms = now() - start;
+    printf( "  box overlap scan %8.1f us per query, %u of %u mismatched\n", ms * 1e3 / checks, mismatches, checks );
+    return 0;
+}
@@ -0,0 +1,206 @@
+//
+//  narrowphase-bench.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+//  Times the shape specific collision routines still registered in the CollisionDetector against
+//  the GJK/EPA routine on the same random poses, and counts where the two disagree.
+//
+//  usage: narrowphase-bench [poses = 20000] [repeat = 3]
+//
+
+#include <random>
+#include "benchmark.hpp"
+#include "../src/systems/physics/3d/collision/collider/rigid-shapes.hpp"
+#include "../src/systems/physics/3d/collision/algorithms/convex-vs-convex.hpp"
+#include "../src/systems/physics/3d/collision/algorithms/box-vs-box.hpp"
+#include "../src/systems/physics/3d/collision/algorithms/box-vs-sphere.hpp"
+#include "../src/systems/physics/3d/collision/algorithms/sphere-vs-sphere.hpp"
+#include "../src/systems/physics/3d/collision/algorithms/capsule-vs-capsule.hpp"
+#include "../src/systems/physics/3d/collision/algorithms/plane-vs-box.hpp"
+#include "../src/systems/physics/3d/collision/algorithms/plane-vs-sphere.hpp"
+
+namespace kege::bench{
+
+    typedef bool (*CollisionFunction)( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions );
+
+    enum Shape{ BOX, SPHERE, CAPSULE, PLANE };
+
+    Collider* makeCollider( Shape shape )
+    {
+        switch ( shape )
+        {
+            case BOX:
+            {
+                OBB box;
+                box.center = vec3( 0.f );
+                box.extents = vec3( 0.5f, 0.4f, 0.6f );
+                box.axes = mat33( 1.f );
+                return new ColliderBox( box );
+            }
+            case SPHERE:
+                return new ColliderSphere( Sphere( vec3( 0.f ), 0.5f ) );
+
+            case CAPSULE:
+            {
+                Capsule capsule;
+                capsule.center = vec3( 0.f );
+                capsule.height = 1.f;
+                capsule.radius = 0.3f;
+                return new ColliderCapsule( capsule );
+            }
+            case PLANE:
+            {
+                Plane plane;
+                plane.normal = vec3( 0.f, 1.f, 0.f );
+                plane.distance = 0.f;
+                return new ColliderPlane( plane );
+            }
+        }
+        return nullptr;
+    }
+
+    struct Pose
+    {
+        vec3 center;
+        quat orientation;
+    };
+
+    struct ShapePair
+    {
+        const char* name;
+        Shape a;
+        Shape b;
+        CollisionFunction specialized;
+        CollisionFunction gjk;
+    };
+
+    /**
+     * @brief Runs `func` on every pose and gets the nanoseconds per call, the cost of placing
+     * the shapes and resetting the registry included.
+     */
+    double time( CollisionFunction func, Rigidbody& a, Rigidbody& b, const std::vector< Pose >& poses, uint32_t repeat, kege::CollisionRegistry& collisions )
+    {
+        const double start = now();
+        for ( uint32_t r = 0; r < repeat; ++r )
+        {
+            for ( const Pose& pose : poses )
+            {
+                b.center = pose.center;
+                b.orientation = pose.orientation;
+                a.collider->integrate( &a );
+                b.collider->integrate( &b );
+                collisions.reset();
+                if ( func ) func( &a, &b, collisions );
+            }
+        }
+        return ( now() - start ) * 1e6 / ( double( repeat ) * poses.size() );
+    }
+
+    void compare( const ShapePair& pair, uint32_t count, uint32_t repeat )
+    {
+        std::mt19937 random( 7 );
+        auto uniform = [&random]( float min, float max )
+        {
+            return std::uniform_real_distribution< float >( min, max )( random );
+        };
+
+        std::vector< Pose > poses( count );
+        for ( Pose& pose : poses )
+        {
+            // against a plane the shape only moves up and down through it
+            pose.center = ( pair.a == PLANE )
+            ? vec3( uniform( -1.f, 1.f ), uniform( -0.6f, 0.8f ), uniform( -1.f, 1.f ) )
+            : vec3( uniform( -1.1f, 1.1f ), uniform( -1.1f, 1.1f ), uniform( -1.1f, 1.1f ) );
+            pose.orientation = normalize( quat( uniform( 0.f, 360.f ), normalize( vec3( uniform( -1.f, 1.f ), uniform( -1.f, 1.f ), uniform( -1.f, 1.f ) ) + vec3( 0.001f, 0.f, 0.f ) ) ) );
+        }
+
+        Rigidbody a;
+        Rigidbody b;
+        a.center = vec3( 0.f );
+        a.orientation = ( pair.a == PLANE ) ? quat() : normalize( quat( 30.f, normalize( vec3( 0.3f, 1.f, 0.2f ) ) ) );
+        a.collider = makeCollider( pair.a );
+        b.collider = makeCollider( pair.b );
+
+        kege::CollisionRegistry collisions;
+        collisions.resize( 8 );
+
+        const double overhead = time( nullptr, a, b, poses, repeat, collisions );
+        const double specialized = time( pair.specialized, a, b, poses, repeat, collisions ) - overhead;
+        const double gjk = time( pair.gjk, a, b, poses, repeat, collisions ) - overhead;
+
+        // run both on every pose, a miss against a hit deeper than a millimeter is a disagreement
+        uint32_t hits = 0;
+        uint32_t disagree = 0;
+        uint32_t normals = 0;
+        float depth_difference = 0.f;
+        for ( const Pose& pose : poses )
+        {
+            b.center = pose.center;
+            b.orientation = pose.orientation;
+            a.collider->integrate( &a );
+            b.collider->integrate( &b );
+
+            bool hit[2];
+            vec3 normal[2];
+            float depth[2] = { 0.f, 0.f };
+            for ( int k = 0; k < 2; ++k )
+            {
+                collisions.reset();
+                ( k == 0 ? pair.specialized : pair.gjk )( &a, &b, collisions );
+                hit[ k ] = collisions.count() > 0;
+                if ( !hit[ k ] ) continue;
+
+                normal[ k ] = collisions[0]->normal;
+                for ( uint32_t i = 0; i < collisions[0]->contact_count; ++i )
+                {
+                    depth[ k ] = std::max( depth[ k ], collisions[0]->contacts[ i ].depth );
+                }
+            }
+
+            if ( hit[0] != hit[1] )
+            {
+                disagree += ( std::max( depth[0], depth[1] ) > 1e-3f );
+            }
+            else if ( hit[0] )
+            {
+                hits += 1;
+                normals += ( dot( normal[0], normal[1] ) > 0.99f );
+                depth_difference = std::max( depth_difference, fabsf( depth[0] - depth[1] ) );
+            }
+        }
+
+        printf( "  %-16s %7.0f ns %7.0f ns  %5.2fx | %5u both hit, %4u disagree, normals agree %5.1f%%, depth differs by up to %.4f\n",
+               pair.name, specialized, gjk, gjk / specialized, hits, disagree, hits ? 100.0 * normals / hits : 100.0, depth_difference );
+    }
+
+}
+
+int main( int argc, char** argv )
+{
+    using namespace kege;
+    using namespace kege::algo;
+    using namespace kege::bench;
+
+    const uint32_t count = argument( argc, argv, 1, 20000 );
+    const uint32_t repeat = argument( argc, argv, 2, 3 );
+
+    const ShapePair pairs[] =
+    {
+        { "sphere-sphere",   SPHERE,  SPHERE,  sphereSphereCollision,   convexCollision },
+        { "box-box",         BOX,     BOX,     boxBoxCollision,         convexCollision },
+        { "box-sphere",      BOX,     SPHERE,  boxSphereCollision,      convexCollision },
+        { "capsule-capsule", CAPSULE, CAPSULE, capsuleCapsuleCollision, convexCollision },
+        { "plane-box",       PLANE,   BOX,     planeBoxCollision,       planeConvexCollision },
+        { "plane-sphere",    PLANE,   SPHERE,  planeSphereCollision,    planeConvexCollision },
+    };
+
+    printf( "%u random poses, mean of %u passes, the cost of placing the shapes taken out\n", count, repeat );
+    printf( "  %-16s %10s %10s  %6s\n", "pair", "specialized", "gjk", "ratio" );
+    for ( const ShapePair& pair : pairs )
+    {
+        compare( pair, count, repeat );
+    }
+    return 0;
+}
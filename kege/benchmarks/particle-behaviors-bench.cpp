@@ -0,0 +1,169 @@
+//
+//  particle-behaviors-bench.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+//  Steps a million particles through gravity, quadratic drag, wind, a color gradient and a size
+//  curve the way ParticleEffectSystem does, one virtual call per behavior per range, and through
+//  a per particle loop of the same math on Particle structs. The two are checked against each other.
+//
+//  usage: particle-behaviors-bench [particles = 1000000] [repeat = 10]
+//
+
+#include <random>
+#include "benchmark.hpp"
+#include "../src/core/task/parallel-for.hpp"
+#include "../src/core/math/algebra/lanes.hpp"
+#include "../src/systems/particle/behaviors/gravity-behavior.hpp"
+#include "../src/systems/particle/behaviors/air-resistance.hpp"
+#include "../src/systems/particle/behaviors/wind-behavior.hpp"
+#include "../src/systems/particle/behaviors/color-over-lifetime.hpp"
+#include "../src/systems/particle/behaviors/size-over-lifetime.hpp"
+
+namespace kege::bench{
+
+    const vec3 GRAVITY( 0.f, 0.01f, 0.f );
+
+    /**
+     * @brief The behaviors of the benchmark for one particle, as they were written before the
+     * particles were stored in streams.
+     */
+    void stepParticle( Particle& p, float dms, const WindBehavior& wind, const AirResistance& air, const Gradient& gradient, const std::vector< float >& curve )
+    {
+        p.velocity -= GRAVITY * p.invmass;
+
+        const float speed = magn( p.velocity );
+        if ( speed > 0.0001f )
+        {
+            const float drag = 0.5f * air.fluid_density * speed * speed * air.coefficient * p.size * p.size;
+            p.velocity += -normalize( p.velocity ) * drag * dms * p.invmass;
+        }
+
+        const float falloff = 1.f - kege::clamp( magn( p.position ) / wind.falloffRadius, 0.f, 1.f );
+        vec3 force = normalize( wind.direction ) * wind.strength + wind.turbulence * vec3( 1.f, 0.5f, 1.f );
+        p.velocity += force * falloff * p.invmass * dms;
+
+        const float t = p.health / p.max_health;
+        p.color = gradient.evaluate( t );
+
+        const float x = kege::clamp( t, 0.f, 1.f ) * ( curve.size() - 1 );
+        const uint32_t k = std::min( uint32_t( x ), uint32_t( curve.size() - 2 ) );
+        p.size = curve[ k ] + ( curve[ k + 1 ] - curve[ k ] ) * ( x - k );
+
+        p.health = std::max( p.health - dms, 0.f );
+        p.position += p.velocity * dms;
+    }
+
+    /**
+     * @brief Ages and moves a range of particles, the step ParticleEffectSystem runs after the behaviors.
+     */
+    void integrate( ParticleBuffer& s, uint32_t first, uint32_t last, float dms )
+    {
+        for ( uint32_t i = first; i < last; ++i )
+        {
+            s[ ParticleBuffer::HEALTH ][ i ] = std::max( s[ ParticleBuffer::HEALTH ][ i ] - dms, 0.f );
+            s[ ParticleBuffer::POSITION_X ][ i ] += s[ ParticleBuffer::VELOCITY_X ][ i ] * dms;
+            s[ ParticleBuffer::POSITION_Y ][ i ] += s[ ParticleBuffer::VELOCITY_Y ][ i ] * dms;
+            s[ ParticleBuffer::POSITION_Z ][ i ] += s[ ParticleBuffer::VELOCITY_Z ][ i ] * dms;
+        }
+    }
+
+}
+
+int main( int argc, char** argv )
+{
+    using namespace kege;
+    using namespace kege::bench;
+
+    const uint32_t count = argument( argc, argv, 1, 1000000 );
+    const uint32_t repeat = argument( argc, argv, 2, 10 );
+    const float dms = 1.f / 60.f;
+
+    Gradient gradient;
+    gradient.addKey( 0.0f, vec4( 1.f, 0.f, 0.f, 0.f ) );
+    gradient.addKey( 0.3f, vec4( 1.f, 1.f, 0.f, 1.f ) );
+    gradient.addKey( 1.0f, vec4( 1.f, 1.f, 1.f, 1.f ) );
+
+    const std::vector< float > curve = { 0.2f, 1.f, 0.5f };
+    array< float > sizes( uint32_t( curve.size() ) );
+    for ( uint32_t i = 0; i < curve.size(); ++i ) sizes[ i ] = curve[ i ];
+
+    Ref< WindBehavior > wind = new WindBehavior();
+    Ref< AirResistance > air = new AirResistance();
+    std::vector< Ref< Behavior > > behaviors =
+    {
+        new DirectionalGravity( GRAVITY ), air.ref(), wind.ref(), new ColorOverLifetime( gradient ), new SizeOverLifetime( sizes )
+    };
+
+    std::mt19937 random( 7 );
+    auto uniform = [&random]( float min, float max )
+    {
+        return std::uniform_real_distribution< float >( min, max )( random );
+    };
+
+    std::vector< Particle > particles( count );
+    ParticleBuffer buffer( count );
+    for ( uint32_t i = 0; i < count; ++i )
+    {
+        Particle& p = particles[ i ];
+        p.position = vec3( uniform( -8.f, 8.f ), uniform( -8.f, 8.f ), uniform( -8.f, 8.f ) );
+        p.velocity = vec3( uniform( -3.f, 3.f ), uniform( -3.f, 3.f ), uniform( -3.f, 3.f ) );
+        p.color = vec4( 1.f );
+        p.sprite = vec4( 0.f );
+        p.size = uniform( 0.1f, 1.f );
+        p.rotation = 0.f;
+        p.invmass = uniform( 0.5f, 2.f );
+        p.max_health = uniform( 1.f, 5.f );
+        p.health = p.max_health * uniform( 0.1f, 1.f );
+        buffer.set( i, p );
+    }
+    buffer.particle_count = count;
+
+    auto per_particle = [&]()
+    {
+        for ( Particle& p : particles )
+        {
+            stepParticle( p, dms, *wind, *air, gradient, curve );
+        }
+    };
+
+    auto ranges = [&]( uint32_t first, uint32_t last )
+    {
+        for ( Ref< Behavior >& behavior : behaviors )
+        {
+            behavior->update( dms, buffer, first, last );
+        }
+        integrate( buffer, first, last, dms );
+    };
+
+    const uint32_t grain = ( std::max( ParallelFor::grain, 1u ) + ParticleBuffer::LANES - 1 ) / ParticleBuffer::LANES * ParticleBuffer::LANES;
+    auto parallel = [&]()
+    {
+        kege::parallelFor( 0, buffer.paddedCount(), grain, ranges );
+    };
+
+    // a few steps of both from the same start, before the timing moves them apart
+    for ( int i = 0; i < 3; ++i )
+    {
+        per_particle();
+        ranges( 0, buffer.paddedCount() );
+    }
+    float difference = 0.f;
+    for ( uint32_t i = 0; i < count; ++i )
+    {
+        const Particle q = buffer.get( i );
+        const Particle& p = particles[ i ];
+        difference = std::max( difference, magn( q.velocity - p.velocity ) );
+        difference = std::max( difference, magn( q.position - p.position ) );
+        for ( int k = 0; k < 4; ++k ) difference = std::max( difference, fabsf( q.color[ k ] - p.color[ k ] ) );
+        difference = std::max( difference, fabsf( q.size - p.size ) );
+    }
+
+    printf( "%u particles, %s lanes, %u workers, best of %u\n", count, kege::simd::instructionSet(), JobSystem::instance().workerCount(), repeat );
+    printf( "  per particle:            %8.2f ms\n", best( repeat, per_particle ) );
+    printf( "  ranges, calling thread:  %8.2f ms\n", best( repeat, [&](){ ranges( 0, buffer.paddedCount() ); } ) );
+    printf( "  ranges, job workers:     %8.2f ms\n", best( repeat, parallel ) );
+    printf( "  largest difference after 3 steps: %.2g\n", difference );
+    return 0;
+}
@@ -0,0 +1,222 @@
+//
+//  particle-depth-sort-bench.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+//  Sorts the particles of many effects back to front with ParticleDepthSorter, once as a full
+//  radix sort against std::sort of the same depths, then over frames where the particles drift,
+//  about one in 150 expires and is emitted again, and the view turns, in FULL and INCREMENTAL mode.
+//  The frames are run again with still particles and a still view, the case INCREMENTAL is for.
+//  The order is checked to run far to near and to hold every particle once.
+//
+//  usage: particle-depth-sort-bench [particles = 500000] [effects = 100] [frames = 60]
+//  environment: KEGE_SORT_SPEED scales the particle velocities, KEGE_SORT_TURN the view turn per frame
+//
+
+#include <cmath>
+#include <random>
+#include <algorithm>
+#include "benchmark.hpp"
+#include "../src/systems/particle/systems/particle-depth-sorter.hpp"
+
+namespace kege::bench{
+
+    class SortScene
+    {
+    public:
+
+        SortScene( uint32_t particles, uint32_t effects, float speed )
+        :   _random( 1 )
+        ,   _spread( -50.f, 50.f )
+        ,   _speed( speed )
+        {
+            const uint32_t count = std::max( 1u, particles / effects );
+            _buffers.reserve( effects );
+            for ( uint32_t e = 0; e < effects; ++e )
+            {
+                _buffers.emplace_back( count );
+                ParticleBuffer& buffer = _buffers.back();
+                buffer.particle_count = count;
+                for ( uint32_t i = 0; i < count; ++i )
+                {
+                    spawn( buffer, i );
+                }
+            }
+
+            // effects scattered in front of a view looking down -z
+            for ( ParticleBuffer& buffer : _buffers )
+            {
+                mat44 model;
+                model[3] = vec4( _spread( _random ) * 4.f, _spread( _random ) * 4.f, _spread( _random ) * 4.f - 300.f, 1.f );
+                _sources.push_back({ &buffer, model });
+            }
+        }
+
+        /**
+         * @brief Moves the particles one 16 ms frame and replaces the expired ones.
+         */
+        void step()
+        {
+            for ( ParticleBuffer& buffer : _buffers )
+            {
+                for ( uint32_t i = 0; i < buffer.particle_count; ++i )
+                {
+                    buffer[ ParticleBuffer::HEALTH ][ i ] -= 1.f;
+                    buffer[ ParticleBuffer::POSITION_X ][ i ] += buffer[ ParticleBuffer::VELOCITY_X ][ i ] * 16.f;
+                    buffer[ ParticleBuffer::POSITION_Y ][ i ] += buffer[ ParticleBuffer::VELOCITY_Y ][ i ] * 16.f;
+                    buffer[ ParticleBuffer::POSITION_Z ][ i ] += buffer[ ParticleBuffer::VELOCITY_Z ][ i ] * 16.f;
+                }
+                buffer.removeExpired();
+                while ( buffer.particle_count < buffer.capacity() )
+                {
+                    spawn( buffer, buffer.particle_count++ );
+                }
+            }
+        }
+
+        /**
+         * @brief Times std::sort of the particle depths along the initial view, the fastest of `repeat` runs.
+         */
+        double referenceSort( uint32_t repeat )
+        {
+            std::vector< std::pair< float, uint32_t > > depths;
+            return best( repeat, [&]()
+            {
+                depths.clear();
+                for ( const Source& source : _sources )
+                {
+                    const ParticleBuffer& buffer = *source.particles;
+                    for ( uint32_t i = 0; i < buffer.particle_count; ++i )
+                    {
+                        depths.push_back({ source.model[3].z + buffer[ ParticleBuffer::POSITION_Z ][ i ], uint32_t( depths.size() ) });
+                    }
+                }
+                std::sort( depths.begin(), depths.end(), []( const auto& a, const auto& b ){ return a.first < b.first; });
+            });
+        }
+
+        inline const std::vector< ParticleDepthSorter::Source >& sources()const
+        {
+            return _sources;
+        }
+
+    private:
+
+        typedef ParticleDepthSorter::Source Source;
+
+        void spawn( ParticleBuffer& buffer, uint32_t i )
+        {
+            buffer[ ParticleBuffer::POSITION_X ][ i ] = _spread( _random );
+            buffer[ ParticleBuffer::POSITION_Y ][ i ] = _spread( _random );
+            buffer[ ParticleBuffer::POSITION_Z ][ i ] = _spread( _random );
+            buffer[ ParticleBuffer::VELOCITY_X ][ i ] = _spread( _random ) * _speed;
+            buffer[ ParticleBuffer::VELOCITY_Y ][ i ] = _spread( _random ) * _speed;
+            buffer[ ParticleBuffer::VELOCITY_Z ][ i ] = _spread( _random ) * _speed;
+            buffer[ ParticleBuffer::HEALTH ][ i ] = float( 1 + _random() % 300 );
+        }
+
+    private:
+
+        std::vector< ParticleBuffer > _buffers;
+        std::vector< Source > _sources;
+        std::mt19937 _random;
+        std::uniform_real_distribution< float > _spread;
+        float _speed;
+    };
+
+    /**
+     * @brief Checks the sorter holds every particle once, ordered far to near along `depth`.
+     */
+    bool ordered( const ParticleDepthSorter& sorter, const vec4& depth )
+    {
+        const uint32_t count = sorter.count();
+        std::vector< bool > seen( count, false );
+        double previous = 1e30;
+        for ( uint32_t j = 0; j < count; ++j )
+        {
+            const uint32_t g = sorter.order()[ j ];
+            if ( g >= count || seen[ g ] ) return false;
+            seen[ g ] = true;
+
+            const uint32_t source = sorter.owner( g );
+            const uint32_t i = g - sorter.base( source );
+            const ParticleBuffer& particles = *sorter.sources()[ source ].particles;
+            const mat44& m = sorter.sources()[ source ].model;
+
+            const float x = particles[ ParticleBuffer::POSITION_X ][ i ];
+            const float y = particles[ ParticleBuffer::POSITION_Y ][ i ];
+            const float z = particles[ ParticleBuffer::POSITION_Z ][ i ];
+            const double wx = m[0].x * x + m[1].x * y + m[2].x * z + m[3].x;
+            const double wy = m[0].y * x + m[1].y * y + m[2].y * z + m[3].y;
+            const double wz = m[0].z * x + m[1].z * y + m[2].z * z + m[3].z;
+            const double distance = depth.x * wx + depth.y * wy + depth.z * wz + depth.w;
+
+            // the sorter works in float, allow for its rounding of the depth
+            const double tolerance = 1e-5 * ( fabs( wx ) + fabs( wy ) + fabs( wz ) + fabs( depth.w ) + fabs( x ) + fabs( y ) + fabs( z ) ) + 1e-4;
+            if ( distance > previous + tolerance ) return false;
+            previous = std::min( previous, distance );
+        }
+        return true;
+    }
+
+    void frames( uint32_t particles, uint32_t effects, uint32_t count, ParticleDepthSorter::Mode mode, float speed, float turn )
+    {
+        SortScene scene( particles, effects, speed );
+        ParticleDepthSorter sorter;
+        vec4 depth( 0.f, 0.f, -1.f, 0.f );
+        sorter.sort( scene.sources(), depth, mode );
+
+        double total = 0.0;
+        uint32_t incremental = 0;
+        bool correct = true;
+        float angle = 0.f;
+        for ( uint32_t f = 0; f < count; ++f )
+        {
+            scene.step();
+            angle += turn;
+            depth = vec4( sinf( angle ), 0.f, -cosf( angle ), 0.f );
+
+            const double start = now();
+            sorter.sort( scene.sources(), depth, mode );
+            total += now() - start;
+
+            incremental += sorter.wasIncremental() ? 1 : 0;
+            if ( f % 10 == 0 ) correct = correct && ordered( sorter, depth );
+        }
+        printf( "  %-12s %8.3f ms a frame over %u frames, incremental %u of %u, order %s\n", ( mode == ParticleDepthSorter::FULL ) ? "full:" : "incremental:",
+               total / std::max( 1u, count ), count, incremental, count, correct ? "correct" : "WRONG" );
+    }
+
+}
+
+int main( int argc, char** argv )
+{
+    using namespace kege;
+    using namespace kege::bench;
+
+    const uint32_t particles = argument( argc, argv, 1, 500000 );
+    const uint32_t effects = std::max( 1u, argument( argc, argv, 2, 100 ) );
+    const uint32_t count = argument( argc, argv, 3, 60 );
+    const float speed = float( environment( "KEGE_SORT_SPEED", 0.0005 ) );
+    const float turn = float( environment( "KEGE_SORT_TURN", 0.002 ) );
+
+    SortScene scene( particles, effects, speed );
+    ParticleDepthSorter sorter;
+    const vec4 depth( 0.f, 0.f, -1.f, 0.f );
+    const double full = best( 10, [&](){ sorter.sort( scene.sources(), depth, ParticleDepthSorter::FULL ); });
+    const bool correct = ordered( sorter, depth );
+
+    printf( "%u particles in %u effects\n", sorter.count(), effects );
+    printf( "  radix sort:  %8.3f ms, order %s\n", full, correct ? "correct" : "WRONG" );
+    printf( "  std::sort:   %8.3f ms\n", scene.referenceSort( 5 ) );
+
+    printf( "moving particles, turning view\n" );
+    frames( particles, effects, count, ParticleDepthSorter::FULL, speed, turn );
+    frames( particles, effects, count, ParticleDepthSorter::INCREMENTAL, speed, turn );
+
+    printf( "still particles and view, only the expired ones emitted again\n" );
+    frames( particles, effects, count, ParticleDepthSorter::FULL, 0.f, 0.f );
+    frames( particles, effects, count, ParticleDepthSorter::INCREMENTAL, 0.f, 0.f );
+    return 0;
+}
@@ -0,0 +1,167 @@
+//
+//  physics-scene.hpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef kege_benchmark_physics_scene_hpp
+#define kege_benchmark_physics_scene_hpp
+
+#include <cmath>
+#include <random>
+#include "benchmark.hpp"
+#include "../src/systems/physics/3d/simulation/physics-simulation.hpp"
+#include "../src/systems/physics/3d/simulators/collision-detector.hpp"
+#include "../src/systems/physics/3d/collision/collider/rigid-shapes.hpp"
+
+namespace kege::bench{
+
+    /**
+     * @brief Random spheres and boxes drifting through a cube, bouncing off its walls.
+     *
+     * The bodies move kinematically instead of going through the solvers, so every broadphase
+     * sees the same body states step after step and only the collision detection is timed.
+     * The cube grows with the body count to keep the density, and so the contacts per body, fixed.
+     */
+    class PhysicsScene
+    {
+    public:
+
+        struct Result
+        {
+            /**
+             * averages over the steps run.
+             */
+            double pairs_tested;
+            double milliseconds;
+            double manifolds;
+        };
+
+        /**
+         * @brief Adds `count` random spheres and boxes, the same ones for the same seed.
+         */
+        void generate( uint32_t count, uint32_t seed )
+        {
+            std::mt19937 random( seed );
+            auto uniform = [&random]( float min, float max )
+            {
+                return std::uniform_real_distribution< float >( min, max )( random );
+            };
+
+            // about one body per 2.5^3 units of volume
+            _extent = 1.25f * std::cbrt( float( count ) );
+
+            for ( uint32_t i = 0; i < count; ++i )
+            {
+                Rigidbody* body = _bodies.get( _bodies.create( i + 1 ) );
+                body->center = vec3( uniform( -_extent, _extent ), uniform( -_extent, _extent ), uniform( -_extent, _extent ) );
+                body->prev = body->center;
+                body->orientation = normalize( quat( uniform( 0.f, 360.f ), normalize( vec3( uniform( -1.f, 1.f ), uniform( -1.f, 1.f ), 1.f ) ) ) );
+                body->linear.velocity = vec3( uniform( -2.f, 2.f ), uniform( -2.f, 2.f ), uniform( -2.f, 2.f ) );
+                body->linear.invmass = 1.0;
+                body->up = vec3( 0.f, 1.f, 0.f );
+                body->friction = 0.5f;
+                body->cor = 0.f;
+                body->immovable = false;
+                body->is_awake = true;
+                body->sleepable = false;
+
+                if ( i % 2 == 0 )
+                {
+                    Sphere sphere;
+                    sphere.center = body->center;
+                    sphere.radius = uniform( 0.3f, 0.7f );
+                    body->angular.inertia_inverse = computeSphereInverseTensor( sphere.radius, 1.f );
+                    body->collider = new ColliderSphere( sphere );
+                }
+                else
+                {
+                    OBB box;
+                    box.center = body->center;
+                    box.extents = vec3( uniform( 0.3f, 0.6f ), uniform( 0.3f, 0.6f ), uniform( 0.3f, 0.6f ) );
+                    box.axes = mat33( 1.f );
+                    body->angular.inertia_inverse = computeBoxInverseTensor( box.extents * 2.f, 1.f );
+                    body->collider = new ColliderBox( box );
+                }
+                body->collider->integrate( body );
+            }
+        }
+
+        /**
+         * @brief Moves every body along its velocity and runs the collision detection once.
+         */
+        void step( double time_step )
+        {
+            for ( uint32_t i = 0; i < _bodies.size(); ++i )
+            {
+                Rigidbody* body = _bodies.at( i );
+                body->prev = body->center;
+                body->center += body->linear.velocity * float( time_step );
+                for ( int axis = 0; axis < 3; ++axis )
+                {
+                    if ( ( body->center[ axis ] > _extent && body->linear.velocity[ axis ] > 0.f ) ||
+                         ( body->center[ axis ] < -_extent && body->linear.velocity[ axis ] < 0.f ) )
+                    {
+                        body->linear.velocity[ axis ] = -body->linear.velocity[ axis ];
+                    }
+                }
+                body->collider->integrate( body );
+            }
+            _detector->simulate( time_step );
+        }
+
+        /**
+         * @brief Generates the bodies and steps them with the given broadphase, null tests every pair.
+         * Meant to be called once per scene.
+         */
+        Result run( physics::Broadphase* broadphase, uint32_t count, uint32_t steps, uint32_t seed )
+        {
+            _simulation.setBroadphase( broadphase );
+            generate( count, seed );
+
+            Result result = { 0.0, 0.0, 0.0 };
+            for ( uint32_t i = 0; i < steps; ++i )
+            {
+                step( 1.0 / 60.0 );
+                result.pairs_tested += _detector->stats().pairs_tested;
+                result.milliseconds += _detector->stats().milliseconds;
+                result.manifolds += _simulation.getCollisionRegistry().count();
+            }
+            result.pairs_tested /= steps;
+            result.milliseconds /= steps;
+            result.manifolds /= steps;
+            return result;
+        }
+
+        PhysicsScene()
+        :   _detector( new physics::CollisionDetector() )
+        ,   _extent( 0.f )
+        {
+            // the detector is driven directly, the rest of the pipeline installed here never runs
+            _simulation.initialize( &_bodies );
+            _simulation.addSimulator( physics::Simulation::ON_UPDATE, _detector );
+        }
+
+    private:
+
+        ComponentCacheT< Rigidbody > _bodies;
+        physics::Simulation _simulation;
+
+        /**
+         * owned by the simulation.
+         */
+        physics::CollisionDetector* _detector;
+        float _extent;
+    };
+
+    /**
+     * @brief Prints one line of PhysicsScene::run() results.
+     */
+    inline void print( const char* name, const PhysicsScene::Result& result )
+    {
+        printf( "  %-16s %12.0f pairs tested %10.3f ms per step %8.1f manifolds\n", name, result.pairs_tested, result.milliseconds, result.manifolds );
+    }
+
+}
+#endif /* kege_benchmark_physics_scene_hpp */
@@ -10,6 +10,7 @@
 namespace kege{
 
     uint32_t ComponentCache::_type_counter = 0;
+    uint32_t ComponentCache::_change_tick = 1;
 
     Relationship compare(const kege::EntitySignature& a, const kege::EntitySignature& b)
     {
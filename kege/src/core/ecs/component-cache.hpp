@@ -9,8 +9,11 @@
 #define component_cache_hpp
 
 #include <stdlib.h>
+#include <new>
 #include <bitset>
 #include <vector>
+#include <utility>
+#include <type_traits>
 #include <unordered_map>
 
 namespace kege{
@@ -24,8 +27,10 @@ namespace kege{
 
     /**
      * @brief Represents a unique identifier for a specific component instance.
+     *
+     * 32 bits of handle index and 32 bits of generation, see ComponentCacheT.
      */
-    typedef uint32_t ComponentID;
+    typedef uint64_t ComponentID;
 
     /**
      * @brief Represents a unique type identifier for a specific component type.
@@ -78,15 +83,99 @@ namespace kege{
          */
         virtual void purge() = 0;
 
+        /**
+         * @brief The ComponentType of the components managed by this cache.
+         */
+        virtual ComponentType componentType()const = 0;
+
+        /**
+         * @brief Size in bytes of one component of this type.
+         */
+        virtual uint32_t componentSize()const = 0;
+
+        /**
+         * @brief Alignment requirement of one component of this type.
+         */
+        virtual uint32_t componentAlignment()const = 0;
+
+        /**
+         * @brief Move-constructs the component with the given ID into raw memory and erases it from this cache.
+         * @param component_id The ID of the component to move out.
+         * @param dst Uninitialized memory large enough to hold one component.
+         */
+        virtual void moveOut( ComponentID component_id, void* dst ) = 0;
+
+        /**
+         * @brief Creates a component for the given entity by moving from raw memory, destroying the source.
+         * @param entity_id The ID of the entity that will own the component.
+         * @param src A live component of this type. It is destroyed after the move.
+         * @return The ID of the newly created component.
+         */
+        virtual ComponentID moveIn( EntityID entity_id, void* src ) = 0;
+
+        /**
+         * @brief Move-constructs a component from src into dst and destroys src.
+         */
+        virtual void relocate( void* dst, void* src ) = 0;
+
+        /**
+         * @brief Default-constructs a component in raw memory.
+         */
+        virtual void construct( void* dst ) = 0;
+
+        /**
+         * @brief Destroys a component that lives in raw memory.
+         */
+        virtual void destruct( void* ptr ) = 0;
+
+        /**
+         * @brief Pins this component type to its cache.
+         *
+         * Pinned components are never moved into archetype chunks. Code that walks a cache
+         * directly, like the physics simulation over its rigidbodies, pins the type so it keeps
+         * seeing every component.
+         */
+        void pin(){ _pinned = true; }
+
+        /**
+         * @brief Checks if this component type is pinned to its cache.
+         */
+        bool isPinned()const{ return _pinned; }
+
+        /**
+         * @brief Gets the current change tick. Components are stamped with it when they are
+         * created or handed out for writing, see ComponentCacheT::get() and EntityChunk::get().
+         */
+        static uint32_t changeTick(){ return _change_tick; }
+
+        /**
+         * @brief Starts a new change tick. The EntitySystemManager advances it once per update.
+         * @return The new change tick.
+         */
+        static uint32_t advanceChangeTick(){ return ++_change_tick; }
+
         /**
          * @brief Virtual destructor to ensure proper cleanup in derived classes.
          */
         virtual ~ComponentCache(){}
 
+        ComponentCache(): _pinned( false ) {}
+
         /**
          * @brief Static counter used to assign unique ComponentType values to different component types.
          */
         static uint32_t _type_counter;
+
+    protected:
+
+        /**
+         * @brief The current change tick. Starts at 1, so a version of 0 means never changed.
+         */
+        static uint32_t _change_tick;
+
+    private:
+
+        bool _pinned;
     };
 
 }
@@ -100,8 +189,19 @@ namespace kege{
      * @brief Template class for managing components of a specific type.
      *
      * Inherits from ComponentCache and provides concrete implementations for managing
-     * components of the template parameter `Component`. Uses a free-list strategy for efficient
-     * allocation and deallocation of component instances.
+     * components of the template parameter `Component`. Live components are packed densely:
+     * erasing a component moves the last live component into its slot (swap-and-pop), so
+     * iterating the cache only touches live components. A ComponentID is a stable handle into
+     * a table of slots, made of a handle index and a generation counter. The generation is
+     * bumped whenever a handle is freed, so a stale ComponentID is rejected instead of
+     * aliasing a newer component. A handle whose generation runs out is retired rather than
+     * reused, so an id never matches a second component, however long the game runs.
+     *
+     * Pointers returned by get() stay valid until the next create() or erase() on this cache.
+     *
+     * Every live component carries a change version, the change tick at which it was last
+     * created or handed out by the mutable get(). The dense range accessors at(), data() and the
+     * iterators do not stamp, code that writes through them calls markChanged() itself.
      *
      * @tparam Component The type of the component being managed.
      */
@@ -109,52 +209,64 @@ namespace kege{
     {
     public:
 
+        enum : uint32_t
+        {
+            HANDLE_INDEX_BITS = 32,
+            HANDLE_INDEX_MASK = 0xFFFFFFFF,
+            HANDLE_GENERATION_MASK = 0xFFFFFFFF
+        };
+
         class ConstIterator
         {
         public:
 
-            inline const Component* operator ->()
+            friend inline bool operator !=( const ConstIterator& a, const ConstIterator& b )
+            {
+                return a._index != b._index;
+            }
+
+            friend inline bool operator ==( const ConstIterator& a, const ConstIterator& b )
             {
-                return _components->get( _component );
+                return a._index == b._index;
             }
 
-            void operator --(int)
+            inline const Component* operator ->()const
             {
-                _component--;
-                return ConstIterator( _components, _component );
+                return _components->at( _index );
             }
-            void operator -()
+
+            inline const Component* operator *()const
             {
-                _component--;
-                return ConstIterator( _components, _component );
+                return _components->at( _index );
             }
 
-            void operator ++(int)
+            ConstIterator operator ++(int)
             {
-                _component++;
-                return ConstIterator( _components, _component );
+                ConstIterator i = *this;
+                _index++;
+                return i;
             }
-            void operator ++()
+
+            ConstIterator& operator ++()
             {
-                _component++;
-                return ConstIterator( _components, _component );
+                _index++;
+                return *this;
             }
 
-            ConstIterator( ComponentCacheT< Component >* components, ComponentID component )
+            ConstIterator( const ComponentCacheT< Component >* components, uint32_t index )
             :   _components( components )
-            ,   _component( component )
+            ,   _index( index )
             {}
 
             ConstIterator()
             :   _components( nullptr )
-            ,   _component( -1 )
+            ,   _index( 0 )
             {}
 
         private:
 
-            ComponentID _component;
-            ComponentCacheT< Component >* _components;
-            friend ComponentCacheT< Component >;
+            const ComponentCacheT< Component >* _components;
+            uint32_t _index;
         };
 
         class Iterator
@@ -163,235 +275,300 @@ namespace kege{
 
             friend inline Iterator operator -( const Iterator& other, int32_t i )
             {
-                return Iterator( other._components, other._component - i );
+                return Iterator( other._components, other._index - i );
             }
 
             friend inline Iterator operator +( const Iterator& other, int32_t i )
             {
-                return Iterator( other._components, other._component + i );
-            }
-
-            friend inline Iterator operator -( int32_t i, const Iterator& other )
-            {
-                return Iterator( other._components, i - other._component );
+                return Iterator( other._components, other._index + i );
             }
 
             friend inline Iterator operator +( int32_t i, const Iterator& other )
             {
-                return Iterator( other._components, i + other._component + i );
+                return Iterator( other._components, other._index + i );
             }
 
             friend inline bool operator !=( const Iterator& a, const Iterator& b )
             {
-                return a._component != b._component;
+                return a._index != b._index;
             }
+
             friend inline bool operator ==( const Iterator& a, const Iterator& b )
             {
-                return a._componens == b._component;
+                return a._index == b._index;
             }
 
             inline Component* operator ->()
             {
-                return _components->get( _component );
+                return _components->at( _index );
             }
 
             inline Component* operator *()
             {
-                return _components->get( _component );
+                return _components->at( _index );
+            }
+
+            /**
+             * @brief Gets the ComponentID of the component this iterator points at.
+             */
+            inline ComponentID id()const
+            {
+                return _components->idAt( _index );
             }
 
             Iterator operator --(int)
             {
-                _component--;
-                return Iterator( _components, _component );
+                Iterator i = *this;
+                _index--;
+                return i;
             }
 
-            Iterator operator --()
+            Iterator& operator --()
             {
-                _component--;
-                return Iterator( _components, _component );
+                _index--;
+                return *this;
             }
 
             Iterator operator ++(int)
             {
-                _component++;
-                return Iterator( _components, _component );
+                Iterator i = *this;
+                _index++;
+                return i;
             }
 
-            Iterator operator ++()
+            Iterator& operator ++()
             {
-                _component++;
-                return Iterator( _components, _component );
+                _index++;
+                return *this;
             }
 
-            Iterator( ComponentCacheT< Component >* components, ComponentID component )
+            Iterator( ComponentCacheT< Component >* components, uint32_t index )
             :   _components( components )
-            ,   _component( component )
+            ,   _index( index )
             {}
 
             Iterator()
             :   _components( nullptr )
-            ,   _component( -1 )
+            ,   _index( 0 )
             {}
 
         private:
 
-            ComponentID _component;
             ComponentCacheT< Component >* _components;
+            uint32_t _index;
             friend ComponentCacheT< Component >;
         };
 
         ConstIterator begin()const
         {
-            return ConstIterator( this, _head );
+            return ConstIterator( this, 0 );
         }
 
         ConstIterator end()const
         {
-            return ConstIterator( this, _tail );
+            return ConstIterator( this, size() );
         }
 
         Iterator begin()
         {
-            return Iterator( this, _head );
+            return Iterator( this, 0 );
         }
 
         Iterator end()
         {
-            return Iterator( this, _tail );
+            return Iterator( this, size() );
         }
 
-    protected:
+    public:
 
-        void remove( int32_t& head, int32_t& tail, ComponentID index )
+        /**
+         * @brief Erases a component and frees its handle.
+         *
+         * The last live component is moved into the freed slot, keeping the live range contiguous.
+         * @param component The ID of the component to erase.
+         */
+        void erase( ComponentID component )
         {
-            if ( head == index )
+            const uint32_t index = handleIndex( component );
+            if ( !isvalid( component ) ) return;
+
+            const uint32_t slot = _handles[ index ].slot;
+            const uint32_t last = size() - 1;
+            if ( slot != last )
             {
-                head = _components[ head ].next;
-                if( head < 0 )
-                {
-                    tail = -1;
-                }
+                _dense[ slot ] = std::move( _dense[ last ] );
+                _versions[ slot ] = _versions[ last ];
+                _owners[ slot ] = _owners[ last ];
+                _dense_handles[ slot ] = _dense_handles[ last ];
+                _handles[ _dense_handles[ slot ] ].slot = slot;
             }
-            else if ( tail == index )
+            _dense.pop_back();
+            _versions.pop_back();
+            _owners.pop_back();
+            _dense_handles.pop_back();
+
+            // a handle that went through every generation is never handed out again
+            Handle& handle = _handles[ index ];
+            if ( handle.generation >= max_generation )
             {
-                tail = _components[ head ].prev;
-                if( tail < 0 )
-                {
-                    head = -1;
-                }
+                handle.generation = 0;
+                handle.slot = INVALID_HANDLE;
+                return;
             }
-            else
-            {
-                int32_t prev = _components[ index ].prev;
-                int32_t next = _components[ index ].next;
-                _components[ next ].prev = prev;
-                _components[ prev ].next = next;
-            }
-            _components[ index ].owner = 0;
+            handle.generation = nextGeneration( handle.generation );
+            handle.slot = _free_head;
+            _free_head = index;
         }
 
-        void insert( int32_t& head, int32_t& tail, int32_t index )
+        /**
+         * @brief Gets a constant pointer to the component data with the given ID.
+         * @param component The ID of the component to retrieve.
+         * @return A constant pointer to the component data, or nullptr if the ID is stale or invalid.
+         */
+        const Component* get( ComponentID component )const
         {
-            if ( head < 0 )
-            {
-                tail = head = index;
-            }
-            else
-            {
-                _components[ index ].prev = tail;
-                _components[ tail ].next = index;
-                tail = index;
-            }
+            return isvalid( component ) ? &_dense[ _handles[ handleIndex( component ) ].slot ] : nullptr;
         }
 
-    public:
+        /**
+         * @brief Gets a mutable pointer to the component data with the given ID and stamps the
+         * component with the current change tick.
+         * @param component The ID of the component to retrieve.
+         * @return A mutable pointer to the component data, or nullptr if the ID is stale or invalid.
+         */
+        Component* get( ComponentID component )
+        {
+            if ( !isvalid( component ) ) return nullptr;
+            const uint32_t slot = _handles[ handleIndex( component ) ].slot;
+            _versions[ slot ] = _change_tick;
+            return &_dense[ slot ];
+        }
 
         /**
-         * @brief Marks a component as free for reuse.
-         *
-         * Adds the component ID to the free-list. The component's owner is reset to 0.
-         * @param index The ID of the component to erase.
+         * @brief Gets the change tick at which a component was last written.
+         * @return The version, or 0 if the ID is stale or invalid.
          */
-        void erase( ComponentID index )
+        uint32_t version( ComponentID component )const
         {
-            remove( _head, _tail, index );
-            insert( _free_head, _free_tail, index );
+            return isvalid( component ) ? _versions[ _handles[ handleIndex( component ) ].slot ] : 0;
         }
 
         /**
-         * @brief Gets a constant pointer to the component data with the given ID.
-         * @param index The ID of the component to retrieve.
-         * @return A constant pointer to the component data, or nullptr if the index is invalid.
+         * @brief Gets the change version of the component stored at a position of the dense range.
+         */
+        inline uint32_t versionAt( uint32_t index )const
+        {
+            return _versions[ index ];
+        }
+
+        /**
+         * @brief Stamps the component stored at a position of the dense range with the current change tick.
          */
-        const Component* get( ComponentID index )const
+        inline void markChanged( uint32_t index )
         {
-            return ( index < _components.size() )? &_components[ index ].data : nullptr;
+            _versions[ index ] = _change_tick;
         }
 
         /**
-         * @brief Gets a mutable pointer to the component data with the given ID.
-         * @param index The ID of the component to retrieve.
-         * @return A mutable pointer to the component data, or nullptr if the index is invalid.
+         * @brief Gets the component stored at a position of the dense range [0, size()).
          */
-        Component* get( ComponentID index )
+        inline const Component* at( uint32_t index )const
         {
-            return ( index < _components.size() )? &_components[ index ].data : nullptr;
+            return &_dense[ index ];
         }
 
         /**
-         * @brief Checks if a given ComponentID is valid and currently owned by an entity.
+         * @brief Gets the component stored at a position of the dense range [0, size()).
+         */
+        inline Component* at( uint32_t index )
+        {
+            return &_dense[ index ];
+        }
+
+        /**
+         * @brief Gets the ComponentID of the component stored at a position of the dense range.
+         */
+        inline ComponentID idAt( uint32_t index )const
+        {
+            const uint32_t handle = _dense_handles[ index ];
+            return makeID( handle, _handles[ handle ].generation );
+        }
+
+        /**
+         * @brief Gets the live components as one contiguous array of size() elements.
+         */
+        inline const Component* data()const
+        {
+            return _dense.data();
+        }
+
+        /**
+         * @brief Gets the live components as one contiguous array of size() elements.
+         */
+        inline Component* data()
+        {
+            return _dense.data();
+        }
+
+        /**
+         * @brief Gets the number of live components.
+         */
+        inline uint32_t size()const
+        {
+            return uint32_t( _dense.size() );
+        }
+
+        /**
+         * @brief Checks if a given ComponentID refers to a live component.
          * @param component The ID of the component to check.
-         * @return True if the component is valid (has a non-zero owner), false otherwise.
+         * @return True if the handle exists and its generation matches, false otherwise.
          */
         bool isvalid( ComponentID component )const
         {
-            return owner( component ) >= 0;
+            // retired handles have generation 0, ids never do. this also rejects ComponentID 0
+            const uint32_t index = handleIndex( component );
+            const uint32_t generation = handleGeneration( component );
+            return generation != 0 && index < _handles.size() && _handles[ index ].generation == generation;
         }
 
         /**
          * @brief Gets the EntityID of the entity that owns the given component.
          * @param component The ID of the component.
-         * @return The EntityID of the owner, or false (which will be implicitly cast to 0) if the component is not valid.
+         * @return The EntityID of the owner, or 0 if the component is not valid.
          */
         EntityID owner( ComponentID component )const
         {
-            return ( component < _components.size() )? _components[ component ].owner : false;
+            return isvalid( component ) ? _owners[ _handles[ handleIndex( component ) ].slot ] : 0;
         }
 
         /**
          * @brief Creates a new component instance and associates it with the given EntityID.
          *
-         * Tries to reuse a component from the free-list. If the free-list is empty, a new
-         * component is allocated.
+         * The component is appended to the dense range. A freed handle is reused if one is
+         * available, otherwise a new handle is allocated.
          * @param entity The ID of the entity that will own the new component.
          * @return The ID of the newly created component.
          */
         ComponentID create( EntityID entity )
         {
-            ComponentID component_id;
-            if ( _free_head >= 0 )
+            uint32_t index;
+            if ( _free_head != INVALID_HANDLE )
             {
-                component_id = _free_head;
-                _free_head = _components[ _free_head ].next;
-                if ( _free_head == _free_tail )
-                {
-                    _free_head = _free_tail = 0;
-                }
+                index = _free_head;
+                _free_head = _handles[ index ].slot;
             }
             else
             {
-                component_id = _count;
-                if ( _count >= _components.size() )
-                {
-                    _components.resize( 2 + 2 * _components.size() );
-                }
-                _count++;
+                index = uint32_t( _handles.size() );
+                _handles.push_back({ 0, 1 });
             }
 
-            insert( _head, _tail, component_id );
-            _components[ component_id ].owner = entity;
-            return component_id;
+            _handles[ index ].slot = size();
+            _dense.emplace_back();
+            _versions.push_back( _change_tick );
+            _owners.push_back( entity );
+            _dense_handles.push_back( index );
+            return makeID( index, _handles[ index ].generation );
         }
 
 
@@ -400,12 +577,64 @@ namespace kege{
             return _type;
         }
 
+        ComponentType componentType()const
+        {
+            return _type;
+        }
+
+        uint32_t componentSize()const
+        {
+            return sizeof( Component );
+        }
+
+        uint32_t componentAlignment()const
+        {
+            return alignof( Component );
+        }
+
+        void moveOut( ComponentID component, void* dst )
+        {
+            new ( dst ) Component( std::move( *get( component ) ) );
+            erase( component );
+        }
+
+        ComponentID moveIn( EntityID entity, void* src )
+        {
+            ComponentID component_id = create( entity );
+            Component* component = reinterpret_cast< Component* >( src );
+            *get( component_id ) = std::move( *component );
+            component->~Component();
+            return component_id;
+        }
+
+        void relocate( void* dst, void* src )
+        {
+            Component* component = reinterpret_cast< Component* >( src );
+            new ( dst ) Component( std::move( *component ) );
+            component->~Component();
+        }
+
+        void construct( void* dst )
+        {
+            new ( dst ) Component();
+        }
+
+        void destruct( void* ptr )
+        {
+            reinterpret_cast< Component* >( ptr )->~Component();
+        }
+
         /**
          * @brief Removes all component instances managed by this manager and clears the underlying storage.
          */
         void purge()
         {
-            _components.clear();
+            _dense.clear();
+            _versions.clear();
+            _owners.clear();
+            _dense_handles.clear();
+            _handles.clear();
+            _free_head = INVALID_HANDLE;
         }
 
         /**
@@ -420,73 +649,90 @@ namespace kege{
 
         /**
          * @brief Default constructor for ComponentCacheT.
-         *
-         * Initializes the internal counters and free-list pointers.
          */
         ComponentCacheT()
-        :   _count( 0 )
-        ,   _free_head( -1 )
-        ,   _free_tail( -1 )
-        ,   _head( -1 )
-        ,   _tail( -1 )
+        :   _free_head( INVALID_HANDLE )
         {}
 
+    public:
+
+        /**
+         * @brief A handle freed at this generation is retired instead of reused. Lower it only to
+         * exercise retirement, it must stay at least 1.
+         */
+        static uint32_t max_generation;
+
     private:
 
+        enum : uint32_t { INVALID_HANDLE = 0xFFFFFFFF };
+
         /**
-         * @brief Internal structure to hold the component data and metadata.
+         * @brief Indirection from a ComponentID to the dense slot of its component.
          */
-        struct ComponentInfo
+        struct Handle
         {
             /**
-             * @brief The actual component data.
+             * @brief The dense slot of the component, or the next free handle while the handle is free.
              */
-            Component data;
+            uint32_t slot;
 
             /**
-             * @brief The EntityID of the entity that owns this component.
+             * @brief Bumped each time the handle is freed. Never 0 in an id, so ComponentID 0 is never valid, and a retired handle has 0.
              */
-            EntityID owner;
-
-            /**
-             * @brief Index of the next free component in the free-list (used when a component is erased).
-             */
-            int32_t next;
-            int32_t prev;
+            uint32_t generation;
         };
 
+        static inline uint32_t handleIndex( ComponentID component )
+        {
+            return uint32_t( component & HANDLE_INDEX_MASK );
+        }
+
+        static inline uint32_t handleGeneration( ComponentID component )
+        {
+            return uint32_t( ( component >> HANDLE_INDEX_BITS ) & HANDLE_GENERATION_MASK );
+        }
+
+        static inline ComponentID makeID( uint32_t index, uint32_t generation )
+        {
+            return ( ComponentID( generation ) << HANDLE_INDEX_BITS ) | index;
+        }
+
+        static inline uint32_t nextGeneration( uint32_t generation )
+        {
+            return generation + 1;
+        }
+
     private:
 
         /**
-         * @brief Vector to store the component objects.
+         * @brief The live components, packed without holes.
          */
-        std::vector< ComponentInfo > _components;
+        std::vector< Component > _dense;
 
         /**
-         * @brief Counter for the total number of components created (including those in the free-list).
+         * @brief The change version of each live component, parallel to _dense.
          */
-        uint32_t _count;
+        std::vector< uint32_t > _versions;
 
         /**
-         * @brief Index of the first free component in the free-list.
+         * @brief The owner of each live component, parallel to _dense.
          */
-        int32_t _free_head;
+        std::vector< EntityID > _owners;
 
         /**
-         * @brief Index of the last free component in the free-list.
+         * @brief The handle of each live component, parallel to _dense.
          */
-        int32_t _free_tail;
-
+        std::vector< uint32_t > _dense_handles;
 
         /**
-         * @brief Index of the first free component in the free-list.
+         * @brief The handle table that ComponentIDs index into.
          */
-        int32_t _head;
+        std::vector< Handle > _handles;
 
         /**
-         * @brief Index of the last free component in the free-list.
+         * @brief Head of the list of free handles, chained through Handle::slot.
          */
-        int32_t _tail;
+        uint32_t _free_head;
 
         /**
          * @brief Static member to store the unique ComponentType for this component type.
@@ -500,6 +746,7 @@ namespace kege{
     };
 
     template< typename T > uint32_t ComponentCacheT< T >::_type = ComponentCache::_type_counter++;
+    template< typename T > uint32_t ComponentCacheT< T >::max_generation = ComponentCacheT< T >::HANDLE_GENERATION_MASK;
 
     enum Relationship
     {
@@ -515,7 +762,7 @@ namespace kege{
     template< typename... T > kege::EntitySignature createEntitySignature()
     {
         kege::EntitySignature signature;
-        ( signature.set( kege::ComponentCacheT< T >::getType() ), ... );
+        ( signature.set( kege::ComponentCacheT< std::remove_const_t< T > >::getType() ), ... );
         return signature;
     }
 }
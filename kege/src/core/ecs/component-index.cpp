@@ -0,0 +1,66 @@
+//
+//  component-index.cpp
+//  ecs
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#include "component-index.hpp"
+
+namespace kege{
+
+    void ComponentIndex::allocate( uint32_t page )
+    {
+        if ( page >= _pages.size() )
+        {
+            _pages.resize( page + 1, nullptr );
+        }
+        _pages[ page ] = new ComponentID[ PAGE_SIZE ]();
+    }
+
+    size_t ComponentIndex::memory()const
+    {
+        size_t bytes = _pages.capacity() * sizeof( ComponentID* );
+        for ( const ComponentID* page : _pages )
+        {
+            if ( page ) bytes += PAGE_SIZE * sizeof( ComponentID );
+        }
+        return bytes;
+    }
+
+    void ComponentIndex::clear()
+    {
+        for ( ComponentID*& page : _pages )
+        {
+            delete [] page;
+            page = nullptr;
+        }
+        _pages.clear();
+    }
+
+    ComponentIndex::ComponentIndex( ComponentIndex&& other )
+    :   _pages( std::move( other._pages ) )
+    {
+        other._pages.clear();
+    }
+
+    ComponentIndex& ComponentIndex::operator=( ComponentIndex&& other )
+    {
+        if ( this != &other )
+        {
+            clear();
+            _pages = std::move( other._pages );
+            other._pages.clear();
+        }
+        return *this;
+    }
+
+    ComponentIndex::~ComponentIndex()
+    {
+        clear();
+    }
+
+    ComponentIndex::ComponentIndex()
+    {}
+
+}
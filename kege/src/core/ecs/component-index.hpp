@@ -0,0 +1,88 @@
+//
+//  component-index.hpp
+//  ecs
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef component_index_hpp
+#define component_index_hpp
+
+#include "component-cache.hpp"
+
+namespace kege{
+
+    /**
+     * @brief Maps container ids to the ComponentID of one component type.
+     *
+     * The index is a sparse array split into fixed-size pages. A page is only allocated once a
+     * container inside its range receives a component of this type, so the memory of a type
+     * is bounded by the id range of the containers that actually use it. Lookups are two array
+     * reads and never hash.
+     */
+    class ComponentIndex
+    {
+    public:
+
+        enum{ PAGE_SHIFT = 12, PAGE_SIZE = 1 << PAGE_SHIFT, PAGE_MASK = PAGE_SIZE - 1 };
+
+        /**
+         * @brief Gets the ComponentID stored for a container.
+         *
+         * The container must have been set before, callers test the container signature first.
+         */
+        inline ComponentID get( uint32_t container )const
+        {
+            return _pages[ container >> PAGE_SHIFT ][ container & PAGE_MASK ];
+        }
+
+        /**
+         * @brief Stores the ComponentID of a container, allocating its page if needed.
+         */
+        inline void set( uint32_t container, ComponentID component )
+        {
+            const uint32_t page = container >> PAGE_SHIFT;
+            if ( page >= _pages.size() || _pages[ page ] == nullptr )
+            {
+                allocate( page );
+            }
+            _pages[ page ][ container & PAGE_MASK ] = component;
+        }
+
+        /**
+         * @brief Checks if the page of a container is allocated.
+         */
+        inline bool contains( uint32_t container )const
+        {
+            const uint32_t page = container >> PAGE_SHIFT;
+            return page < _pages.size() && _pages[ page ] != nullptr;
+        }
+
+        /**
+         * @brief Gets the number of bytes held by the allocated pages.
+         */
+        size_t memory()const;
+
+        /**
+         * @brief Frees every page.
+         */
+        void clear();
+
+        ComponentIndex( ComponentIndex&& other );
+        ComponentIndex& operator=( ComponentIndex&& other );
+        ComponentIndex( const ComponentIndex& ) = delete;
+        ComponentIndex& operator=( const ComponentIndex& ) = delete;
+        ~ComponentIndex();
+        ComponentIndex();
+
+    private:
+
+        void allocate( uint32_t page );
+
+    private:
+
+        std::vector< ComponentID* > _pages;
+    };
+
+}
+#endif /* component_index_hpp */
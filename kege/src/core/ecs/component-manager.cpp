@@ -9,9 +9,28 @@
 
 namespace kege{
 
-    const EntityComponentMap& ComponentManager::getEntityComponents( uint32_t entity )const
+    EntityComponentMap ComponentManager::getEntityComponents( uint32_t entity )const
     {
-        return _component_containers[ entity ].components;
+        EntityComponentMap components;
+        const ComponentContainer& c = _component_containers[ entity ];
+        for ( ComponentType type = 0; type < MAX_COMPONENT_TYPES; ++type )
+        {
+            if ( c.signature.test( type ) )
+            {
+                components[ type ] = ( isChunkStored( c, type ) ) ? 0 : _component_indices[ type ].get( entity );
+            }
+        }
+        return components;
+    }
+
+    size_t ComponentManager::getIndexMemory()const
+    {
+        size_t bytes = 0;
+        for ( const ComponentIndex& index : _component_indices )
+        {
+            bytes += index.memory();
+        }
+        return bytes;
     }
 
     const EntitySignature& ComponentManager::signature( uint32_t entity )const
@@ -19,14 +38,95 @@ namespace kege{
         return _component_containers[ entity ].signature;
     }
 
+    ComponentCache* ComponentManager::getComponentCache( ComponentType type )const
+    {
+        return ( type < _component_caches.size() ) ? _component_caches[ type ] : nullptr;
+    }
+
+    bool ComponentManager::buildChunkLayout( const EntitySignature& signature, ChunkLayout& layout )const
+    {
+        std::vector< ComponentCache* > caches;
+        for ( ComponentType type = 0; type < MAX_COMPONENT_TYPES; ++type )
+        {
+            if ( signature.test( type ) && _component_caches[ type ] && !_component_caches[ type ]->isPinned() )
+            {
+                caches.push_back( _component_caches[ type ] );
+            }
+        }
+        return !caches.empty() && layout.build( caches );
+    }
+
+    void ComponentManager::attachChunk( uint32_t container, EntityChunk* chunk, uint32_t row )
+    {
+        ComponentContainer& c = _component_containers[ container ];
+        const std::vector< ChunkColumn >& columns = chunk->layout()->columns();
+        for ( uint32_t i = 0; i < columns.size(); ++i )
+        {
+            if ( c.signature.test( columns[ i ].type ) )
+            {
+                columns[ i ].cache->moveOut( _component_indices[ columns[ i ].type ].get( container ), chunk->at( i, row ) );
+            }
+            else
+            {
+                columns[ i ].cache->construct( chunk->at( i, row ) );
+            }
+        }
+        c.chunk = chunk;
+        c.row = row;
+    }
+
+    void ComponentManager::detachChunk( uint32_t container )
+    {
+        ComponentContainer& c = _component_containers[ container ];
+        if ( c.chunk == nullptr )
+        {
+            return;
+        }
+
+        const std::vector< ChunkColumn >& columns = c.chunk->layout()->columns();
+        for ( uint32_t i = 0; i < columns.size(); ++i )
+        {
+            if ( c.signature.test( columns[ i ].type ) )
+            {
+                _component_indices[ columns[ i ].type ].set( container, columns[ i ].cache->moveIn( container, c.chunk->at( i, c.row ) ) );
+            }
+            else
+            {
+                columns[ i ].cache->destruct( c.chunk->at( i, c.row ) );
+            }
+        }
+        c.chunk = nullptr;
+        c.row = 0;
+    }
+
+    void ComponentManager::setChunkRow( uint32_t container, EntityChunk* chunk, uint32_t row )
+    {
+        _component_containers[ container ].chunk = chunk;
+        _component_containers[ container ].row = row;
+    }
+
+    bool ComponentManager::inChunk( uint32_t container, const EntityChunk* chunk, uint32_t row )const
+    {
+        return _component_containers[ container ].chunk == chunk && _component_containers[ container ].row == row;
+    }
+
     void ComponentManager::purge( uint32_t& entity )
     {
-        for(const auto& [type, id] : _component_containers[ entity ].components)
+        ComponentContainer& c = _component_containers[ entity ];
+        for ( ComponentType type = 0; type < MAX_COMPONENT_TYPES; ++type )
         {
-            _component_caches[ type ]->erase( id );
+            /*
+             components stored in an archetype chunk stay in their row until the registry
+             releases it, the container only forgets where they are.
+             */
+            if ( c.signature.test( type ) && !isChunkStored( c, type ) )
+            {
+                _component_caches[ type ]->erase( _component_indices[ type ].get( entity ) );
+            }
         }
-        _component_containers[ entity ].components.clear();
-        _component_containers[ entity ].signature.reset();
+        c.chunk = nullptr;
+        c.row = 0;
+        c.signature.reset();
 
         if ( _head == 0 )
         {
@@ -81,16 +181,22 @@ namespace kege{
             }
         }
         _component_caches.clear();
+
+        for ( ComponentIndex& index : _component_indices )
+        {
+            index.clear();
+        }
     }
 
     std::ostream& ComponentManager::print(std::ostream& os, uint32_t entity)
     {
         os<<"  container: " << entity <<"\n";
         os<<"    components:\n";
-        for(const auto& [type, id] : _component_containers[ entity ].components)
+        for(const auto& [type, id] : getEntityComponents( entity ))
         {
             os<<"      type: " << type <<"\n";
-            os<<"      id:   " << id <<"\n";
+            if ( id == 0 ) os<<"      chunk row: " << _component_containers[ entity ].row <<"\n";
+            else os<<"      id:   " << id <<"\n";
         }
         return os;
     }
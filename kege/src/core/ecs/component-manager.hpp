@@ -10,9 +10,16 @@
 
 #include <iostream>
 #include "component-cache.hpp"
+#include "entity-chunk.hpp"
+#include "component-index.hpp"
 
 namespace kege{
 
+    /**
+     * @brief A snapshot of the components of a container, keyed by ComponentType.
+     *
+     * Components stored in an archetype chunk have no ComponentID and map to 0.
+     */
     typedef std::unordered_map< ComponentType, ComponentID > EntityComponentMap;
 
     /**
@@ -21,18 +28,22 @@ namespace kege{
     struct ComponentContainer
     {
         /**
-         * @brief Stores the component IDs for each component type associated with this container.
+         * @brief Bitset representing the signature of components this container possesses.
          *
-         * The key is the ComponentType, and the value is the ComponentID within the respective ComponentManager.
+         * Each bit corresponds to a specific ComponentType. The ComponentID of every set bit is
+         * stored in the ComponentIndex of its type, unless the component lives in `chunk`.
          */
-        EntityComponentMap components;
+        EntitySignature signature;
 
         /**
-         * @brief Bitset representing the signature of components this container possesses.
-         *
-         * Each bit corresponds to a specific ComponentType.
+         * @brief The archetype chunk that holds the non-pinned components of this container, or nullptr.
          */
-        EntitySignature signature;
+        EntityChunk* chunk = nullptr;
+
+        /**
+         * @brief The row of this container inside `chunk`.
+         */
+        uint32_t row = 0;
 
         /**
          * @brief Pointer to the next free container slot (used for efficient container creation and deletion).
@@ -116,14 +127,26 @@ namespace kege{
         template< typename Component > Component* add( uint32_t& container )
         {
             ComponentCacheT< Component >* cmgr = getComponentCache< Component >();
+            ComponentContainer& c = _component_containers[ container ];
+
+            if ( c.chunk != nullptr )
+            {
+                Component* component = c.chunk->get< Component >( c.row );
+                if ( component )
+                {
+                    c.signature.set( cmgr->_type );
+                    return component;
+                }
+            }
 
-            if ( !_component_containers[ container ].signature.test( cmgr->_type ) )
+            ComponentIndex& index = _component_indices[ cmgr->_type ];
+            if ( !c.signature.test( cmgr->_type ) )
             {
-                _component_containers[ container ].components[ cmgr->_type ] = cmgr->create( container );
-                _component_containers[ container ].signature.set( cmgr->_type );
+                index.set( container, cmgr->create( container ) );
+                c.signature.set( cmgr->_type );
             }
 
-            return cmgr->get( _component_containers[ container ].components[ cmgr->_type ] );
+            return cmgr->get( index.get( container ) );
         }
 
         /**
@@ -137,11 +160,28 @@ namespace kege{
         template< typename Component > void erase( uint32_t& container )
         {
             ComponentCacheT< Component >* cmgr = getComponentCache< Component >();
-            if ( _component_containers[ container ].signature.test( cmgr->_type ) )
+            ComponentContainer& c = _component_containers[ container ];
+
+            if ( c.chunk != nullptr && c.signature.test( cmgr->_type ) )
             {
-                cmgr->erase( _component_containers[ container ].components[ cmgr->_type ] );
-                _component_containers[ container ].signature.reset( cmgr->_type );
-                _component_containers[ container ].components[ cmgr->_type ] = 0;
+                /*
+                 a chunk column can not shrink for a single row. the slot is reset and the
+                 signature bit cleared, the row leaves the chunk when its entity is removed
+                 from the registry.
+                 */
+                Component* component = c.chunk->get< Component >( c.row );
+                if ( component )
+                {
+                    *component = Component();
+                    c.signature.reset( cmgr->_type );
+                    return;
+                }
+            }
+
+            if ( c.signature.test( cmgr->_type ) )
+            {
+                cmgr->erase( _component_indices[ cmgr->_type ].get( container ) );
+                c.signature.reset( cmgr->_type );
             }
         }
 
@@ -151,7 +191,7 @@ namespace kege{
          * @param container The ID of the container whose component is being requested.
          * @return A constant pointer to the component, or nullptr if the container doesn't have this component.
          */
-        template< typename Component > const Component* get( const uint32_t& container, const uint32_t& component )const
+        template< typename Component > const Component* get( const uint32_t& container, const ComponentID& component )const
         {
             return getComponentCache< Component >()->get( component );
         }
@@ -162,7 +202,7 @@ namespace kege{
          * @param container The ID of the container whose component is being requested.
          * @return A mutable pointer to the component, or nullptr if the container doesn't have this component.
          */
-        template< typename Component > Component* get( uint32_t& container, const uint32_t& component )
+        template< typename Component > Component* get( uint32_t& container, const ComponentID& component )
         {
             return getComponentCache< Component >()->get( component );
         }
@@ -176,9 +216,14 @@ namespace kege{
         template< typename Component > const Component* get( const uint32_t& container )const
         {
             const ComponentCacheT< Component >* cmgr = getComponentCache< Component >();
-            if ( cmgr == nullptr || !_component_containers[ container ].signature.test( cmgr->_type ) ) return nullptr;
-            auto m = _component_containers[ container ].components.find( cmgr->_type );
-            return cmgr->get( m->second );
+            const ComponentContainer& c = _component_containers[ container ];
+            if ( cmgr == nullptr || !c.signature.test( cmgr->_type ) ) return nullptr;
+            if ( c.chunk != nullptr )
+            {
+                const Component* component = static_cast< const EntityChunk* >( c.chunk )->get< Component >( c.row );
+                if ( component ) return component;
+            }
+            return cmgr->get( _component_indices[ cmgr->_type ].get( container ) );
         }
 
         /**
@@ -190,8 +235,14 @@ namespace kege{
         template< typename Component > Component* get( uint32_t& container )
         {
             ComponentCacheT< Component >* cmgr = getComponentCache< Component >();
-            if ( !_component_containers[ container ].signature.test( cmgr->_type ) ) return nullptr;
-            return cmgr->get( _component_containers[ container ].components[ cmgr->_type ] );
+            ComponentContainer& c = _component_containers[ container ];
+            if ( !c.signature.test( cmgr->_type ) ) return nullptr;
+            if ( c.chunk != nullptr )
+            {
+                Component* component = c.chunk->get< Component >( c.row );
+                if ( component ) return component;
+            }
+            return cmgr->get( _component_indices[ cmgr->_type ].get( container ) );
         }
 
         /**
@@ -200,13 +251,78 @@ namespace kege{
          * @param container The ID of the container to check.
          * @return True if the container has the component, false otherwise.
          */
+        /**
+         * @brief Gets the cache id of a component of a specific type for an container.
+         * @tparam Component The type of the component.
+         * @param container The ID of the container.
+         * @return The component id inside its ComponentCacheT, or 0 if the container doesn't have this component in a cache.
+         */
+        template< typename Component > ComponentID getComponentID( const uint32_t& container )const
+        {
+            const uint32_t& TYPE = ComponentCacheT< Component >::_type;
+            const ComponentContainer& c = _component_containers[ container ];
+            if ( !c.signature.test( TYPE ) || isChunkStored( c, TYPE ) ) return 0;
+            return _component_indices[ TYPE ].get( container );
+        }
+
         template< typename Component > bool has( const uint32_t& container )const
         {
             const uint32_t& TYPE = ComponentCacheT< Component >::_type;
             return _component_containers[ container ].signature.test( TYPE );
         }
 
-        const EntityComponentMap& getEntityComponents( uint32_t entity )const;
+        /**
+         * @brief Gets every component of a container, chunk-stored ones with ComponentID 0.
+         *
+         * The map is assembled from the signature and the component indices on each call and is
+         * meant for tools such as the editor, not for per-frame lookups.
+         */
+        EntityComponentMap getEntityComponents( uint32_t entity )const;
+
+        /**
+         * @brief Gets the number of bytes held by the component indices.
+         */
+        size_t getIndexMemory()const;
+
+        /**
+         * @brief Gets the cache of a component type without knowing the type at compile time.
+         * @return The cache, or nullptr if no component of this type was ever created.
+         */
+        ComponentCache* getComponentCache( ComponentType type )const;
+
+        /**
+         * @brief Builds the chunk layout for a signature.
+         *
+         * Every non-pinned component type of the signature gets one column.
+         * @return True if the layout has at least one column and one row fits into a chunk.
+         */
+        bool buildChunkLayout( const EntitySignature& signature, ChunkLayout& layout )const;
+
+        /**
+         * @brief Moves the chunk-stored components of a container out of their caches into a chunk row.
+         * @param container The ID of the container.
+         * @param chunk The chunk that receives the components.
+         * @param row A reserved row of the chunk with uninitialized component memory.
+         */
+        void attachChunk( uint32_t container, EntityChunk* chunk, uint32_t row );
+
+        /**
+         * @brief Moves the components of a container out of its chunk row back into their caches.
+         *
+         * The row is left with uninitialized component memory.
+         * @param container The ID of the container.
+         */
+        void detachChunk( uint32_t container );
+
+        /**
+         * @brief Updates the chunk location of a container whose row was relocated by its chunk.
+         */
+        void setChunkRow( uint32_t container, EntityChunk* chunk, uint32_t row );
+
+        /**
+         * @brief Checks if the components of a container are stored in a specific chunk row.
+         */
+        bool inChunk( uint32_t container, const EntityChunk* chunk, uint32_t row )const;
 
         /**
          * @brief Gets the component signature of an container.
@@ -254,6 +370,21 @@ namespace kege{
 
     private:
 
+        /**
+         * @brief Checks if the component of a type is stored in the archetype chunk of a container.
+         */
+        inline bool isChunkStored( const ComponentContainer& c, ComponentType type )const
+        {
+            return c.chunk != nullptr && c.chunk->layout()->column( type ) >= 0;
+        }
+
+    private:
+
+        /**
+         * @brief One sparse container-to-component index per component type.
+         */
+        ComponentIndex _component_indices[ MAX_COMPONENT_TYPES ];
+
         /**
          * @brief Vector to store the container data.
          */
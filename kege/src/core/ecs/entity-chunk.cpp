@@ -0,0 +1,133 @@
+//
+//  entity-chunk.cpp
+//  ecs
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#include <algorithm>
+#include "entity-chunk.hpp"
+
+namespace kege{
+
+    static inline uint32_t alignOffset( uint32_t offset, uint32_t alignment )
+    {
+        return ( offset + alignment - 1 ) & ~( alignment - 1 );
+    }
+
+    bool ChunkLayout::build( const std::vector< ComponentCache* >& caches )
+    {
+        _columns.clear();
+        for ( int i = 0; i < MAX_COMPONENT_TYPES; ++i )
+        {
+            _column_index[ i ] = -1;
+        }
+
+        /*
+         every row needs room for the entity id plus one element of each column. the worst
+         case padding between columns is subtracted up front so the offsets computed below
+         always stay inside the chunk.
+         */
+        uint32_t row_size = sizeof( uint32_t );
+        uint32_t padding = 0;
+        for ( ComponentCache* cache : caches )
+        {
+            row_size += cache->componentSize();
+            padding  += cache->componentAlignment();
+        }
+
+        _capacity = ( ENTITY_CHUNK_SIZE > padding ) ? ( ENTITY_CHUNK_SIZE - padding ) / row_size : 0;
+        if ( _capacity == 0 )
+        {
+            return false;
+        }
+
+        uint32_t offset = sizeof( uint32_t ) * _capacity;
+        for ( ComponentCache* cache : caches )
+        {
+            offset = alignOffset( offset, cache->componentAlignment() );
+            _column_index[ cache->componentType() ] = int8_t( _columns.size() );
+            _columns.push_back({ cache, cache->componentType(), offset, cache->componentSize() });
+            offset += cache->componentSize() * _capacity;
+        }
+        return true;
+    }
+
+    ChunkLayout::ChunkLayout()
+    :   _capacity( 0 )
+    {
+        for ( int i = 0; i < MAX_COMPONENT_TYPES; ++i )
+        {
+            _column_index[ i ] = -1;
+        }
+    }
+
+}
+
+namespace kege{
+
+    uint32_t EntityChunk::push( uint32_t entity )
+    {
+        entities()[ _count ] = entity;
+        for ( uint32_t c = 0; c < _column_versions.size(); ++c )
+        {
+            markChanged( c, _count );
+        }
+        return _count++;
+    }
+
+    void EntityChunk::pop()
+    {
+        _count--;
+    }
+
+    void EntityChunk::relocate( uint32_t dst, EntityChunk& other, uint32_t src )
+    {
+        const std::vector< ChunkColumn >& columns = _layout->columns();
+        for ( uint32_t c = 0; c < columns.size(); ++c )
+        {
+            columns[ c ].cache->relocate( at( c, dst ), other.at( c, src ) );
+
+            const uint32_t version = other.version( c, src );
+            _versions[ c * _layout->capacity() + dst ] = version;
+            _column_versions[ c ] = std::max( _column_versions[ c ], version );
+        }
+        entities()[ dst ] = other.entities()[ src ];
+    }
+
+    void EntityChunk::markChanged( uint32_t column )
+    {
+        const uint32_t tick = ComponentCache::changeTick();
+        uint32_t* versions = &_versions[ column * _layout->capacity() ];
+        for ( uint32_t row = 0; row < _count; ++row )
+        {
+            versions[ row ] = tick;
+        }
+        _column_versions[ column ] = tick;
+    }
+
+    void EntityChunk::destruct( uint32_t row )
+    {
+        const std::vector< ChunkColumn >& columns = _layout->columns();
+        for ( uint32_t c = 0; c < columns.size(); ++c )
+        {
+            columns[ c ].cache->destruct( at( c, row ) );
+        }
+    }
+
+    EntityChunk::EntityChunk( const ChunkLayout* layout )
+    :   _layout( layout )
+    ,   _data( nullptr )
+    ,   _count( 0 )
+    ,   _versions( layout->columns().size() * layout->capacity(), 0 )
+    ,   _column_versions( layout->columns().size(), 0 )
+    {
+        _data = reinterpret_cast< uint8_t* >( ::operator new( ENTITY_CHUNK_SIZE, std::align_val_t( 64 ) ) );
+    }
+
+    EntityChunk::~EntityChunk()
+    {
+        ::operator delete( _data, std::align_val_t( 64 ) );
+    }
+
+}
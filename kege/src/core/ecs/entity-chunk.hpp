@@ -0,0 +1,270 @@
+//
+//  entity-chunk.hpp
+//  ecs
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef entity_chunk_hpp
+#define entity_chunk_hpp
+
+#include "component-cache.hpp"
+
+namespace kege{
+
+    enum{ ENTITY_CHUNK_SIZE = 16 * 1024 };
+
+    /**
+     * @brief Describes one component column inside an EntityChunk.
+     */
+    struct ChunkColumn
+    {
+        /**
+         * @brief The cache of this component type. Used for type-erased construct, move and destroy.
+         */
+        ComponentCache* cache;
+
+        /**
+         * @brief The component type stored in this column.
+         */
+        ComponentType type;
+
+        /**
+         * @brief Byte offset of the first element of this column from the start of the chunk.
+         */
+        uint32_t offset;
+
+        /**
+         * @brief Size in bytes of one element of this column.
+         */
+        uint32_t stride;
+    };
+
+    /**
+     * @brief The memory layout shared by all chunks of one EntityGroup.
+     *
+     * A chunk starts with a column of entity ids followed by one column per non-pinned
+     * component type of the group signature. Every column holds `capacity` elements.
+     */
+    class ChunkLayout
+    {
+    public:
+
+        /**
+         * @brief Gets the column index of a component type.
+         * @return The column index, or -1 if the type is not stored in the chunk.
+         */
+        inline int32_t column( ComponentType type )const
+        {
+            return _column_index[ type ];
+        }
+
+        /**
+         * @brief Gets the number of entity rows a single chunk can hold.
+         */
+        inline uint32_t capacity()const
+        {
+            return _capacity;
+        }
+
+        /**
+         * @brief Gets the component columns of this layout.
+         */
+        inline const std::vector< ChunkColumn >& columns()const
+        {
+            return _columns;
+        }
+
+        /**
+         * @brief Builds the layout for a set of component caches.
+         * @param caches The caches of every non-pinned component type of the group signature.
+         * @return True if at least one row fits into a chunk, false otherwise.
+         */
+        bool build( const std::vector< ComponentCache* >& caches );
+
+        ChunkLayout();
+
+    private:
+
+        std::vector< ChunkColumn > _columns;
+        int8_t _column_index[ MAX_COMPONENT_TYPES ];
+        uint32_t _capacity;
+    };
+
+    /**
+     * @brief A fixed-size block of memory holding the components of up to `capacity` entities
+     * of one EntityGroup, stored column by column.
+     *
+     * Next to the component data the chunk keeps the change version of every element, the change
+     * tick at which it was last written, and per column the newest of those versions. get() and
+     * push() stamp, column() and at() do not, code writing through them calls markChanged().
+     */
+    class EntityChunk
+    {
+    public:
+
+        /**
+         * @brief Gets a pointer to the first element of a component column.
+         * @tparam Component The component type of the column.
+         * @return The column, or nullptr if the component type is not stored in this chunk.
+         */
+        template< typename Component > Component* column()
+        {
+            int32_t index = _layout->column( ComponentCacheT< Component >::getType() );
+            return ( index < 0 ) ? nullptr : reinterpret_cast< Component* >( _data + _layout->columns()[ index ].offset );
+        }
+
+        template< typename Component > const Component* column()const
+        {
+            int32_t index = _layout->column( ComponentCacheT< Component >::getType() );
+            return ( index < 0 ) ? nullptr : reinterpret_cast< const Component* >( _data + _layout->columns()[ index ].offset );
+        }
+
+        /**
+         * @brief Gets a pointer to the component of a specific row and stamps it with the current change tick.
+         * @tparam Component The component type to retrieve.
+         * @return The component, or nullptr if the component type is not stored in this chunk.
+         */
+        template< typename Component > Component* get( uint32_t row )
+        {
+            int32_t index = _layout->column( ComponentCacheT< Component >::getType() );
+            if ( index < 0 ) return nullptr;
+            markChanged( uint32_t( index ), row );
+            return reinterpret_cast< Component* >( _data + _layout->columns()[ index ].offset ) + row;
+        }
+
+        /**
+         * @brief Gets a read-only pointer to the component of a specific row. Does not stamp.
+         */
+        template< typename Component > const Component* get( uint32_t row )const
+        {
+            const Component* components = column< Component >();
+            return ( components ) ? &components[ row ] : nullptr;
+        }
+
+        /**
+         * @brief Gets the change version of the element of a column at a specific row.
+         */
+        inline uint32_t version( uint32_t column, uint32_t row )const
+        {
+            return _versions[ column * _layout->capacity() + row ];
+        }
+
+        /**
+         * @brief Gets the newest change version of any element of a column. Every element of
+         * the column is older than a tick greater than this one.
+         */
+        inline uint32_t columnVersion( uint32_t column )const
+        {
+            return _column_versions[ column ];
+        }
+
+        /**
+         * @brief Stamps the element of a column at a specific row with the current change tick.
+         */
+        inline void markChanged( uint32_t column, uint32_t row )
+        {
+            const uint32_t tick = ComponentCache::changeTick();
+            _versions[ column * _layout->capacity() + row ] = tick;
+            _column_versions[ column ] = tick;
+        }
+
+        /**
+         * @brief Stamps the element of a column at a specific row, leaving the column version alone.
+         * Threads writing different rows of one chunk call this after markColumnChanged().
+         */
+        inline void markRowChanged( uint32_t column, uint32_t row )
+        {
+            _versions[ column * _layout->capacity() + row ] = ComponentCache::changeTick();
+        }
+
+        /**
+         * @brief Raises the column version to the current change tick without stamping any row.
+         */
+        inline void markColumnChanged( uint32_t column )
+        {
+            _column_versions[ column ] = ComponentCache::changeTick();
+        }
+
+        /**
+         * @brief Stamps every occupied row of a column with the current change tick.
+         */
+        void markChanged( uint32_t column );
+
+        /**
+         * @brief Gets a type-erased pointer to the element of a column at a specific row.
+         */
+        inline void* at( uint32_t column, uint32_t row )
+        {
+            const ChunkColumn& c = _layout->columns()[ column ];
+            return _data + c.offset + c.stride * row;
+        }
+
+        /**
+         * @brief Gets the entity id column of this chunk.
+         */
+        inline uint32_t* entities()
+        {
+            return reinterpret_cast< uint32_t* >( _data );
+        }
+
+        inline const ChunkLayout* layout()const
+        {
+            return _layout;
+        }
+
+        inline uint32_t count()const
+        {
+            return _count;
+        }
+
+        inline bool full()const
+        {
+            return _count >= _layout->capacity();
+        }
+
+        /**
+         * @brief Reserves the next free row.
+         * @return The index of the reserved row. Its component memory is uninitialized.
+         */
+        uint32_t push( uint32_t entity );
+
+        /**
+         * @brief Releases the last row. The caller is responsible for its component memory.
+         */
+        void pop();
+
+        /**
+         * @brief Moves the components of row `src` of chunk `other` into row `dst` of this chunk.
+         *
+         * The destination memory must be uninitialized and the source is destroyed after the move.
+         */
+        void relocate( uint32_t dst, EntityChunk& other, uint32_t src );
+
+        /**
+         * @brief Destroys the components stored in a row.
+         */
+        void destruct( uint32_t row );
+
+        EntityChunk( const ChunkLayout* layout );
+        ~EntityChunk();
+
+        EntityChunk( const EntityChunk& ) = delete;
+        EntityChunk& operator=( const EntityChunk& ) = delete;
+
+    private:
+
+        const ChunkLayout* _layout;
+        uint8_t* _data;
+        uint32_t _count;
+
+        /**
+         * change versions, column by column with `capacity` elements per column, and the newest
+         * version of each column.
+         */
+        std::vector< uint32_t > _versions;
+        std::vector< uint32_t > _column_versions;
+    };
+
+}
+#endif /* entity_chunk_hpp */
@@ -0,0 +1,231 @@
+//
+//  entity-command-buffer.cpp
+//  ecs
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#include <atomic>
+#include <cassert>
+#include <algorithm>
+#include <unordered_set>
+#include "entity-command-buffer.hpp"
+#include "../task/job-system.hpp"
+
+namespace kege{
+
+    /**
+     * the stream the calling thread last recorded into, tagged with the serial of its buffer.
+     * a thread usually records into a single buffer, so one entry keeps recording lock free.
+     */
+    struct ThreadStreamCache
+    {
+        uint64_t serial = 0;
+        void* stream = nullptr;
+    };
+    static thread_local ThreadStreamCache t_stream_cache;
+    static std::atomic< uint64_t > s_next_serial( 1 );
+
+    Entity EntityCommandBuffer::create()
+    {
+        Stream& stream = local();
+
+        // past either limit the placeholder would decode to another stream or another entity
+        if ( stream.index >= MAX_STREAMS || stream.created > CREATED_MASK )
+        {
+            assert( false && "EntityCommandBuffer: too many threads or created entities for one playback" );
+            return Entity();
+        }
+
+        uint32_t id = PLACEHOLDER | ( stream.index << STREAM_SHIFT ) | stream.created;
+        stream.created += 1;
+        stream.commands.push_back({ CREATE, id, 0, nullptr });
+        return Entity( id );
+    }
+
+    void EntityCommandBuffer::destroy( const Entity& entity )
+    {
+        local().commands.push_back({ DESTROY, entity.getID(), 0, nullptr });
+    }
+
+    void EntityCommandBuffer::playback( EntityRegistry& registry, const Entity& parent )
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+
+        /*
+         the threads first touch the buffer in a different order every run, the worker index
+         does not change. the stable sort keeps threads outside the job system in first use order.
+         */
+        std::vector< Stream* > streams( _streams.size() );
+        for ( uint32_t s = 0; s < _streams.size(); ++s )
+        {
+            streams[ s ] = _streams[ s ].get();
+        }
+        std::stable_sort( streams.begin(), streams.end(), []( const Stream* a, const Stream* b ){ return a->worker < b->worker; } );
+
+        // turn the placeholders into real entities first, later commands may refer to any of them
+        std::vector< std::vector< Entity > > created( _streams.size() );
+        for ( Stream* stream : streams )
+        {
+            std::vector< Entity >& entities = created[ stream->index ];
+            entities.reserve( stream->created );
+            for ( uint32_t i = 0; i < stream->created; ++i )
+            {
+                entities.push_back( Entity::create() );
+            }
+        }
+
+        auto resolve = [ &created ]( uint32_t id ) -> Entity
+        {
+            if ( id & PLACEHOLDER )
+            {
+                const uint32_t stream = ( id & ~PLACEHOLDER ) >> STREAM_SHIFT;
+                const uint32_t index = id & CREATED_MASK;
+                // not a placeholder of this buffer, or one recorded before the last playback
+                if ( stream >= created.size() || index >= created[ stream ].size() )
+                {
+                    return Entity();
+                }
+                return created[ stream ][ index ];
+            }
+            return Entity( id );
+        };
+
+        // entities destroyed by this batch skip the rest of their commands
+        std::vector< Entity > destroyed;
+        std::unordered_set< uint32_t > destroyed_ids;
+        for ( Stream* stream : streams )
+        {
+            for ( const Command& command : stream->commands )
+            {
+                if ( command.type == DESTROY )
+                {
+                    Entity entity = resolve( command.entity );
+                    if ( destroyed_ids.insert( entity.getID() ).second )
+                    {
+                        destroyed.push_back( entity );
+                    }
+                }
+            }
+        }
+
+        /*
+         a grouped entity leaves its group right before its first command that changes its
+         signature, and rejoins the group of its final signature after every command is applied.
+         commands that keep the signature, like setting an existing component, never move it.
+         */
+        registry._defer_release = true;
+        std::vector< Entity > moved;
+        std::unordered_set< uint32_t > moved_ids;
+        for ( Stream* stream : streams )
+        {
+            for ( Command& command : stream->commands )
+            {
+                if ( command.type == CREATE || command.type == DESTROY )
+                {
+                    continue;
+                }
+
+                Entity entity = resolve( command.entity );
+                if ( !entity || destroyed_ids.count( entity.getID() ) )
+                {
+                    continue;
+                }
+
+                const bool has = entity.signature().test( command.component );
+                const bool structural = ( command.type == ERASE ) ? has : !has;
+                if ( structural && !moved_ids.count( entity.getID() ) && registry.contains( entity ) )
+                {
+                    registry.removeEntity( entity );
+                    moved_ids.insert( entity.getID() );
+                    moved.push_back( entity );
+                }
+                command.apply( entity );
+            }
+        }
+
+        for ( Entity& entity : moved )
+        {
+            registry.insertEntity( entity );
+        }
+
+        Entity root = parent;
+        std::vector< Entity > inserted;
+        for ( Stream* stream : streams )
+        {
+            for ( Entity& entity : created[ stream->index ] )
+            {
+                if ( destroyed_ids.count( entity.getID() ) ) continue;
+                if ( root ) root.attach( entity );
+                inserted.push_back( entity );
+            }
+        }
+        registry.insert( inserted.data(), uint32_t( inserted.size() ) );
+
+        for ( Entity& entity : destroyed )
+        {
+            if ( !entity || entity == root ) continue;
+            registry.remove( entity );
+            entity.destroy();
+        }
+
+        registry._defer_release = false;
+        registry.releaseDeferredGroups();
+
+        for ( std::unique_ptr< Stream >& stream : _streams )
+        {
+            stream->commands.clear();
+            stream->created = 0;
+        }
+    }
+
+    bool EntityCommandBuffer::empty()const
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        for ( const std::unique_ptr< Stream >& stream : _streams )
+        {
+            if ( !stream->commands.empty() ) return false;
+        }
+        return true;
+    }
+
+    void EntityCommandBuffer::clear()
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        for ( std::unique_ptr< Stream >& stream : _streams )
+        {
+            stream->commands.clear();
+            stream->created = 0;
+        }
+    }
+
+    EntityCommandBuffer::Stream& EntityCommandBuffer::local()
+    {
+        if ( t_stream_cache.serial == _serial )
+        {
+            return *static_cast< Stream* >( t_stream_cache.stream );
+        }
+
+        std::lock_guard< std::mutex > lock( _mutex );
+        Stream*& stream = _thread_streams[ std::this_thread::get_id() ];
+        if ( stream == nullptr )
+        {
+            _streams.push_back( std::unique_ptr< Stream >( new Stream ) );
+            stream = _streams.back().get();
+            stream->index = uint32_t( _streams.size() - 1 );
+            stream->worker = JobSystem::currentWorker();
+        }
+
+        t_stream_cache.serial = _serial;
+        t_stream_cache.stream = stream;
+        return *stream;
+    }
+
+    EntityCommandBuffer::EntityCommandBuffer()
+    :   _serial( s_next_serial.fetch_add( 1 ) )
+    {}
+
+    EntityCommandBuffer::~EntityCommandBuffer()
+    {}
+
+}
@@ -0,0 +1,181 @@
+//
+//  entity-command-buffer.hpp
+//  ecs
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef entity_command_buffer_hpp
+#define entity_command_buffer_hpp
+
+#include <mutex>
+#include <thread>
+#include <memory>
+#include <functional>
+#include <unordered_map>
+#include "entity-registry.hpp"
+
+namespace kege{
+
+    /**
+     * @brief Records structural changes to entities and applies them later, at a sync point.
+     *
+     * Creating and destroying entities or adding and erasing components moves entities between
+     * the groups of an EntityRegistry, which invalidates every iterator over those groups. A
+     * system running on a job worker records the changes here instead, and the owner plays them
+     * back once no system is iterating.
+     *
+     * Every thread records into its own stream, so recording never locks once a thread has
+     * touched the buffer. Playback applies the streams by the JobSystem worker index of their
+     * thread, threads that are not workers first in the order they first used the buffer, and
+     * the commands of one stream in the order they were recorded.
+     *
+     * At most 256 threads can create entities through one buffer, each at most 8,388,608 per
+     * playback. Creations past either limit assert in debug builds and return an invalid entity
+     * otherwise, whose commands playback skips. Placeholders are told apart by the top bit of
+     * the id, which EntityManager never hands out for a real entity.
+     *
+     * @code
+     * EntityCommandBuffer& commands = ...;
+     * Entity spark = commands.create();
+     * commands.add< Transform >( spark, transform );
+     * commands.destroy( expired );
+     * ...
+     * commands.playback( registry, root );
+     * @endcode
+     */
+    class EntityCommandBuffer
+    {
+    public:
+
+        /**
+         * @brief Records the creation of an entity.
+         * @return A placeholder that can be passed to the other commands of this buffer. It turns
+         * into a real entity during playback and must not be used outside the buffer.
+         */
+        Entity create();
+
+        /**
+         * @brief Records the removal of an entity, and its children, from the registry followed by its destruction.
+         */
+        void destroy( const Entity& entity );
+
+        /**
+         * @brief Records adding a component to an entity.
+         */
+        template< typename Component > void add( const Entity& entity, const Component& component = Component() );
+
+        /**
+         * @brief Records setting a component of an entity, adding it if the entity lacks one.
+         */
+        template< typename Component > void set( const Entity& entity, const Component& component );
+
+        /**
+         * @brief Records erasing a component from an entity.
+         */
+        template< typename Component > void erase( const Entity& entity );
+
+        /**
+         * @brief Applies and clears every recorded command. Must not run while any thread records
+         * into this buffer or iterates the registry.
+         *
+         * Each grouped entity leaves its group at most once, before its first structural change,
+         * and rejoins once all of its commands are applied. Groups emptied along the way stay in
+         * the registry and its views, so no view is updated for entities that merely move.
+         *
+         * @param registry The registry the entities are grouped in.
+         * @param parent Created entities are attached to it when valid. It is never destroyed.
+         */
+        void playback( EntityRegistry& registry, const Entity& parent = Entity() );
+
+        /**
+         * @brief Checks if no commands are recorded.
+         */
+        bool empty()const;
+
+        /**
+         * @brief Drops every recorded command without applying it.
+         */
+        void clear();
+
+        EntityCommandBuffer();
+        ~EntityCommandBuffer();
+
+        EntityCommandBuffer( const EntityCommandBuffer& ) = delete;
+        EntityCommandBuffer& operator=( const EntityCommandBuffer& ) = delete;
+
+    private:
+
+        enum Type{ CREATE, DESTROY, ADD, SET, ERASE };
+
+        struct Command
+        {
+            Type type;
+            uint32_t entity;
+            ComponentType component;
+            std::function< void( Entity& ) > apply;
+        };
+
+        struct Stream
+        {
+            std::vector< Command > commands;
+            uint32_t created = 0;
+            uint32_t index = 0;
+
+            /**
+             * the JobSystem worker index of the recording thread, -1 for other threads. playback sorts by it.
+             */
+            int32_t worker = -1;
+        };
+
+        /**
+         * placeholders have the top bit set, the stream index in the next 8 bits and the
+         * position among the stream's created entities in the low 23 bits.
+         */
+        static constexpr uint32_t PLACEHOLDER = 0x80000000;
+        static constexpr uint32_t STREAM_SHIFT = 23;
+        static constexpr uint32_t CREATED_MASK = ( 1u << STREAM_SHIFT ) - 1;
+        static constexpr uint32_t MAX_STREAMS = 256;
+
+        template< typename Component > void record( Type type, const Entity& entity, std::function< void( Entity& ) > apply );
+        Stream& local();
+
+    private:
+
+        std::vector< std::unique_ptr< Stream > > _streams;
+        std::unordered_map< std::thread::id, Stream* > _thread_streams;
+        mutable std::mutex _mutex;
+
+        /**
+         * distinguishes this buffer from earlier ones at the same address in the per-thread cache.
+         */
+        uint64_t _serial;
+    };
+
+
+    template< typename Component >
+    void EntityCommandBuffer::add( const Entity& entity, const Component& component )
+    {
+        record< Component >( ADD, entity, [ component ]( Entity& e ){ e.add< Component >( component ); } );
+    }
+
+    template< typename Component >
+    void EntityCommandBuffer::set( const Entity& entity, const Component& component )
+    {
+        record< Component >( SET, entity, [ component ]( Entity& e ){ e.set< Component >( component ); } );
+    }
+
+    template< typename Component >
+    void EntityCommandBuffer::erase( const Entity& entity )
+    {
+        record< Component >( ERASE, entity, []( Entity& e ){ e.erase< Component >(); } );
+    }
+
+    template< typename Component >
+    void EntityCommandBuffer::record( Type type, const Entity& entity, std::function< void( Entity& ) > apply )
+    {
+        local().commands.push_back({ type, entity.getID(), ComponentCacheT< Component >::getType(), std::move( apply ) });
+    }
+
+}
+#endif /* entity_command_buffer_hpp */
@@ -5,6 +5,8 @@
 //  Created by Kenneth Esdaile on 3/19/25.
 //
 
+#include <cassert>
+#include <cstdint>
 #include "entity-manager.hpp"
 
 namespace kege{
@@ -152,6 +154,12 @@ namespace kege{
         }
         else
         {
+            // ids with the top bit set stand for the placeholders of an EntityCommandBuffer
+            assert( _count < INT32_MAX && "EntityManager: out of entity ids" );
+            if ( _count == INT32_MAX )
+            {
+                return 0;
+            }
             index = _count;
             if ( _count >= _entities.size() )
             {
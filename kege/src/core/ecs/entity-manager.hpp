@@ -149,11 +149,62 @@ namespace kege{
             return _component_manager.has< Component >( _entities[ entity ].id );
         }
 
-        const EntityComponentMap& getEntityComponents( uint32_t entity )const
+        /**
+         * @brief Gets the cache id of a component of a specific type for an entity.
+         * @tparam Component The type of the component.
+         * @param entity The ID of the entity.
+         * @return The component id inside its ComponentCacheT, or 0 if the entity doesn't have this component in a cache.
+         */
+        template< typename Component > ComponentID getComponentID( uint32_t entity )const
+        {
+            return _component_manager.getComponentID< Component >( _entities[ entity ].id );
+        }
+
+        EntityComponentMap getEntityComponents( uint32_t entity )const
         {
             return _component_manager.getEntityComponents( _entities[ entity ].id );
         }
 
+        /**
+         * @brief Builds the archetype chunk layout for a signature.
+         */
+        bool buildChunkLayout( const EntitySignature& signature, ChunkLayout& layout )const
+        {
+            return _component_manager.buildChunkLayout( signature, layout );
+        }
+
+        /**
+         * @brief Moves the chunk-stored components of an entity into a chunk row.
+         */
+        void attachChunk( const uint32_t& entity, EntityChunk* chunk, uint32_t row )
+        {
+            _component_manager.attachChunk( _entities[ entity ].id, chunk, row );
+        }
+
+        /**
+         * @brief Moves the components of an entity out of its chunk row back into their caches.
+         */
+        void detachChunk( const uint32_t& entity )
+        {
+            _component_manager.detachChunk( _entities[ entity ].id );
+        }
+
+        /**
+         * @brief Updates the chunk location of an entity whose row was relocated.
+         */
+        void setChunkRow( const uint32_t& entity, EntityChunk* chunk, uint32_t row )
+        {
+            _component_manager.setChunkRow( _entities[ entity ].id, chunk, row );
+        }
+
+        /**
+         * @brief Checks if the components of an entity are stored in a specific chunk row.
+         */
+        bool inChunk( const uint32_t& entity, const EntityChunk* chunk, uint32_t row )const
+        {
+            return _component_manager.inChunk( _entities[ entity ].id, chunk, row );
+        }
+
         /**
          * @brief Gets the component signature of an entity.
          *
@@ -5,7 +5,7 @@
 //  Created by Kenneth Esdaile on 4/21/25.
 //
 
-#include <ostream>
+#include <algorithm>
 #include "entity-registry.hpp"
 #include "entity-manager.hpp"
 
@@ -18,11 +18,12 @@ namespace kege{
         {
             EntityView* view = new EntityView;
             view->_registry = this;
-            for ( uint32_t i = 0; i < _entities.size(); ++i )
+            for ( EntityGroup& group : _entities )
             {
-                if ( compare( _entities[i].signature, signature ) == SUBSET )
+                if ( group.signature.any() && compare( group.signature, signature ) == SUBSET )
                 {
-                    view->_groups.push_back(i);
+                    view->addGroup( group.id );
+                    group.viewers.push_back( view );
                 }
             }
             _entity_views[ signature ] = view;
@@ -38,8 +39,8 @@ namespace kege{
         {
             if ( compare( new_group.signature, signature ) == SUBSET )
             {
-                view->_groups.push_back( new_group.id );
-                new_group.viewers.insert( view );
+                view->addGroup( new_group.id );
+                new_group.viewers.push_back( view );
             }
         }
     }
@@ -56,94 +57,349 @@ namespace kege{
 
     void EntityRegistry::insert( Entity& entity )
     {
-        EntityRegistryKey* registry = entity.add< EntityRegistryKey >();
-        
-        auto m = _entity_group_index_table.find( entity.signature() );
-        if ( m == _entity_group_index_table.end() )
+        if ( entity.begin() == 0 )
         {
-            int index = (int) _entities.size();
-            _entity_group_index_table[ entity.signature() ] = index;
+            insertEntity( entity );
+            return;
+        }
+        insert( &entity, 1 );
+    }
 
-            _entities.push_back({});
-            EntityGroup& group = _entities[ index ];
-            group.count = 0;
+    void EntityRegistry::insert( Entity* entities, uint32_t count )
+    {
+        std::vector< Entity > flat;
+        flatten( entities, count, flat );
+
+        /*
+         resolve the group of every entity first and grow each group once. the entities are
+         then appended in their original order, which keeps the component moves of archetype
+         storage walking the caches front to back.
+         */
+        std::vector< uint32_t > groups( flat.size() );
+        std::vector< uint32_t > added;
 
-            registry->index = (int) group.entities.size();
-            group.entities.push_back({});
-            group.entities[ group.count ] = entity;
-            group.signature = entity.signature();
-            group.id = index;
-            group.count += 1;
+        kege::EntitySignature last;
+        uint32_t group = 0;
+        for ( uint32_t i = 0; i < flat.size(); ++i )
+        {
+            // the key is part of the signature, so it is added before the group is resolved
+            flat[ i ].add< EntityRegistryKey >();
 
-            updateViews( group );
+            // scenes tend to hold runs of identical entities, only a new signature needs a lookup
+            const kege::EntitySignature& signature = flat[ i ].signature();
+            if ( i == 0 || signature != last )
+            {
+                group = acquireGroup( signature );
+                last = signature;
+            }
+            if ( group >= added.size() )
+            {
+                added.resize( group + 1, 0 );
+            }
+            added[ group ] += 1;
+            groups[ i ] = group;
         }
-        else
+
+        for ( uint32_t g = 0; g < added.size(); ++g )
         {
-            EntityGroup& group = _entities[ m->second ];
-            registry->index = group.count;
-            if ( group.count >= group.entities.size()  )
+            if ( added[ g ] == 0 ) continue;
+
+            EntityGroup& target = _entities[ g ];
+            const uint32_t size = target.count + added[ g ];
+            if ( target.entities.size() < size )
+            {
+                target.entities.resize( size );
+            }
+            if ( target.layout != nullptr )
             {
-                group.entities.resize(1 + 2 * group.entities.size());
+                target.chunks.reserve( ( size + target.layout->capacity() - 1 ) / target.layout->capacity() );
             }
-            group.entities[ group.count ] = entity;
-            group.count += 1;
         }
 
-        for( Entity e = entity.begin(); e != 0; e = e.next() )
+        for ( uint32_t i = 0; i < flat.size(); ++i )
         {
-            insert( e );
+            appendEntity( _entities[ groups[ i ] ], flat[ i ] );
         }
     }
 
     void EntityRegistry::remove( Entity& entity )
     {
-        for( Entity e = entity.begin(); e != 0; e = e.next() )
+        if ( entity.begin() == 0 )
         {
-            remove( e );
+            removeEntity( entity );
+            return;
         }
 
+        // children leave before their parents
+        std::vector< Entity > flat;
+        flatten( &entity, 1, flat );
+        for ( auto e = flat.rbegin(); e != flat.rend(); ++e )
+        {
+            removeEntity( *e );
+        }
+    }
+
+    bool EntityRegistry::contains( const Entity& entity )const
+    {
         auto m = _entity_group_index_table.find( entity.signature() );
+        if ( m == _entity_group_index_table.end() )
+        {
+            return false;
+        }
+
+        const EntityRegistryKey* registry = entity.get< EntityRegistryKey >();
+        const EntityGroup& group = _entities[ m->second ];
+        return registry != nullptr && registry->index >= 0 && uint32_t( registry->index ) < group.count && group.entities[ registry->index ] == entity;
+    }
+
+    void EntityRegistry::insertEntity( Entity& entity )
+    {
+        entity.add< EntityRegistryKey >();
+        appendEntity( _entities[ acquireGroup( entity.signature() ) ], entity );
+    }
+
+    void EntityRegistry::removeEntity( Entity& entity )
+    {
+        auto m = _entity_group_index_table.find( entity.signature() );
+        if ( m == _entity_group_index_table.end() )
+        {
+            return;
+        }
+
+        EntityGroup& group = _entities[ m->second ];
+        EntityRegistryKey* registry = entity.get< EntityRegistryKey >();
+        if ( registry == nullptr || registry->index < 0 || uint32_t( registry->index ) >= group.count || group.entities[ registry->index ] != entity )
+        {
+            return;
+        }
+
+        const uint32_t index = registry->index;
+        const uint32_t last = group.count - 1;
+
+        if ( group.layout != nullptr )
+        {
+            detachChunkRow( group, entity, index );
+        }
+
+        group.entities[ index ] = group.entities[ last ];
+        group.entities[ last ] = 0;
+        group.count -= 1;
+
+        if ( index != last )
+        {
+            group.entities[ index ].get< EntityRegistryKey >()->index = index;
+        }
+
+        // groups emptied by a command buffer playback are kept for the entities it moves back in
+        if ( group.count == 0 )
+        {
+            if ( _defer_release ) _deferred_groups.push_back( group.id );
+            else releaseGroup( group.id );
+        }
+    }
+
+    void EntityRegistry::releaseDeferredGroups()
+    {
+        for ( uint32_t index : _deferred_groups )
+        {
+            // a group can be listed twice, or refilled after it was emptied
+            const EntityGroup& group = _entities[ index ];
+            auto m = _entity_group_index_table.find( group.signature );
+            if ( group.count == 0 && m != _entity_group_index_table.end() && m->second == index )
+            {
+                releaseGroup( index );
+            }
+        }
+        _deferred_groups.clear();
+    }
+
+    uint32_t EntityRegistry::acquireGroup( const kege::EntitySignature& signature )
+    {
+        auto m = _entity_group_index_table.find( signature );
         if ( m != _entity_group_index_table.end() )
         {
-            EntityRegistryKey* registry = entity.get< EntityRegistryKey >();
-            if ( _entities[ m->second ].count > 0 )
+            return m->second;
+        }
+
+        uint32_t index;
+        if ( !_free_groups.empty() )
+        {
+            index = _free_groups.back();
+            _free_groups.pop_back();
+        }
+        else
+        {
+            index = uint32_t( _entities.size() );
+            _entities.push_back({});
+        }
+        _entity_group_index_table[ signature ] = index;
+
+        EntityGroup& group = _entities[ index ];
+        group.signature = signature;
+        group.count = 0;
+        group.id = index;
+
+        if ( _storage_mode == ARCHETYPE_STORAGE )
+        {
+            group.layout = new ChunkLayout;
+            if ( !Entity::getManager().buildChunkLayout( group.signature, *group.layout ) )
             {
-                std::cout << _entities[ m->second ].entities[ registry->index ] <<"\n";
-                int index = _entities[ m->second ].count - 1;
+                // nothing to store in chunks, this group keeps using the component caches
+                delete group.layout;
+                group.layout = nullptr;
+            }
+        }
 
-                Entity& e1 = _entities[ m->second ].entities[ registry->index ];
-                Entity& e2 = _entities[ m->second ].entities[ index ];
-                Entity tmp = e1;
-                e1 = e2;
-                e2 = tmp;
+        updateViews( group );
+        return index;
+    }
 
-                e1.get< EntityRegistryKey >()->index = registry->index;
+    void EntityRegistry::releaseGroup( uint32_t index )
+    {
+        EntityGroup& group = _entities[ index ];
+        releaseChunks( group );
 
-                _entities[ m->second ].entities[ index ] = 0;
-                _entities[ m->second ].count -= 1;
+        for ( EntityView* view : group.viewers )
+        {
+            view->removeGroup( group.id );
+        }
+        group.viewers.clear();
 
-                if ( _entities[ m->second ].count == 0 )
-                {
-                    // if the entity list is empty remove it from the entity-views that are processes it.
-                    for (EntityView* view : _entities[ m->second ].viewers )
-                    {
-                        auto it = std::find( view->_groups.begin(), view->_groups.end(), _entities[ m->second ].id );
-                        if( it != view->_groups.end() )
-                        {
-                            view->_groups.erase(it);
-                        }
-                    }
-                    // also remove the entity list from the this registry
-                    _entities.erase(_entities.begin() + _entities[ m->second ].id );
-                    _entity_group_index_table.erase(m);
-                }
+        _entity_group_index_table.erase( group.signature );
+        std::vector< Entity >().swap( group.entities );
+        group.signature.reset();
+        group.count = 0;
+        _free_groups.push_back( index );
+    }
+
+    void EntityRegistry::appendEntity( EntityGroup& group, Entity& entity )
+    {
+        entity.get< EntityRegistryKey >()->index = int32_t( group.count );
+        if ( group.count >= group.entities.size() )
+        {
+            group.entities.resize( 1 + 2 * group.entities.size() );
+        }
+        group.entities[ group.count ] = entity;
+        group.count += 1;
+
+        if ( group.layout != nullptr )
+        {
+            attachChunkRow( group, entity, group.count - 1 );
+        }
+    }
+
+    void EntityRegistry::flatten( Entity* entities, uint32_t count, std::vector< Entity >& out )
+    {
+        out.reserve( out.size() + count );
+        const size_t first = out.size();
+        for ( uint32_t i = 0; i < count; ++i )
+        {
+            out.push_back( entities[ i ] );
+        }
+        for ( size_t i = first; i < out.size(); ++i )
+        {
+            for ( Entity e = out[ i ].begin(); e != 0; e = e.next() )
+            {
+                out.push_back( e );
             }
         }
     }
 
+    void EntityRegistry::attachChunkRow( EntityGroup& group, Entity& entity, uint32_t index )
+    {
+        const uint32_t capacity = group.layout->capacity();
+        if ( index / capacity >= group.chunks.size() )
+        {
+            group.chunks.push_back( new EntityChunk( group.layout ) );
+        }
+
+        EntityChunk* chunk = group.chunks[ index / capacity ];
+        uint32_t row = chunk->push( entity.getID() );
+        Entity::getManager().attachChunk( entity.getID(), chunk, row );
+    }
+
+    void EntityRegistry::detachChunkRow( EntityGroup& group, Entity& entity, uint32_t index )
+    {
+        EntityManager& manager = Entity::getManager();
+        const uint32_t capacity = group.layout->capacity();
+        const uint32_t last = group.count - 1;
+
+        EntityChunk* hole = group.chunks[ index / capacity ];
+        EntityChunk* tail = group.chunks[ last / capacity ];
+
+        manager.detachChunk( entity.getID() );
+
+        /*
+         mirror the swap-with-last of the group entity list, the last row of the last chunk
+         fills the hole so entity i always stays at row ( i % capacity ) of chunk ( i / capacity ).
+         */
+        if ( index != last )
+        {
+            hole->relocate( index % capacity, *tail, last % capacity );
+            manager.setChunkRow( group.entities[ last ].getID(), hole, index % capacity );
+        }
+
+        tail->pop();
+        if ( tail->count() == 0 )
+        {
+            delete tail;
+            group.chunks.pop_back();
+        }
+    }
+
+    void EntityRegistry::releaseChunks( EntityGroup& group )
+    {
+        if ( group.layout == nullptr )
+        {
+            return;
+        }
+
+        EntityManager& manager = Entity::getManager();
+        const uint32_t capacity = group.layout->capacity();
+        for ( uint32_t i = 0; i < group.count; ++i )
+        {
+            EntityChunk* chunk = group.chunks[ i / capacity ];
+            uint32_t entity = group.entities[ i ].getID();
+            if ( manager.isvalid( entity ) && manager.inChunk( entity, chunk, i % capacity ) )
+            {
+                // entity outlives this registry, give its components back to the caches
+                manager.detachChunk( entity );
+            }
+            else
+            {
+                // entity was destroyed while grouped, its components still live in the row
+                chunk->destruct( i % capacity );
+            }
+        }
+
+        for ( EntityChunk* chunk : group.chunks )
+        {
+            delete chunk;
+        }
+        group.chunks.clear();
+
+        delete group.layout;
+        group.layout = nullptr;
+    }
+
+    bool EntityRegistry::setStorageMode( StorageMode mode )
+    {
+        if ( getCount() != 0 )
+        {
+            return false;
+        }
+        _storage_mode = mode;
+        return true;
+    }
+
+    EntityRegistry::StorageMode EntityRegistry::getStorageMode()const
+    {
+        return _storage_mode;
+    }
+
     int EntityRegistry::getCount()const
     {
-        return (int)_entities.size();
+        return int( _entities.size() - _free_groups.size() );
     }
 
     void EntityRegistry::clear()
@@ -153,13 +409,24 @@ namespace kege{
             delete view;
             view = nullptr;
         }
+        for ( EntityGroup& group : _entities )
+        {
+            releaseChunks( group );
+        }
         _entity_group_index_table.clear();
         _entity_views.clear();
         _entities.clear();
+        _free_groups.clear();
+        _deferred_groups.clear();
     }
 
     EntityRegistry::~EntityRegistry()
     {
         clear();
     }
+
+    EntityRegistry::EntityRegistry()
+    :   _storage_mode( CACHE_STORAGE )
+    ,   _defer_release( false )
+    {}
 }
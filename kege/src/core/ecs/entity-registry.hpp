@@ -26,13 +26,28 @@ namespace kege{
     {
     public:
 
+        /**
+         * CACHE_STORAGE keeps component data in the per-type component caches.
+         * ARCHETYPE_STORAGE moves the non-pinned components of every grouped entity into
+         * fixed-size chunks owned by its group, one column per component type.
+         */
+        enum StorageMode{ CACHE_STORAGE, ARCHETYPE_STORAGE };
+
         template< typename... T > kege::EntityView* getEntityView()
         {
             kege::EntitySignature signature;
-            ( signature.set( kege::ComponentCacheT< T >::getType() ), ... );
+            ( signature.set( kege::ComponentCacheT< std::remove_const_t< T > >::getType() ), ... );
             return getEntityView( signature );
         }
 
+        /**
+         * @brief Gets a typed view that hands out the components T... instead of Entity handles.
+         */
+        template< typename... T > kege::EntityViewT< T... > view()
+        {
+            return kege::EntityViewT< T... >( getEntityView< T... >() );
+        }
+
         EntityView* getEntityView( const kege::EntitySignature& signature );
         void updateViews( EntityGroup& new_group );
         const EntityGroup* getEntities( int index )const;
@@ -40,17 +55,90 @@ namespace kege{
         void insert( Entity& entity );
         void remove( Entity& entity );
 
+        /**
+         * @brief Inserts many entities, and their children, at once.
+         *
+         * Every group the entities land in is grown once per call instead of once per entity,
+         * and runs of entities with the same signature share one group lookup.
+         */
+        void insert( Entity* entities, uint32_t count );
+
+        /**
+         * @brief Checks if the entity is currently grouped by this registry.
+         */
+        bool contains( const Entity& entity )const;
+
+        /**
+         * @brief Sets how the components of grouped entities are stored.
+         * @return False if the registry already holds entities, in which case the mode is unchanged.
+         */
+        bool setStorageMode( StorageMode mode );
+        StorageMode getStorageMode()const;
+
         int getCount()const;
         void clear();
         ~EntityRegistry();
+        EntityRegistry();
+
+    private:
+
+        /**
+         * insert or remove a single entity, leaving its children where they are.
+         */
+        void insertEntity( Entity& entity );
+        void removeEntity( Entity& entity );
+
+        /**
+         * find the group of a signature, creating it and adding it to the matching views when
+         * there is none yet. new groups reuse the ids of released ones.
+         */
+        uint32_t acquireGroup( const kege::EntitySignature& signature );
+
+        /**
+         * drop an empty group from the registry and from the views that iterate it. its id goes
+         * to the free list, the ids of every other group stay valid.
+         */
+        void releaseGroup( uint32_t index );
+
+        /**
+         * release the groups emptied while _defer_release was set that are still empty.
+         */
+        void releaseDeferredGroups();
+
+        /**
+         * add an entity that already has its EntityRegistryKey to the end of a group.
+         */
+        void appendEntity( EntityGroup& group, Entity& entity );
+
+        /**
+         * collect entities and all of their descendants, parents before children.
+         */
+        static void flatten( Entity* entities, uint32_t count, std::vector< Entity >& out );
+
+        void attachChunkRow( EntityGroup& group, Entity& entity, uint32_t index );
+        void detachChunkRow( EntityGroup& group, Entity& entity, uint32_t index );
+        void releaseChunks( EntityGroup& group );
 
     private:
 
         std::unordered_map< kege::EntitySignature, EntityView* > _entity_views;
         std::unordered_map< kege::EntitySignature, uint32_t > _entity_group_index_table;
         std::vector< EntityGroup > _entities;
+        std::vector< uint32_t > _free_groups;
+        StorageMode _storage_mode;
+
+        /**
+         * set while a command buffer plays back. groups it empties are kept instead of being
+         * released, so views are not rebuilt per command and later batches can refill them.
+         */
+        bool _defer_release;
+        std::vector< uint32_t > _deferred_groups;
+
         friend EntityView;
+        friend class EntityCommandBuffer;
+        template< typename... Components > friend class EntityViewT;
     };
 
 }
+#include "typed-entity-view.hpp"
 #endif /* entity_registry_hpp */
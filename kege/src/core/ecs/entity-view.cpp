@@ -11,6 +11,33 @@
 
 namespace kege{
 
+    void EntityView::addGroup( uint32_t group )
+    {
+        if ( group >= _slots.size() )
+        {
+            _slots.resize( group + 1, NO_SLOT );
+        }
+        if ( _slots[ group ] == NO_SLOT )
+        {
+            _slots[ group ] = uint32_t( _groups.size() );
+            _groups.push_back( group );
+        }
+    }
+
+    void EntityView::removeGroup( uint32_t group )
+    {
+        if ( group >= _slots.size() || _slots[ group ] == NO_SLOT )
+        {
+            return;
+        }
+
+        const uint32_t slot = _slots[ group ];
+        const uint32_t last = _groups.back();
+        _groups[ slot ] = last;
+        _slots[ last ] = slot;
+        _groups.pop_back();
+        _slots[ group ] = NO_SLOT;
+    }
 
     const std::vector< Entity >& EntityView::getEntities( uint32_t group )const
     {
@@ -8,8 +8,9 @@
 #ifndef entity_view_hpp
 #define entity_view_hpp
 
-#include <set>
+#include <vector>
 #include "entity.hpp"
+#include "entity-chunk.hpp"
 
 namespace kege{
 
@@ -17,14 +18,27 @@ namespace kege{
     class EntityIterator;
     class ConstEntityIterator;
     class EntityView;
+    template< typename... Components > class EntityViewT;
 
+    /**
+     * a group of entities sharing one signature. the id is the index of the group in its registry
+     * and stays the same for the lifetime of the group. a released group keeps its slot with an
+     * empty signature until a new signature reuses it.
+     */
     struct EntityGroup
     {
-        std::set< EntityView* > viewers;
+        std::vector< EntityView* > viewers;
         std::vector< Entity > entities;
         kege::EntitySignature signature;
         uint32_t count = 0;
         uint32_t id = 0;
+
+        /**
+         * archetype storage. entity i of this group lives in row ( i % capacity ) of chunks[ i / capacity ].
+         * layout is null when the group uses the component caches.
+         */
+        std::vector< EntityChunk* > chunks;
+        ChunkLayout* layout = nullptr;
     };
 
     class EntityView
@@ -55,12 +69,28 @@ namespace kege{
         bool entityIsAccessible( uint32_t group, uint32_t index )const;
         bool isEqual( uint32_t group1, uint32_t index1, uint32_t group2, uint32_t index2 )const;
 
+        /**
+         * add or remove a registry group in constant time. removal moves the last group of the
+         * view into the freed position, so the order of the groups is not kept.
+         */
+        void addGroup( uint32_t group );
+        void removeGroup( uint32_t group );
+
         std::vector< uint32_t > _groups;
+
+        /**
+         * position of each registry group in _groups, indexed by group id. NO_SLOT for groups
+         * this view does not iterate.
+         */
+        std::vector< uint32_t > _slots;
+        static constexpr uint32_t NO_SLOT = 0xFFFFFFFF;
+
         EntityRegistry* _registry;
 
         friend ConstEntityIterator;
         friend EntityIterator;
         friend EntityRegistry;
+        template< typename... Components > friend class EntityViewT;
     };
 
 }
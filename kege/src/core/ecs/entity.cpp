@@ -21,7 +21,7 @@ namespace kege{
         return entity._mgr->print( os, entity._id );
     }
 
-    const EntityComponentMap& Entity::getEntityComponents()const
+    EntityComponentMap Entity::getEntityComponents()const
     {
         return _mgr->getEntityComponents( _id );
     }
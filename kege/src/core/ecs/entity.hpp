@@ -162,7 +162,7 @@ namespace kege{
          * @return A mutable pointer to the component instance, or `nullptr` if the entity does not have
          * a component of the specified type or if the entity ID is invalid.
          */
-        template< typename Component > uint32_t getComponentID()const;
+        template< typename Component > ComponentID getComponentID()const;
 
         /**
          * @brief Checks if this entity possesses a component of a specific type.
@@ -171,7 +171,7 @@ namespace kege{
          */
         template< typename Component > bool has() const;
 
-        const EntityComponentMap& getEntityComponents()const;
+        EntityComponentMap getEntityComponents()const;
 
         /**
          * @brief Gets the component signature of this entity.
@@ -382,6 +382,12 @@ namespace kege{
         return ( _mgr->isvalid( _id ) ) ? _mgr->get< Component >( _id ) : nullptr;
     }
 
+    template< typename Component >
+    ComponentID Entity::getComponentID() const
+    {
+        return ( _mgr->isvalid( _id ) ) ? _mgr->getComponentID< Component >( _id ) : 0;
+    }
+
     template< typename Component >
     bool Entity::has() const
     {
@@ -0,0 +1,459 @@
+//
+//  typed-entity-view.hpp
+//  ecs
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef typed_entity_view_hpp
+#define typed_entity_view_hpp
+
+#include <tuple>
+#include <type_traits>
+#include "entity-registry.hpp"
+#include "../task/parallel-for.hpp"
+
+namespace kege{
+
+    /**
+     * @brief A compile-time typed view over the groups of an EntityView.
+     *
+     * Instead of handing out Entity handles that each resolve their components through the
+     * entity manager, the typed view hands out the components themselves. Component caches are
+     * resolved once per call, group signatures are tested once per group and chunk columns are
+     * resolved once per chunk, so the per-entity signature tests and hash lookups disappear from
+     * the loop body.
+     *
+     * Components requested as `const T` are handed out read-only. Every other component that is
+     * handed out is stamped with the current change tick, so a later changed() view sees it.
+     *
+     * @code
+     * registry.view< Transform, Rigidbody >().each([]( Transform& transform, Rigidbody& body ){ ... });
+     * registry.view< Transform, Rigidbody >().each([]( Entity entity, Transform& transform, Rigidbody& body ){ ... });
+     * registry.view< Transform, Rigidbody >().eachChunk([]( uint32_t count, Transform* transforms, Rigidbody* bodies ){ ... });
+     * registry.view< Transform, Rigidbody >().parallelEach([]( Transform& transform, Rigidbody& body ){ ... });
+     * registry.view< const Rigidbody, Transform >().changed< Rigidbody >( tick ).each([]( const Rigidbody& body, Transform& transform ){ ... });
+     * @endcode
+     *
+     * @tparam Components The component types every visited entity is guaranteed to have.
+     */
+    template< typename... Components > class EntityViewT
+    {
+    public:
+
+        /**
+         * @brief Calls `func( Components&... )` or `func( Entity, Components&... )` for every entity of the view.
+         */
+        template< typename Func > void each( Func&& func );
+
+        /**
+         * @brief Calls `func( uint32_t count, Components*... )` with contiguous spans of components.
+         *
+         * Archetype chunks that store every requested component type are handed out as one span
+         * per chunk. Entities whose components live in the component caches are handed out as
+         * spans of length one. A changed() filter skips whole chunks only, so a span may hold
+         * unchanged entities next to changed ones.
+         */
+        template< typename Func > void eachChunk( Func&& func );
+
+        /**
+         * @brief Like each(), but the entities are split into batches that run on the job workers.
+         *
+         * Batches never cross a group or a chunk, so each batch resolves its columns once. The call
+         * returns after every entity has been visited. `func` is called concurrently and may only
+         * touch the components it is handed, plus data no other batch writes.
+         *
+         * @param grain Entities per batch. Zero uses ParallelFor::grain. With ParallelFor::serial
+         * set, this behaves exactly like each().
+         */
+        template< typename Func > void parallelEach( Func&& func, uint32_t grain = 0 );
+
+        /**
+         * @brief Gets a view that only visits entities where at least one of the component types
+         * T was written at or after the change tick `since`.
+         *
+         * A system that keeps the tick of its previous run, see ComponentCache::changeTick(),
+         * only visits what changed in between. Every T must be one of the view's component types.
+         */
+        template< typename... T > EntityViewT changed( uint32_t since )const;
+
+        /**
+         * @brief Gets the number of entities this view visits, ignoring a changed() filter.
+         */
+        uint32_t count()const;
+
+        /**
+         * @brief Gets the untyped view this typed view iterates.
+         */
+        inline EntityView* view()const
+        {
+            return _view;
+        }
+
+        /**
+         * @brief Wraps an existing EntityView. Groups of the view that lack one of the component
+         * types are skipped, so the view may come from a system with a wider or narrower signature.
+         */
+        EntityViewT( EntityView* view );
+
+    private:
+
+        template< typename Component > using Base = std::remove_const_t< Component >;
+        typedef std::tuple< ComponentCacheT< Base< Components > >*... > Caches;
+
+        template< typename Component > static constexpr bool holds()
+        {
+            return ( std::is_same_v< Base< Component >, Base< Components > > || ... );
+        }
+
+        template< typename Component > static Component& fetch( Component* column, uint32_t row, uint32_t entity, ComponentCacheT< Base< Component > >* cache, EntityManager& manager )
+        {
+            if ( column != nullptr )
+            {
+                return column[ row ];
+            }
+            if constexpr ( std::is_const_v< Component > )
+            {
+                const ComponentCacheT< Base< Component > >* read = cache;
+                return *read->get( manager.getComponentID< Base< Component > >( entity ) );
+            }
+            else
+            {
+                return *cache->get( manager.getComponentID< Base< Component > >( entity ) );
+            }
+        }
+
+        template< typename Func, typename... Args > static void invoke( Func& func, uint32_t entity, Args&... args )
+        {
+            if constexpr ( std::is_invocable_v< Func&, Entity, Args&... > )
+            {
+                func( Entity( entity ), args... );
+            }
+            else
+            {
+                func( args... );
+            }
+        }
+
+        /**
+         * stamps the chunk columns of the writable component types for one row. components that
+         * live in a cache were stamped by the cache when fetch() handed them out. the concurrent
+         * variant leaves the column versions to a serial touchColumns() call.
+         */
+        template< typename Component > static void touch( EntityChunk* chunk, uint32_t row )
+        {
+            if constexpr ( !std::is_const_v< Component > )
+            {
+                int32_t column = chunk->layout()->column( ComponentCacheT< Component >::getType() );
+                if ( column >= 0 ) chunk->markChanged( uint32_t( column ), row );
+            }
+        }
+
+        template< typename Component > static void touchRow( EntityChunk* chunk, uint32_t row )
+        {
+            if constexpr ( !std::is_const_v< Component > )
+            {
+                int32_t column = chunk->layout()->column( ComponentCacheT< Component >::getType() );
+                if ( column >= 0 ) chunk->markRowChanged( uint32_t( column ), row );
+            }
+        }
+
+        template< typename Component > static void touchColumn( EntityChunk* chunk )
+        {
+            if constexpr ( !std::is_const_v< Component > )
+            {
+                int32_t column = chunk->layout()->column( ComponentCacheT< Component >::getType() );
+                if ( column >= 0 ) chunk->markColumnChanged( uint32_t( column ) );
+            }
+        }
+
+        template< typename Component > static void touch( EntityChunk* chunk )
+        {
+            if constexpr ( !std::is_const_v< Component > )
+            {
+                int32_t column = chunk->layout()->column( ComponentCacheT< Component >::getType() );
+                if ( column >= 0 ) chunk->markChanged( uint32_t( column ) );
+            }
+        }
+
+        template< typename Component > bool modified( const EntityChunk* chunk, uint32_t row, uint32_t entity, const Caches& caches, EntityManager& manager )const
+        {
+            const ComponentType type = ComponentCacheT< Base< Component > >::getType();
+            if ( !_changed.test( type ) ) return false;
+
+            int32_t column = ( chunk != nullptr ) ? chunk->layout()->column( type ) : -1;
+            if ( column >= 0 ) return chunk->version( uint32_t( column ), row ) >= _since;
+
+            const ComponentCacheT< Base< Component > >* cache = std::get< ComponentCacheT< Base< Component > >* >( caches );
+            return cache->version( manager.getComponentID< Base< Component > >( entity ) ) >= _since;
+        }
+
+        /**
+         * checks the changed() filter for one entity. a null chunk means every component lives in a cache.
+         */
+        bool accepts( const EntityChunk* chunk, uint32_t row, uint32_t entity, const Caches& caches, EntityManager& manager )const
+        {
+            return _changed.none() || ( modified< Components >( chunk, row, entity, caches, manager ) || ... );
+        }
+
+        /**
+         * checks if any row of a chunk may pass the changed() filter. a filtered type that lives in
+         * a cache has no column version, so its chunks can not be skipped.
+         */
+        bool accepts( const EntityChunk* chunk )const
+        {
+            if ( _changed.none() ) return true;
+            for ( uint32_t c = 0; c < chunk->layout()->columns().size(); ++c )
+            {
+                if ( _changed.test( chunk->layout()->columns()[ c ].type ) && chunk->columnVersion( c ) >= _since ) return true;
+            }
+            for ( uint32_t type = 0; type < MAX_COMPONENT_TYPES; ++type )
+            {
+                if ( _changed.test( type ) && chunk->layout()->column( type ) < 0 ) return true;
+            }
+            return false;
+        }
+
+        bool accepts( const EntityGroup& group )const
+        {
+            return ( group.signature & _signature ) == _signature;
+        }
+
+        /**
+         * a range of rows of one chunk, or of one cache group when chunk is null.
+         */
+        struct Batch
+        {
+            EntityGroup* group;
+            EntityChunk* chunk;
+            uint32_t begin;
+            uint32_t end;
+        };
+
+    private:
+
+        EntityView* _view;
+        EntitySignature _signature;
+
+        /**
+         * the component types of the changed() filter, none when the view is unfiltered.
+         */
+        EntitySignature _changed;
+        uint32_t _since;
+    };
+
+
+    template< typename... Components >
+    template< typename Func > void EntityViewT< Components... >::each( Func&& func )
+    {
+        if ( _view == nullptr ) return;
+
+        EntityManager& manager = Entity::getManager();
+        Caches caches( manager.getComponentManager< Base< Components > >()... );
+
+        for ( uint32_t index : _view->_groups )
+        {
+            EntityGroup& group = _view->_registry->_entities[ index ];
+            if ( !accepts( group ) ) continue;
+
+            if ( group.layout != nullptr )
+            {
+                for ( EntityChunk* chunk : group.chunks )
+                {
+                    if ( !accepts( chunk ) ) continue;
+
+                    std::tuple< Components*... > columns( chunk->column< Base< Components > >()... );
+                    const uint32_t* entities = chunk->entities();
+                    const uint32_t size = chunk->count();
+
+                    for ( uint32_t row = 0; row < size; ++row )
+                    {
+                        if ( !accepts( chunk, row, entities[ row ], caches, manager ) ) continue;
+                        invoke
+                        (
+                            func, entities[ row ],
+                            fetch( std::get< Components* >( columns ), row, entities[ row ], std::get< ComponentCacheT< Base< Components > >* >( caches ), manager )...
+                        );
+                        ( touch< Components >( chunk, row ), ... );
+                    }
+                }
+            }
+            else
+            {
+                for ( uint32_t i = 0; i < group.count; ++i )
+                {
+                    const uint32_t entity = group.entities[ i ].getID();
+                    if ( !accepts( nullptr, 0, entity, caches, manager ) ) continue;
+                    invoke
+                    (
+                        func, entity,
+                        fetch< Components >( nullptr, 0, entity, std::get< ComponentCacheT< Base< Components > >* >( caches ), manager )...
+                    );
+                }
+            }
+        }
+    }
+
+    template< typename... Components >
+    template< typename Func > void EntityViewT< Components... >::eachChunk( Func&& func )
+    {
+        if ( _view == nullptr ) return;
+
+        EntityManager& manager = Entity::getManager();
+        Caches caches( manager.getComponentManager< Base< Components > >()... );
+
+        for ( uint32_t index : _view->_groups )
+        {
+            EntityGroup& group = _view->_registry->_entities[ index ];
+            if ( !accepts( group ) ) continue;
+
+            if ( group.layout != nullptr )
+            {
+                for ( EntityChunk* chunk : group.chunks )
+                {
+                    if ( !accepts( chunk ) ) continue;
+
+                    std::tuple< Components*... > columns( chunk->column< Base< Components > >()... );
+                    if ( ( ( std::get< Components* >( columns ) != nullptr ) && ... ) )
+                    {
+                        func( chunk->count(), std::get< Components* >( columns )... );
+                        ( touch< Components >( chunk ), ... );
+                        continue;
+                    }
+
+                    // at least one component type is pinned to its cache, fall back to single rows.
+                    const uint32_t* entities = chunk->entities();
+                    for ( uint32_t row = 0; row < chunk->count(); ++row )
+                    {
+                        if ( !accepts( chunk, row, entities[ row ], caches, manager ) ) continue;
+                        func( uint32_t( 1 ), &fetch( std::get< Components* >( columns ), row, entities[ row ], std::get< ComponentCacheT< Base< Components > >* >( caches ), manager )... );
+                        ( touch< Components >( chunk, row ), ... );
+                    }
+                }
+            }
+            else
+            {
+                for ( uint32_t i = 0; i < group.count; ++i )
+                {
+                    const uint32_t entity = group.entities[ i ].getID();
+                    if ( !accepts( nullptr, 0, entity, caches, manager ) ) continue;
+                    func( uint32_t( 1 ), &fetch< Components >( nullptr, 0, entity, std::get< ComponentCacheT< Base< Components > >* >( caches ), manager )... );
+                }
+            }
+        }
+    }
+
+    template< typename... Components >
+    template< typename Func > void EntityViewT< Components... >::parallelEach( Func&& func, uint32_t grain )
+    {
+        if ( _view == nullptr ) return;
+        if ( ParallelFor::serial )
+        {
+            each( func );
+            return;
+        }
+        if ( grain == 0 ) grain = std::max( ParallelFor::grain, 1u );
+
+        std::vector< Batch > batches;
+        for ( uint32_t index : _view->_groups )
+        {
+            EntityGroup& group = _view->_registry->_entities[ index ];
+            if ( !accepts( group ) ) continue;
+
+            if ( group.layout != nullptr )
+            {
+                for ( EntityChunk* chunk : group.chunks )
+                {
+                    if ( !accepts( chunk ) ) continue;
+                    ( touchColumn< Components >( chunk ), ... );
+                    for ( uint32_t row = 0; row < chunk->count(); row += grain )
+                    {
+                        batches.push_back({ &group, chunk, row, std::min( row + grain, chunk->count() ) });
+                    }
+                }
+            }
+            else
+            {
+                for ( uint32_t i = 0; i < group.count; i += grain )
+                {
+                    batches.push_back({ &group, nullptr, i, std::min( i + grain, group.count ) });
+                }
+            }
+        }
+
+        EntityManager& manager = Entity::getManager();
+        Caches caches( manager.getComponentManager< Base< Components > >()... );
+
+        parallelFor( 0, uint32_t( batches.size() ), 1, [ & ]( uint32_t first, uint32_t last )
+        {
+            for ( uint32_t b = first; b < last; ++b )
+            {
+                const Batch& batch = batches[ b ];
+                if ( batch.chunk != nullptr )
+                {
+                    std::tuple< Components*... > columns( batch.chunk->template column< Base< Components > >()... );
+                    const uint32_t* entities = batch.chunk->entities();
+                    for ( uint32_t row = batch.begin; row < batch.end; ++row )
+                    {
+                        if ( !accepts( batch.chunk, row, entities[ row ], caches, manager ) ) continue;
+                        invoke
+                        (
+                            func, entities[ row ],
+                            fetch( std::get< Components* >( columns ), row, entities[ row ], std::get< ComponentCacheT< Base< Components > >* >( caches ), manager )...
+                        );
+                        ( touchRow< Components >( batch.chunk, row ), ... );
+                    }
+                }
+                else
+                {
+                    for ( uint32_t i = batch.begin; i < batch.end; ++i )
+                    {
+                        const uint32_t entity = batch.group->entities[ i ].getID();
+                        if ( !accepts( nullptr, 0, entity, caches, manager ) ) continue;
+                        invoke
+                        (
+                            func, entity,
+                            fetch< Components >( nullptr, 0, entity, std::get< ComponentCacheT< Base< Components > >* >( caches ), manager )...
+                        );
+                    }
+                }
+            }
+        });
+    }
+
+    template< typename... Components >
+    template< typename... T > EntityViewT< Components... > EntityViewT< Components... >::changed( uint32_t since )const
+    {
+        static_assert( sizeof...( T ) > 0, "changed() needs at least one component type" );
+        static_assert( ( holds< T >() && ... ), "changed() types must be components of the view" );
+
+        EntityViewT view( *this );
+        view._changed |= createEntitySignature< T... >();
+        view._since = since;
+        return view;
+    }
+
+    template< typename... Components >
+    uint32_t EntityViewT< Components... >::count()const
+    {
+        uint32_t total = 0;
+        if ( _view == nullptr ) return total;
+
+        for ( uint32_t index : _view->_groups )
+        {
+            const EntityGroup& group = _view->_registry->_entities[ index ];
+            if ( accepts( group ) ) total += group.count;
+        }
+        return total;
+    }
+
+    template< typename... Components >
+    EntityViewT< Components... >::EntityViewT( EntityView* view )
+    :   _view( view )
+    ,   _signature( createEntitySignature< Components... >() )
+    ,   _changed()
+    ,   _since( 0 )
+    {}
+
+}
+#endif /* typed_entity_view_hpp */
@@ -28,6 +28,7 @@ namespace kege{
         _module->addSystem( "entity-selecter" );
         _module->addSystem( "entity-dragging" );
 
+        _module->addSystem( "particle-lod" );
         _module->addSystem( "particle-emitter-updater" );
         _module->addSystem( "particle-effect-updater" );
 
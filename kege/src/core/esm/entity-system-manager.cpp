@@ -12,6 +12,7 @@ namespace kege{
 
     EntitySystemManager::EntitySystemManager( kege::Engine* engine )
     :   kege::System( engine, "entity-system-manager" )
+    ,   _rebuild_schedule( true )
     {
     }
 
@@ -22,6 +23,7 @@ namespace kege{
         if ( system->checkFlag( kege::EntitySystem::REQUIRE_UPDATE ) )
         {
             _system_updates.push_back( system.ref() );
+            _rebuild_schedule = true;
         }
 
         if ( system->checkFlag( kege::EntitySystem::REQUIRE_RENDER ) )
@@ -48,12 +50,50 @@ namespace kege{
         }
     }
     
+    kege::EntitySystem* EntitySystemManager::getSystem( const std::string& name )
+    {
+        for ( kege::Ref< kege::EntitySystem >& system : _systems )
+        {
+            if ( system->getName() == name )
+            {
+                return system.ref();
+            }
+        }
+        return nullptr;
+    }
+
     void EntitySystemManager::update( double dms )
     {
-        for (kege::Ref< kege::EntitySystem > system : _systems )
+        if ( _rebuild_schedule )
+        {
+            _scheduler.build( _system_updates );
+            _rebuild_schedule = false;
+            Log::info << _scheduler.dump() << Log::nl;
+        }
+        // components written from here on carry this update's change tick
+        ComponentCache::advanceChangeTick();
+        _scheduler.execute( dms );
+
+        // sync point, no system is iterating anymore
+        if ( _engine->scene() )
+        {
+            _engine->scene()->playback();
+        }
+    }
+
+    void EntitySystemManager::setScheduleMode( SystemScheduler::Mode mode )
+    {
+        _scheduler.setMode( mode );
+    }
+
+    std::string EntitySystemManager::dumpSchedule()
+    {
+        if ( _rebuild_schedule )
         {
-            system->update( dms );
+            _scheduler.build( _system_updates );
+            _rebuild_schedule = false;
         }
+        return _scheduler.dump();
     }
 
     void EntitySystemManager::render( double dms )
@@ -103,6 +143,7 @@ namespace kege{
         _system_updates.clear();
         _system_renders.clear();
         _system_inputs.clear();
+        _scheduler.build( _system_updates );
         Log::info << getName() << ", shutdown complete."<<Log::nl;
     }
 
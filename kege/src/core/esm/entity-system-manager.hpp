@@ -9,6 +9,7 @@
 #define kege_entity_system_manager_hpp
 
 #include "../system/system.hpp"
+#include "system-scheduler.hpp"
 
 namespace kege{
 
@@ -29,12 +30,30 @@ namespace kege{
 
         void addSystem( kege::Ref< kege::EntitySystem > system );
         void addSystem( const std::string& name );
+
+        /**
+         * @brief Finds an added system by the name it was constructed with, such as "physics-system".
+         * @return The system, or null if none has that name.
+         */
+        kege::EntitySystem* getSystem( const std::string& name );
+
         void update( double dms );
         void render( double dms );
         void onSceneChange();
         bool initialize();
         void shutdown();
 
+        /**
+         * @brief Selects between running independent systems concurrently and the deterministic
+         * single-thread order.
+         */
+        void setScheduleMode( SystemScheduler::Mode mode );
+
+        /**
+         * @brief Gets a readable description of the update schedule.
+         */
+        std::string dumpSchedule();
+
         virtual ~EntitySystemManager();
 
     protected:
@@ -56,6 +75,12 @@ namespace kege{
          */
         std::vector< kege::EntitySystem* > _system_inputs;
 
+        /**
+         * runs the update of _system_updates by their declared component access.
+         */
+        SystemScheduler _scheduler;
+        bool _rebuild_schedule;
+
         kege::Engine* _engine;
     };
 
@@ -41,11 +41,28 @@ namespace kege{
         bool checkFlag( StateBitFlag flag );
         EntityView* getEntities(){return _entities;}
 
+        const kege::EntitySignature& getReads()const{return _reads;}
+        const kege::EntitySignature& getWrites()const{return _writes;}
+
+        /**
+         * a system that declares no component access may touch anything, the scheduler runs it
+         * alone on the main thread.
+         */
+        bool isExclusive()const{return _reads.none() && _writes.none();}
+
         virtual ~EntitySystem();
 
     protected:
 
         kege::EntitySignature _signature;
+
+        /**
+         * component types update() only reads and component types it modifies. declaring them
+         * lets the EntitySystemManager run this system alongside systems it does not conflict with.
+         */
+        kege::EntitySignature _reads;
+        kege::EntitySignature _writes;
+
         EntityView* _entities;
         uint32_t _requirements;
 
@@ -0,0 +1,245 @@
+//
+//  system-scheduler.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#include <chrono>
+#include <thread>
+#include <sstream>
+#include <algorithm>
+#include "entity-system.hpp"
+#include "system-scheduler.hpp"
+#include "../task/job-system.hpp"
+
+namespace kege{
+
+    static EntitySignature conflicts( const EntitySystem* a, const EntitySystem* b )
+    {
+        return ( a->getWrites() & ( b->getReads() | b->getWrites() ) ) | ( b->getWrites() & a->getReads() );
+    }
+
+    static bool dependsOn( const EntitySystem* a, const EntitySystem* b )
+    {
+        return a->isExclusive() || b->isExclusive() || conflicts( a, b ).any();
+    }
+
+    void SystemScheduler::build( const std::vector< EntitySystem* >& systems )
+    {
+        const uint32_t count = uint32_t( systems.size() );
+        _nodes.clear();
+        _nodes.resize( count );
+        _stages = 0;
+
+        /*
+         walking the earlier systems from the closest one backwards, a conflicting system that
+         is already an ancestor of this one needs no edge of its own. this keeps the graph free
+         of redundant edges without changing the order it enforces.
+         */
+        std::vector< std::vector< bool > > ancestors( count, std::vector< bool >( count, false ) );
+        for ( uint32_t i = 0; i < count; ++i )
+        {
+            Node& node = _nodes[ i ];
+            node.system = systems[ i ];
+            node.exclusive = systems[ i ]->isExclusive();
+            node.stage = 0;
+
+            for ( int32_t j = int32_t( i ) - 1; j >= 0; --j )
+            {
+                if ( ancestors[ i ][ j ] || !dependsOn( systems[ j ], systems[ i ] ) )
+                {
+                    continue;
+                }
+
+                node.predecessors.push_back( j );
+                _nodes[ j ].successors.push_back( i );
+                node.stage = std::max( node.stage, _nodes[ j ].stage + 1 );
+
+                ancestors[ i ][ j ] = true;
+                for ( uint32_t k = 0; k < uint32_t( j ); ++k )
+                {
+                    if ( ancestors[ j ][ k ] ) ancestors[ i ][ k ] = true;
+                }
+            }
+            _stages = std::max( _stages, node.stage + 1 );
+        }
+
+        _pending = std::vector< std::atomic< uint32_t > >( count );
+    }
+
+    void SystemScheduler::execute( double dms )
+    {
+        if ( _mode == SERIAL || _nodes.size() <= 1 )
+        {
+            for ( Node& node : _nodes )
+            {
+                node.system->update( dms );
+            }
+            return;
+        }
+
+        _dms = dms;
+        _remaining = uint32_t( _nodes.size() );
+        _main_queue.clear();
+
+        for ( uint32_t i = 0; i < _nodes.size(); ++i )
+        {
+            _pending[ i ].store( uint32_t( _nodes[ i ].predecessors.size() ), std::memory_order_relaxed );
+        }
+
+        for ( uint32_t i = 0; i < _nodes.size(); ++i )
+        {
+            if ( _nodes[ i ].predecessors.empty() )
+            {
+                dispatch( i );
+            }
+        }
+
+        /*
+         the calling thread runs the exclusive systems and otherwise helps the job workers, so it
+         never sits idle while systems are still waiting for a thread.
+         */
+        JobSystem& jobs = JobSystem::instance();
+        std::unique_lock< std::mutex > lock( _mutex );
+        while ( _remaining > 0 )
+        {
+            if ( !_main_queue.empty() )
+            {
+                uint32_t node = _main_queue.back();
+                _main_queue.pop_back();
+
+                lock.unlock();
+                run( node );
+                lock.lock();
+                continue;
+            }
+
+            lock.unlock();
+            bool helped = jobs.help();
+            lock.lock();
+
+            if ( !helped && _remaining > 0 && _main_queue.empty() )
+            {
+                _condition.wait_for( lock, std::chrono::microseconds( 200 ) );
+            }
+        }
+    }
+
+    void SystemScheduler::dispatch( uint32_t node )
+    {
+        if ( _nodes[ node ].exclusive )
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+            _main_queue.push_back( node );
+            _condition.notify_all();
+        }
+        else
+        {
+            JobSystem::instance().schedule( [ this, node ](){ run( node ); } );
+        }
+    }
+
+    void SystemScheduler::run( uint32_t node )
+    {
+        _nodes[ node ].system->update( _dms );
+
+        for ( uint32_t successor : _nodes[ node ].successors )
+        {
+            if ( _pending[ successor ].fetch_sub( 1, std::memory_order_acq_rel ) == 1 )
+            {
+                dispatch( successor );
+            }
+        }
+
+        std::lock_guard< std::mutex > lock( _mutex );
+        _remaining -= 1;
+        if ( _remaining == 0 )
+        {
+            _condition.notify_all();
+        }
+    }
+
+    std::string SystemScheduler::dump()const
+    {
+        std::ostringstream out;
+        out << "system schedule: " << _nodes.size() << " systems, " << _stages << " stages, ";
+        out << ( ( _mode == SERIAL ) ? "serial" : "parallel" ) << "\n";
+
+        for ( uint32_t stage = 0; stage < _stages; ++stage )
+        {
+            out << "  stage " << stage << ":";
+            for ( const Node& node : _nodes )
+            {
+                if ( node.stage == stage )
+                {
+                    out << " " << node.system->getName() << ( node.exclusive ? "*" : "" );
+                }
+            }
+            out << "\n";
+        }
+
+        out << "  dependencies:\n";
+        for ( const Node& node : _nodes )
+        {
+            for ( uint32_t p : node.predecessors )
+            {
+                const Node& predecessor = _nodes[ p ];
+                out << "    " << predecessor.system->getName() << " -> " << node.system->getName();
+                if ( predecessor.exclusive || node.exclusive )
+                {
+                    out << " ( exclusive )\n";
+                    continue;
+                }
+
+                out << " ( component types:";
+                EntitySignature types = conflicts( predecessor.system, node.system );
+                for ( ComponentType type = 0; type < MAX_COMPONENT_TYPES; ++type )
+                {
+                    if ( types.test( type ) ) out << " " << type;
+                }
+                out << " )\n";
+            }
+        }
+        out << "  * exclusive, runs alone on the calling thread\n";
+        return out.str();
+    }
+
+    std::string SystemScheduler::graphviz()const
+    {
+        std::ostringstream out;
+        out << "digraph schedule {\n";
+        out << "  rankdir=LR;\n";
+        for ( const Node& node : _nodes )
+        {
+            out << "  \"" << node.system->getName() << "\" [shape=box" << ( node.exclusive ? ", style=bold" : "" ) << "];\n";
+        }
+        for ( const Node& node : _nodes )
+        {
+            for ( uint32_t p : node.predecessors )
+            {
+                out << "  \"" << _nodes[ p ].system->getName() << "\" -> \"" << node.system->getName() << "\";\n";
+            }
+        }
+        out << "}\n";
+        return out.str();
+    }
+
+    void SystemScheduler::setMode( Mode mode )
+    {
+        _mode = mode;
+    }
+
+    SystemScheduler::Mode SystemScheduler::getMode()const
+    {
+        return _mode;
+    }
+
+    SystemScheduler::SystemScheduler()
+    :   _remaining( 0 )
+    ,   _stages( 0 )
+    ,   _dms( 0.0 )
+    ,   _mode( ( std::thread::hardware_concurrency() > 1 ) ? PARALLEL : SERIAL )
+    {}
+
+}
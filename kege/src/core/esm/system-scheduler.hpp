@@ -0,0 +1,115 @@
+//
+//  system-scheduler.hpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef kege_system_scheduler_hpp
+#define kege_system_scheduler_hpp
+
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <condition_variable>
+#include "../ecs/component-cache.hpp"
+
+namespace kege{
+
+    class EntitySystem;
+
+    /**
+     * @brief Runs the update of a list of entity systems as a dependency graph.
+     *
+     * Two systems conflict when one writes a component type the other reads or writes, or when
+     * either is exclusive (declares no access at all). Every system depends on each earlier
+     * system it conflicts with, so the registration order is kept wherever it matters and
+     * non-conflicting systems are free to run at the same time. Exclusive systems always run on
+     * the thread that calls execute().
+     */
+    class SystemScheduler
+    {
+    public:
+
+        enum Mode
+        {
+            /**
+             * independent systems run concurrently on the job workers.
+             */
+            PARALLEL,
+
+            /**
+             * every system runs on the calling thread in registration order. deterministic.
+             */
+            SERIAL
+        };
+
+        /**
+         * @brief Builds the dependency graph of a list of systems, given in registration order.
+         */
+        void build( const std::vector< EntitySystem* >& systems );
+
+        /**
+         * @brief Runs the update of every system once and returns when all of them completed.
+         */
+        void execute( double dms );
+
+        /**
+         * @brief Gets a readable description of the schedule: the stages of systems that can
+         * run together and the dependencies between systems with their conflicting component types.
+         */
+        std::string dump()const;
+
+        /**
+         * @brief Gets the dependency graph in graphviz dot format.
+         */
+        std::string graphviz()const;
+
+        void setMode( Mode mode );
+        Mode getMode()const;
+
+        SystemScheduler();
+
+    private:
+
+        struct Node
+        {
+            EntitySystem* system;
+
+            /**
+             * systems that can only start after this system completed.
+             */
+            std::vector< uint32_t > successors;
+
+            /**
+             * systems this system waits on.
+             */
+            std::vector< uint32_t > predecessors;
+
+            /**
+             * longest dependency chain leading to this system.
+             */
+            uint32_t stage;
+            bool exclusive;
+        };
+
+        void dispatch( uint32_t node );
+        void run( uint32_t node );
+
+    private:
+
+        std::vector< Node > _nodes;
+        std::vector< std::atomic< uint32_t > > _pending;
+        std::vector< uint32_t > _main_queue;
+        std::mutex _mutex;
+        std::condition_variable _condition;
+        uint32_t _remaining;
+        uint32_t _stages;
+        double _dms;
+        Mode _mode;
+    };
+
+}
+
+#endif /* kege_system_scheduler_hpp */
@@ -0,0 +1,99 @@
+//
+//  frame-ring-buffer.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#include "../../graphics/core/frame-ring-buffer.hpp"
+
+namespace kege{
+
+    bool FrameRingBuffer::initialize( Graphics* graphics, BufferUsage usage, uint64_t frame_size )
+    {
+        _graphics = graphics;
+        _usage = usage;
+        return reserve( frame_size );
+    }
+
+    void FrameRingBuffer::beginFrame( uint32_t frame_index )
+    {
+        _region = frame_index % MAX_FRAMES_IN_FLIGHT;
+        _head = _region * _frame_size;
+        _end = _head + _frame_size;
+    }
+
+    bool FrameRingBuffer::allocate( uint64_t size, uint64_t alignment, Allocation& allocation )
+    {
+        if ( _mapped == nullptr ) return false;
+
+        const uint64_t offset = ( alignment > 1 ) ? ( _head + alignment - 1 ) / alignment * alignment : _head;
+        if ( offset + size > _end ) return false;
+
+        allocation.buffer = _buffer;
+        allocation.offset = offset;
+        allocation.data = _mapped + offset;
+        _head = offset + size;
+        return true;
+    }
+
+    bool FrameRingBuffer::reserve( uint64_t frame_size )
+    {
+        if ( _graphics == nullptr ) return false;
+        if ( _mapped != nullptr && frame_size <= _frame_size ) return true;
+
+        if ( _buffer )
+        {
+            _graphics->unmapBuffer( _buffer );
+            _graphics->destroyBuffer( _buffer );
+            _buffer = {};
+            _mapped = nullptr;
+        }
+
+        _buffer = _graphics->createBuffer
+        ({
+            .size = frame_size * MAX_FRAMES_IN_FLIGHT,
+            .data = nullptr,
+            .usage = _usage,
+            .memory_usage = MemoryUsage::CpuToGpu
+        });
+        if ( !_buffer )
+        {
+            KEGE_LOG_ERROR << "FrameRingBuffer: failed to create a buffer of " << frame_size * MAX_FRAMES_IN_FLIGHT << " bytes." << Log::nl;
+            _frame_size = 0;
+            _head = _end = 0;
+            return false;
+        }
+
+        // CpuToGpu memory is host coherent, the mapping is kept until the buffer is destroyed
+        _mapped = reinterpret_cast< uint8_t* >( _graphics->mapBuffer( _buffer ) );
+        _frame_size = frame_size;
+        beginFrame( _region );
+        return _mapped != nullptr;
+    }
+
+    void FrameRingBuffer::shutdown()
+    {
+        if ( _graphics != nullptr && _buffer )
+        {
+            _graphics->unmapBuffer( _buffer );
+            _graphics->destroyBuffer( _buffer );
+        }
+        _buffer = {};
+        _mapped = nullptr;
+        _frame_size = 0;
+        _head = _end = 0;
+    }
+
+    FrameRingBuffer::FrameRingBuffer()
+    :   _graphics( nullptr )
+    ,   _buffer()
+    ,   _usage( BufferUsage::None )
+    ,   _mapped( nullptr )
+    ,   _frame_size( 0 )
+    ,   _head( 0 )
+    ,   _end( 0 )
+    ,   _region( 0 )
+    {}
+
+}
@@ -0,0 +1,86 @@
+//
+//  frame-ring-buffer.hpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef kege_frame_ring_buffer_hpp
+#define kege_frame_ring_buffer_hpp
+
+#include "../../graphics/core/graphics.hpp"
+
+namespace kege{
+
+    /**
+     * @brief A CPU to GPU buffer for data that is written again every frame, such as dynamic vertices.
+     *
+     * The buffer is split into one region per frame in flight and stays mapped for its whole life.
+     * Every frame hands out slices of its own region, so the CPU never writes memory that the GPU
+     * may still be reading for an earlier frame, and no map or unmap is needed between draws.
+     */
+    class FrameRingBuffer
+    {
+    public:
+
+        struct Allocation
+        {
+            BufferHandle buffer;
+
+            /**
+             * where the slice starts in the buffer, the offset to bind it at.
+             */
+            uint64_t offset;
+            void* data;
+        };
+
+        /**
+         * @brief Creates the buffer with `frame_size` bytes for every frame in flight.
+         */
+        bool initialize( Graphics* graphics, BufferUsage usage, uint64_t frame_size );
+
+        /**
+         * @brief Starts handing out the region of frame_index, the slices of the last frame that used it are given up.
+         */
+        void beginFrame( uint32_t frame_index );
+
+        /**
+         * @brief Takes `size` bytes from the region of the current frame.
+         * @return False if the region has no room left, the allocation is untouched.
+         */
+        bool allocate( uint64_t size, uint64_t alignment, Allocation& allocation );
+
+        /**
+         * @brief Grows every region to at least `frame_size` bytes.
+         *
+         * The old buffer is destroyed, which waits for the device to go idle, and the slices already
+         * taken this frame are lost. Call it before the first allocation of a frame, and leave some
+         * room so it stays rare.
+         */
+        bool reserve( uint64_t frame_size );
+
+        /**
+         * @brief Gets the size of the region of each frame.
+         */
+        inline uint64_t frameSize()const
+        {
+            return _frame_size;
+        }
+
+        void shutdown();
+        FrameRingBuffer();
+
+    private:
+
+        Graphics* _graphics;
+        BufferHandle _buffer;
+        BufferUsage _usage;
+        uint8_t* _mapped;
+        uint64_t _frame_size;
+        uint64_t _head;
+        uint64_t _end;
+        uint32_t _region;
+    };
+
+}
+#endif /* kege_frame_ring_buffer_hpp */
@@ -0,0 +1,116 @@
+//
+//  lanes.hpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef kege_lanes_hpp
+#define kege_lanes_hpp
+
+#include <cmath>
+
+#if !defined( KEGE_NO_SIMD ) && ( defined( __AVX__ ) || defined( __SSE2__ ) || defined( _M_X64 ) )
+#include <immintrin.h>
+#endif
+
+namespace kege::simd{
+
+    /*
+     the few operations the structure of arrays kernels need, over the widest float vector the
+     compiler targets. a kernel is written once against these and compiles to 8, 4 or 1 values per
+     step. loads and stores are aligned, arrays have to start on a 32 byte boundary. defining
+     KEGE_NO_SIMD before including this header forces the scalar path.
+
+     a mask is what the comparisons return, a lane of all ones or all zeros, or 1 and 0 when scalar.
+     */
+#if !defined( KEGE_NO_SIMD ) && defined( __AVX__ )
+
+    typedef __m256 lanes;
+    enum{ WIDTH = 8 };
+    static inline lanes load( const float* p ){ return _mm256_load_ps( p ); }
+    static inline void store( float* p, lanes a ){ _mm256_store_ps( p, a ); }
+    static inline lanes splat( float s ){ return _mm256_set1_ps( s ); }
+    static inline lanes add( lanes a, lanes b ){ return _mm256_add_ps( a, b ); }
+    static inline lanes sub( lanes a, lanes b ){ return _mm256_sub_ps( a, b ); }
+    static inline lanes mul( lanes a, lanes b ){ return _mm256_mul_ps( a, b ); }
+    static inline lanes divide( lanes a, lanes b ){ return _mm256_div_ps( a, b ); }
+    static inline lanes root( lanes a ){ return _mm256_sqrt_ps( a ); }
+    static inline lanes minimum( lanes a, lanes b ){ return _mm256_min_ps( a, b ); }
+    static inline lanes maximum( lanes a, lanes b ){ return _mm256_max_ps( a, b ); }
+
+    /** the mask of the lanes where a > b */
+    static inline lanes greater( lanes a, lanes b ){ return _mm256_cmp_ps( a, b, _CMP_GT_OQ ); }
+
+    /** a where the mask is set, b elsewhere */
+    static inline lanes choose( lanes mask, lanes a, lanes b ){ return _mm256_blendv_ps( b, a, mask ); }
+
+    /** keeps the lanes whose magnitude is at least `min`, zeroes the rest */
+    static inline lanes keepAbove( lanes a, lanes min )
+    {
+        const lanes magnitude = _mm256_andnot_ps( _mm256_set1_ps( -0.f ), a );
+        return _mm256_and_ps( a, _mm256_cmp_ps( magnitude, min, _CMP_GE_OQ ) );
+    }
+    static inline const char* instructionSet(){ return "avx"; }
+
+#elif !defined( KEGE_NO_SIMD ) && ( defined( __SSE2__ ) || defined( _M_X64 ) )
+
+    typedef __m128 lanes;
+    enum{ WIDTH = 4 };
+    static inline lanes load( const float* p ){ return _mm_load_ps( p ); }
+    static inline void store( float* p, lanes a ){ _mm_store_ps( p, a ); }
+    static inline lanes splat( float s ){ return _mm_set1_ps( s ); }
+    static inline lanes add( lanes a, lanes b ){ return _mm_add_ps( a, b ); }
+    static inline lanes sub( lanes a, lanes b ){ return _mm_sub_ps( a, b ); }
+    static inline lanes mul( lanes a, lanes b ){ return _mm_mul_ps( a, b ); }
+    static inline lanes divide( lanes a, lanes b ){ return _mm_div_ps( a, b ); }
+    static inline lanes root( lanes a ){ return _mm_sqrt_ps( a ); }
+    static inline lanes minimum( lanes a, lanes b ){ return _mm_min_ps( a, b ); }
+    static inline lanes maximum( lanes a, lanes b ){ return _mm_max_ps( a, b ); }
+
+    /** the mask of the lanes where a > b */
+    static inline lanes greater( lanes a, lanes b ){ return _mm_cmpgt_ps( a, b ); }
+
+    /** a where the mask is set, b elsewhere */
+    static inline lanes choose( lanes mask, lanes a, lanes b ){ return _mm_or_ps( _mm_and_ps( mask, a ), _mm_andnot_ps( mask, b ) ); }
+
+    /** keeps the lanes whose magnitude is at least `min`, zeroes the rest */
+    static inline lanes keepAbove( lanes a, lanes min )
+    {
+        const lanes magnitude = _mm_andnot_ps( _mm_set1_ps( -0.f ), a );
+        return _mm_and_ps( a, _mm_cmpge_ps( magnitude, min ) );
+    }
+    static inline const char* instructionSet(){ return "sse2"; }
+
+#else
+
+    typedef float lanes;
+    enum{ WIDTH = 1 };
+    static inline lanes load( const float* p ){ return *p; }
+    static inline void store( float* p, lanes a ){ *p = a; }
+    static inline lanes splat( float s ){ return s; }
+    static inline lanes add( lanes a, lanes b ){ return a + b; }
+    static inline lanes sub( lanes a, lanes b ){ return a - b; }
+    static inline lanes mul( lanes a, lanes b ){ return a * b; }
+    static inline lanes divide( lanes a, lanes b ){ return a / b; }
+    static inline lanes root( lanes a ){ return std::sqrt( a ); }
+    static inline lanes minimum( lanes a, lanes b ){ return ( b < a ) ? b : a; }
+    static inline lanes maximum( lanes a, lanes b ){ return ( a < b ) ? b : a; }
+
+    /** 1 if a > b, 0 otherwise */
+    static inline lanes greater( lanes a, lanes b ){ return ( a > b ) ? 1.f : 0.f; }
+
+    /** a if the mask is set, b otherwise */
+    static inline lanes choose( lanes mask, lanes a, lanes b ){ return ( mask != 0.f ) ? a : b; }
+
+    /** keeps the value if its magnitude is at least `min`, zero otherwise */
+    static inline lanes keepAbove( lanes a, lanes min )
+    {
+        return ( std::fabs( a ) >= min ) ? a : 0.f;
+    }
+    static inline const char* instructionSet(){ return "scalar"; }
+
+#endif
+
+}
+#endif /* kege_lanes_hpp */
@@ -8,6 +8,7 @@
 #ifndef random_hpp
 #define random_hpp
 
+#include <cstdint>
 #include "vectors.hpp"
 
 namespace kege{
@@ -44,6 +45,63 @@ namespace kege{
     double probable_amount(double pct, double amount);
 }
 
+namespace kege{
+
+    /**
+     * @brief A random number generator with its own state, a PCG32.
+     *
+     * Unlike rand() it can be owned by one thread or one batch of work. Streams with the same
+     * seed and different sequences give different numbers, so parallel work that takes its
+     * stream from the batch it runs, rather than the thread, draws the same numbers every run.
+     */
+    class RandomStream
+    {
+    public:
+
+        /**
+         * @brief Gets the next 32 random bits.
+         */
+        inline uint32_t next()
+        {
+            const uint64_t state = _state;
+            _state = state * 6364136223846793005ULL + _increment;
+            const uint32_t xorshifted = uint32_t( ( ( state >> 18u ) ^ state ) >> 27u );
+            const uint32_t rotation = uint32_t( state >> 59u );
+            return ( xorshifted >> rotation ) | ( xorshifted << ( ( -rotation ) & 31 ) );
+        }
+
+        /**
+         * @brief Gets a number in [0, 1).
+         */
+        inline float uniform()
+        {
+            return float( next() >> 8 ) * ( 1.0f / 16777216.0f );
+        }
+
+        /**
+         * @brief Gets a number in [from, to).
+         */
+        inline float range( float from, float to )
+        {
+            return from + ( to - from ) * uniform();
+        }
+
+        RandomStream( uint64_t seed = 0, uint64_t sequence = 0 )
+        :   _state( 0 )
+        ,   _increment( ( sequence << 1u ) | 1u )
+        {
+            next();
+            _state += seed;
+            next();
+        }
+
+    private:
+
+        uint64_t _state;
+        uint64_t _increment;
+    };
+}
+
 namespace kege{
 
     class rand1i
@@ -81,6 +139,9 @@ namespace kege{
         float gen() const
         { return randf(min, max); }
 
+        float gen( RandomStream& random ) const
+        { return random.range(min, max); }
+
         rand1f()
         {}
         rand1f(float min,float max)
@@ -131,6 +192,9 @@ namespace kege{
         vec3 gen() const
         { return { x.gen(), y.gen(), z.gen() }; }
 
+        vec3 gen( RandomStream& random ) const
+        { return { x.gen( random ), y.gen( random ), z.gen( random ) }; }
+
         rand3f()
         {}
         rand3f(rand1f const &x,rand1f const &y,rand1f const &z )
@@ -157,6 +221,10 @@ namespace kege{
         vec4 gen() const
         { return vec4(x.gen(), y.gen(), z.gen(), w.gen()); }
 
+        // braces keep the draws in order, the arguments of a call are evaluated in any order
+        vec4 gen( RandomStream& random ) const
+        { return vec4{ x.gen( random ), y.gen( random ), z.gen( random ), w.gen( random ) }; }
+
         rand4f()
         {}
         rand4f(rand1f const &x,rand1f const &y,rand1f const &z,rand1f const &w)
@@ -40,6 +40,7 @@ namespace kege{
             }
         }
 
+        scene->insert( params.entities );
         return scene;
     }
 
@@ -121,6 +122,7 @@ namespace kege{
             .anti_gravity = json[ "anti_gravity" ].getBool(),
             .immovable = json[ "immovable" ].getBool(),
             .sleepable = json[ "sleepable" ].getBool(),
+            .continuous_collision = json[ "continuous_collision" ].getBool(),
             .up = vec3(0.f, 1.f, 0.f)
         };
 
@@ -219,9 +221,31 @@ namespace kege{
             }
         }
 
+        Json lod = json[ "lod" ];
+        if ( lod )
+        {
+            kege::ParticleLOD settings;
+            if ( lod[ "radius" ] ) settings.radius = lod[ "radius" ].getFloat();
+            if ( lod[ "near_distance" ] ) settings.near_distance = lod[ "near_distance" ].getFloat();
+            if ( lod[ "far_distance" ] ) settings.far_distance = lod[ "far_distance" ].getFloat();
+            if ( lod[ "cull_distance" ] ) settings.cull_distance = lod[ "cull_distance" ].getFloat();
+            if ( lod[ "min_emission" ] ) settings.min_emission = lod[ "min_emission" ].getFloat();
+            if ( lod[ "max_tick_interval" ] ) settings.max_tick_interval = lod[ "max_tick_interval" ].getInt();
+            if ( lod[ "priority" ] ) settings.priority = lod[ "priority" ].getInt();
+
+            if ( entity )
+            {
+                entity->add< kege::ParticleLOD >( settings );
+            }
+            else
+            {
+                params->assets->add< kege::ParticleLOD >( params->id, settings );
+            }
+        }
+
         if ( entity )
         {
-            entity->add< kege::ParticleBuffer >({ array< kege::Particle >( json[ "max_particles" ].getInt() ) });
+            entity->add< kege::ParticleBuffer >( kege::ParticleBuffer( json[ "max_particles" ].getInt() ) );
             entity->add< kege::ParticleEffect >( effect );
         }
         else
@@ -625,7 +649,7 @@ namespace kege{
         }
         else
         {
-            params->scene->insert( entity );
+            params->entities.push_back( entity );
         }
     }
 
@@ -803,6 +827,26 @@ namespace kege{
         }
     }
 
+    void SceneLoader::colliderConvex( Params* params, Entity* entity, Json json )
+    {
+        Json points = json[ "points" ];
+        std::vector< vec3 > vertices( points.count() );
+        for (int i = 0; i < points.count(); ++i )
+        {
+            vertices[ i ] = toVec3( points[ i ] );
+        }
+
+        kege::Ref< kege::Collider > collider = new ColliderConvex( vertices );
+
+        if ( entity )
+        {
+            setRigidbodyCollider( entity, collider );
+        }
+        else
+        {
+            params->assets->add< kege::Ref< kege::Collider > >( params->id, collider );
+        }
+    }
     void SceneLoader::colliderPlane( Params* params, Entity* entity, Json json )
     {
         Plane shape;
@@ -1165,6 +1209,7 @@ namespace kege{
         _resource_parsers[ "collider-cont" ] = colliderCone;
         _resource_parsers[ "collider-circle" ] = colliderCircle;
         _resource_parsers[ "collider-cylinder" ] = colliderCylinder;
+        _resource_parsers[ "collider-convex" ] = colliderConvex;
         _resource_parsers[ "collider-plane" ] = colliderPlane;
         _resource_parsers[ "collider-sphere" ] = colliderSphere;
         _resource_parsers[ "collider-box" ] = colliderBox;
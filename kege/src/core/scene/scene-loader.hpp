@@ -79,6 +79,11 @@ namespace kege{
             AssetSystem* assets;
             std::string id;
             std::string type;
+
+            /**
+             * top level entities, inserted into the scene as one batch once the file is parsed.
+             */
+            std::vector< Entity > entities;
         };
 
         typedef std::function< Ref< Mesh >( AssetSystem* assets, Json json ) > MeshParserFunct;
@@ -154,6 +159,7 @@ namespace kege{
         static void colliderMesh( Params* params, Entity* entity, Json json );
         static void colliderCone( Params* params, Entity* entity, Json json );
         static void colliderCylinder( Params* params, Entity* entity, Json json );
+        static void colliderConvex( Params* params, Entity* entity, Json json );
         static void colliderPlane( Params* params, Entity* entity, Json json );
         static void colliderSphere( Params* params, Entity* entity, Json json );
         static void colliderBox( Params* params, Entity* entity, Json json );
@@ -20,6 +20,16 @@ namespace kege{
         return _registry;
     }
 
+    EntityCommandBuffer& Scene::getCommandBuffer()
+    {
+        return _commands;
+    }
+
+    void Scene::playback()
+    {
+        _commands.playback( _registry, _root );
+    }
+
     void Scene::setCameraEntity( const Entity& entity )
     {
         _camera = entity;
@@ -57,6 +67,15 @@ namespace kege{
         _registry.insert( entity );
     }
 
+    void Scene::insert( std::vector< Entity >& entities )
+    {
+        for ( Entity& entity : entities )
+        {
+            _root.attach( entity );
+        }
+        _registry.insert( entities.data(), uint32_t( entities.size() ) );
+    }
+
     bool Scene::remove( Entity& entity )
     {
         if ( _root != entity )
@@ -113,6 +132,7 @@ namespace kege{
     void Scene::shutdown()
     {
         _ready = false;
+        _commands.clear();
         if( _camera ) _camera.destroy();
         if( _player ) _player.destroy();
         if( _root ) _root.destroy();
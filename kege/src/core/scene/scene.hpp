@@ -12,6 +12,7 @@
 #include "../math/algebra/vectors.hpp"
 #include "../ecs/entity.hpp"
 #include "../ecs/entity-registry.hpp"
+#include "../ecs/entity-command-buffer.hpp"
 #include "../utils/asset-system.hpp"
 #include "entity-tag.hpp"
 
@@ -35,6 +36,20 @@ namespace kege{
          */
         kege::EntityRegistry& getEntityRegistry();
 
+        /**
+         * @fn getCommandBuffer
+         *
+         * @return the buffer systems record structural changes into while they update. safe to
+         * record into from any thread.
+         */
+        kege::EntityCommandBuffer& getCommandBuffer();
+
+        /**
+         * @fn playback
+         * @brief Apply the recorded structural changes. New entities are attached to the root.
+         */
+        void playback();
+
         /**
          * @fn setSceneRay
          *
@@ -106,6 +121,13 @@ namespace kege{
          */
         void insert( Entity entity );
 
+        /**
+         * @fn insert
+         * @brief Attach many entities to the scene root and integrate them with one registry batch.
+         * @param entities The entities to insert, their children are inserted with them.
+         */
+        void insert( std::vector< Entity >& entities );
+
         /**
          * @fn initialize
          *
@@ -143,6 +165,11 @@ namespace kege{
          */
         kege::EntityRegistry _registry;
 
+        /**
+         * structural changes recorded during the system updates
+         */
+        kege::EntityCommandBuffer _commands;
+
         /**
          * The camera entity
          */
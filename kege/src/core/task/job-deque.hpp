@@ -0,0 +1,165 @@
+//
+//  job-deque.hpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef job_deque_hpp
+#define job_deque_hpp
+
+#include <atomic>
+#include <vector>
+#include <cstdint>
+
+namespace kege{
+
+    /**
+     * @brief Chase-Lev work-stealing deque of pointers.
+     *
+     * The owning worker pushes and pops at the bottom, any other thread steals from the top.
+     * Only push() and pop() may be called by the owner, steal() is safe from every thread.
+     * The ring grows when full. Retired rings are kept until the deque is destroyed, because a
+     * concurrent thief may still be reading one.
+     */
+    template< typename T > class JobDeque
+    {
+    public:
+
+        void push( T* item )
+        {
+            int64_t b = _bottom.load( std::memory_order_relaxed );
+            int64_t t = _top.load( std::memory_order_acquire );
+            Ring* ring = _ring.load( std::memory_order_relaxed );
+
+            if ( b - t > ring->capacity - 1 )
+            {
+                ring = grow( ring, b, t );
+            }
+
+            ring->put( b, item );
+            _bottom.store( b + 1, std::memory_order_release );
+        }
+
+        T* pop()
+        {
+            int64_t b = _bottom.load( std::memory_order_relaxed ) - 1;
+            Ring* ring = _ring.load( std::memory_order_relaxed );
+            _bottom.store( b, std::memory_order_relaxed );
+            std::atomic_thread_fence( std::memory_order_seq_cst );
+            int64_t t = _top.load( std::memory_order_relaxed );
+
+            if ( t > b )
+            {
+                // empty
+                _bottom.store( b + 1, std::memory_order_relaxed );
+                return nullptr;
+            }
+
+            T* item = ring->get( b );
+            if ( t == b )
+            {
+                // last item, race the thieves for it
+                if ( !_top.compare_exchange_strong( t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) )
+                {
+                    item = nullptr;
+                }
+                _bottom.store( b + 1, std::memory_order_relaxed );
+            }
+            return item;
+        }
+
+        T* steal()
+        {
+            int64_t t = _top.load( std::memory_order_acquire );
+            std::atomic_thread_fence( std::memory_order_seq_cst );
+            int64_t b = _bottom.load( std::memory_order_acquire );
+
+            if ( t >= b )
+            {
+                return nullptr;
+            }
+
+            Ring* ring = _ring.load( std::memory_order_acquire );
+            T* item = ring->get( t );
+            if ( !_top.compare_exchange_strong( t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) )
+            {
+                return nullptr;
+            }
+            return item;
+        }
+
+        bool empty()const
+        {
+            return _bottom.load( std::memory_order_relaxed ) <= _top.load( std::memory_order_relaxed );
+        }
+
+        JobDeque( int64_t capacity = 256 )
+        :   _top( 0 )
+        ,   _bottom( 0 )
+        ,   _ring( new Ring( capacity ) )
+        {}
+
+        ~JobDeque()
+        {
+            for ( Ring* ring : _retired )
+            {
+                delete ring;
+            }
+            delete _ring.load();
+        }
+
+        JobDeque( const JobDeque& ) = delete;
+        JobDeque& operator=( const JobDeque& ) = delete;
+
+    private:
+
+        struct Ring
+        {
+            T* get( int64_t i )const
+            {
+                return items[ i & ( capacity - 1 ) ].load( std::memory_order_relaxed );
+            }
+
+            void put( int64_t i, T* item )
+            {
+                items[ i & ( capacity - 1 ) ].store( item, std::memory_order_relaxed );
+            }
+
+            Ring( int64_t size )
+            :   capacity( size )
+            ,   items( new std::atomic< T* >[ size ] )
+            {}
+
+            ~Ring()
+            {
+                delete [] items;
+            }
+
+            int64_t capacity;
+            std::atomic< T* >* items;
+        };
+
+        Ring* grow( Ring* ring, int64_t b, int64_t t )
+        {
+            Ring* bigger = new Ring( ring->capacity * 2 );
+            for ( int64_t i = t; i < b; ++i )
+            {
+                bigger->put( i, ring->get( i ) );
+            }
+            _retired.push_back( ring );
+            _ring.store( bigger, std::memory_order_release );
+            return bigger;
+        }
+
+    private:
+
+        alignas( 64 ) std::atomic< int64_t > _top;
+        alignas( 64 ) std::atomic< int64_t > _bottom;
+        std::atomic< Ring* > _ring;
+        std::vector< Ring* > _retired;
+    };
+
+}
+
+#endif /* job_deque_hpp */
@@ -0,0 +1,332 @@
+//
+//  job-system.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#include <chrono>
+#include "job-system.hpp"
+
+namespace kege{
+
+    /**
+     * the job system and worker index of the calling thread. -1 on threads that are not workers.
+     */
+    static thread_local JobSystem* t_job_system = nullptr;
+    static thread_local int32_t t_worker = -1;
+
+    bool JobHandle::done()const
+    {
+        return !_counter || _counter->pending.load( std::memory_order_acquire ) == 0;
+    }
+
+    void JobHandle::wait()const
+    {
+        while ( !done() )
+        {
+            if ( _system && _system->help() )
+            {
+                continue;
+            }
+
+            /*
+             nothing to help with, the tracked jobs are running elsewhere. the timeout lets this
+             thread pick up jobs those may spawn.
+             */
+            std::unique_lock< std::mutex > lock( _counter->mutex );
+            _counter->condition.wait_for( lock, std::chrono::microseconds( 200 ), [ this ](){ return _counter->done; } );
+        }
+    }
+
+}
+
+namespace kege{
+
+    JobHandle JobSystem::schedule( const std::function< void() >& job )
+    {
+        Job* j = new Job( job, std::make_shared< JobCounter >( 1 ), 0 );
+        JobHandle handle( j->counter, this );
+        submit( j );
+        return handle;
+    }
+
+    JobHandle JobSystem::schedule( const std::function< void() >& job, const std::vector< JobHandle >& dependencies )
+    {
+        /*
+         the job holds one extra dependency while it registers with its dependencies, so it can
+         not be released by a dependency that completes in the middle of the loop.
+         */
+        Job* j = new Job( job, std::make_shared< JobCounter >( 1 ), 1 );
+        JobHandle handle( j->counter, this );
+
+        for ( const JobHandle& dependency : dependencies )
+        {
+            if ( !dependency._counter ) continue;
+
+            std::lock_guard< std::mutex > lock( dependency._counter->mutex );
+            if ( !dependency._counter->done )
+            {
+                dependency._counter->dependents.push_back( j );
+                j->dependencies.fetch_add( 1, std::memory_order_relaxed );
+            }
+        }
+
+        release( j );
+        return handle;
+    }
+
+    JobHandle JobSystem::schedule( uint32_t count, const std::function< void( uint32_t ) >& job )
+    {
+        std::shared_ptr< JobCounter > counter = std::make_shared< JobCounter >( count );
+        std::shared_ptr< std::function< void( uint32_t ) > > shared = std::make_shared< std::function< void( uint32_t ) > >( job );
+
+        for ( uint32_t i = 0; i < count; ++i )
+        {
+            submit( new Job( [ shared, i ](){ ( *shared )( i ); }, counter, 0 ) );
+        }
+        return JobHandle( counter, this );
+    }
+
+    bool JobSystem::help()
+    {
+        Job* job = find( ( t_job_system == this ) ? t_worker : -1 );
+        if ( job )
+        {
+            execute( job );
+            return true;
+        }
+        return false;
+    }
+
+    uint32_t JobSystem::workerCount()const
+    {
+        return uint32_t( _workers.size() );
+    }
+
+    int32_t JobSystem::currentWorker()
+    {
+        return t_worker;
+    }
+
+    void JobSystem::start( uint32_t workers )
+    {
+        std::lock_guard< std::mutex > lock( _start_mutex );
+        if ( _running.load() )
+        {
+            return;
+        }
+
+        if ( workers == 0 )
+        {
+            uint32_t hardware = std::thread::hardware_concurrency();
+            workers = ( hardware > 1 ) ? hardware - 1 : 1;
+        }
+
+        _running.store( true );
+        for ( uint32_t i = 0; i < workers; ++i )
+        {
+            _workers.push_back( std::unique_ptr< Worker >( new Worker ) );
+        }
+        for ( uint32_t i = 0; i < workers; ++i )
+        {
+            _workers[ i ]->thread = std::thread( &JobSystem::work, this, int32_t( i ) );
+        }
+    }
+
+    void JobSystem::shutdown()
+    {
+        std::lock_guard< std::mutex > lock( _start_mutex );
+        if ( !_running.load() )
+        {
+            return;
+        }
+
+        _running.store( false );
+        {
+            std::lock_guard< std::mutex > park( _park_mutex );
+            _park_condition.notify_all();
+        }
+
+        for ( std::unique_ptr< Worker >& worker : _workers )
+        {
+            if ( worker->thread.joinable() )
+            {
+                worker->thread.join();
+            }
+        }
+
+        // the workers are gone, run whatever they left behind on this thread.
+        for ( Job* job = find( -1 ); job != nullptr; job = find( -1 ) )
+        {
+            execute( job );
+        }
+        _workers.clear();
+    }
+
+    JobSystem& JobSystem::instance()
+    {
+        JobSystem& system = global();
+        if ( !system._running.load( std::memory_order_acquire ) )
+        {
+            system.start();
+        }
+        return system;
+    }
+
+    JobSystem& JobSystem::global()
+    {
+        static JobSystem system;
+        return system;
+    }
+
+    void JobSystem::submit( Job* job )
+    {
+        if ( t_job_system == this && t_worker >= 0 )
+        {
+            _workers[ t_worker ]->deque.push( job );
+        }
+        else
+        {
+            std::lock_guard< std::mutex > lock( _injected_mutex );
+            _injected.push_back( job );
+            _injected_count.fetch_add( 1, std::memory_order_release );
+        }
+        wake();
+    }
+
+    void JobSystem::execute( Job* job )
+    {
+        job->execute();
+        complete( job->counter );
+        delete job;
+    }
+
+    void JobSystem::complete( const std::shared_ptr< JobCounter >& counter )
+    {
+        if ( counter->pending.fetch_sub( 1, std::memory_order_acq_rel ) != 1 )
+        {
+            return;
+        }
+
+        std::vector< Job* > ready;
+        {
+            std::lock_guard< std::mutex > lock( counter->mutex );
+            counter->done = true;
+            ready.swap( counter->dependents );
+        }
+        counter->condition.notify_all();
+
+        for ( Job* job : ready )
+        {
+            release( job );
+        }
+    }
+
+    void JobSystem::release( Job* job )
+    {
+        if ( job->dependencies.fetch_sub( 1, std::memory_order_acq_rel ) == 1 )
+        {
+            submit( job );
+        }
+    }
+
+    Job* JobSystem::find( int32_t worker )
+    {
+        Job* job = nullptr;
+        if ( worker >= 0 )
+        {
+            job = _workers[ worker ]->deque.pop();
+            if ( job ) return job;
+        }
+
+        if ( _injected_count.load( std::memory_order_acquire ) > 0 )
+        {
+            std::lock_guard< std::mutex > lock( _injected_mutex );
+            if ( !_injected.empty() )
+            {
+                job = _injected.front();
+                _injected.pop_front();
+                _injected_count.fetch_sub( 1, std::memory_order_relaxed );
+                return job;
+            }
+        }
+
+        const uint32_t count = uint32_t( _workers.size() );
+        const uint32_t first = ( worker >= 0 ) ? uint32_t( worker ) + 1 : 0;
+        for ( uint32_t i = 0; i < count; ++i )
+        {
+            uint32_t victim = ( first + i ) % count;
+            if ( int32_t( victim ) == worker ) continue;
+
+            job = _workers[ victim ]->deque.steal();
+            if ( job ) return job;
+        }
+        return nullptr;
+    }
+
+    void JobSystem::work( int32_t worker )
+    {
+        t_job_system = this;
+        t_worker = worker;
+
+        while ( _running.load( std::memory_order_acquire ) )
+        {
+            Job* job = find( worker );
+            for ( int spin = 0; job == nullptr && spin < 32; ++spin )
+            {
+                std::this_thread::yield();
+                job = find( worker );
+            }
+
+            if ( job )
+            {
+                execute( job );
+                continue;
+            }
+
+            /*
+             read the epoch before the last look for work. anything published after that look
+             changes the epoch, so the wait below returns right away instead of sleeping on it.
+             */
+            uint64_t epoch = _epoch.load();
+            job = find( worker );
+            if ( job )
+            {
+                execute( job );
+                continue;
+            }
+
+            std::unique_lock< std::mutex > lock( _park_mutex );
+            _parked.fetch_add( 1 );
+            _park_condition.wait( lock, [ this, epoch ](){ return _epoch.load() != epoch || !_running.load(); } );
+            _parked.fetch_sub( 1 );
+        }
+
+        t_job_system = nullptr;
+        t_worker = -1;
+    }
+
+    void JobSystem::wake()
+    {
+        _epoch.fetch_add( 1 );
+        if ( _parked.load() > 0 )
+        {
+            std::lock_guard< std::mutex > lock( _park_mutex );
+            _park_condition.notify_one();
+        }
+    }
+
+    JobSystem::~JobSystem()
+    {
+        shutdown();
+    }
+
+    JobSystem::JobSystem()
+    :   _injected_count( 0 )
+    ,   _epoch( 0 )
+    ,   _parked( 0 )
+    ,   _running( false )
+    {}
+
+}
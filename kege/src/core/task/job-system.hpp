@@ -0,0 +1,206 @@
+//
+//  job-system.hpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef job_system_hpp
+#define job_system_hpp
+
+#include <mutex>
+#include <deque>
+#include <thread>
+#include <memory>
+#include <functional>
+#include <condition_variable>
+#include "job-deque.hpp"
+
+namespace kege{
+
+    class JobSystem;
+    struct Job;
+
+    /**
+     * @brief Completion counter shared by a job handle and the jobs it tracks.
+     */
+    struct JobCounter
+    {
+        /**
+         * number of tracked jobs that have not completed yet.
+         */
+        std::atomic< uint32_t > pending;
+
+        /**
+         * jobs that wait on this counter. guarded by mutex, cleared once the counter completes.
+         */
+        std::vector< Job* > dependents;
+        std::condition_variable condition;
+        std::mutex mutex;
+        bool done;
+
+        JobCounter( uint32_t count ): pending( count ), done( count == 0 ) {}
+    };
+
+    /**
+     * @brief A reference to scheduled work. Completes once every job it tracks has run.
+     *
+     * An empty handle counts as completed, so it can be passed as a dependency freely.
+     */
+    class JobHandle
+    {
+    public:
+
+        /**
+         * @brief Checks if every job tracked by this handle has completed.
+         */
+        bool done()const;
+
+        /**
+         * @brief Blocks until the handle completes. The calling thread runs pending jobs while it waits.
+         */
+        void wait()const;
+
+        explicit operator bool()const{ return _counter != nullptr; }
+
+        JobHandle(){}
+
+    private:
+
+        JobHandle( const std::shared_ptr< JobCounter >& counter, JobSystem* system ): _counter( counter ), _system( system ) {}
+
+        std::shared_ptr< JobCounter > _counter;
+        JobSystem* _system = nullptr;
+        friend JobSystem;
+    };
+
+    /**
+     * @brief A unit of work owned by the JobSystem.
+     */
+    struct Job
+    {
+        std::function< void() > execute;
+        std::shared_ptr< JobCounter > counter;
+
+        /**
+         * number of dependencies that have not completed yet, plus one while the job is being scheduled.
+         */
+        std::atomic< uint32_t > dependencies;
+
+        Job( const std::function< void() >& job, const std::shared_ptr< JobCounter >& counter, uint32_t dependencies )
+        :   execute( job )
+        ,   counter( counter )
+        ,   dependencies( dependencies )
+        {}
+    };
+
+    /**
+     * @brief Work-stealing job scheduler.
+     *
+     * Each worker thread owns a Chase-Lev deque. Jobs scheduled from a worker go to its own
+     * deque, jobs scheduled from other threads go to a shared injection queue. An idle worker
+     * first drains its own deque, then the injection queue, then steals from the other workers,
+     * and parks on a condition variable once it finds nothing. Scheduling wakes one parked worker.
+     */
+    class JobSystem
+    {
+    public:
+
+        /**
+         * @brief Schedules a job.
+         * @return A handle that completes when the job has run.
+         */
+        JobHandle schedule( const std::function< void() >& job );
+
+        /**
+         * @brief Schedules a job that only starts after every dependency has completed.
+         */
+        JobHandle schedule( const std::function< void() >& job, const std::vector< JobHandle >& dependencies );
+
+        /**
+         * @brief Schedules `count` jobs calling `job( i )` for i in [0, count), tracked by one handle.
+         */
+        JobHandle schedule( uint32_t count, const std::function< void( uint32_t ) >& job );
+
+        /**
+         * @brief Runs one pending job on the calling thread if there is one.
+         * @return True if a job was run.
+         */
+        bool help();
+
+        /**
+         * @brief Gets the number of worker threads.
+         */
+        uint32_t workerCount()const;
+
+        /**
+         * @brief Gets the index of the calling thread among the workers of its job system, -1 if it is not a worker.
+         */
+        static int32_t currentWorker();
+
+        /**
+         * @brief Starts the worker threads. Zero picks one less than the hardware thread count.
+         */
+        void start( uint32_t workers = 0 );
+
+        /**
+         * @brief Runs the remaining jobs and joins the worker threads.
+         */
+        void shutdown();
+
+        /**
+         * @brief The process wide job system. Started with the default worker count on first use.
+         */
+        static JobSystem& instance();
+
+        /**
+         * @brief The same process wide job system as instance(), returned as it is without starting it.
+         */
+        static JobSystem& global();
+
+        ~JobSystem();
+        JobSystem();
+
+    private:
+
+        struct Worker
+        {
+            JobDeque< Job > deque;
+            std::thread thread;
+        };
+
+        void submit( Job* job );
+        void execute( Job* job );
+        void complete( const std::shared_ptr< JobCounter >& counter );
+        void release( Job* job );
+        Job* find( int32_t worker );
+        void work( int32_t worker );
+        void wake();
+
+    private:
+
+        std::vector< std::unique_ptr< Worker > > _workers;
+
+        /**
+         * jobs scheduled from threads that are not workers of this system.
+         */
+        std::deque< Job* > _injected;
+        std::mutex _injected_mutex;
+        std::atomic< uint32_t > _injected_count;
+
+        /**
+         * parking. _epoch changes every time work is published, so a worker that saw no work
+         * before reading the epoch can not miss a wake up.
+         */
+        std::condition_variable _park_condition;
+        std::mutex _park_mutex;
+        std::atomic< uint64_t > _epoch;
+        std::atomic< uint32_t > _parked;
+
+        std::atomic< bool > _running;
+        std::mutex _start_mutex;
+    };
+
+}
+
+#endif /* job_system_hpp */
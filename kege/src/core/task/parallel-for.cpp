@@ -0,0 +1,15 @@
+//
+//  parallel-for.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#include "parallel-for.hpp"
+
+namespace kege{
+
+    uint32_t ParallelFor::grain = 256;
+    bool ParallelFor::serial = false;
+
+}
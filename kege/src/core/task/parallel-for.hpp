@@ -0,0 +1,72 @@
+//
+//  parallel-for.hpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef parallel_for_hpp
+#define parallel_for_hpp
+
+#include <algorithm>
+#include "job-system.hpp"
+
+namespace kege{
+
+    /**
+     * @brief Settings shared by every parallelFor and EntityViewT::parallelEach call.
+     */
+    struct ParallelFor
+    {
+        /**
+         * number of items per batch used when a call passes a grain of zero.
+         */
+        static uint32_t grain;
+
+        /**
+         * when set, every parallel loop runs as a single batch on the calling thread, in order.
+         * meant for debugging.
+         */
+        static bool serial;
+    };
+
+    /**
+     * @brief Splits [begin, end) into batches of `grain` items and calls `func( first, last )`
+     * for every batch on the job workers. Returns once every batch has run. The calling thread
+     * runs batches too while it waits.
+     *
+     * A range that fits in one batch, or ParallelFor::serial, runs `func( begin, end )` inline.
+     *
+     * @param grain Items per batch. Zero uses ParallelFor::grain.
+     */
+    template< typename Func > void parallelFor( uint32_t begin, uint32_t end, uint32_t grain, Func&& func )
+    {
+        if ( begin >= end ) return;
+        if ( grain == 0 ) grain = std::max( ParallelFor::grain, 1u );
+
+        const uint32_t count = end - begin;
+        const uint32_t batches = ( count + grain - 1 ) / grain;
+        if ( ParallelFor::serial || batches <= 1 )
+        {
+            func( begin, end );
+            return;
+        }
+
+        JobSystem::instance().schedule( batches, [ &func, begin, end, grain ]( uint32_t batch )
+        {
+            const uint32_t first = begin + batch * grain;
+            func( first, std::min( first + grain, end ) );
+        }).wait();
+    }
+
+    /**
+     * @brief parallelFor using ParallelFor::grain.
+     */
+    template< typename Func > void parallelFor( uint32_t begin, uint32_t end, Func&& func )
+    {
+        parallelFor( begin, end, 0, std::forward< Func >( func ) );
+    }
+
+}
+
+#endif /* parallel_for_hpp */
@@ -17,70 +17,39 @@ namespace kege{
 
 
 
-    void TaskManagerSystem::addTask( const std::function< void() >& task, Task::Status* status, Task::Type type )
+    // every task type runs on the job workers, the type only stays in the signature for existing callers
+    void TaskManagerSystem::addTask( const std::function< void() >& task, Task::Status* status, Task::Type )
     {
-        taskManager( type )->addTask( task, status );
-    }
-
-    void TaskManagerSystem::addTaskManager( Task::Type type )
-    {
-        if( getTaskManager( type ) == nullptr )
+        if ( !task )
         {
-            createTaskManager( type );
+            return;
         }
-    }
 
-    bool TaskManagerSystem::initialize()
-    {
-        if ( _task_managers.empty() )
+        if ( status == nullptr )
         {
-            addTaskManager( Task::Type::General );
+            JobSystem::instance().schedule( task );
+            return;
         }
-        return true;
-    }
 
-    void TaskManagerSystem::shutdown()
-    {
-        for ( int i=0; i<_task_managers.size(); ++i )
+        status->state.store( Task::Status::Pending, std::memory_order_release );
+        JobSystem::instance().schedule( [ task, status ]()
         {
-            _task_managers[ i ]->shutdown();
-            _task_managers[ i ].clear();
-        }
-        _task_managers.clear();
+            status->state.store( Task::Status::Executing, std::memory_order_release );
+            task();
+            status->endTask();
+        });
     }
 
-    TaskManager* TaskManagerSystem::createTaskManager( Task::Type type )
-    {
-        TaskManager* manager = getTaskManager( type );
-        if ( manager == nullptr )
-        {
-            manager = new TaskManager( type );
-            _task_managers.push_back( manager );
-        }
-        //manager->addNewTaskExecutor();
-        return manager;
-    }
-
-    TaskManager* TaskManagerSystem::getTaskManager( Task::Type type )
+    bool TaskManagerSystem::initialize()
     {
-        for ( int i=0; i<_task_managers.size(); ++i )
-        {
-            if ( _task_managers[ i ]->type() == type )
-            {
-                return _task_managers[ i ].ref();
-            }
-        }
-        return nullptr;
+        JobSystem::instance();
+        return true;
     }
 
-    TaskManager* TaskManagerSystem::taskManager( Task::Type type )
+    void TaskManagerSystem::shutdown()
     {
-        TaskManager* manager = getTaskManager( type );
-        if ( manager == nullptr )
-        {
-            manager = createTaskManager( type );
-        }
-        return manager;
+        // instance() would start the workers again only to join them, when they are already stopped
+        JobSystem::global().shutdown();
     }
 
     TaskManagerSystem::TaskManagerSystem()
@@ -92,5 +61,4 @@ namespace kege{
         shutdown();
     }
 
-    std::vector< kege::Ref< TaskManager > > TaskManagerSystem::_task_managers;
 }
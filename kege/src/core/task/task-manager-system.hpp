@@ -8,31 +8,27 @@
 #ifndef task_manager_system_hpp
 #define task_manager_system_hpp
 
-#include "task-manager.hpp"
+#include "task.hpp"
+#include "job-system.hpp"
 
 namespace kege{
 
+    /**
+     * @brief Task front end kept for existing callers. Every task runs on the JobSystem.
+     *
+     * Task::Type no longer selects a separate manager, all task types share the job workers.
+     */
     class TaskManagerSystem
     {
     public:
 
         static void addTask( const std::function< void() >& task, Task::Status* status = nullptr, Task::Type type = Task::Type::General );
-        static void addTaskManager( Task::Type type );
+
         static bool initialize();
         static void shutdown();
 
         TaskManagerSystem();
         ~TaskManagerSystem();
-
-    private:
-
-        static TaskManager* createTaskManager( Task::Type type );
-        static TaskManager* getTaskManager( Task::Type type );
-        static TaskManager* taskManager( Task::Type type );
-
-    private:
-
-        static std::vector< kege::Ref< TaskManager > > _task_managers;
     };
 
 
@@ -9,22 +9,19 @@
 
 namespace kege{
 
-    bool Task::Status::operator==( const Task::Status::State& state )
+    bool Task::Status::operator==( const Task::Status::State& state )const
     {
-        std::unique_lock< std::mutex > lock( this->mutex );
-        return this->state = state;
+        return this->state.load( std::memory_order_acquire ) == state;
     }
     
-    bool Task::Status::operator==( const Task::Status& status )
+    bool Task::Status::operator==( const Task::Status& status )const
     {
-        std::unique_lock< std::mutex > lock( this->mutex );
-        return this->state = status.state;
+        return this->state.load( std::memory_order_acquire ) == status.state.load( std::memory_order_acquire );
     }
     
     void Task::Status::endTask()
     {
-        std::unique_lock< std::mutex > lock( this->mutex );
-        this->state = Completed;
+        this->state.store( Completed, std::memory_order_release );
     }
 
 }
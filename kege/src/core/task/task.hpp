@@ -18,7 +18,7 @@
 
 namespace kege{
 
-    class TaskExecutor;
+    class TaskManagerSystem;
 
     struct Task
     {
@@ -29,16 +29,15 @@ namespace kege{
         public:
 
             enum State{ Idle, Pending, Executing, Completed };
-            bool operator==( const Task::Status::State& state );
-            bool operator==( const Task::Status& status );
+            bool operator==( const Task::Status::State& state )const;
+            bool operator==( const Task::Status& status )const;
             void endTask();
             Status(): state( State::Idle ) {}
 
         private:
 
-            friend TaskExecutor;
-            std::mutex mutex;
-            State state;
+            friend TaskManagerSystem;
+            std::atomic< State > state;
         };
 
         // Optional: Constructor to initialize the task.
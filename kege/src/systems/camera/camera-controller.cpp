@@ -85,6 +85,8 @@ namespace kege{
     :   kege::EntitySystem( engine, "camera-control-system", REQUIRE_UPDATE )
     {
         _signature = createEntitySignature< kege::Camera, kege::CameraControls >();
+        _reads = createEntitySignature< kege::Camera >();
+        _writes = createEntitySignature< kege::CameraControls, kege::Rigidbody, kege::Transform >();
     }
 
     KEGE_REGISTER_SYSTEM( CameraControlSystem, "camera-controller" );
@@ -41,6 +41,8 @@ namespace kege{
     :   kege::EntitySystem( engine, "follow-system", REQUIRE_UPDATE )
     {
         _signature = createEntitySignature< Follow, Transform >();
+        _reads = createEntitySignature< Follow >();
+        _writes = createEntitySignature< Transform >();
     }
 
     KEGE_REGISTER_SYSTEM( FollowSystem, "follow" );
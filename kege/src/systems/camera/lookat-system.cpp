@@ -44,6 +44,8 @@ namespace kege{
     :   kege::EntitySystem( engine, "lookat-system", REQUIRE_UPDATE )
     {
         _signature = createEntitySignature< LookAt, Transform >();
+        _reads = createEntitySignature< LookAt >();
+        _writes = createEntitySignature< Transform >();
     }
 
     KEGE_REGISTER_SYSTEM( LookAtSystem, "lookat" );
@@ -59,15 +59,10 @@ namespace kege{
         encoder->bindGraphicsPipeline( pipeline );
         encoder->bindDescriptorSets( camera_descriptor );
 
-        for (kege::Entity entity : *_entities )
+        kege::EntityViewT< const kege::Ref< kege::Mesh >, const Transform >( _entities ).each([ context, encoder ]( const kege::Ref< kege::Mesh >& mesh, const Transform& transform )
         {
-            kege::Ref< kege::Mesh >* mesh = entity.get< kege::Ref< kege::Mesh > >();
-            Transform* transform = entity.get< Transform >();
-
-            if ( mesh == nullptr ) continue;
-
-            kege::Ref< kege::Mesh > resmesh = *mesh;//assets->get< kege::Ref< kege::Mesh > >( mesh->resource );
-            if ( resmesh == nullptr ) continue;;
+            kege::Ref< kege::Mesh > resmesh = mesh;//assets->get< kege::Ref< kege::Mesh > >( mesh->resource );
+            if ( resmesh == nullptr ) return;
 
             if( !resmesh->vertex_buffer )
             {
@@ -78,14 +73,14 @@ namespace kege{
             encoder->bindIndexBuffer( resmesh->index_buffer, 0, false );
 
             ModelMatrices model;
-            model(transform->position, transform->orientation, transform->scale);
+            model(transform.position, transform.orientation, transform.scale);
             encoder->setPushConstants(ShaderStage::Vertex, 0, sizeof( model ), &model );
 
             for (int i=0; i<resmesh->primatives.size(); ++i)
             {
                 resmesh->primatives[i]->draw( encoder );
             }
-        }
+        });
         
     }
 
@@ -6,33 +6,43 @@
 //
 
 #include "air-resistance.hpp"
+#include "../../../core/math/algebra/lanes.hpp"
 
 namespace kege{
 
-    void AirResistance::update( double dms, Particle& particle )
-    {
-        if ( particle.invmass <= 0.0f ) return; // Skip immovable particles
+    using namespace kege::simd;
 
-        // Calculate drag force magnitude
-        float speed = kege::magn( particle.velocity );
-        if (speed <= 0.0001f) return; // Avoid division by zero
+    void AirResistance::update( double dms, ParticleBuffer& s, uint32_t first, uint32_t last )
+    {
+        const lanes zero = splat( 0.f );
+        const lanes h = splat( float( dms ) );
+        const lanes k = splat( ( use_quadratic_drag ) ? 0.5f * fluid_density * coefficient : coefficient );
 
-        kege::vec3 drag_force;
-        if ( this->use_quadratic_drag )
-        {
-            // Quadratic drag (realistic): F = -0.5 * ρ * v² * C_d * A * v̂
-            float area = particle.size *particle.size;
-            float forceMagnitude = 0.5f * this->fluid_density * speed * speed * this->coefficient * area;
-            drag_force = -kege::normalize(particle.velocity) * forceMagnitude;
-        }
-        else
+        for ( uint32_t i = first; i < last; i += WIDTH )
         {
-            // Linear drag (game-friendly): F = -k * v
-            drag_force = -particle.velocity * this->coefficient;
-        }
+            const lanes vx = load( s[ ParticleBuffer::VELOCITY_X ] + i );
+            const lanes vy = load( s[ ParticleBuffer::VELOCITY_Y ] + i );
+            const lanes vz = load( s[ ParticleBuffer::VELOCITY_Z ] + i );
+
+            /*
+             Quadratic drag (realistic): F = -0.5 * ρ * v² * C_d * A * v̂, which is -0.5 * ρ * |v| * C_d * A * v.
+             Linear drag (game-friendly): F = -k * v. immovable particles have no inverse mass
+             and get no change. a velocity of zero gets a zero force, no need to skip it.
+             */
+            lanes drag = k;
+            if ( use_quadratic_drag )
+            {
+                const lanes size = load( s[ ParticleBuffer::SIZE ] + i );
+                const lanes speed = root( add( add( mul( vx, vx ), mul( vy, vy ) ), mul( vz, vz ) ) );
+                drag = mul( drag, mul( speed, mul( size, size ) ) );
+            }
 
-        // Apply force to velocity (F = ma → a = F * inverseMass)
-        particle.velocity += drag_force * static_cast<float>( dms ) * particle.invmass;
+            // Apply force to velocity (F = ma → a = F * inverseMass)
+            drag = mul( mul( drag, h ), maximum( load( s[ ParticleBuffer::INVMASS ] + i ), zero ) );
+            store( s[ ParticleBuffer::VELOCITY_X ] + i, sub( vx, mul( vx, drag ) ) );
+            store( s[ ParticleBuffer::VELOCITY_Y ] + i, sub( vy, mul( vy, drag ) ) );
+            store( s[ ParticleBuffer::VELOCITY_Z ] + i, sub( vz, mul( vz, drag ) ) );
+        }
     }
 
     AirResistance::AirResistance
@@ -14,7 +14,7 @@ namespace kege{
 
     struct AirResistance : public Behavior
     {
-        void update( double dms, Particle& particle );
+        void update( double dms, ParticleBuffer& particles, uint32_t first, uint32_t last ) override;
         AirResistance
         (
             float coefficient = 0.47f, // Drag coefficient (default for a sphere)
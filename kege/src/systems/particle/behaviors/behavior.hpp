@@ -10,7 +10,7 @@
 
 #include <vector>
 #include "../../../core/utils/array.hpp"
-#include "../effect/particle.hpp"
+#include "../effect/particle-buffer.hpp"
 
 namespace kege{
 
@@ -18,7 +18,14 @@ namespace kege{
     {
     public:
 
-        virtual void update( double dms, Particle& particle ) = 0;
+        /**
+         * @brief Applies the behavior to the particles in [first, last) of the buffer.
+         *
+         * `first` and `last` are multiples of ParticleBuffer::LANES, `last` may run past the
+         * particle count into the padding. Different ranges of a buffer are updated on several
+         * threads at once, and effects may share a behavior, so update() must not change it.
+         */
+        virtual void update( double dms, ParticleBuffer& particles, uint32_t first, uint32_t last ) = 0;
         virtual ~Behavior(){}
     };
 
@@ -6,12 +6,16 @@
 //
 
 #include "color-over-lifetime.hpp"
+#include "../../../core/math/algebra/lanes.hpp"
 
 namespace kege{
 
+    using namespace kege::simd;
+
     void Gradient::addKey( float t, const vec4& color)
     {
         _keys.push_back({ t, color });
+        buildRamps();
     }
     vec4 Gradient::evaluate(float t) const
     {
@@ -44,14 +48,66 @@ namespace kege{
         std::sort(_keys.begin(), _keys.end(), [](const GradientKey& key1, const GradientKey& key2) -> bool {
             return key1.t < key2.t;
         });
+        buildRamps();
+    }
+
+    const std::vector< GradientKey >& Gradient::keys()const
+    {
+        return _keys;
     }
 
-    void ColorOverLifetime::update( double dms, Particle& particle )
+    const std::vector< GradientRamp >& Gradient::ramps()const
     {
-        if ( gradient.size() == 0) return;
+        return _ramps;
+    }
+
+    void Gradient::buildRamps()
+    {
+        _ramps.clear();
+        for ( size_t k = 1; k < _keys.size(); ++k )
+        {
+            const GradientKey& a = _keys[ k - 1 ];
+            const GradientKey& b = _keys[ k ];
+            _ramps.push_back({ a.t, 1.f / kege::max( b.t - a.t, 1e-6f ), b.color - a.color });
+        }
+    }
+
+    void ColorOverLifetime::update( double dms, ParticleBuffer& s, uint32_t first, uint32_t last )
+    {
+        // without keys there is no color to give, and no ramps to build one from
+        if ( gradient.size() == 0 ) return;
+
+        /*
+         the gradient is the first color plus, for every pair of keys, their difference times a
+         ramp that climbs from 0 to 1 between them. this is evaluate() without a search, the same
+         for every lane. keys at the same time make a ramp that is close to a step. the ramps are
+         built when the keys change, not per batch.
+         */
+        const std::vector< GradientRamp >& ramps = gradient.ramps();
+        const lanes zero = splat( 0.f );
+        const lanes one = splat( 1.f );
+        const vec4 origin = gradient.keys().front().color;
 
-        float t = particle.health / particle.max_health;
-        particle.color = gradient.evaluate( t );
+        for ( uint32_t i = first; i < last; i += WIDTH )
+        {
+            const lanes t = divide( load( s[ ParticleBuffer::HEALTH ] + i ), load( s[ ParticleBuffer::MAX_HEALTH ] + i ) );
+            lanes r = splat( origin.x );
+            lanes g = splat( origin.y );
+            lanes b = splat( origin.z );
+            lanes a = splat( origin.w );
+            for ( const GradientRamp& ramp : ramps )
+            {
+                const lanes weight = maximum( minimum( mul( sub( t, splat( ramp.start ) ), splat( ramp.scale ) ), one ), zero );
+                r = add( r, mul( weight, splat( ramp.delta.x ) ) );
+                g = add( g, mul( weight, splat( ramp.delta.y ) ) );
+                b = add( b, mul( weight, splat( ramp.delta.z ) ) );
+                a = add( a, mul( weight, splat( ramp.delta.w ) ) );
+            }
+            store( s[ ParticleBuffer::COLOR_R ] + i, r );
+            store( s[ ParticleBuffer::COLOR_G ] + i, g );
+            store( s[ ParticleBuffer::COLOR_B ] + i, b );
+            store( s[ ParticleBuffer::COLOR_A ] + i, a );
+        }
     }
 
     ColorOverLifetime::ColorOverLifetime( const Gradient& gradient )
@@ -17,6 +17,17 @@ namespace kege{
         float t; // Time (0 to 1)
         vec4 color; // RGBA
     };
+
+    /**
+     * @brief The change of color between two neighbouring keys, climbing from 0 to 1 over their time span.
+     */
+    struct GradientRamp
+    {
+        float start;
+        float scale;
+        vec4 delta;
+    };
+
     class Gradient {
     public:
 
@@ -25,16 +36,31 @@ namespace kege{
         size_t size()const;
         void sortKeys();
 
+        /**
+         * @brief Gets the keys, in the order they were added or sorted to.
+         */
+        const std::vector< GradientKey >& keys()const;
+
+        /**
+         * @brief Gets a ramp per pair of neighbouring keys, rebuilt whenever the keys change.
+         */
+        const std::vector< GradientRamp >& ramps()const;
+
         //Gradient();
         Gradient() = default;
 
+    private:
+
+        void buildRamps();
+
     private:
 
         std::vector< GradientKey > _keys;
+        std::vector< GradientRamp > _ramps;
     };
     struct ColorOverLifetime : public Behavior
     {
-        void update( double dms, Particle& particle );
+        void update( double dms, ParticleBuffer& particles, uint32_t first, uint32_t last ) override;
         ColorOverLifetime( const Gradient& colors );
         Gradient gradient;
     };
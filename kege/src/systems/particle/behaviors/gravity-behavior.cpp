@@ -6,12 +6,25 @@
 //
 
 #include "gravity-behavior.hpp"
+#include "../../../core/math/algebra/lanes.hpp"
 
 namespace kege{
 
-    void DirectionalGravity::update( double dms, Particle& particle )
+    using namespace kege::simd;
+
+    void DirectionalGravity::update( double dms, ParticleBuffer& s, uint32_t first, uint32_t last )
     {
-        particle.velocity -= force * particle.invmass;;
+        const lanes fx = splat( force.x );
+        const lanes fy = splat( force.y );
+        const lanes fz = splat( force.z );
+
+        for ( uint32_t i = first; i < last; i += WIDTH )
+        {
+            const lanes invmass = load( s[ ParticleBuffer::INVMASS ] + i );
+            store( s[ ParticleBuffer::VELOCITY_X ] + i, sub( load( s[ ParticleBuffer::VELOCITY_X ] + i ), mul( fx, invmass ) ) );
+            store( s[ ParticleBuffer::VELOCITY_Y ] + i, sub( load( s[ ParticleBuffer::VELOCITY_Y ] + i ), mul( fy, invmass ) ) );
+            store( s[ ParticleBuffer::VELOCITY_Z ] + i, sub( load( s[ ParticleBuffer::VELOCITY_Z ] + i ), mul( fz, invmass ) ) );
+        }
     }
     DirectionalGravity::DirectionalGravity(const kege::vec3& force)
     :   force( force )
@@ -20,32 +33,40 @@ namespace kege{
 
 
 
-    void CenterOfMassGravity::update( double dms, Particle& particle )
+    void CenterOfMassGravity::update( double dms, ParticleBuffer& s, uint32_t first, uint32_t last )
     {
-        // Direction from particle to center of mass
-        kege::vec3 dir = -particle.position;
-        float distance = kege::magn(dir);
+        const lanes zero = splat( 0.f );
+        const lanes h = splat( float( dms ) );
+        const lanes g = splat( strength );
+        const lanes epsilon = splat( 0.001f ); // avoids div/0 in the inverse-square law
 
-        // Normalize direction (skip if distance is zero)
-        if (distance > 0.0f) dir /= distance;
+        for ( uint32_t i = first; i < last; i += WIDTH )
+        {
+            // Direction from particle to center of mass
+            lanes dx = sub( zero, load( s[ ParticleBuffer::POSITION_X ] + i ) );
+            lanes dy = sub( zero, load( s[ ParticleBuffer::POSITION_Y ] + i ) );
+            lanes dz = sub( zero, load( s[ ParticleBuffer::POSITION_Z ] + i ) );
+            const lanes distance2 = add( add( mul( dx, dx ), mul( dy, dy ) ), mul( dz, dz ) );
+            const lanes distance = root( distance2 );
 
-        // Calculate force magnitude
-        float force_magnitude = strength;
+            // Normalize direction (skip if distance is zero)
+            const lanes away = greater( distance, zero );
+            dx = choose( away, divide( dx, distance ), dx );
+            dy = choose( away, divide( dy, distance ), dy );
+            dz = choose( away, divide( dz, distance ), dz );
 
-        if (falloff)
-        {
             // Inverse-square law: F ~ 1/r² (realistic gravity)
-            force_magnitude /= (distance * distance + 0.001f); // +epsilon to avoid div/0
-        }
+            lanes force_magnitude = ( falloff ) ? divide( g, add( distance2, epsilon ) ) : g;
 
-        // Adjust for particle mass (F = ma, but particle stores 1/mass for stability)
-        if (particle.invmass > 0.0f)
-        {
-            force_magnitude /= particle.invmass; // Equivalent to F *= m
-        }
+            // Adjust for particle mass (F = ma, but particle stores 1/mass for stability)
+            const lanes invmass = load( s[ ParticleBuffer::INVMASS ] + i );
+            force_magnitude = mul( choose( greater( invmass, zero ), divide( force_magnitude, invmass ), force_magnitude ), h );
 
-        // Apply force to particle velocity (Euler integration)
-        particle.velocity += dir * force_magnitude * static_cast<float>(dms);
+            // Apply force to particle velocity (Euler integration)
+            store( s[ ParticleBuffer::VELOCITY_X ] + i, add( load( s[ ParticleBuffer::VELOCITY_X ] + i ), mul( dx, force_magnitude ) ) );
+            store( s[ ParticleBuffer::VELOCITY_Y ] + i, add( load( s[ ParticleBuffer::VELOCITY_Y ] + i ), mul( dy, force_magnitude ) ) );
+            store( s[ ParticleBuffer::VELOCITY_Z ] + i, add( load( s[ ParticleBuffer::VELOCITY_Z ] + i ), mul( dz, force_magnitude ) ) );
+        }
     }
 
     CenterOfMassGravity::CenterOfMassGravity
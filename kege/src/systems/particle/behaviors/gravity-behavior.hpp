@@ -14,14 +14,14 @@ namespace kege{
 
     struct DirectionalGravity : public Behavior
     {
-        void update( double dms, Particle& particle ) override;
+        void update( double dms, ParticleBuffer& particles, uint32_t first, uint32_t last ) override;
         DirectionalGravity( const kege::vec3& force );
         kege::vec3 force;
     };
 
     struct CenterOfMassGravity : public Behavior
     {
-        void update( double dms, Particle& particle ) override;
+        void update( double dms, ParticleBuffer& particles, uint32_t first, uint32_t last ) override;
 
         CenterOfMassGravity
         (
@@ -6,30 +6,37 @@
 //
 
 #include "size-over-lifetime.hpp"
+#include "../../../core/math/algebra/lanes.hpp"
+
 namespace kege{
 
-    void SizeOverLifetime::update( double dms, Particle& particle )
+    using namespace kege::simd;
+
+    void SizeOverLifetime::update( double dms, ParticleBuffer& s, uint32_t first, uint32_t last )
     {
         if ( curve.size() == 0) return;
 
-        float t = particle.health / particle.max_health;
+        /*
+         the values of the curve are spread evenly over the lifetime. the size is the first value
+         plus the difference of every pair of neighbours times how far t has come between them,
+         clamped to [0, 1], which is the linear interpolation of the pair t falls in.
+         */
+        const lanes zero = splat( 0.f );
+        const lanes one = splat( 1.f );
+        const lanes segments = splat( float( curve.size() - 1 ) );
 
-        if (t <= 0.0f)
+        for ( uint32_t i = first; i < last; i += WIDTH )
         {
-            particle.size = curve[0];
-            return;
+            const lanes t = divide( load( s[ ParticleBuffer::HEALTH ] + i ), load( s[ ParticleBuffer::MAX_HEALTH ] + i ) );
+            const lanes x = mul( t, segments );
+            lanes size = splat( curve[ 0 ] );
+            for ( size_t k = 1; k < curve.size(); ++k )
+            {
+                const lanes weight = maximum( minimum( sub( x, splat( float( k - 1 ) ) ), one ), zero );
+                size = add( size, mul( weight, splat( curve[ k ] - curve[ k - 1 ] ) ) );
+            }
+            store( s[ ParticleBuffer::SIZE ] + i, size );
         }
-
-        if (t >= 1.0f)
-        {
-            particle.size = curve[ curve.size() - 1 ];
-            return;
-        }
-
-        int min = int( curve.size() - 1 ) * t;
-        int max = min + 1;
-
-        particle.size = lerp( curve[ min ], curve[ max ], t );
     }
 
     SizeOverLifetime::SizeOverLifetime( const array< float >& curve )
@@ -14,7 +14,7 @@ namespace kege{
 
     struct SizeOverLifetime : public Behavior
     {
-        void update( double dms, Particle& particle );
+        void update( double dms, ParticleBuffer& particles, uint32_t first, uint32_t last ) override;
         SizeOverLifetime( const array< float >& curve );
         array< float > curve;
     };
@@ -6,31 +6,40 @@
 //
 
 #include "velocity-over-lifetime.hpp"
+#include "../../../core/math/algebra/lanes.hpp"
 
 namespace kege{
 
-    void VelocityOverLifetime::update( double dms, Particle& particle )
+    using namespace kege::simd;
+
+    void VelocityOverLifetime::update( double dms, ParticleBuffer& s, uint32_t first, uint32_t last )
     {
         if ( velocities.size() == 0) return;
 
-        float t = particle.health / particle.max_health;
-
-        if (t <= 0.0f)
-        {
-            particle.velocity += velocities[0];
-            return;
-        }
+        // the velocities are spread evenly over the lifetime, interpolated the way SizeOverLifetime is
+        const lanes zero = splat( 0.f );
+        const lanes one = splat( 1.f );
+        const lanes segments = splat( float( velocities.size() - 1 ) );
 
-        if (t >= 1.0f)
+        for ( uint32_t i = first; i < last; i += WIDTH )
         {
-            particle.velocity += velocities[ velocities.size() - 1 ];
-            return;
+            const lanes t = divide( load( s[ ParticleBuffer::HEALTH ] + i ), load( s[ ParticleBuffer::MAX_HEALTH ] + i ) );
+            const lanes x = mul( t, segments );
+            lanes vx = splat( velocities[ 0 ].x );
+            lanes vy = splat( velocities[ 0 ].y );
+            lanes vz = splat( velocities[ 0 ].z );
+            for ( size_t k = 1; k < velocities.size(); ++k )
+            {
+                const lanes weight = maximum( minimum( sub( x, splat( float( k - 1 ) ) ), one ), zero );
+                const vec3 delta = velocities[ k ] - velocities[ k - 1 ];
+                vx = add( vx, mul( weight, splat( delta.x ) ) );
+                vy = add( vy, mul( weight, splat( delta.y ) ) );
+                vz = add( vz, mul( weight, splat( delta.z ) ) );
+            }
+            store( s[ ParticleBuffer::VELOCITY_X ] + i, add( load( s[ ParticleBuffer::VELOCITY_X ] + i ), vx ) );
+            store( s[ ParticleBuffer::VELOCITY_Y ] + i, add( load( s[ ParticleBuffer::VELOCITY_Y ] + i ), vy ) );
+            store( s[ ParticleBuffer::VELOCITY_Z ] + i, add( load( s[ ParticleBuffer::VELOCITY_Z ] + i ), vz ) );
         }
-
-        int min = int( velocities.size() - 1 ) * t;
-        int max = min + 1;
-
-        particle.velocity += lerp( velocities[ min ], velocities[ max ], t );
     }
 
     VelocityOverLifetime::VelocityOverLifetime( const array< vec3 >& velocities )
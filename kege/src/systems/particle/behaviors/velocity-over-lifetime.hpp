@@ -14,7 +14,7 @@ namespace kege{
 
     struct VelocityOverLifetime : public Behavior
     {
-        void update( double dms, Particle& particle );
+        void update( double dms, ParticleBuffer& particles, uint32_t first, uint32_t last ) override;
         VelocityOverLifetime( const array< vec3 >& velocities );
         array< vec3 > velocities;
     };
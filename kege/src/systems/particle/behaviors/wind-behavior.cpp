@@ -6,42 +6,54 @@
 //
 
 #include "wind-behavior.hpp"
+#include "../../../core/math/algebra/lanes.hpp"
 
 namespace kege{
 
-    void WindBehavior::update( double dms, Particle& particle )
-    {
-        if (particle.invmass <= 0.0f) return; // Skip immovable particles
-
-        // Calculate wind origin (use windZone.transform if provided, else assume global wind)
-        kege::vec3 windOrigin( 0.0f );
-
-        // 1. Apply distance falloff (if falloffRadius > 0)
-        float distance = kege::magn(particle.position - windOrigin);
-        float falloff = 1.0f;
-        if (falloffRadius > 0.0f)
-        {
-            falloff = 1.0f - kege::clamp(distance / falloffRadius, 0.0f, 1.0f);
-            if (falloff <= 0.0f) return; // Outside influence zone
-        }
+    using namespace kege::simd;
 
-        // 2. Calculate base wind force
+    void WindBehavior::update( double dms, ParticleBuffer& s, uint32_t first, uint32_t last )
+    {
+        // 1. Calculate base wind force, the same for every particle
         kege::vec3 windForce = kege::normalize(direction) * strength;
 
-        // 3. Add turbulence (Perlin noise for smooth randomness)
+        // 2. Add turbulence (Perlin noise for smooth randomness)
         if (turbulence > 0.0f)
         {
-            time += static_cast<float>( dms ) * frequency;
+            /*
+             time is the phase the noise would be sampled at. it is not advanced here, update()
+             runs on many threads and for every effect sharing this behavior.
+             */
             ///kege::vec3 noiseInput = particle.position * 0.1f + kege::vec3(time);
             float noise = 1.0f;//PerlinNoise3D(noiseInput.x, noiseInput.y, noiseInput.z);
             windForce += turbulence * noise * kege::vec3(1.0f, 0.5f, 1.0f); // Anisotropic
         }
+        windForce *= static_cast<float>( dms );
+
+        const lanes zero = splat( 0.f );
+        const lanes one = splat( 1.f );
+        const lanes wx = splat( windForce.x );
+        const lanes wy = splat( windForce.y );
+        const lanes wz = splat( windForce.z );
+        const lanes reach = splat( ( falloffRadius > 0.0f ) ? 1.0f / falloffRadius : 0.0f );
 
-        // 4. Apply falloff and inverse mass
-        windForce *= falloff * particle.invmass;
+        for ( uint32_t i = first; i < last; i += WIDTH )
+        {
+            // 3. Apply distance falloff from the wind origin (if falloffRadius > 0), 0 outside the influence zone
+            const lanes px = load( s[ ParticleBuffer::POSITION_X ] + i );
+            const lanes py = load( s[ ParticleBuffer::POSITION_Y ] + i );
+            const lanes pz = load( s[ ParticleBuffer::POSITION_Z ] + i );
+            const lanes distance = root( add( add( mul( px, px ), mul( py, py ) ), mul( pz, pz ) ) );
+            const lanes falloff = sub( one, minimum( mul( distance, reach ), one ) );
 
-        // 5. Update particle velocity
-        particle.velocity += windForce * static_cast<float>( dms );
+            // 4. Apply falloff and inverse mass, immovable particles get no change
+            const lanes scale = mul( falloff, maximum( load( s[ ParticleBuffer::INVMASS ] + i ), zero ) );
+
+            // 5. Update particle velocity
+            store( s[ ParticleBuffer::VELOCITY_X ] + i, add( load( s[ ParticleBuffer::VELOCITY_X ] + i ), mul( wx, scale ) ) );
+            store( s[ ParticleBuffer::VELOCITY_Y ] + i, add( load( s[ ParticleBuffer::VELOCITY_Y ] + i ), mul( wy, scale ) ) );
+            store( s[ ParticleBuffer::VELOCITY_Z ] + i, add( load( s[ ParticleBuffer::VELOCITY_Z ] + i ), mul( wz, scale ) ) );
+        }
     }
 
     WindBehavior::WindBehavior
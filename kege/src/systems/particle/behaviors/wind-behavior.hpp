@@ -16,7 +16,7 @@ namespace kege{
     {
     public:
 
-        void update( double dms, Particle& particle );
+        void update( double dms, ParticleBuffer& particles, uint32_t first, uint32_t last ) override;
         WindBehavior
         (
             kege::vec3 direction = kege::vec3(1.0f, 0.0f, 0.0f), // Normalized wind direction
@@ -0,0 +1,244 @@
+//
+//  particle-buffer.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#include <cstring>
+#include <utility>
+#include <algorithm>
+#include "particle-buffer.hpp"
+#include "../../../core/task/parallel-for.hpp"
+
+namespace kege{
+
+    Particle ParticleBuffer::get( uint32_t i )const
+    {
+        const ParticleBuffer& s = *this;
+        Particle particle;
+        particle.position   = vec3( s[ POSITION_X ][ i ], s[ POSITION_Y ][ i ], s[ POSITION_Z ][ i ] );
+        particle.velocity   = vec3( s[ VELOCITY_X ][ i ], s[ VELOCITY_Y ][ i ], s[ VELOCITY_Z ][ i ] );
+        particle.color      = vec4( s[ COLOR_R ][ i ], s[ COLOR_G ][ i ], s[ COLOR_B ][ i ], s[ COLOR_A ][ i ] );
+        particle.sprite     = vec4( s[ SPRITE_X ][ i ], s[ SPRITE_Y ][ i ], s[ SPRITE_Z ][ i ], s[ SPRITE_W ][ i ] );
+        particle.size       = s[ SIZE ][ i ];
+        particle.rotation   = s[ ROTATION ][ i ];
+        particle.invmass    = s[ INVMASS ][ i ];
+        particle.max_health = s[ MAX_HEALTH ][ i ];
+        particle.health     = s[ HEALTH ][ i ];
+        return particle;
+    }
+
+    void ParticleBuffer::set( uint32_t i, const Particle& particle )
+    {
+        ParticleBuffer& s = *this;
+        s[ POSITION_X ][ i ] = particle.position.x;
+        s[ POSITION_Y ][ i ] = particle.position.y;
+        s[ POSITION_Z ][ i ] = particle.position.z;
+        s[ VELOCITY_X ][ i ] = particle.velocity.x;
+        s[ VELOCITY_Y ][ i ] = particle.velocity.y;
+        s[ VELOCITY_Z ][ i ] = particle.velocity.z;
+        s[ COLOR_R ][ i ] = particle.color.x;
+        s[ COLOR_G ][ i ] = particle.color.y;
+        s[ COLOR_B ][ i ] = particle.color.z;
+        s[ COLOR_A ][ i ] = particle.color.w;
+        s[ SPRITE_X ][ i ] = particle.sprite.x;
+        s[ SPRITE_Y ][ i ] = particle.sprite.y;
+        s[ SPRITE_Z ][ i ] = particle.sprite.z;
+        s[ SPRITE_W ][ i ] = particle.sprite.w;
+        s[ SIZE ][ i ] = particle.size;
+        s[ ROTATION ][ i ] = particle.rotation;
+        s[ INVMASS ][ i ] = particle.invmass;
+        s[ MAX_HEALTH ][ i ] = particle.max_health;
+        s[ HEALTH ][ i ] = particle.health;
+    }
+
+    uint32_t ParticleBuffer::removeExpired( uint32_t grain )
+    {
+        /*
+         a parallel stream compaction in place. with `alive` particles surviving, every expired
+         particle before `alive` is a hole and every surviving particle from `alive` on has to
+         move. both are counted per batch, a prefix sum over the batches gives the k-th hole and
+         the k-th mover, and the k-th mover fills the k-th hole. holes and movers never overlap,
+         so the moves can run in any order.
+         */
+        if ( particle_count == 0 ) return 0;
+        if ( grain == 0 ) grain = COMPACTION_GRAIN;
+
+        const float* health = ( *this )[ HEALTH ];
+        const uint32_t count = particle_count;
+        const uint32_t batches = ( count + grain - 1 ) / grain;
+
+        std::vector< uint32_t > survivors( batches );
+        kege::parallelFor( 0, batches, 1, [ &survivors, health, count, grain ]( uint32_t first, uint32_t last )
+        {
+            for ( uint32_t b = first; b < last; ++b )
+            {
+                uint32_t n = 0;
+                for ( uint32_t i = b * grain, end = std::min( i + grain, count ); i < end; ++i )
+                {
+                    n += ( health[ i ] > 0.f );
+                }
+                survivors[ b ] = n;
+            }
+        });
+
+        uint32_t alive = 0;
+        for ( uint32_t n : survivors ) alive += n;
+        if ( alive == count ) return 0;
+
+        /*
+         the first hole and first mover of every batch. a batch that holds `alive` has both, the
+         holes before it and the movers after it.
+         */
+        std::vector< uint32_t > holes( batches + 1 );
+        std::vector< uint32_t > movers( batches + 1 );
+        for ( uint32_t b = 0; b < batches; ++b )
+        {
+            const uint32_t start = b * grain;
+            const uint32_t end = std::min( start + grain, count );
+            uint32_t front = 0, back = 0;
+            if ( end <= alive )
+            {
+                front = ( end - start ) - survivors[ b ];
+            }
+            else if ( alive <= start )
+            {
+                back = survivors[ b ];
+            }
+            else
+            {
+                for ( uint32_t i = start; i < end; ++i )
+                {
+                    if ( i < alive ) front += !( health[ i ] > 0.f );
+                    else back += ( health[ i ] > 0.f );
+                }
+            }
+            holes[ b + 1 ] = holes[ b ] + front;
+            movers[ b + 1 ] = movers[ b ] + back;
+        }
+
+        // where the k-th mover is
+        std::vector< uint32_t > sources( count - alive );
+        kege::parallelFor( alive / grain, batches, 1, [ &sources, &movers, health, count, alive, grain ]( uint32_t first, uint32_t last )
+        {
+            for ( uint32_t b = first; b < last; ++b )
+            {
+                uint32_t k = movers[ b ];
+                for ( uint32_t i = std::max( b * grain, alive ), end = std::min( b * grain + grain, count ); i < end; ++i )
+                {
+                    if ( health[ i ] > 0.f ) sources[ k++ ] = i;
+                }
+            }
+        });
+
+        ParticleBuffer& s = *this;
+        kege::parallelFor( 0, ( alive + grain - 1 ) / grain, 1, [ &s, &sources, &holes, health, alive, grain ]( uint32_t first, uint32_t last )
+        {
+            for ( uint32_t b = first; b < last; ++b )
+            {
+                uint32_t k = holes[ b ];
+                for ( uint32_t i = b * grain, end = std::min( i + grain, alive ); i < end; ++i )
+                {
+                    if ( health[ i ] > 0.f ) continue;
+
+                    const uint32_t source = sources[ k++ ];
+                    for ( uint32_t stream = 0; stream < MAX_STREAMS; ++stream )
+                    {
+                        float* values = s[ Stream( stream ) ];
+                        values[ i ] = values[ source ];
+                    }
+                }
+            }
+        });
+
+        particle_count = alive;
+        return count - alive;
+    }
+
+    void ParticleBuffer::reserve( uint32_t capacity )
+    {
+        const uint32_t stride = ( capacity + LANES - 1 ) / LANES * LANES;
+        const uint32_t count = std::min( particle_count, capacity );
+
+        /*
+         one block for every stream, over-allocated by a lane so the base can be moved up to a
+         32 byte boundary. the stride is a multiple of 8 floats, every stream stays aligned.
+         */
+        std::vector< float > storage( size_t( stride ) * MAX_STREAMS + LANES, 0.f );
+        const uintptr_t address = reinterpret_cast< uintptr_t >( storage.data() );
+        float* base = storage.data() + ( ( 32 - address % 32 ) % 32 ) / sizeof( float );
+
+        // a max health of 1 keeps the lifetime kernels free of NaNs in the unused lanes
+        std::fill( base + size_t( MAX_HEALTH ) * stride, base + size_t( MAX_HEALTH + 1 ) * stride, 1.f );
+
+        for ( uint32_t stream = 0; stream < MAX_STREAMS && count != 0; ++stream )
+        {
+            std::memcpy( base + size_t( stream ) * stride, _base + size_t( stream ) * _stride, count * sizeof( float ) );
+        }
+
+        _storage.swap( storage );
+        _base = base;
+        _capacity = capacity;
+        _stride = stride;
+        particle_count = count;
+    }
+
+    ParticleBuffer& ParticleBuffer::operator =( const ParticleBuffer& other )
+    {
+        if ( this != &other )
+        {
+            /*
+             the copied storage would keep the offset of the other buffer's alignment, which need
+             not be the offset this allocation needs. the streams are copied one by one instead.
+             */
+            particle_count = 0;
+            reserve( other._capacity );
+            for ( uint32_t stream = 0; stream < MAX_STREAMS && other.particle_count != 0; ++stream )
+            {
+                std::memcpy( ( *this )[ Stream( stream ) ], other[ Stream( stream ) ], other.particle_count * sizeof( float ) );
+            }
+            particle_count = other.particle_count;
+        }
+        return *this;
+    }
+
+    ParticleBuffer& ParticleBuffer::operator =( ParticleBuffer&& other ) noexcept
+    {
+        // a moved vector keeps its allocation, and with it the alignment of the base
+        _storage.swap( other._storage );
+        std::swap( _base, other._base );
+        std::swap( _capacity, other._capacity );
+        std::swap( _stride, other._stride );
+        std::swap( particle_count, other.particle_count );
+        return *this;
+    }
+
+    ParticleBuffer::ParticleBuffer( const ParticleBuffer& other )
+    :   particle_count( 0 )
+    ,   _base( nullptr )
+    ,   _capacity( 0 )
+    ,   _stride( 0 )
+    {
+        *this = other;
+    }
+
+    ParticleBuffer::ParticleBuffer( ParticleBuffer&& other ) noexcept
+    :   particle_count( 0 )
+    ,   _base( nullptr )
+    ,   _capacity( 0 )
+    ,   _stride( 0 )
+    {
+        *this = std::move( other );
+    }
+
+    ParticleBuffer::ParticleBuffer( uint32_t capacity )
+    :   particle_count( 0 )
+    ,   _base( nullptr )
+    ,   _capacity( 0 )
+    ,   _stride( 0 )
+    {
+        reserve( capacity );
+    }
+
+}
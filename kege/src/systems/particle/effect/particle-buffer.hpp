@@ -0,0 +1,127 @@
+//
+//  particle-buffer.hpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef kege_particle_buffer_hpp
+#define kege_particle_buffer_hpp
+
+#include <vector>
+#include "particle.hpp"
+
+namespace kege{
+
+    /**
+     * @brief Storage buffer for particle data, one float array per particle field.
+     *
+     * Behaviors touch a few fields of every particle. Stored this way a field of 8 neighbouring
+     * particles is one aligned 32 byte load, and a behavior runs over a whole range of particles
+     * as a vector loop instead of one virtual call per particle.
+     *
+     * Particles [0, particle_count) are alive. Every array is padded to a multiple of LANES past
+     * the capacity, kernels may run over the lanes past particle_count and their values mean nothing.
+     */
+    class ParticleBuffer
+    {
+    public:
+
+        enum Stream
+        {
+            POSITION_X, POSITION_Y, POSITION_Z,
+            VELOCITY_X, VELOCITY_Y, VELOCITY_Z,
+            COLOR_R, COLOR_G, COLOR_B, COLOR_A,
+            SPRITE_X, SPRITE_Y, SPRITE_Z, SPRITE_W,
+            SIZE,
+            ROTATION,
+            INVMASS,
+            MAX_HEALTH,
+            HEALTH,
+            MAX_STREAMS
+        };
+
+        /**
+         * the number of particles the widest kernel handles at once, the arrays are aligned and padded to it.
+         */
+        enum{ LANES = 8 };
+
+        /**
+         * the particles per batch of removeExpired(). testing a particle costs little, far smaller
+         * batches spend more time scheduling than scanning.
+         */
+        enum{ COMPACTION_GRAIN = 4096 };
+
+        /**
+         * @brief Gets particle i as one struct, for code that handles a few particles at a time.
+         */
+        Particle get( uint32_t i )const;
+
+        /**
+         * @brief Writes every field of particle i.
+         */
+        void set( uint32_t i, const Particle& particle );
+
+        /**
+         * @brief Removes the particles whose health has run out.
+         *
+         * The particles that live past the new count move into the places of the expired ones
+         * before it, so most particles stay where they are. Large buffers are scanned and moved
+         * in batches of `grain` particles on the job workers, COMPACTION_GRAIN when it is 0. The
+         * result is the same however the batches are run.
+         *
+         * @return The number of particles removed.
+         */
+        uint32_t removeExpired( uint32_t grain = 0 );
+
+        /**
+         * @brief Grows or shrinks the arrays to room for `capacity` particles, keeping the particles that fit.
+         */
+        void reserve( uint32_t capacity );
+
+        inline float* operator[]( Stream stream )
+        {
+            return _base + size_t( stream ) * _stride;
+        }
+
+        inline const float* operator[]( Stream stream )const
+        {
+            return _base + size_t( stream ) * _stride;
+        }
+
+        /**
+         * @brief Gets the number of particles the buffer has room for.
+         */
+        inline uint32_t capacity()const
+        {
+            return _capacity;
+        }
+
+        /**
+         * @brief Gets particle_count rounded up to a multiple of LANES, the end of the range kernels run over.
+         */
+        inline uint32_t paddedCount()const
+        {
+            return ( particle_count + LANES - 1 ) / LANES * LANES;
+        }
+
+        ParticleBuffer& operator =( const ParticleBuffer& other );
+        ParticleBuffer& operator =( ParticleBuffer&& other ) noexcept;
+        ParticleBuffer( const ParticleBuffer& other );
+        ParticleBuffer( ParticleBuffer&& other ) noexcept;
+        ParticleBuffer( uint32_t capacity = 0 );
+
+    public:
+
+        uint32_t particle_count; ///< Number of currently active particles (<= capacity())
+
+    private:
+
+        std::vector< float > _storage;
+        float* _base;
+        uint32_t _capacity;
+        uint32_t _stride;
+    };
+
+}
+#endif /* kege_particle_buffer_hpp */
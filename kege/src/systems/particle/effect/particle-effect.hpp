@@ -10,6 +10,7 @@
 
 #include "../emitter/emitter.hpp"
 #include "../behaviors/behavior.hpp"
+#include "particle-buffer.hpp"
 
 namespace kege{
 
@@ -22,6 +23,8 @@ namespace kege{
     struct ParticleEmitter
     {
         Ref<Emitter> emitter; ///< Reference to the emitter implementation that handles particle spawning
+        uint64_t seed = 0; ///< Picks the random numbers of the particles, together with the entity id
+        uint64_t emitted = 0; ///< Number of particles emitted so far, the position of the next one in the random sequence
     };
 
     /**
@@ -40,15 +43,35 @@ namespace kege{
     };
 
     /**
-     * @brief Storage buffer for particle data.
+     * @brief Level of detail settings of a particle effect, and the level ParticleLODSystem picked for it.
      *
-     * Contains the actual particle data and maintains the current count
-     * of active particles in the system.
+     * Effects without one are always emitted, simulated and drawn at full rate. With one, an effect
+     * that is far from the camera emits fewer particles and is simulated every few frames with the
+     * time it skipped, an effect outside the view is not drawn, and an effect past cull_distance
+     * stops emitting and is left to expire.
      */
-    struct ParticleBuffer
+    struct ParticleLOD
     {
-        array<kege::Particle> particles; ///< Contiguous storage for particle data
-        uint32_t particle_count = 0; ///< Number of currently active particles (<= particles.size())
+        /**
+         * Radius of the sphere around the effect's position that the frustum test uses. The particles
+         * are not measured, so it has to cover as far as they travel. Particles past it disappear with
+         * the effect when the sphere leaves the view.
+         */
+        float radius = 1.f;
+        float near_distance = 25.f; ///< Closer than this the effect runs at full rate
+        float far_distance = 200.f; ///< From here on the effect runs at min_emission and max_tick_interval
+        float cull_distance = 400.f; ///< Past this the effect stops emitting and is not drawn
+        float min_emission = 0.25f; ///< Fraction of the emission rate left at far_distance
+        uint32_t max_tick_interval = 4; ///< Frames between simulation steps at far_distance and outside the view
+        int32_t priority = 0; ///< Effects of higher priority keep emitting when the particle budget runs out
+
+        float distance = 0.f; ///< Distance to the camera this frame
+        float emission_scale = 1.f; ///< Fraction of the emission rate the effect emits at this frame
+        double step = 0.0; ///< Time the effect is simulated by this frame, 0 when it skips the frame
+        double elapsed = 0.0; ///< Time gone by since the effect was last simulated
+        uint32_t tick_interval = 1; ///< Frames between simulation steps at this distance
+        bool visible = true; ///< Whether the effect's sphere is in the view
+        bool throttled = false; ///< Whether the effect stopped emitting to keep the particle budget
     };
 }
 #endif /* particle_effect_hpp */
@@ -21,9 +21,9 @@ namespace kege{
         this->axes[ 1 ] = axes[ 1 ];
         this->radius = radius;
     }
-    kege::point3 EmitterCircleLine::emit()
+    kege::point3 EmitterCircleLine::emit( RandomStream& random )
     {
-        float radian = kege::randf(0, 6.28f);
+        float radian = random.range(0, 6.28f);
         return axes[ 0 ] * cosf( radian ) * radius + axes[ 1 ] * sinf( radian ) * radius;
     }
 }
@@ -44,10 +44,10 @@ namespace kege{
         this->radius[ 0 ] = min_radius;
         this->radius[ 1 ] = max_radius;
     }
-    kege::point3 EmitterCircleArea::emit()
+    kege::point3 EmitterCircleArea::emit( RandomStream& random )
     {
-        float radian = kege::randf(0, 6.28f);
-        float len = kege::randf(radius[ 0 ], radius[ 1 ]);
+        float radian = random.range(0, 6.28f);
+        float len = random.range(radius[ 0 ], radius[ 1 ]);
         return axes[ 0 ] * cosf( radian ) * len + axes[ 1 ] * sinf( radian ) * len;
     }
 }
@@ -17,7 +17,7 @@ namespace kege{
     public:
 
         EmitterCircleLine( float emissions_per_second, bool burst, kege::vec3 axes[ 2 ], float radius );
-        kege::point3 emit();
+        kege::point3 emit( RandomStream& random );
 
         kege::vec3 axes[ 2 ];
         float radius;
@@ -30,7 +30,7 @@ namespace kege{
     {
     public:
         EmitterCircleArea( float emissions_per_second, bool burst, kege::vec3 axes[ 2 ], float min_radius, float max_radius );
-        kege::point3 emit();
+        kege::point3 emit( RandomStream& random );
 
         kege::vec3 axes[ 2 ];
         float radius[ 2 ];
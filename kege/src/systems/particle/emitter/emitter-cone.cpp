@@ -23,10 +23,10 @@ namespace kege{
     ,   height( h )
     {
     }
-    kege::point3 EmitterCone::emit()
+    kege::point3 EmitterCone::emit( RandomStream& random )
     {
-        float t = kege::randf( 0.f, 1.f );
-        float radian = kege::randf( 0.f, 6.28f );
+        float t = random.range( 0.f, 1.f );
+        float radian = random.range( 0.f, 6.28f );
         float z = sinf( radian ) * t * radius[1];
         float x = cosf( radian ) * t * radius[0];
         float y = kege::lerp( -height, height, t );
@@ -25,7 +25,7 @@ namespace kege{
             float max_radius
         );
         
-        kege::point3 emit();
+        kege::point3 emit( RandomStream& random );
         kege::vec3 axes[2];
         float radius[2];
         float height;
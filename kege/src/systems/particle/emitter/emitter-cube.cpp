@@ -9,13 +9,13 @@
 
 namespace kege{
 
-    kege::point3 EmitterCube::emit()
+    kege::point3 EmitterCube::emit( RandomStream& random )
     {
         return kege::point3
         (
-            kege::randf( -extents.x, extents.x ),
-            kege::randf( -extents.y, extents.y ),
-            kege::randf( -extents.z, extents.z )
+            random.range( -extents.x, extents.x ),
+            random.range( -extents.y, extents.y ),
+            random.range( -extents.z, extents.z )
         );
     };
     EmitterCube::EmitterCube
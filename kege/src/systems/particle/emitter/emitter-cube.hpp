@@ -22,7 +22,7 @@ namespace kege{
             float height,
             float depth
         );
-        kege::point3 emit();
+        kege::point3 emit( RandomStream& random );
         kege::point3 extents;
     };
 }
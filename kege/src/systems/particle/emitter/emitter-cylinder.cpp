@@ -20,13 +20,13 @@ namespace kege{
     ,   height( h )
     ,   radius( r )
     {}
-    kege::point3 EmitterCylinderSurface::emit()
+    kege::point3 EmitterCylinderSurface::emit( RandomStream& random )
     {
-        float radian = kege::randf(0, 6.28f);
+        float radian = random.range(0, 6.28f);
         point3 position;
         position  = axes[1] * sinf( radian ) * radius;
         position += axes[1] * cosf( radian ) * radius;
-        position += axes[0] * kege::randf(0, height);
+        position += axes[0] * random.range(0, height);
         return position;
     }
 }
@@ -46,16 +46,16 @@ namespace kege{
     ,   radius{ min_radius, max_radius }
     ,   height( height )
     {}
-    kege::point3 EmitterCylinder::emit()
+    kege::point3 EmitterCylinder::emit( RandomStream& random )
     {
-        float radian = kege::randf(0.0f, 6.28f);
-        float radius0 = kege::randf(0.0f, radius[0]);
-        float radius1 = kege::randf(0.0f, radius[1]);
+        float radian = random.range(0.0f, 6.28f);
+        float radius0 = random.range(0.0f, radius[0]);
+        float radius1 = random.range(0.0f, radius[1]);
 
         point3 position;
         position  = axes[1] * sinf( radian ) * radius0;
         position += axes[1] * cosf( radian ) * radius1;
-        position += axes[0] * kege::randf(0, height);
+        position += axes[0] * random.range(0, height);
         return position;
     }
 }
@@ -24,7 +24,7 @@ namespace kege{
             float radius
         );
 
-        kege::point3 emit();
+        kege::point3 emit( RandomStream& random );
         kege::vec3 axes[2];
         float height;
         float radius;
@@ -46,7 +46,7 @@ namespace kege{
             float max_radius
         );
 
-        kege::point3 emit();
+        kege::point3 emit( RandomStream& random );
         kege::vec3 axes[2];
         float radius[2];
         float height;
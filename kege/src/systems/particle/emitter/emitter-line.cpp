@@ -22,9 +22,9 @@ namespace kege{
         length = magn(direction);
         direction /= length;
     }
-    kege::point3 EmitterLine::emit()
+    kege::point3 EmitterLine::emit( RandomStream& random )
     {
-        return origin + direction * kege::randf(0.f, length);
+        return origin + direction * random.range(0.f, length);
     }
 }
 
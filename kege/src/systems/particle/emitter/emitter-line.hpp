@@ -23,7 +23,7 @@ namespace kege{
             const kege::point3& end
         );
         
-        kege::point3 emit();
+        kege::point3 emit( RandomStream& random );
         kege::vec3 direction;
         kege::vec3 origin;
         float length;
@@ -9,9 +9,9 @@
 
 namespace kege{
 
-    kege::point3 EmitterPlane::emit()
+    kege::point3 EmitterPlane::emit( RandomStream& random )
     {
-        return position + (axes[ 0 ] * kege::randf(-extents.x, extents.x)) + (axes[ 1 ] * kege::randf(-extents.y, extents.y));
+        return position + (axes[ 0 ] * random.range(-extents.x, extents.x)) + (axes[ 1 ] * random.range(-extents.y, extents.y));
     }
     
     EmitterPlane::EmitterPlane
@@ -23,7 +23,7 @@ namespace kege{
             const kege::point3& c,
             const kege::point2& extents
         );
-        kege::point3 emit();
+        kege::point3 emit( RandomStream& random );
         kege::point3 position;
         kege::vec3 axes[ 2 ];
         kege::point2 extents;
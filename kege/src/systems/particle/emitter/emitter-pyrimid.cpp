@@ -23,16 +23,16 @@ namespace kege{
     {
     }
     
-    kege::point3 EmitterPyrimid::emit()
+    kege::point3 EmitterPyrimid::emit( RandomStream& random )
     {
-        float t = kege::randf(0.f, 1.f);
+        float t = random.range(0.f, 1.f);
         float h = kege::lerp(0.f, height, t);
 
         float w = width*t;
-        w = kege::randf(-w, w);
+        w = random.range(-w, w);
 
         float d = depth*t;
-        d = kege::randf(-d, d);
+        d = random.range(-d, d);
 
         return kege::point3(w, h, d);
     }
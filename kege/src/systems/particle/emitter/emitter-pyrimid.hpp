@@ -24,7 +24,7 @@ namespace kege{
             float depth
         );
 
-        kege::point3 emit();
+        kege::point3 emit( RandomStream& random );
 
         float width, height, depth;
     };
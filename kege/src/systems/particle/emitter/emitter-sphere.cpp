@@ -22,11 +22,11 @@ namespace kege{
     {
     }
 
-    kege::point3 EmitterSphereArea::emit()
+    kege::point3 EmitterSphereArea::emit( RandomStream& random )
     {
-        float radianA = kege::randf(0, 6.28f);
-        float radianB = kege::randf(0, 6.28f);
-        float radius = kege::randf(min_radius, max_radius);
+        float radianA = random.range(0, 6.28f);
+        float radianB = random.range(0, 6.28f);
+        float radius = random.range(min_radius, max_radius);
         float y = sinf(radianB) * radius;
         float r = cosf(radianB) * radius;
         float z = sinf(radianA) * r;
@@ -41,10 +41,10 @@ namespace kege{
     :   Emitter( emissions_per_second, burst )
     ,   radius(r)
     {}
-    kege::point3 EmitterSphere::emit()
+    kege::point3 EmitterSphere::emit( RandomStream& random )
     {
-        float radianA = kege::randf(0, 6.28f);
-        float radianB = kege::randf(0, 6.28f);
+        float radianA = random.range(0, 6.28f);
+        float radianB = random.range(0, 6.28f);
         float y = sinf(radianB) * radius;
         float r = cosf(radianB) * radius;
         float z = sinf(radianA) * r;
@@ -23,7 +23,7 @@ namespace kege{
             float max_radius
         );
 
-        kege::point3 emit();
+        kege::point3 emit( RandomStream& random );
         float min_radius;
         float max_radius;
     };
@@ -35,7 +35,7 @@ namespace kege{
     {
     public:
         EmitterSphere( float emissions_per_second, bool burst, float radius );
-        kege::point3 emit();
+        kege::point3 emit( RandomStream& random );
         float radius;
     };
 }
@@ -30,12 +30,12 @@ namespace kege{
         axes[ 0 ] = cross( normal, axes[ 1 ] );
         axes[ 1 ] = cross( normal, axes[ 0 ] );
     }
-    kege::point3 EmitterTriangle::emit()
+    kege::point3 EmitterTriangle::emit( RandomStream& random )
     {
-        const float t = kege::randf(0, 1.0f);
+        const float t = random.range(0, 1.0f);
 
         float b = base * t;
-        b = kege::randf(-b, b);
+        b = random.range(-b, b);
         float h = kege::lerp(-height, height, t);
 
         return position + axes[ 0 ] * b + axes[ 1 ] * h;
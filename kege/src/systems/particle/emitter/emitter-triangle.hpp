@@ -25,7 +25,7 @@ namespace kege{
             float height,
             float base
         );
-        kege::point3 emit();
+        kege::point3 emit( RandomStream& random );
 
         kege::point3 position;
         kege::vec3 axes[ 2 ];
@@ -21,6 +21,17 @@ namespace kege{
         return count;
     }
 
+    void Emitter::emit( RandomStream& random, uint32_t count, float* x, float* y, float* z )
+    {
+        for ( uint32_t i = 0; i < count; ++i )
+        {
+            const vec3 position = emit( random );
+            x[ i ] = position.x;
+            y[ i ] = position.y;
+            z[ i ] = position.z;
+        }
+    }
+
     Emitter::Emitter
     (
         float emissions_per_second, // particles to emit every second
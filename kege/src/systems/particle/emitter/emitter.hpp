@@ -28,10 +28,20 @@ namespace kege{
          * @brief Emits a new particle position based on the given transform.
          *
          * This is a pure virtual method that must be implemented by concrete emitter types.
+         * It may be called from several threads at once, each with its own random stream.
          *
+         * @param random The stream every random draw is taken from.
          * @return A position vector where the particle should be emitted in world space.
          */
-        virtual vec3 emit() = 0;
+        virtual vec3 emit( RandomStream& random ) = 0;
+
+        /**
+         * @brief Emits the positions of `count` new particles into the x, y and z arrays.
+         *
+         * The default calls emit( random ) for every particle. Emitters that can produce a
+         * batch faster override it.
+         */
+        virtual void emit( RandomStream& random, uint32_t count, float* x, float* y, float* z );
 
         /**
          * @brief Updates the internal emission timer and computes how many particles to emit.
@@ -0,0 +1,116 @@
+//
+//  billboard-particle-data.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#include "billboard-particle-data.hpp"
+
+#if !defined( KEGE_NO_SIMD ) && ( defined( __SSE2__ ) || defined( _M_X64 ) )
+#include <immintrin.h>
+#define KEGE_PACK_SSE
+#endif
+
+namespace kege{
+
+    /*
+     the packing below writes a particle as 13 consecutive floats. the vectors of the math library
+     have no padding, if that changes the packing has to change with it.
+     */
+    static_assert( sizeof( BillboardParticleData ) == 13 * sizeof( float ), "BillboardParticleData is expected to be 13 packed floats" );
+
+    void packBillboardParticles( const ParticleBuffer& particles, uint32_t first, uint32_t last, BillboardParticleData* out )
+    {
+        const float* px = particles[ ParticleBuffer::POSITION_X ];
+        const float* py = particles[ ParticleBuffer::POSITION_Y ];
+        const float* pz = particles[ ParticleBuffer::POSITION_Z ];
+        const float* cr = particles[ ParticleBuffer::COLOR_R ];
+        const float* cg = particles[ ParticleBuffer::COLOR_G ];
+        const float* cb = particles[ ParticleBuffer::COLOR_B ];
+        const float* ca = particles[ ParticleBuffer::COLOR_A ];
+        const float* sx = particles[ ParticleBuffer::SPRITE_X ];
+        const float* sy = particles[ ParticleBuffer::SPRITE_Y ];
+        const float* sz = particles[ ParticleBuffer::SPRITE_Z ];
+        const float* sw = particles[ ParticleBuffer::SPRITE_W ];
+        const float* size = particles[ ParticleBuffer::SIZE ];
+        const float* rotation = particles[ ParticleBuffer::ROTATION ];
+
+        float* dst = reinterpret_cast< float* >( out );
+        uint32_t i = first;
+
+#ifdef KEGE_PACK_SSE
+        /*
+         4 particles at a time. the first 12 floats of a particle are three groups of 4 streams,
+         (position, red), (green, blue, alpha, sprite x) and (sprite yzw, size). each group is
+         loaded as 4 particles of 4 streams and transposed into 4 particles, so a particle is
+         written with 3 vector stores and its rotation.
+         */
+        for ( ; i + 4 <= last; i += 4, dst += 4 * 13 )
+        {
+            __m128 a0 = _mm_loadu_ps( px + i ), a1 = _mm_loadu_ps( py + i ), a2 = _mm_loadu_ps( pz + i ), a3 = _mm_loadu_ps( cr + i );
+            __m128 b0 = _mm_loadu_ps( cg + i ), b1 = _mm_loadu_ps( cb + i ), b2 = _mm_loadu_ps( ca + i ), b3 = _mm_loadu_ps( sx + i );
+            __m128 c0 = _mm_loadu_ps( sy + i ), c1 = _mm_loadu_ps( sz + i ), c2 = _mm_loadu_ps( sw + i ), c3 = _mm_loadu_ps( size + i );
+            _MM_TRANSPOSE4_PS( a0, a1, a2, a3 );
+            _MM_TRANSPOSE4_PS( b0, b1, b2, b3 );
+            _MM_TRANSPOSE4_PS( c0, c1, c2, c3 );
+
+            _mm_storeu_ps( dst +  0, a0 ); _mm_storeu_ps( dst +  4, b0 ); _mm_storeu_ps( dst +  8, c0 ); dst[ 12 ] = rotation[ i + 0 ];
+            _mm_storeu_ps( dst + 13, a1 ); _mm_storeu_ps( dst + 17, b1 ); _mm_storeu_ps( dst + 21, c1 ); dst[ 25 ] = rotation[ i + 1 ];
+            _mm_storeu_ps( dst + 26, a2 ); _mm_storeu_ps( dst + 30, b2 ); _mm_storeu_ps( dst + 34, c2 ); dst[ 38 ] = rotation[ i + 2 ];
+            _mm_storeu_ps( dst + 39, a3 ); _mm_storeu_ps( dst + 43, b3 ); _mm_storeu_ps( dst + 47, c3 ); dst[ 51 ] = rotation[ i + 3 ];
+        }
+#endif
+
+        for ( ; i < last; ++i, dst += 13 )
+        {
+            dst[  0 ] = px[ i ];
+            dst[  1 ] = py[ i ];
+            dst[  2 ] = pz[ i ];
+            dst[  3 ] = cr[ i ];
+            dst[  4 ] = cg[ i ];
+            dst[  5 ] = cb[ i ];
+            dst[  6 ] = ca[ i ];
+            dst[  7 ] = sx[ i ];
+            dst[  8 ] = sy[ i ];
+            dst[  9 ] = sz[ i ];
+            dst[ 10 ] = sw[ i ];
+            dst[ 11 ] = size[ i ];
+            dst[ 12 ] = rotation[ i ];
+        }
+    }
+
+    void packBillboardParticles( const ParticleDepthSorter& sorter, uint32_t first, uint32_t last, BillboardParticleData* out )
+    {
+        const uint32_t* order = sorter.order();
+        const std::vector< ParticleDepthSorter::Source >& sources = sorter.sources();
+
+        float* dst = reinterpret_cast< float* >( out );
+        for ( uint32_t j = first; j < last; ++j, dst += 13 )
+        {
+            const uint32_t index = order[ j ];
+            const uint32_t source = sorter.owner( index );
+            const uint32_t i = index - sorter.base( source );
+            const ParticleBuffer& s = *sources[ source ].particles;
+            const mat44& m = sources[ source ].model;
+
+            const float x = s[ ParticleBuffer::POSITION_X ][ i ];
+            const float y = s[ ParticleBuffer::POSITION_Y ][ i ];
+            const float z = s[ ParticleBuffer::POSITION_Z ][ i ];
+            dst[  0 ] = m[ 0 ].x * x + m[ 1 ].x * y + m[ 2 ].x * z + m[ 3 ].x;
+            dst[  1 ] = m[ 0 ].y * x + m[ 1 ].y * y + m[ 2 ].y * z + m[ 3 ].y;
+            dst[  2 ] = m[ 0 ].z * x + m[ 1 ].z * y + m[ 2 ].z * z + m[ 3 ].z;
+            dst[  3 ] = s[ ParticleBuffer::COLOR_R ][ i ];
+            dst[  4 ] = s[ ParticleBuffer::COLOR_G ][ i ];
+            dst[  5 ] = s[ ParticleBuffer::COLOR_B ][ i ];
+            dst[  6 ] = s[ ParticleBuffer::COLOR_A ][ i ];
+            dst[  7 ] = s[ ParticleBuffer::SPRITE_X ][ i ];
+            dst[  8 ] = s[ ParticleBuffer::SPRITE_Y ][ i ];
+            dst[  9 ] = s[ ParticleBuffer::SPRITE_Z ][ i ];
+            dst[ 10 ] = s[ ParticleBuffer::SPRITE_W ][ i ];
+            dst[ 11 ] = s[ ParticleBuffer::SIZE ][ i ];
+            dst[ 12 ] = s[ ParticleBuffer::ROTATION ][ i ];
+        }
+    }
+
+}
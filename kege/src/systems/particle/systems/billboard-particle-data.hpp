@@ -0,0 +1,45 @@
+//
+//  billboard-particle-data.hpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef kege_billboard_particle_data_hpp
+#define kege_billboard_particle_data_hpp
+
+#include "../effect/particle-buffer.hpp"
+#include "particle-depth-sorter.hpp"
+
+namespace kege{
+
+    /**
+     * @brief One particle as the billboard shader reads it, a per instance vertex.
+     */
+    struct BillboardParticleData
+    {
+        vec3  position;
+        vec4  color;
+        vec4  sprite;
+        float size;
+        float rotation;
+    };
+
+    /**
+     * @brief Writes particles [first, last) of a buffer to `out` in the layout of the billboard shader.
+     *
+     * `out` may be mapped GPU memory, it is only written, front to back. Separate ranges can be
+     * packed on separate threads.
+     */
+    void packBillboardParticles( const ParticleBuffer& particles, uint32_t first, uint32_t last, BillboardParticleData* out );
+
+    /**
+     * @brief Writes places [first, last) of a sorter's order to `out`, in that order.
+     *
+     * Positions are moved to world space by the model matrix of their source, particles of
+     * different effects can then be drawn together, with an identity model matrix.
+     */
+    void packBillboardParticles( const ParticleDepthSorter& sorter, uint32_t first, uint32_t last, BillboardParticleData* out );
+
+}
+#endif /* kege_billboard_particle_data_hpp */
@@ -6,9 +6,14 @@
 //
 
 #include "billboard-particle-renderer.hpp"
+#include "../../../core/task/parallel-for.hpp"
 
 namespace kege{
 
+    uint32_t BillboardParticleRenderer::pack_grain = 16384;
+    bool BillboardParticleRenderer::depth_sort = false;
+    ParticleDepthSorter::Mode BillboardParticleRenderer::sort_mode = ParticleDepthSorter::INCREMENTAL;
+
     void BillboardParticleRenderer::operator()( kege::RenderPassContext* context )
     {
         if ( context->name() != "geometry" )
@@ -21,6 +26,69 @@ namespace kege{
 
         kege::Graphics* graphics = context->getGraphics();
 
+        // every effect gets a range of one slice, its particles are instances [first, first + count)
+        uint32_t total = 0;
+        _draws.clear();
+        for ( kege::Entity entity : *_entities )
+        {
+            const ParticleBuffer* buffer = entity.get< ParticleBuffer >();
+            const ParticleLOD* lod = entity.get< ParticleLOD >();
+            if ( buffer->particle_count == 0 || ( lod && !lod->visible ) ) continue;
+
+            _draws.push_back({ buffer, entity.get< Transform >(), total });
+            total += buffer->particle_count;
+        }
+        if ( total == 0 ) return;
+
+        _vertices.beginFrame( graphics->getCurrFrameIndex() );
+
+        const uint64_t bytes = uint64_t( total ) * sizeof( BillboardParticleData );
+        if ( bytes > _vertices.frameSize() && !_vertices.reserve( bytes + bytes / 2 ) )
+        {
+            return;
+        }
+
+        FrameRingBuffer::Allocation slice;
+        if ( !_vertices.allocate( bytes, sizeof( float ), slice ) )
+        {
+            return;
+        }
+
+        const Entity& player = _engine->scene()->getPlayer();
+        const Camera* camera = ( depth_sort && player ) ? player.get< Camera >() : nullptr;
+
+        BillboardParticleData* data = reinterpret_cast< BillboardParticleData* >( slice.data );
+        if ( camera )
+        {
+            _sort_sources.clear();
+            for ( const Draw& draw : _draws )
+            {
+                _sort_sources.push_back({ draw.particles, ModelMatrices( *draw.transform ).transform });
+            }
+
+            // the view looks down its -z axis, the depth is minus the view space z
+            const mat44& view = camera->matrices.transform;
+            _sorter.sort( _sort_sources, vec4( -view[ 0 ].z, -view[ 1 ].z, -view[ 2 ].z, -view[ 3 ].z ), sort_mode );
+
+            const ParticleDepthSorter* sorter = &_sorter;
+            kege::parallelFor( 0, total, pack_grain, [ sorter, data ]( uint32_t first, uint32_t last )
+            {
+                packBillboardParticles( *sorter, first, last, data + first );
+            });
+        }
+        else
+        {
+            for ( const Draw& draw : _draws )
+            {
+                const ParticleBuffer* particles = draw.particles;
+                BillboardParticleData* out = data + draw.first;
+                kege::parallelFor( 0, particles->particle_count, pack_grain, [ particles, out ]( uint32_t first, uint32_t last )
+                {
+                    packBillboardParticles( *particles, first, last, out + first );
+                });
+            }
+        }
+
         CommandEncoder* encoder = context->getCommandBuffer()->createCommandEncoder();
         encoder->setScissor
         ({
@@ -37,41 +105,24 @@ namespace kege{
 
         encoder->bindGraphicsPipeline( _pipeline );
         encoder->bindDescriptorSets( camera_descriptor );
+        encoder->bindVertexBuffers( 0, { slice.buffer }, { slice.offset });
 
         ModelMatrices model_matrices;
-
-        for ( kege::Entity entity : *_entities )
+        if ( camera )
         {
-            ParticleBuffer* buffer = entity.get< ParticleBuffer >();
-            Transform* transform = entity.get< Transform >();
-
-            if ( !_storage_buffer )
-            {
-                _storage_buffer = graphics->createBuffer
-                ({
-                    .size = buffer->particle_count * sizeof( BillboardParticleData ),
-                    .data = nullptr,
-                    .memory_usage = MemoryUsage::CpuToGpu,
-                    .usage = BufferUsage::VertexBuffer
-                });
-            }
-
-            BillboardParticleData* data = reinterpret_cast< BillboardParticleData* >( graphics->mapBuffer( _storage_buffer ) );
-            for( uint32_t i = 0; i < buffer->particle_count ; i += 1 )
-            {
-                data[i].size     = buffer->particles[ i ].size;
-                data[i].color    = buffer->particles[ i ].color;
-                data[i].position = buffer->particles[ i ].position;
-                data[i].rotation = buffer->particles[ i ].rotation;
-                data[i].sprite   = buffer->particles[ i ].sprite;
-            }
-            graphics->unmapBuffer( _storage_buffer );
-
-            model_matrices = ModelMatrices( *transform );
+            // the sorted particles are already in world space
+            model_matrices.transform = mat44();
+            model_matrices.rotation = mat44();
+            encoder->setPushConstants(ShaderStage::Vertex, 0, sizeof( model_matrices ), &model_matrices );
+            encoder->draw( 4, total, 0, 0 );
+            return;
+        }
 
-            encoder->bindVertexBuffers( 0, { _storage_buffer }, { 0 });
+        for ( const Draw& draw : _draws )
+        {
+            model_matrices = ModelMatrices( *draw.transform );
             encoder->setPushConstants(ShaderStage::Vertex, 0, sizeof( model_matrices ), &model_matrices );
-            encoder->draw( 4, buffer->particle_count, 0, 0 );
+            encoder->draw( 4, draw.particles->particle_count, 0, draw.first );
         }
     }
 
@@ -84,6 +135,13 @@ namespace kege{
             return false;
         }
 
+        // room for 64k particles a frame to start with, it grows with the particle count
+        if ( !_vertices.initialize( _engine->graphics(), BufferUsage::VertexBuffer, 65536 * sizeof( BillboardParticleData ) ) )
+        {
+            KEGE_LOG_ERROR << "billboard-particle-rendering-system: failed to create the vertex ring buffer.";
+            return false;
+        }
+
         _comm.add< kege::RenderPassContext*, BillboardParticleRenderer>( this );
         return EntitySystem::initialize();
     }
@@ -91,6 +149,7 @@ namespace kege{
     void BillboardParticleRenderer::shutdown()
     {
         _comm.remove< kege::RenderPassContext*, BillboardParticleRenderer >( this );
+        _vertices.shutdown();
         EntitySystem::shutdown();
     }
 
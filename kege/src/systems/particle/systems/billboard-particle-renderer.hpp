@@ -10,18 +10,11 @@
 
 #include "../effect/particle-effect.hpp"
 #include "../../-/system-dependencies.hpp"
+#include "../../../core/graphics/core/frame-ring-buffer.hpp"
+#include "billboard-particle-data.hpp"
 
 namespace kege{
 
-    struct BillboardParticleData
-    {
-        vec3  position;
-        vec4  color;
-        vec4  sprite;
-        float size;
-        float rotation;
-    };
-
     enum class BillboardType
     {
         Spherical,
@@ -33,6 +26,15 @@ namespace kege{
         kege::ImageHandle texture;
     };
 
+    /**
+     * @brief Draws the particles of every effect as camera facing quads.
+     *
+     * The particles of all effects are packed into one slice of a persistently mapped ring buffer
+     * each frame and drawn from it, one draw per effect at its own first instance.
+     *
+     * With depth_sort on, the particles of all effects are sorted back to front for the camera and
+     * packed in that order, then drawn with one draw, so blending is right across effects.
+     */
     class BillboardParticleRenderer : public kege::EntitySystem
     {
     public:
@@ -42,9 +44,37 @@ namespace kege{
         bool initialize();
         void shutdown();
 
+    public:
+
+        /**
+         * @brief Large effects are packed in batches of this many particles on the job workers.
+         */
+        static uint32_t pack_grain;
+
+        /**
+         * @brief Sorts the particles back to front before they are drawn. Off by default.
+         */
+        static bool depth_sort;
+
+        /**
+         * @brief How the depth sort is done, INCREMENTAL reuses the order of the last frame.
+         */
+        static ParticleDepthSorter::Mode sort_mode;
+
+    private:
+
+        struct Draw
+        {
+            const ParticleBuffer* particles;
+            const Transform* transform;
+            uint32_t first;
+        };
 
         kege::PipelineHandle _pipeline;
-        kege::BufferHandle _storage_buffer;
+        kege::FrameRingBuffer _vertices;
+        std::vector< Draw > _draws;
+        ParticleDepthSorter _sorter;
+        std::vector< ParticleDepthSorter::Source > _sort_sources;
     };
 
 }
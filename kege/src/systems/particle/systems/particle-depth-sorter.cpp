@@ -0,0 +1,494 @@
+//
+//  particle-depth-sorter.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#include <atomic>
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+#include "particle-depth-sorter.hpp"
+#include "../../../core/task/parallel-for.hpp"
+
+namespace kege{
+
+    uint32_t ParticleDepthSorter::grain = 16384;
+    uint32_t ParticleDepthSorter::coherence_window = 32;
+    float ParticleDepthSorter::max_displaced = 0.1f;
+
+    static const uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+    /**
+     * a key that sorts far before near. the bits of a positive float sort like the float, the bits
+     * of a negative one the other way around, flipping them makes every float sort as unsigned,
+     * and the complement turns the order around.
+     */
+    static inline uint32_t depthKey( float depth )
+    {
+        uint32_t bits;
+        std::memcpy( &bits, &depth, sizeof( bits ) );
+        bits ^= ( bits & 0x80000000u ) ? 0xFFFFFFFFu : 0x80000000u;
+        return ~bits;
+    }
+
+    /**
+     * sorts `count` pairs by key, least significant byte first. every pass counts the bytes of
+     * each batch, the sums over the batches give each batch the places its pairs go to, and the
+     * batches scatter their pairs in parallel. the result ends up in keys and values.
+     */
+    static void radixSort( uint32_t* keys, uint32_t* values, uint32_t* scratch_keys, uint32_t* scratch_values, uint32_t count, uint32_t grain, std::vector< uint32_t >& counts )
+    {
+        if ( count < 2 ) return;
+
+        const uint32_t batches = ( count + grain - 1 ) / grain;
+
+        // a byte that is the same in every key would not move anything
+        std::vector< uint32_t > ands( batches ), ors( batches );
+        kege::parallelFor( 0, batches, 1, [ &ands, &ors, keys, count, grain ]( uint32_t first, uint32_t last )
+        {
+            for ( uint32_t b = first; b < last; ++b )
+            {
+                uint32_t a = 0xFFFFFFFF, o = 0;
+                for ( uint32_t i = b * grain, end = std::min( i + grain, count ); i < end; ++i )
+                {
+                    a &= keys[ i ];
+                    o |= keys[ i ];
+                }
+                ands[ b ] = a;
+                ors[ b ] = o;
+            }
+        });
+        uint32_t differ = 0, a = 0xFFFFFFFF, o = 0;
+        for ( uint32_t b = 0; b < batches; ++b )
+        {
+            a &= ands[ b ];
+            o |= ors[ b ];
+        }
+        differ = a ^ o;
+
+        counts.resize( size_t( batches ) * 256 );
+        uint32_t* src_keys = keys;
+        uint32_t* src_values = values;
+        uint32_t* dst_keys = scratch_keys;
+        uint32_t* dst_values = scratch_values;
+
+        for ( uint32_t shift = 0; shift < 32; shift += 8 )
+        {
+            if ( ( ( differ >> shift ) & 0xFF ) == 0 ) continue;
+
+            uint32_t* histograms = counts.data();
+            kege::parallelFor( 0, batches, 1, [ histograms, src_keys, count, grain, shift ]( uint32_t first, uint32_t last )
+            {
+                for ( uint32_t b = first; b < last; ++b )
+                {
+                    uint32_t* histogram = histograms + size_t( b ) * 256;
+                    std::fill( histogram, histogram + 256, 0u );
+                    for ( uint32_t i = b * grain, end = std::min( i + grain, count ); i < end; ++i )
+                    {
+                        ++histogram[ ( src_keys[ i ] >> shift ) & 0xFF ];
+                    }
+                }
+            });
+
+            // the first place of each byte of each batch, bytes in order, batches in order within a byte
+            uint32_t sum = 0;
+            for ( uint32_t digit = 0; digit < 256; ++digit )
+            {
+                for ( uint32_t b = 0; b < batches; ++b )
+                {
+                    const uint32_t n = histograms[ size_t( b ) * 256 + digit ];
+                    histograms[ size_t( b ) * 256 + digit ] = sum;
+                    sum += n;
+                }
+            }
+
+            kege::parallelFor( 0, batches, 1, [ histograms, src_keys, src_values, dst_keys, dst_values, count, grain, shift ]( uint32_t first, uint32_t last )
+            {
+                for ( uint32_t b = first; b < last; ++b )
+                {
+                    uint32_t* places = histograms + size_t( b ) * 256;
+                    for ( uint32_t i = b * grain, end = std::min( i + grain, count ); i < end; ++i )
+                    {
+                        const uint32_t place = places[ ( src_keys[ i ] >> shift ) & 0xFF ]++;
+                        dst_keys[ place ] = src_keys[ i ];
+                        dst_values[ place ] = src_values[ i ];
+                    }
+                }
+            });
+
+            std::swap( src_keys, dst_keys );
+            std::swap( src_values, dst_values );
+        }
+
+        if ( src_keys != keys )
+        {
+            kege::parallelFor( 0, count, grain, [ keys, values, src_keys, src_values ]( uint32_t first, uint32_t last )
+            {
+                std::memcpy( keys + first, src_keys + first, ( last - first ) * sizeof( uint32_t ) );
+                std::memcpy( values + first, src_values + first, ( last - first ) * sizeof( uint32_t ) );
+            });
+        }
+    }
+
+    /**
+     * sorts [first, last) by insertion, on the assumption that it is nearly sorted and that
+     * [first, start) already is. takes the pairs it moves from the budget and gives up when it
+     * runs out.
+     */
+    static bool insertionSort( uint32_t* keys, uint32_t* values, uint32_t first, uint32_t start, uint32_t last, uint64_t& budget )
+    {
+        for ( uint32_t i = std::max( start, first + 1 ); i < last; ++i )
+        {
+            const uint32_t key = keys[ i ];
+            if ( keys[ i - 1 ] <= key ) continue;
+
+            const uint32_t value = values[ i ];
+            uint32_t j = i;
+            for ( ; j > first && keys[ j - 1 ] > key; --j )
+            {
+                keys[ j ] = keys[ j - 1 ];
+                values[ j ] = values[ j - 1 ];
+            }
+            keys[ j ] = key;
+            values[ j ] = value;
+
+            if ( budget < i - j ) return false;
+            budget -= i - j;
+        }
+        return true;
+    }
+
+    /**
+     * how many of the first `index` merged pairs of a and b come from a, ties taken from a first.
+     */
+    static uint32_t mergeSplit( const uint32_t* a, uint32_t a_count, const uint32_t* b, uint32_t b_count, uint32_t index )
+    {
+        uint32_t low = ( index > b_count ) ? index - b_count : 0;
+        uint32_t high = std::min( index, a_count );
+        while ( low < high )
+        {
+            const uint32_t i = ( low + high ) / 2;
+            if ( a[ i ] <= b[ index - i - 1 ] ) low = i + 1;
+            else high = i;
+        }
+        return low;
+    }
+
+    /**
+     * whether the pair at j is out of order with the pairs `window` places around it.
+     */
+    static inline bool isDisplaced( const uint32_t* keys, uint32_t count, uint32_t j, uint32_t window )
+    {
+        return ( j >= window && keys[ j ] < keys[ j - window ] ) || ( j + window < count && keys[ j ] > keys[ j + window ] );
+    }
+
+    uint32_t ParticleDepthSorter::sort( const std::vector< Source >& sources, const vec4& depth, Mode mode )
+    {
+        _sources = sources;
+        _bases.resize( sources.size() + 1 );
+        _bases[ 0 ] = 0;
+        for ( size_t s = 0; s < sources.size(); ++s )
+        {
+            _bases[ s + 1 ] = _bases[ s ] + sources[ s ].particles->particle_count;
+        }
+        _count = _bases.back();
+
+        // the arrays only grow, the order of the last sort has to outlive the start of this one
+        for ( std::vector< uint32_t >* array : { &_owners, &_depth_keys, &_keys, &_order, &_scratch_keys, &_scratch_order } )
+        {
+            if ( array->size() < _count ) array->resize( _count );
+        }
+
+        computeKeys( depth );
+
+        /*
+         a failed incremental sort costs about as much as the full sort after it. when the
+         particles move too much for it, it is tried again after 1, 2, 4 up to 64 frames.
+         */
+        _incremental = false;
+        if ( mode == INCREMENTAL && _skip > 0 )
+        {
+            --_skip;
+        }
+        else if ( mode == INCREMENTAL )
+        {
+            _incremental = sortIncremental();
+            _backoff = ( _incremental ) ? 1 : std::min( _backoff * 2, 64u );
+            _skip = ( _incremental ) ? 0 : _backoff - 1;
+        }
+        if ( !_incremental )
+        {
+            sortFull();
+        }
+
+        _previous.clear();
+        for ( size_t s = 0; s < sources.size(); ++s )
+        {
+            _previous.push_back({ sources[ s ].particles, _bases[ s ], _bases[ s + 1 ] - _bases[ s ] });
+        }
+        _previous_count = _count;
+        return _count;
+    }
+
+    void ParticleDepthSorter::computeKeys( const vec4& depth )
+    {
+        /*
+         the depth is linear in the world position, which is linear in the particle's position.
+         folding the model matrix into the plane leaves one plane per source.
+         */
+        _planes.resize( _sources.size() );
+        for ( size_t s = 0; s < _sources.size(); ++s )
+        {
+            const mat44& m = _sources[ s ].model;
+            _planes[ s ] = vec4
+            (
+                depth.x * m[ 0 ].x + depth.y * m[ 0 ].y + depth.z * m[ 0 ].z,
+                depth.x * m[ 1 ].x + depth.y * m[ 1 ].y + depth.z * m[ 1 ].z,
+                depth.x * m[ 2 ].x + depth.y * m[ 2 ].y + depth.z * m[ 2 ].z,
+                depth.x * m[ 3 ].x + depth.y * m[ 3 ].y + depth.z * m[ 3 ].z + depth.w
+            );
+        }
+
+        const std::vector< Source >& sources = _sources;
+        const std::vector< uint32_t >& bases = _bases;
+        const std::vector< vec4 >& planes = _planes;
+        uint32_t* keys = _depth_keys.data();
+        uint32_t* owners = _owners.data();
+        kege::parallelFor( 0, _count, grain, [ &sources, &bases, &planes, keys, owners ]( uint32_t first, uint32_t last )
+        {
+            uint32_t s = uint32_t( std::upper_bound( bases.begin(), bases.end(), first ) - bases.begin() ) - 1;
+            for ( uint32_t g = first; g < last; )
+            {
+                while ( bases[ s + 1 ] <= g ) ++s;
+
+                const ParticleBuffer& particles = *sources[ s ].particles;
+                const float* x = particles[ ParticleBuffer::POSITION_X ];
+                const float* y = particles[ ParticleBuffer::POSITION_Y ];
+                const float* z = particles[ ParticleBuffer::POSITION_Z ];
+                const vec4 plane = planes[ s ];
+                const uint32_t base = bases[ s ];
+                const uint32_t end = std::min( last, bases[ s + 1 ] );
+                for ( ; g < end; ++g )
+                {
+                    const uint32_t i = g - base;
+                    keys[ g ] = depthKey( plane.x * x[ i ] + plane.y * y[ i ] + plane.z * z[ i ] + plane.w );
+                    owners[ g ] = s;
+                }
+            }
+        });
+    }
+
+    void ParticleDepthSorter::sortFull()
+    {
+        uint32_t* keys = _keys.data();
+        uint32_t* order = _order.data();
+        const uint32_t* depth_keys = _depth_keys.data();
+        kege::parallelFor( 0, _count, grain, [ keys, order, depth_keys ]( uint32_t first, uint32_t last )
+        {
+            for ( uint32_t g = first; g < last; ++g )
+            {
+                keys[ g ] = depth_keys[ g ];
+                order[ g ] = g;
+            }
+        });
+        radixSort( keys, order, _scratch_keys.data(), _scratch_order.data(), _count, std::max( grain, 1u ), _counts );
+    }
+
+    bool ParticleDepthSorter::sortIncremental()
+    {
+        if ( _previous.empty() || _previous_count == 0 || _count == 0 ) return false;
+
+        const uint32_t count = _count;
+        const uint32_t batch = std::max( grain, 1u );
+
+        /*
+         where the particles of the last sort are now. a source keeps the particles below both its
+         old and its new count in their places, the ones past its new count are gone. particles a
+         compaction moved are in the place of others, they come out of order and are caught below.
+         */
+        std::unordered_map< const ParticleBuffer*, uint32_t > previous;
+        for ( uint32_t p = 0; p < uint32_t( _previous.size() ); ++p )
+        {
+            previous[ _previous[ p ].particles ] = p;
+        }
+
+        _remap.assign( _previous_count, INVALID_INDEX );
+        std::vector< uint32_t > kept( _sources.size(), 0 );
+        for ( uint32_t s = 0; s < uint32_t( _sources.size() ); ++s )
+        {
+            auto found = previous.find( _sources[ s ].particles );
+            if ( found == previous.end() ) continue;
+
+            const Range& range = _previous[ found->second ];
+            kept[ s ] = std::min( range.count, _bases[ s + 1 ] - _bases[ s ] );
+            for ( uint32_t i = 0; i < kept[ s ]; ++i )
+            {
+                _remap[ range.base + i ] = _bases[ s ] + i;
+            }
+        }
+
+        // the last order in this frame's indices, then the particles that are new
+        uint32_t* keys = _scratch_keys.data();
+        uint32_t* order = _scratch_order.data();
+        uint32_t n = 0;
+        for ( uint32_t j = 0; j < _previous_count; ++j )
+        {
+            const uint32_t g = _remap[ _order[ j ] ];
+            if ( g == INVALID_INDEX ) continue;
+            keys[ n ] = _depth_keys[ g ];
+            order[ n ] = g;
+            ++n;
+        }
+        for ( uint32_t s = 0; s < uint32_t( _sources.size() ); ++s )
+        {
+            for ( uint32_t g = _bases[ s ] + kept[ s ]; g < _bases[ s + 1 ]; ++g )
+            {
+                keys[ n ] = _depth_keys[ g ];
+                order[ n ] = g;
+                ++n;
+            }
+        }
+
+        /*
+         the pairs out of order with their neighbours are split off. the rest are close to their
+         places, they are kept and touched up by insertion. the split off ones are few, they are
+         sorted on their own and merged with the kept ones.
+         */
+        const uint32_t batches = ( count + batch - 1 ) / batch;
+        const uint32_t window = std::max( coherence_window, 1u );
+        std::vector< uint32_t > displaced( batches + 1, 0 );
+        kege::parallelFor( 0, batches, 1, [ &displaced, keys, count, batch, window ]( uint32_t first, uint32_t last )
+        {
+            for ( uint32_t b = first; b < last; ++b )
+            {
+                uint32_t n = 0;
+                for ( uint32_t j = b * batch, end = std::min( j + batch, count ); j < end; ++j )
+                {
+                    n += isDisplaced( keys, count, j, window );
+                }
+                displaced[ b + 1 ] = n;
+            }
+        });
+        for ( uint32_t b = 0; b < batches; ++b )
+        {
+            displaced[ b + 1 ] += displaced[ b ];
+        }
+
+        const uint32_t displaced_count = displaced[ batches ];
+        const uint32_t kept_count = count - displaced_count;
+        if ( displaced_count > uint32_t( max_displaced * float( count ) ) ) return false;
+
+        if ( _displaced_keys.size() < displaced_count )
+        {
+            _displaced_keys.resize( displaced_count );
+            _displaced_order.resize( displaced_count );
+        }
+
+        uint32_t* kept_keys = _keys.data();
+        uint32_t* kept_order = _order.data();
+        uint32_t* displaced_keys = _displaced_keys.data();
+        uint32_t* displaced_order = _displaced_order.data();
+        kege::parallelFor( 0, batches, 1, [ & ]( uint32_t first, uint32_t last )
+        {
+            for ( uint32_t b = first; b < last; ++b )
+            {
+                uint32_t d = displaced[ b ];
+                uint32_t k = b * batch - d;
+                for ( uint32_t j = b * batch, end = std::min( j + batch, count ); j < end; ++j )
+                {
+                    if ( isDisplaced( keys, count, j, window ) )
+                    {
+                        displaced_keys[ d ] = keys[ j ];
+                        displaced_order[ d ] = order[ j ];
+                        ++d;
+                    }
+                    else
+                    {
+                        kept_keys[ k ] = keys[ j ];
+                        kept_order[ k ] = order[ j ];
+                        ++k;
+                    }
+                }
+            }
+        });
+
+        /*
+         the kept pairs by insertion, batch by batch, then across the seams of the batches. a
+         seam is done as soon as a pair is not smaller than the one before it, the rest of its
+         batch is sorted and larger. past about 2 moves per pair it is no faster than the radix
+         sort, so it gives up there.
+         */
+        const uint32_t kept_batches = ( kept_count + batch - 1 ) / batch;
+        std::atomic< bool > sorted( true );
+        kege::parallelFor( 0, kept_batches, 1, [ &sorted, kept_keys, kept_order, kept_count, batch ]( uint32_t first, uint32_t last )
+        {
+            for ( uint32_t b = first; b < last && sorted.load( std::memory_order_relaxed ); ++b )
+            {
+                const uint32_t begin = b * batch;
+                const uint32_t end = std::min( begin + batch, kept_count );
+                uint64_t budget = uint64_t( end - begin ) * 2;
+                if ( !insertionSort( kept_keys, kept_order, begin, begin, end, budget ) )
+                {
+                    sorted.store( false, std::memory_order_relaxed );
+                }
+            }
+        });
+        if ( !sorted.load() ) return false;
+
+        uint64_t budget = uint64_t( kept_count ) * 2;
+        for ( uint32_t b = 1; b < kept_batches; ++b )
+        {
+            const uint32_t begin = b * batch;
+            const uint32_t end = std::min( begin + batch, kept_count );
+            for ( uint32_t i = begin; i < end && kept_keys[ i ] < kept_keys[ i - 1 ]; ++i )
+            {
+                if ( !insertionSort( kept_keys, kept_order, 0, i, i + 1, budget ) ) return false;
+            }
+        }
+
+        // the split off pairs, with the arrays the last order was built in as scratch
+        radixSort( displaced_keys, displaced_order, keys, order, displaced_count, batch, _counts );
+
+        // both merged into the scratch arrays, in batches of the output found by merge path
+        kege::parallelFor( 0, batches, 1, [ = ]( uint32_t first, uint32_t last )
+        {
+            for ( uint32_t b = first; b < last; ++b )
+            {
+                const uint32_t begin = b * batch;
+                const uint32_t end = std::min( begin + batch, count );
+                uint32_t k = mergeSplit( kept_keys, kept_count, displaced_keys, displaced_count, begin );
+                uint32_t d = begin - k;
+                for ( uint32_t j = begin; j < end; ++j )
+                {
+                    if ( d >= displaced_count || ( k < kept_count && kept_keys[ k ] <= displaced_keys[ d ] ) )
+                    {
+                        keys[ j ] = kept_keys[ k ];
+                        order[ j ] = kept_order[ k ];
+                        ++k;
+                    }
+                    else
+                    {
+                        keys[ j ] = displaced_keys[ d ];
+                        order[ j ] = displaced_order[ d ];
+                        ++d;
+                    }
+                }
+            }
+        });
+
+        _keys.swap( _scratch_keys );
+        _order.swap( _scratch_order );
+        return true;
+    }
+
+    ParticleDepthSorter::ParticleDepthSorter()
+    :   _count( 0 )
+    ,   _previous_count( 0 )
+    ,   _backoff( 1 )
+    ,   _skip( 0 )
+    ,   _incremental( false )
+    {}
+
+}
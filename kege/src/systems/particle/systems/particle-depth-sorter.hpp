@@ -0,0 +1,168 @@
+//
+//  particle-depth-sorter.hpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef kege_particle_depth_sorter_hpp
+#define kege_particle_depth_sorter_hpp
+
+#include <vector>
+#include "../effect/particle-buffer.hpp"
+
+namespace kege{
+
+    /**
+     * @brief Orders the particles of several effects back to front for one view.
+     *
+     * The particles are not moved. The result is an order over all of them, index g standing for
+     * particle g - base( s ) of source s, with s = owner( g ). Depths are turned into 32 bit keys
+     * and sorted by a parallel radix sort, 8 bits a pass, passes over bytes every key shares are
+     * skipped.
+     *
+     * In INCREMENTAL mode the order of the last sort is reused. The particles that are still in
+     * their place of the last sort are kept in that order and touched up, the few that are not,
+     * because they are new, moved by a compaction, or moved far in depth, are sorted on their own
+     * and merged in. When too many are out of place it falls back to the full sort.
+     *
+     * One sorter per view, its sort() should not run on several threads at once.
+     */
+    class ParticleDepthSorter
+    {
+    public:
+
+        struct Source
+        {
+            const ParticleBuffer* particles;
+
+            /**
+             * places the particles in the world, the depth is measured after it.
+             */
+            mat44 model;
+        };
+
+        enum Mode{ FULL, INCREMENTAL };
+
+        /**
+         * @brief Sorts the particles of every source from far to near.
+         *
+         * @param depth The view's depth as a plane, dot( depth.xyz, p ) + depth.w is how far in front of the view the world space point p is.
+         * @return The number of particles sorted.
+         */
+        uint32_t sort( const std::vector< Source >& sources, const vec4& depth, Mode mode );
+
+        /**
+         * @brief Gets the sorted particles, far to near.
+         */
+        inline const uint32_t* order()const
+        {
+            return _order.data();
+        }
+
+        /**
+         * @brief Gets the source the particle at index belongs to.
+         */
+        inline uint32_t owner( uint32_t index )const
+        {
+            return _owners[ index ];
+        }
+
+        /**
+         * @brief Gets the index of the first particle of a source.
+         */
+        inline uint32_t base( uint32_t source )const
+        {
+            return _bases[ source ];
+        }
+
+        inline const std::vector< Source >& sources()const
+        {
+            return _sources;
+        }
+
+        inline uint32_t count()const
+        {
+            return _count;
+        }
+
+        /**
+         * @brief Whether the last sort was done incrementally, false if it fell back to the full sort.
+         */
+        inline bool wasIncremental()const
+        {
+            return _incremental;
+        }
+
+        ParticleDepthSorter();
+
+    public:
+
+        /**
+         * @brief The sorts split their work into batches of this many particles.
+         */
+        static uint32_t grain;
+
+        /**
+         * @brief A particle counts as out of place in INCREMENTAL mode when it is out of order with
+         * the particle this many places before or after it.
+         */
+        static uint32_t coherence_window;
+
+        /**
+         * @brief INCREMENTAL mode falls back to the full sort when more than this fraction of the particles is out of place.
+         */
+        static float max_displaced;
+
+    private:
+
+        struct Range
+        {
+            const ParticleBuffer* particles;
+            uint32_t base;
+            uint32_t count;
+        };
+
+        void computeKeys( const vec4& depth );
+        void sortFull();
+        bool sortIncremental();
+
+    private:
+
+        std::vector< Source > _sources;
+        std::vector< uint32_t > _bases;
+
+        /**
+         * the depth of every source as a plane in the space of its particles.
+         */
+        std::vector< vec4 > _planes;
+
+        /**
+         * the sources of the last sort, and where their particles were.
+         */
+        std::vector< Range > _previous;
+
+        std::vector< uint32_t > _owners;
+        std::vector< uint32_t > _depth_keys;
+        std::vector< uint32_t > _keys;
+        std::vector< uint32_t > _order;
+        std::vector< uint32_t > _scratch_keys;
+        std::vector< uint32_t > _scratch_order;
+        std::vector< uint32_t > _displaced_keys;
+        std::vector< uint32_t > _displaced_order;
+        std::vector< uint32_t > _remap;
+        std::vector< uint32_t > _counts;
+
+        uint32_t _count;
+        uint32_t _previous_count;
+
+        /**
+         * frames to wait before the next incremental sort is tried, after one failed.
+         */
+        uint32_t _backoff;
+        uint32_t _skip;
+        bool _incremental;
+    };
+
+}
+#endif /* kege_particle_depth_sorter_hpp */
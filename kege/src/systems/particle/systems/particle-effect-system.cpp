@@ -6,69 +6,70 @@
 //
 
 #include "particle-effect-system.hpp"
+#include "../../../core/math/algebra/lanes.hpp"
 
 namespace kege{
 
-    void ParticleEffectSystem::update( double dms )
+    using namespace kege::simd;
+
+
+    /**
+     * ages the particles in [first, last) and moves them by their velocity.
+     */
+    static void integrateParticles( ParticleBuffer& s, uint32_t first, uint32_t last, float dms, float rate_of_deterioration )
     {
-        for ( kege::Entity entity : *_entities )
+        const lanes zero = splat( 0.f );
+        const lanes h = splat( dms );
+        const lanes decay = splat( dms * rate_of_deterioration );
+
+        for ( uint32_t i = first; i < last; i += WIDTH )
         {
-            ParticleEffect* effect = entity.get< ParticleEffect >();
-            ParticleBuffer* buffer = entity.get< ParticleBuffer >();
+            store( s[ ParticleBuffer::HEALTH ] + i, maximum( sub( load( s[ ParticleBuffer::HEALTH ] + i ), decay ), zero ) );
+            store( s[ ParticleBuffer::POSITION_X ] + i, add( load( s[ ParticleBuffer::POSITION_X ] + i ), mul( load( s[ ParticleBuffer::VELOCITY_X ] + i ), h ) ) );
+            store( s[ ParticleBuffer::POSITION_Y ] + i, add( load( s[ ParticleBuffer::POSITION_Y ] + i ), mul( load( s[ ParticleBuffer::VELOCITY_Y ] + i ), h ) ) );
+            store( s[ ParticleBuffer::POSITION_Z ] + i, add( load( s[ ParticleBuffer::POSITION_Z ] + i ), mul( load( s[ ParticleBuffer::VELOCITY_Z ] + i ), h ) ) );
+        }
+    }
 
-            for (int i=0; i < buffer->particle_count; ++i)
-            {
-                Particle& particle = buffer->particles[ i ];
+    void ParticleEffectSystem::update( double dms )
+    {
+        /*
+         effects run in parallel with each other, and the particles of a large effect are split
+         into ranges as well. expired particles are removed up front by a compaction that is
+         split into ranges too, and has to finish before the particles are updated. every
+         behavior then runs over a whole range at once, the ranges are whole vectors of
+         particles so no two workers share one. an effect with a ParticleLOD only steps on the
+         frames its level of detail picked, by the time it skipped.
+         */
+        const uint32_t grain = ( std::max( ParallelFor::grain, 1u ) + ParticleBuffer::LANES - 1 ) / ParticleBuffer::LANES * ParticleBuffer::LANES;
+        EntityViewT< ParticleEffect, ParticleBuffer >( _entities ).parallelEach([ dms, grain ]( const Entity entity, ParticleEffect& effect_component, ParticleBuffer& buffer_component )
+        {
+            ParticleEffect* effect = &effect_component;
+            ParticleBuffer* buffer = &buffer_component;
 
-                if( particle.max_health == 0.0f )
-                {
-                    if ( effect->initails )
-                    {
-                        particle.color      = effect->initails->color.gen() * effect->initails->saturation.gen();
-                        particle.velocity   = effect->initails->velocity.gen() * effect->initails->speed.gen();
-                        particle.rotation   = effect->initails->mass.gen();
-                        particle.size       = effect->initails->size.gen();
-                        particle.invmass    = 1.0 / effect->initails->mass.gen();
-                        particle.max_health = effect->initails->lifetime.gen();
-                        particle.health     = particle.max_health;
-                    }
-                    else
-                    {
-                        particle.velocity   = {0.f,0.f,0.f};
-                        particle.max_health     = 1.f;
-                        particle.health     = 1.f;
-                        particle.invmass    = 1.f;
-                        particle.rotation   = 0.f;
-                        particle.size       = 1.f;
-                    }
-                }
+            const ParticleLOD* lod = entity.get< ParticleLOD >();
+            const double step = ( lod ) ? lod->step : dms;
+            if ( step <= 0.0 ) return;
 
-                if ( particle.health <= 0 )
-                {
-                    // delete expired particles
-                    Particle p = buffer->particles[i];
-                    buffer->particles[i] = buffer->particles[ buffer->particle_count - 1];
-                    buffer->particles[ buffer->particle_count - 1] = p;
-                    buffer->particle_count--;
-                    i -= 1;
-                    continue;
-                }
+            // delete expired particles
+            buffer->removeExpired();
 
+            kege::parallelFor( 0, buffer->paddedCount(), grain, [ step, effect, buffer ]( uint32_t first, uint32_t last )
+            {
                 for (int j=0; j < effect->behaviors.size(); ++j)
                 {
-                    effect->behaviors[i]->update( dms, particle );
+                    effect->behaviors[j]->update( step, *buffer, first, last );
                 }
-
-                particle.health -= dms * effect->rate_of_deterioration;
-                particle.health = kege::max( 0.f, particle.health );
-                particle.position += particle.velocity * dms;
-            }
-        }
+                integrateParticles( *buffer, first, last, float( step ), effect->rate_of_deterioration );
+            });
+        }, 1 );
     }
 
     bool ParticleEffectSystem::initialize()
     {
-        _signature = createEntitySignature< ParticleEffect, Transform >();
+        _signature = createEntitySignature< ParticleEffect, ParticleBuffer, Transform >();
+        _reads = createEntitySignature< ParticleEffect, ParticleLOD >();
+        _writes = createEntitySignature< ParticleBuffer >();
         return EntitySystem::initialize();
     }
     
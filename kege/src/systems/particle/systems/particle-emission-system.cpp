@@ -8,26 +8,110 @@
 #include "particle-emission-system.hpp"
 namespace kege{
 
+    uint32_t ParticleEmissionSystem::batch_size = 256;
+
     void ParticleEmissionSystem::update( double dms )
     {
+        /*
+         the emitters' timers run first, one effect after another, and every effect reserves its
+         new particles at the end of its buffer. the new particles are then generated in batches
+         on the job workers. every batch draws from its own random stream, picked by the entity
+         and the position of the batch in everything the emitter has emitted, so the particles
+         are the same whatever thread generates them.
+         */
+        _batches.clear();
         for ( kege::Entity entity : *_entities )
         {
             ParticleBuffer* buffer = entity.get< ParticleBuffer >();
             ParticleEmitter* emitter = entity.get< ParticleEmitter >();
+            const ParticleEffect* effect = entity.get< ParticleEffect >();
+            const ParticleLOD* lod = entity.get< ParticleLOD >();
+            if ( !emitter || !emitter->emitter ) continue;
 
-            uint32_t count = emitter->emitter->update( dms );
+            // a slower clock is a lower rate, the emitter keeps its own timing
+            uint32_t count = emitter->emitter->update( ( lod ) ? dms * lod->emission_scale : dms );
+            count = std::min( count, buffer->capacity() - buffer->particle_count );
 
-            for (int i=0; i < count && buffer->particles.size() <= buffer->particle_count; ++i)
+            const uint64_t seed = emitter->seed ^ ( uint64_t( entity.getID() ) * 0x9E3779B97F4A7C15ULL );
+            for ( uint32_t offset = 0; offset < count; offset += batch_size )
             {
-                Particle& particle = buffer->particles[ buffer->particle_count++ ];
-                particle.position = ( emitter->emitter ) ? emitter->emitter->emit() : vec3(0.0);
+                _batches.push_back
+                ({
+                    buffer, emitter->emitter.ref(), effect->initails.ref(), seed,
+                    emitter->emitted + offset,
+                    buffer->particle_count + offset,
+                    std::min( batch_size, count - offset )
+                });
+            }
+            buffer->particle_count += count;
+            emitter->emitted += count;
+        }
+
+        const std::vector< Batch >& batches = _batches;
+        kege::parallelFor( 0, uint32_t( batches.size() ), 1, [ &batches ]( uint32_t first, uint32_t last )
+        {
+            for ( uint32_t b = first; b < last; ++b )
+            {
+                emit( batches[ b ] );
+            }
+        });
+    }
+
+    void ParticleEmissionSystem::emit( const Batch& batch )
+    {
+        ParticleBuffer& s = *batch.buffer;
+        const uint32_t first = batch.first;
+        const uint32_t last = batch.first + batch.count;
+
+        RandomStream random( batch.seed, batch.sequence );
+        batch.emitter->emit( random, batch.count, s[ ParticleBuffer::POSITION_X ] + first, s[ ParticleBuffer::POSITION_Y ] + first, s[ ParticleBuffer::POSITION_Z ] + first );
+
+        const ParticleInitails* initails = batch.initails;
+        for ( uint32_t i = first; i < last; ++i )
+        {
+            Particle particle;
+            if ( initails )
+            {
+                // the operands of * are evaluated in no fixed order, each draw gets its own statement
+                const vec4 color        = initails->color.gen( random );
+                const float saturation  = initails->saturation.gen( random );
+                const vec3 direction    = initails->velocity.gen( random );
+                const float speed       = initails->speed.gen( random );
+                particle.color      = color * saturation;
+                particle.velocity   = direction * speed;
+                particle.rotation   = initails->rotation.gen( random );
+                particle.size       = initails->size.gen( random );
+                particle.invmass    = 1.0 / initails->mass.gen( random );
+                particle.max_health = initails->lifetime.gen( random );
+                particle.health     = particle.max_health;
+            }
+            else
+            {
+                particle.color      = vec4( 1.f );
                 particle.velocity   = {0.f, 0.f, 0.f};
-                particle.max_health = 0.f;
-                particle.health     = 0.f;
+                particle.max_health = 1.f;
+                particle.health     = 1.f;
                 particle.invmass    = 1.f;
                 particle.rotation   = 0.f;
                 particle.size       = 1.f;
             }
+
+            s[ ParticleBuffer::VELOCITY_X ][ i ] = particle.velocity.x;
+            s[ ParticleBuffer::VELOCITY_Y ][ i ] = particle.velocity.y;
+            s[ ParticleBuffer::VELOCITY_Z ][ i ] = particle.velocity.z;
+            s[ ParticleBuffer::COLOR_R ][ i ] = particle.color.x;
+            s[ ParticleBuffer::COLOR_G ][ i ] = particle.color.y;
+            s[ ParticleBuffer::COLOR_B ][ i ] = particle.color.z;
+            s[ ParticleBuffer::COLOR_A ][ i ] = particle.color.w;
+            s[ ParticleBuffer::SPRITE_X ][ i ] = 0.f;
+            s[ ParticleBuffer::SPRITE_Y ][ i ] = 0.f;
+            s[ ParticleBuffer::SPRITE_Z ][ i ] = 0.f;
+            s[ ParticleBuffer::SPRITE_W ][ i ] = 0.f;
+            s[ ParticleBuffer::SIZE ][ i ] = particle.size;
+            s[ ParticleBuffer::ROTATION ][ i ] = particle.rotation;
+            s[ ParticleBuffer::INVMASS ][ i ] = particle.invmass;
+            s[ ParticleBuffer::MAX_HEALTH ][ i ] = particle.max_health;
+            s[ ParticleBuffer::HEALTH ][ i ] = particle.health;
         }
     }
 
@@ -45,6 +129,8 @@ namespace kege{
     :   kege::EntitySystem( engine, "particle-emitter-updater", REQUIRE_UPDATE )
     {
         _signature = createEntitySignature< ParticleEffect, ParticleBuffer, Transform >();
+        _reads = createEntitySignature< ParticleEffect, ParticleLOD >();
+        _writes = createEntitySignature< ParticleBuffer, ParticleEmitter >();
     }
 
     KEGE_REGISTER_SYSTEM( ParticleEmissionSystem, "particle-emitter-updater" );
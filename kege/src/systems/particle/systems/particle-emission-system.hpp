@@ -21,6 +21,36 @@ namespace kege{
         void update( double dms );
         bool initialize();
         void shutdown();
+
+    public:
+
+        /**
+         * @brief New particles are generated in batches of this many, each batch from its own
+         * random stream. Changing it changes which random numbers the particles get.
+         */
+        static uint32_t batch_size;
+
+    private:
+
+        /**
+         * new particles of one effect, generated together.
+         */
+        struct Batch
+        {
+            ParticleBuffer* buffer;
+            Emitter* emitter;
+            const ParticleInitails* initails;
+            uint64_t seed;
+            uint64_t sequence;
+            uint32_t first;
+            uint32_t count;
+        };
+
+        static void emit( const Batch& batch );
+
+    private:
+
+        std::vector< Batch > _batches;
     };
 
 }
@@ -0,0 +1,144 @@
+//
+//  particle-lod-system.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#include <algorithm>
+#include "particle-lod-system.hpp"
+
+namespace kege{
+
+    uint32_t ParticleLODSystem::particle_budget = 500000;
+
+    void ParticleLODSystem::update( double dms )
+    {
+        _stats = {};
+        _candidates.clear();
+        ++_frame;
+
+        Frustum frustum;
+        vec3 eye = {0.f, 0.f, 0.f};
+        const Entity& player = _engine->scene()->getPlayer();
+        const Camera* camera = ( player ) ? player.get< Camera >() : nullptr;
+        if ( camera )
+        {
+            frustum = getFrustum( camera->matrices.projection, camera->matrices.transform );
+            eye = camera->matrices.position;
+        }
+
+        for ( kege::Entity entity : *_entities )
+        {
+            ParticleLOD* lod = entity.get< ParticleLOD >();
+            const ParticleBuffer* buffer = entity.get< ParticleBuffer >();
+            const Transform* transform = entity.get< Transform >();
+
+            // without a camera there is nothing to measure against, every effect runs at full rate
+            lod->distance = ( camera ) ? magn( transform->position - eye ) : 0.f;
+            lod->visible = !camera ||
+            (
+                lod->distance <= lod->cull_distance &&
+                testFrustumSphere( frustum, Sphere( transform->position, lod->radius ) )
+            );
+
+            const uint32_t max_interval = std::max( lod->max_tick_interval, 1u );
+            if ( lod->distance > lod->cull_distance )
+            {
+                lod->emission_scale = 0.f;
+                lod->tick_interval = max_interval;
+            }
+            else if ( !lod->visible )
+            {
+                // kept running slowly, so the effect looks alive when it comes into view
+                lod->emission_scale = lod->min_emission;
+                lod->tick_interval = max_interval;
+            }
+            else
+            {
+                const float range = lod->far_distance - lod->near_distance;
+                const float t = ( range > 0.f )
+                ? std::min( std::max( ( lod->distance - lod->near_distance ) / range, 0.f ), 1.f )
+                : ( ( lod->distance < lod->far_distance ) ? 0.f : 1.f );
+
+                lod->emission_scale = 1.f + ( lod->min_emission - 1.f ) * t;
+                lod->tick_interval = 1 + uint32_t( t * float( max_interval - 1 ) + 0.5f );
+            }
+
+            /*
+             the skipped time is made up in the step the effect does take. effects are spread
+             over the frames by their id, so the far ones do not all step on the same frame.
+             */
+            lod->elapsed += dms;
+            if ( ( _frame + entity.getID() ) % lod->tick_interval == 0 )
+            {
+                lod->step = lod->elapsed;
+                lod->elapsed = 0.0;
+            }
+            else
+            {
+                lod->step = 0.0;
+            }
+            lod->throttled = false;
+
+            _stats.effects += 1;
+            _stats.visible += lod->visible;
+            _stats.simulated += ( lod->step > 0.0 ) ? buffer->particle_count : 0;
+            _stats.drawn += ( lod->visible ) ? buffer->particle_count : 0;
+            _candidates.push_back({ lod, buffer->particle_count });
+        }
+
+        if ( particle_budget == 0 ) return;
+
+        /*
+         the effects are ranked by priority, then visible before hidden, then near before far.
+         an effect keeps emitting while it and the effects ranked above it hold fewer particles
+         than the budget. particles that are alive are left to expire.
+         */
+        std::sort( _candidates.begin(), _candidates.end(), []( const Candidate& a, const Candidate& b )
+        {
+            if ( a.lod->priority != b.lod->priority ) return a.lod->priority > b.lod->priority;
+            if ( a.lod->visible != b.lod->visible ) return a.lod->visible;
+            return a.lod->distance < b.lod->distance;
+        });
+
+        uint64_t used = 0;
+        for ( const Candidate& candidate : _candidates )
+        {
+            used += candidate.count;
+            if ( used >= particle_budget && candidate.lod->emission_scale > 0.f )
+            {
+                candidate.lod->emission_scale = 0.f;
+                candidate.lod->throttled = true;
+                _stats.throttled += 1;
+            }
+        }
+    }
+
+    const ParticleLODSystem::Stats& ParticleLODSystem::stats()const
+    {
+        return _stats;
+    }
+
+    bool ParticleLODSystem::initialize()
+    {
+        return EntitySystem::initialize();
+    }
+
+    void ParticleLODSystem::shutdown()
+    {
+        return EntitySystem::shutdown();
+    }
+
+    ParticleLODSystem::ParticleLODSystem( kege::Engine* engine )
+    :   kege::EntitySystem( engine, "particle-lod", REQUIRE_UPDATE )
+    ,   _stats()
+    ,   _frame( 0 )
+    {
+        _signature = createEntitySignature< ParticleLOD, ParticleBuffer, Transform >();
+        _reads = createEntitySignature< ParticleBuffer, Transform, Camera >();
+        _writes = createEntitySignature< ParticleLOD >();
+    }
+
+    KEGE_REGISTER_SYSTEM( ParticleLODSystem, "particle-lod" );
+}
@@ -0,0 +1,84 @@
+//
+//  particle-lod-system.hpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef kege_particle_lod_system_hpp
+#define kege_particle_lod_system_hpp
+
+#include "../effect/particle-effect.hpp"
+#include "../../-/system-dependencies.hpp"
+
+namespace kege{
+
+    /**
+     * @brief Picks the level of detail of every particle effect with a ParticleLOD each frame.
+     *
+     * Effects are culled against the frustum of the player's camera and slowed down with their
+     * distance to it. When the effects hold more particles than the budget, the effects of the
+     * lowest priority, and of those the farthest, stop emitting until enough particles expired.
+     * Runs before the emission and effect systems, which read the level it picked.
+     */
+    class ParticleLODSystem : public kege::EntitySystem
+    {
+    public:
+
+        struct Stats
+        {
+            uint32_t effects;
+
+            /**
+             * effects whose sphere is in the view.
+             */
+            uint32_t visible;
+
+            /**
+             * effects that stopped emitting to keep the budget.
+             */
+            uint32_t throttled;
+
+            /**
+             * particles of the effects that are simulated this frame.
+             */
+            uint32_t simulated;
+
+            /**
+             * particles of the effects that are drawn this frame.
+             */
+            uint32_t drawn;
+        };
+
+        /**
+         * @brief Gets the numbers of the last update, counted before this frame's emission.
+         */
+        const Stats& stats()const;
+
+        ParticleLODSystem( kege::Engine* engine );
+        void update( double dms );
+        bool initialize();
+        void shutdown();
+
+    public:
+
+        /**
+         * @brief The most particles all effects with a ParticleLOD may hold together, 0 for no limit.
+         */
+        static uint32_t particle_budget;
+
+    private:
+
+        struct Candidate
+        {
+            ParticleLOD* lod;
+            uint32_t count;
+        };
+
+        std::vector< Candidate > _candidates;
+        Stats _stats;
+        uint32_t _frame;
+    };
+
+}
+#endif /* kege_particle_lod_system_hpp */
@@ -9,7 +9,11 @@
 
 namespace kege::algo{
     
-    bool getClipPoints( const OBB* box, Plane plane, Line edges[4], std::vector< vec3 >* intersections )
+    /**
+     * `feature` names the clipping stage and faces, the edge index is added to it so every point
+     * gets an id that stays the same while the boxes touch the same way.
+     */
+    bool getClipPoints( const OBB* box, Plane plane, Line edges[4], std::vector< vec3 >* intersections, std::vector< uint32_t >* features, uint32_t feature )
     {
         vec3 point;
         for ( int i = 0; i < 4; ++i )
@@ -20,6 +24,7 @@ namespace kege::algo{
                 {
                     //float penetration = computePenetrationDepth(edges[ i ], plane);
                     intersections->push_back( point );
+                    features->push_back( feature | uint32_t( i + 1 ) );
                 }
             }
         }
@@ -39,6 +44,7 @@ namespace kege::algo{
     void generateContacts( const OBB* box[2], CollisionManifold* contact, float penetration, bool flip )
     {
         std::vector< vec3 > intersections;
+        std::vector< uint32_t > features;
         contact->contact_count = 0;
         /**
          * 1. Understanding Reference vs. Incident Boxes
@@ -127,6 +133,9 @@ namespace kege::algo{
         vec3 incident_normal = axes[1][inc_axis];
 
 
+        // the faces in the upper bits, the clipping stage and edge in the lower ones
+        const uint32_t faces = uint32_t( ref_axis * 6 + inc_axis ) << 8;
+
         inc_axis /= 2;
         ref_axis /= 2;
 
@@ -142,28 +151,28 @@ namespace kege::algo{
 
         getOBBFacePlane( reference_box, reference_normal, ref_axis, &ref_face_plane );
         getOBBSideEdges( incident_box, incident_normal, inc_axis, inc_side_edges );
-        getClipPoints( reference_box, ref_face_plane, inc_side_edges, &intersections );
+        getClipPoints( reference_box, ref_face_plane, inc_side_edges, &intersections, &features, faces | ( 1 << 4 ) );
 
         getOBBFaceEdges( reference_box, reference_normal, ref_axis, ref_face_edges );
         getOBBSidePlanes( incident_box, incident_normal, inc_axis, inc_side_planes );
-        getClipPoints( incident_box, inc_side_planes[0], ref_face_edges, &intersections );
-        getClipPoints( incident_box, inc_side_planes[1], ref_face_edges, &intersections );
-        getClipPoints( incident_box, inc_side_planes[2], ref_face_edges, &intersections );
-        getClipPoints( incident_box, inc_side_planes[3], ref_face_edges, &intersections );
+        getClipPoints( incident_box, inc_side_planes[0], ref_face_edges, &intersections, &features, faces | ( 2 << 4 ) );
+        getClipPoints( incident_box, inc_side_planes[1], ref_face_edges, &intersections, &features, faces | ( 3 << 4 ) );
+        getClipPoints( incident_box, inc_side_planes[2], ref_face_edges, &intersections, &features, faces | ( 4 << 4 ) );
+        getClipPoints( incident_box, inc_side_planes[3], ref_face_edges, &intersections, &features, faces | ( 5 << 4 ) );
 
         getOBBSideEdges( reference_box, reference_normal, ref_axis, ref_side_edges );
         getOBBFacePlane( incident_box, incident_normal, inc_axis, &inc_face_plane );
-        getClipPoints( incident_box, inc_face_plane, ref_side_edges, &intersections );
+        getClipPoints( incident_box, inc_face_plane, ref_side_edges, &intersections, &features, faces | ( 6 << 4 ) );
 
         if( intersections.size() <= 2 )
         {
-            getClipPoints( incident_box, inc_face_plane, ref_face_edges, &intersections );
+            getClipPoints( incident_box, inc_face_plane, ref_face_edges, &intersections, &features, faces | ( 7 << 4 ) );
         }
 
         if( intersections.size() <= 2 )
         {
             getOBBFaceEdges( incident_box, incident_normal, inc_axis, inc_face_edges );
-            getClipPoints( reference_box, ref_face_plane, inc_face_edges, &intersections );
+            getClipPoints( reference_box, ref_face_plane, inc_face_edges, &intersections, &features, faces | ( 8 << 4 ) );
         }
 
 //        /**
@@ -251,10 +260,12 @@ namespace kege::algo{
         {
             contact->contacts[i].point = intersections[i];
             contact->contacts[i].depth = penetration;
+            contact->contacts[i].feature = features[i];
             contact->contact_count++;
         }
 #ifdef KEGE_DEBUG_CONTACT_GENERATION
-        for (int i = 0; i < intersections.size(); ++i)
+        // only the first MAX_CONTACTS clip points were kept
+        for (uint32_t i = 0; i < contact->contact_count; ++i)
         {
             Communication::broadcast< const MsgDrawAABB& >(MsgDrawAABB{
                 AABB
@@ -1,20 +0,0 @@
-//
-//  box-vs-cone.cpp
-//  flat-landscape
-//
-//  Created by Kenneth Esdaile on 4/16/25.
-//
-
-#include "box-vs-cone.hpp"
-
-namespace kege::algo{
-
-    bool boxConeCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions )
-    {
-        return false;
-    }
-    bool coneBoxCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions )
-    {
-        return false;
-    }
-}
@@ -33,7 +33,7 @@ namespace kege::algo{
 
         vec3 delta = closest_points[1] - closest_points[0];
         float distanceSquared = kege::magnSq( delta );
-        float radiusSum = capsule1->radius + capsule1->radius;
+        float radiusSum = capsule1->radius + capsule2->radius;
 
         if (distanceSquared > radiusSum * radiusSum)
         {
@@ -1,20 +0,0 @@
-//
-//  capsule-vs-cone.cpp
-//  flat-landscape
-//
-//  Created by Kenneth Esdaile on 4/15/25.
-//
-
-#include "capsule-vs-cone.hpp"
-
-namespace kege::algo{
-
-    bool capsuleConeCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions )
-    {
-        return false;
-    }
-    bool coneCapsuleCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions )
-    {
-        return false;
-    }
-}
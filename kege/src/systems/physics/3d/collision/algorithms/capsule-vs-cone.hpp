@@ -1,19 +0,0 @@
-//
-//  capsule-vs-cone.hpp
-//  flat-landscape
-//
-//  Created by Kenneth Esdaile on 4/15/25.
-//
-
-#ifndef capsule_vs_cone_hpp
-#define capsule_vs_cone_hpp
-
-#include "../../collision/algorithms/utils.hpp"
-
-namespace kege::algo{
-
-    bool capsuleConeCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions );
-    bool coneCapsuleCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions );
-}
-
-#endif /* capsule_vs_cone_hpp */
@@ -1,19 +0,0 @@
-//
-//  capsule-vs-cylinder.hpp
-//  flat-landscape
-//
-//  Created by Kenneth Esdaile on 4/15/25.
-//
-
-#ifndef capsule_vs_cylinder_hpp
-#define capsule_vs_cylinder_hpp
-
-#include "../../collision/algorithms/utils.hpp"
-
-namespace kege::algo{
-
-    bool capsuleCylinderCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions );
-    bool cylinderCapsuleCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions );
-
-}
-#endif /* capsule_vs_cylinder_hpp */
@@ -1,21 +0,0 @@
-//
-//  capsule-vs-sphere.cpp
-//  flat-landscape
-//
-//  Created by Kenneth Esdaile on 4/15/25.
-//
-
-#include "capsule-vs-sphere.hpp"
-
-namespace kege::algo{
-
-    bool capsuleSphereCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions )
-    {
-        return false;
-    }
-    bool sphereCapsuleCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions )
-    {
-        return false;
-    }
-
-}
@@ -98,24 +98,9 @@ namespace kege::algo{
 
             //drawLine({ intersection, intersection + normal * 5 });
             //drawAABB({ intersection - 0.05, intersection + 0.05 });
+            return true;
         }
         return false;
     }
 
-
-    bool circleBoxCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions ){return false;}
-    bool circleConeCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions ){return false;}
-    bool circleCapsuleCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions ){return false;}
-    bool circleCylinderCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions ){return false;}
-//    bool circlePlaneCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions ){return false;}
-    bool circleSphereCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions ){return false;}
-    bool circleMeshCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions ){return false;}
-
-    bool boxCircleCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions ){return false;}
-    bool coneCircleCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions ){return false;}
-    bool capsuleCircleCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions ){return false;}
-    bool cylinderCircleCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions ){return false;}
-//    bool planeCircleCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions ){return false;}
-    bool sphereCircleCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions ){return false;}
-    bool meshCircleCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions ){return false;}
 }
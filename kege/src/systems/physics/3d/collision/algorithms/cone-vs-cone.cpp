@@ -1,16 +0,0 @@
-//
-//  cone-vs-cone.cpp
-//  flat-landscape
-//
-//  Created by Kenneth Esdaile on 4/15/25.
-//
-
-#include "cone-vs-cone.hpp"
-
-namespace kege::algo{
-
-    bool coneConeCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions )
-    {
-        return false;
-    }
-}
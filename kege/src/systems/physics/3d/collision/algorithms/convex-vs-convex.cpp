@@ -0,0 +1,124 @@
+//
+//  convex-vs-convex.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#include "convex-vs-convex.hpp"
+#include "gjk-epa.hpp"
+
+namespace kege::algo{
+
+    /**
+     * the manifold of two shapes that overlap, or with a margin, that are less than it apart.
+     */
+    static bool convexContacts( Rigidbody* a, Rigidbody* b, float margin, kege::CollisionRegistry& collisions )
+    {
+        const ColliderSupport shape_a( a->collider.ref() );
+        const ColliderSupport shape_b( b->collider.ref() );
+
+        ConvexContact contact;
+        if ( !gjkPenetration( shape_a, shape_b, contact ) && !( margin > 0.f && gjkSeparation( shape_a, shape_b, margin, contact ) ) )
+        {
+            return false;
+        }
+
+        vec3 points[ MAX_CONTACTS ];
+        float depths[ MAX_CONTACTS ];
+        const uint32_t count = convexContactPoints( shape_a, shape_b, contact, points, depths, margin );
+
+        CollisionManifold* collision = collisions.generate();
+        collision->objects[0] = a;
+        collision->objects[1] = b;
+        collision->normal = contact.normal;
+        collision->contact_count = count;
+        for ( uint32_t i = 0; i < count; ++i )
+        {
+            // the clipped points change with the features, they are matched by where they are
+            collision->contacts[ i ].point = points[ i ];
+            collision->contacts[ i ].depth = depths[ i ];
+            collision->contacts[ i ].feature = 0;
+        }
+        return true;
+    }
+
+    bool convexCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions )
+    {
+        return convexContacts( a, b, 0.f, collisions );
+    }
+
+    bool convexSpeculativeCollision( Rigidbody* a, Rigidbody* b, float margin, kege::CollisionRegistry& collisions )
+    {
+        return convexContacts( a, b, margin, collisions );
+    }
+
+    static bool planeConvexContacts( Rigidbody* a, Rigidbody* b, float margin, kege::CollisionRegistry& collisions )
+    {
+        const Plane* plane = a->collider->getPlane();
+        const Collider* shape = b->collider.ref();
+
+        const vec3 deepest = shape->support( -plane->normal );
+        const float distance = dot( plane->normal, deepest ) - plane->distance;
+        if ( distance >= margin ) return false;
+
+        // every point of the feature facing the plane that is below it, or within the margin above it
+        vec3 face[ MAX_FACE_POINTS ];
+        vec3 face_normal;
+        const uint32_t face_count = shape->supportFace( -plane->normal, face, face_normal );
+
+        vec3 points[ MAX_FACE_POINTS ];
+        float depths[ MAX_FACE_POINTS ];
+        uint32_t count = 0;
+        for ( uint32_t i = 0; i < face_count; ++i )
+        {
+            const float d = dot( plane->normal, face[ i ] ) - plane->distance;
+            if ( d >= margin ) continue;
+            points[ count ] = face[ i ];
+            depths[ count ] = -d;
+            count += 1;
+        }
+        if ( count == 0 )
+        {
+            points[0] = deepest;
+            depths[0] = -distance;
+            count = 1;
+        }
+        count = reduceContactPoints( points, depths, count, plane->normal );
+
+        CollisionManifold* collision = collisions.generate();
+        collision->objects[0] = a;
+        collision->objects[1] = b;
+        collision->normal = plane->normal;
+        collision->contact_count = count;
+        for ( uint32_t i = 0; i < count; ++i )
+        {
+            collision->contacts[ i ].point = points[ i ];
+            collision->contacts[ i ].depth = depths[ i ];
+            collision->contacts[ i ].feature = 0;
+        }
+        return true;
+    }
+
+    bool planeConvexCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions )
+    {
+        return planeConvexContacts( a, b, 0.f, collisions );
+    }
+
+    bool convexPlaneCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions )
+    {
+        // the manifold names the plane first, with the normal pointing at the other shape
+        return planeConvexContacts( b, a, 0.f, collisions );
+    }
+
+    bool planeConvexSpeculativeCollision( Rigidbody* a, Rigidbody* b, float margin, kege::CollisionRegistry& collisions )
+    {
+        return planeConvexContacts( a, b, margin, collisions );
+    }
+
+    bool convexPlaneSpeculativeCollision( Rigidbody* a, Rigidbody* b, float margin, kege::CollisionRegistry& collisions )
+    {
+        return planeConvexContacts( b, a, margin, collisions );
+    }
+
+}
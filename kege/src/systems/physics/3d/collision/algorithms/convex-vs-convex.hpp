@@ -0,0 +1,40 @@
+//
+//  convex-vs-convex.hpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef convex_vs_convex_hpp
+#define convex_vs_convex_hpp
+
+#include "../../collision/algorithms/utils.hpp"
+
+namespace kege::algo{
+
+    /**
+     * @brief Collides any two colliders with a support mapping, with GJK and EPA, clipping their
+     * facing features for the contact points.
+     */
+    bool convexCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions );
+
+    /**
+     * @brief Collides a plane with any collider with a support mapping.
+     */
+    bool planeConvexCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions );
+    bool convexPlaneCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions );
+
+    /**
+     * @brief Like convexCollision(), but shapes that are apart by less than margin also get a
+     * manifold, with negative depths. The solver lets such speculative contacts close the gap
+     * within the step and no further, so fast bodies stop at a surface instead of passing through.
+     */
+    bool convexSpeculativeCollision( Rigidbody* a, Rigidbody* b, float margin, kege::CollisionRegistry& collisions );
+
+    /**
+     * @brief Like planeConvexCollision(), with speculative contacts up to margin above the plane.
+     */
+    bool planeConvexSpeculativeCollision( Rigidbody* a, Rigidbody* b, float margin, kege::CollisionRegistry& collisions );
+    bool convexPlaneSpeculativeCollision( Rigidbody* a, Rigidbody* b, float margin, kege::CollisionRegistry& collisions );
+}
+#endif /* convex_vs_convex_hpp */
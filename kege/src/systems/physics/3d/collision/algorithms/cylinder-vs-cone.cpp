@@ -1,20 +0,0 @@
-//
-//  cylinder-vs-cone.cpp
-//  flat-landscape
-//
-//  Created by Kenneth Esdaile on 4/15/25.
-//
-
-#include "cylinder-vs-cone.hpp"
-
-namespace kege::algo{
-
-    bool cylinderConeCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions )
-    {
-        return false;
-    }
-    bool coneCylinderCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions )
-    {
-        return false;
-    }
-}
@@ -1,21 +0,0 @@
-//
-//  cylinder-vs-sphere.cpp
-//  flat-landscape
-//
-//  Created by Kenneth Esdaile on 4/15/25.
-//
-
-#include "cylinder-vs-sphere.hpp"
-
-namespace kege::algo{
-
-    bool cylinderSphereCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions )
-    {
-        return false;
-    }
-    bool sphereCylinderCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions )
-    {
-        return false;
-    }
-
-}
@@ -0,0 +1,766 @@
+//
+//  gjk-epa.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#include <cfloat>
+#include <algorithm>
+#include "gjk-epa.hpp"
+
+namespace kege::algo{
+
+    enum
+    {
+        GJK_MAX_ITERATIONS = 32,
+        EPA_MAX_ITERATIONS = 48,
+        EPA_MAX_VERTICES = EPA_MAX_ITERATIONS + 4,
+        EPA_MAX_FACES = 2 * EPA_MAX_VERTICES,
+        EPA_MAX_EDGES = 3 * EPA_MAX_FACES / 2,
+        CLIP_POINTS = 2 * MAX_FACE_POINTS + 4
+    };
+
+    // GJK stops once a step gets the distance closer by less than this fraction of it
+    static const float GJK_RELATIVE_TOLERANCE = 1e-4f;
+
+    // closer than this the shapes touch, and EPA takes over
+    static const float GJK_TOUCH_DISTANCE = 1e-5f;
+
+    // cores closer than this leave no direction to push along, and the shapes go through EPA
+    static const float CORE_DISTANCE = 1e-4f;
+
+    /*
+     EPA stops once the polytope grows by less than this toward the closest face. round shapes
+     take many steps to get close, a millimeter is well inside the slop of the solver.
+     */
+    static const float EPA_TOLERANCE = 1e-3f;
+
+    /*
+     a face of either shape is only clipped against when it is within about 25 degrees of the
+     contact normal, anything steeper is an edge or a corner and gets the single EPA point.
+     */
+    static const float REFERENCE_COSINE = 0.9f;
+
+    // the first shape keeps the reference face on near ties, so the choice does not flip between steps
+    static const float REFERENCE_BIAS = 1e-3f;
+
+    /*
+     the shapes may go further into each other along the face normal than along the EPA normal,
+     by this fraction of the depth plus the slack, before the face is passed over. a face any
+     further out of line would push the shapes apart harder than they overlap.
+     */
+    static const float REFERENCE_DEPTH_RATIO = 0.05f;
+    static const float REFERENCE_DEPTH_SLACK = 5e-3f;
+
+    vec3 ColliderSupport::coreSupport( const vec3& direction )const
+    {
+        if ( const Sphere* sphere = collider->getSphere() )
+        {
+            return sphere->center;
+        }
+        if ( const Capsule* capsule = collider->getCapsule() )
+        {
+            const float half = ( dot( direction, capsule->axes[0] ) >= 0.f ) ? capsule->height * 0.5f : -capsule->height * 0.5f;
+            return capsule->center + capsule->axes[0] * half;
+        }
+        return collider->support( direction );
+    }
+
+    float ColliderSupport::margin()const
+    {
+        if ( const Sphere* sphere = collider->getSphere() ) return sphere->radius;
+        if ( const Capsule* capsule = collider->getCapsule() ) return capsule->radius;
+        return 0.f;
+    }
+
+    /**
+     * the core of a shape as a shape of its own.
+     */
+    struct CoreSupport : public ConvexSupport
+    {
+        vec3 support( const vec3& direction )const
+        {
+            return shape.coreSupport( direction );
+        }
+
+        uint32_t supportFace( const vec3& direction, vec3* points, vec3& normal )const
+        {
+            normal = direction;
+            points[0] = shape.coreSupport( direction );
+            return 1;
+        }
+
+        CoreSupport( const ConvexSupport& shape ): shape( shape ) {}
+        const ConvexSupport& shape;
+    };
+
+    /**
+     * a point of the Minkowski difference a - b, with the points of the shapes it came from.
+     */
+    struct Vertex
+    {
+        vec3 w;
+        vec3 a;
+        vec3 b;
+    };
+
+    struct Simplex
+    {
+        Vertex v[4];
+        float weights[4];
+        uint32_t count;
+    };
+
+    static inline Vertex supportOf( const ConvexSupport& a, const ConvexSupport& b, const vec3& direction )
+    {
+        Vertex v;
+        v.a = a.support( direction );
+        v.b = b.support( -direction );
+        v.w = v.a - v.b;
+        return v;
+    }
+
+    static inline void keep( Simplex& s, uint32_t i, float wi )
+    {
+        s.v[0] = s.v[ i ];
+        s.weights[0] = wi;
+        s.count = 1;
+    }
+
+    static inline void keep( Simplex& s, uint32_t i, float wi, uint32_t j, float wj )
+    {
+        const Vertex vi = s.v[ i ];
+        const Vertex vj = s.v[ j ];
+        s.v[0] = vi;
+        s.v[1] = vj;
+        s.weights[0] = wi;
+        s.weights[1] = wj;
+        s.count = 2;
+    }
+
+    static void closestOnSegment( Simplex& s )
+    {
+        const vec3 ab = s.v[1].w - s.v[0].w;
+        const float length_sq = dot( ab, ab );
+        const float t = ( length_sq > 0.f ) ? -dot( s.v[0].w, ab ) / length_sq : 0.f;
+        if ( t <= 0.f ) keep( s, 0, 1.f );
+        else if ( t >= 1.f ) keep( s, 1, 1.f );
+        else
+        {
+            s.weights[0] = 1.f - t;
+            s.weights[1] = t;
+        }
+    }
+
+    /**
+     * the closest point of a triangle to the origin, as closestPointOnTriangle() finds it,
+     * dropping the corners it does not need.
+     */
+    static void closestOnTriangle( Simplex& s )
+    {
+        const vec3& a = s.v[0].w;
+        const vec3& b = s.v[1].w;
+        const vec3& c = s.v[2].w;
+        const vec3 ab = b - a;
+        const vec3 ac = c - a;
+
+        const float d1 = -dot( ab, a );
+        const float d2 = -dot( ac, a );
+        if ( d1 <= 0.f && d2 <= 0.f ) return keep( s, 0, 1.f );
+
+        const float d3 = -dot( ab, b );
+        const float d4 = -dot( ac, b );
+        if ( d3 >= 0.f && d4 <= d3 ) return keep( s, 1, 1.f );
+
+        const float vc = d1 * d4 - d3 * d2;
+        if ( vc <= 0.f && d1 >= 0.f && d3 <= 0.f )
+        {
+            const float t = d1 / ( d1 - d3 );
+            return keep( s, 0, 1.f - t, 1, t );
+        }
+
+        const float d5 = -dot( ab, c );
+        const float d6 = -dot( ac, c );
+        if ( d6 >= 0.f && d5 <= d6 ) return keep( s, 2, 1.f );
+
+        const float vb = d5 * d2 - d1 * d6;
+        if ( vb <= 0.f && d2 >= 0.f && d6 <= 0.f )
+        {
+            const float t = d2 / ( d2 - d6 );
+            return keep( s, 0, 1.f - t, 2, t );
+        }
+
+        const float va = d3 * d6 - d5 * d4;
+        if ( va <= 0.f && ( d4 - d3 ) >= 0.f && ( d5 - d6 ) >= 0.f )
+        {
+            const float t = ( d4 - d3 ) / ( ( d4 - d3 ) + ( d5 - d6 ) );
+            return keep( s, 1, 1.f - t, 2, t );
+        }
+
+        const float denom = 1.f / ( va + vb + vc );
+        s.weights[1] = vb * denom;
+        s.weights[2] = vc * denom;
+        s.weights[0] = 1.f - s.weights[1] - s.weights[2];
+    }
+
+    /**
+     * @return True if the origin is inside the tetrahedron, otherwise the simplex is reduced to
+     * the closest face, edge or corner.
+     */
+    static bool closestOnTetrahedron( Simplex& s )
+    {
+        static const uint32_t faces[4][4] = { { 0, 1, 2, 3 }, { 0, 3, 1, 2 }, { 0, 2, 3, 1 }, { 1, 3, 2, 0 } };
+
+        float best = FLT_MAX;
+        Simplex closest = s;
+        bool outside = false;
+        for ( const auto& f : faces )
+        {
+            const vec3& a = s.v[ f[0] ].w;
+            const vec3 n = cross( s.v[ f[1] ].w - a, s.v[ f[2] ].w - a );
+            const float origin_side = -dot( n, a );
+            const float other_side = dot( n, s.v[ f[3] ].w - a );
+
+            // a flat tetrahedron has no inside, every face is tried
+            if ( origin_side * other_side > 0.f && fabsf( other_side ) > KEGE_EPSILON_F * KEGE_EPSILON_F ) continue;
+            outside = true;
+
+            Simplex face;
+            face.v[0] = s.v[ f[0] ];
+            face.v[1] = s.v[ f[1] ];
+            face.v[2] = s.v[ f[2] ];
+            face.count = 3;
+            closestOnTriangle( face );
+
+            vec3 v( 0.f, 0.f, 0.f );
+            for ( uint32_t i = 0; i < face.count; ++i ) v += face.v[ i ].w * face.weights[ i ];
+            if ( dot( v, v ) < best )
+            {
+                best = dot( v, v );
+                closest = face;
+            }
+        }
+
+        if ( !outside ) return true;
+        s = closest;
+        return false;
+    }
+
+    /**
+     * @return True if the origin is inside the simplex.
+     */
+    static bool solve( Simplex& s, vec3& v )
+    {
+        bool inside = false;
+        switch ( s.count )
+        {
+            case 1: s.weights[0] = 1.f; break;
+            case 2: closestOnSegment( s ); break;
+            case 3: closestOnTriangle( s ); break;
+            default: inside = closestOnTetrahedron( s ); break;
+        }
+
+        v = vec3( 0.f, 0.f, 0.f );
+        if ( !inside )
+        {
+            for ( uint32_t i = 0; i < s.count; ++i ) v += s.v[ i ].w * s.weights[ i ];
+        }
+        return inside;
+    }
+
+    /**
+     * @param separation Stop as soon as the shapes are known to be further apart than this, the
+     * distance returned is then only known to be more than it.
+     * @return The distance of the origin from the Minkowski difference, 0 when it is inside,
+     * with the simplex GJK ended on.
+     */
+    static float gjk( const ConvexSupport& a, const ConvexSupport& b, Simplex& s, float separation )
+    {
+        s.v[0] = supportOf( a, b, vec3( 1.f, 0.f, 0.f ) );
+        s.weights[0] = 1.f;
+        s.count = 1;
+        vec3 v = s.v[0].w;
+
+        for ( uint32_t iteration = 0; iteration < GJK_MAX_ITERATIONS; ++iteration )
+        {
+            const float distance_sq = dot( v, v );
+            if ( distance_sq <= GJK_TOUCH_DISTANCE * GJK_TOUCH_DISTANCE ) return 0.f;
+
+            const Vertex w = supportOf( a, b, -v );
+            const float lower = dot( v, w.w );
+            if ( lower > 0.f && lower * lower > separation * separation * distance_sq ) return sqrtf( distance_sq );
+            if ( distance_sq - dot( v, w.w ) <= GJK_RELATIVE_TOLERANCE * distance_sq ) return sqrtf( distance_sq );
+
+            for ( uint32_t i = 0; i < s.count; ++i )
+            {
+                if ( magnSq( s.v[ i ].w - w.w ) <= KEGE_EPSILON_F * KEGE_EPSILON_F ) return sqrtf( distance_sq );
+            }
+
+            s.v[ s.count++ ] = w;
+            if ( solve( s, v ) ) return 0.f;
+
+            // rounding can stop the distance from going down, it is as close as it gets
+            if ( dot( v, v ) >= distance_sq ) return sqrtf( distance_sq );
+        }
+        return sqrtf( dot( v, v ) );
+    }
+
+    float gjkDistance( const ConvexSupport& a, const ConvexSupport& b, vec3& closest_a, vec3& closest_b )
+    {
+        Simplex s;
+        const float distance = gjk( a, b, s, FLT_MAX );
+        closest_a = vec3( 0.f, 0.f, 0.f );
+        closest_b = vec3( 0.f, 0.f, 0.f );
+        for ( uint32_t i = 0; i < s.count && distance > 0.f; ++i )
+        {
+            closest_a += s.v[ i ].a * s.weights[ i ];
+            closest_b += s.v[ i ].b * s.weights[ i ];
+        }
+        return distance;
+    }
+
+    bool gjkSeparation( const ConvexSupport& a, const ConvexSupport& b, float margin, ConvexContact& contact )
+    {
+        Simplex s;
+        const float margin_a = a.margin();
+        const float margin_b = b.margin();
+        const float margins = margin_a + margin_b;
+
+        // round shapes are as far apart as their cores are, less their margins
+        const float distance = ( margins > 0.f )
+        ?   gjk( CoreSupport( a ), CoreSupport( b ), s, margin + margins ) - margins
+        :   gjk( a, b, s, margin );
+        if ( distance <= GJK_TOUCH_DISTANCE || distance >= margin ) return false;
+
+        vec3 core_a( 0.f, 0.f, 0.f );
+        vec3 core_b( 0.f, 0.f, 0.f );
+        for ( uint32_t i = 0; i < s.count; ++i )
+        {
+            core_a += s.v[ i ].a * s.weights[ i ];
+            core_b += s.v[ i ].b * s.weights[ i ];
+        }
+        contact.normal = ( core_b - core_a ) / ( distance + margins );
+        contact.depth = -distance;
+        contact.point = ( core_a + contact.normal * margin_a + core_b - contact.normal * margin_b ) * 0.5f;
+        return true;
+    }
+
+    /**
+     * grows the simplex GJK ended on into a tetrahedron, which EPA needs to start from. the
+     * origin is on the smaller simplex when the shapes only touch.
+     */
+    static bool fillSimplex( const ConvexSupport& a, const ConvexSupport& b, Simplex& s )
+    {
+        static const vec3 axes[6] =
+        {
+            vec3( 1.f, 0.f, 0.f ), vec3( -1.f, 0.f, 0.f ), vec3( 0.f, 1.f, 0.f ),
+            vec3( 0.f, -1.f, 0.f ), vec3( 0.f, 0.f, 1.f ), vec3( 0.f, 0.f, -1.f )
+        };
+        const float tolerance = KEGE_EPSILON_F;
+
+        if ( s.count == 1 )
+        {
+            for ( const vec3& axis : axes )
+            {
+                const Vertex w = supportOf( a, b, axis );
+                if ( magnSq( w.w - s.v[0].w ) > tolerance * tolerance )
+                {
+                    s.v[ s.count++ ] = w;
+                    break;
+                }
+            }
+            if ( s.count == 1 ) return false;
+        }
+
+        if ( s.count == 2 )
+        {
+            // directions around the line, 60 degrees apart
+            const vec3 line = normalize( s.v[1].w - s.v[0].w );
+            const vec3 u = ( fabsf( line.x ) < 0.57f ) ? normalize( cross( line, axes[0] ) ) : normalize( cross( line, axes[2] ) );
+            const vec3 v = cross( line, u );
+            for ( int k = 0; k < 6 && s.count == 2; ++k )
+            {
+                const float angle = float( k ) * 1.04719755f;
+                const Vertex w = supportOf( a, b, u * cosf( angle ) + v * sinf( angle ) );
+                if ( magnSq( cross( w.w - s.v[0].w, line ) ) > tolerance * tolerance )
+                {
+                    s.v[ s.count++ ] = w;
+                }
+            }
+            if ( s.count == 2 ) return false;
+        }
+
+        if ( s.count == 3 )
+        {
+            const vec3 n = normalize( cross( s.v[1].w - s.v[0].w, s.v[2].w - s.v[0].w ) );
+            Vertex w = supportOf( a, b, n );
+            if ( fabsf( dot( w.w - s.v[0].w, n ) ) <= tolerance ) w = supportOf( a, b, -n );
+            if ( fabsf( dot( w.w - s.v[0].w, n ) ) <= tolerance ) return false;
+            s.v[ s.count++ ] = w;
+        }
+        return true;
+    }
+
+    struct EpaFace
+    {
+        uint32_t v[3];
+        vec3 normal;
+        float distance;
+    };
+
+    static inline bool makeFace( const Vertex* vertices, uint32_t a, uint32_t b, uint32_t c, EpaFace& face )
+    {
+        const vec3 n = cross( vertices[ b ].w - vertices[ a ].w, vertices[ c ].w - vertices[ a ].w );
+        const float length = sqrtf( dot( n, n ) );
+        if ( length <= KEGE_EPSILON_F * KEGE_EPSILON_F ) return false;
+
+        face.v[0] = a;
+        face.v[1] = b;
+        face.v[2] = c;
+        face.normal = n / length;
+        face.distance = dot( face.normal, vertices[ a ].w );
+        return true;
+    }
+
+    bool gjkPenetration( const ConvexSupport& a, const ConvexSupport& b, ConvexContact& contact )
+    {
+        Simplex s;
+        const float margins = a.margin() + b.margin();
+        if ( margins > 0.f )
+        {
+            // shallow contacts of round shapes are the closest points of their cores, pushed out to the surfaces
+            const float distance = gjk( CoreSupport( a ), CoreSupport( b ), s, margins );
+            if ( distance >= margins ) return false;
+            if ( distance > CORE_DISTANCE )
+            {
+                vec3 core_a( 0.f, 0.f, 0.f );
+                vec3 core_b( 0.f, 0.f, 0.f );
+                for ( uint32_t i = 0; i < s.count; ++i )
+                {
+                    core_a += s.v[ i ].a * s.weights[ i ];
+                    core_b += s.v[ i ].b * s.weights[ i ];
+                }
+                contact.normal = ( core_b - core_a ) / distance;
+                contact.depth = margins - distance;
+                contact.point = ( core_a + contact.normal * a.margin() + core_b - contact.normal * b.margin() ) * 0.5f;
+                return true;
+            }
+        }
+
+        if ( gjk( a, b, s, 0.f ) > 0.f ) return false;
+        if ( s.count < 4 && !fillSimplex( a, b, s ) ) return false;
+
+        Vertex vertices[ EPA_MAX_VERTICES ];
+        EpaFace faces[ EPA_MAX_FACES ];
+        uint32_t vertex_count = 4;
+        uint32_t face_count = 0;
+        for ( uint32_t i = 0; i < 4; ++i ) vertices[ i ] = s.v[ i ];
+
+        // the faces of the tetrahedron, wound so their normals point away from the middle
+        const vec3 middle = ( vertices[0].w + vertices[1].w + vertices[2].w + vertices[3].w ) * 0.25f;
+        static const uint32_t start[4][3] = { { 0, 1, 2 }, { 0, 3, 1 }, { 0, 2, 3 }, { 1, 3, 2 } };
+        for ( const auto& f : start )
+        {
+            EpaFace face;
+            if ( !makeFace( vertices, f[0], f[1], f[2], face ) ) return false;
+            if ( dot( face.normal, middle ) - face.distance > 0.f )
+            {
+                makeFace( vertices, f[0], f[2], f[1], face );
+            }
+            faces[ face_count++ ] = face;
+        }
+
+        uint32_t closest = 0;
+        for ( uint32_t iteration = 0; iteration < EPA_MAX_ITERATIONS; ++iteration )
+        {
+            closest = 0;
+            for ( uint32_t i = 1; i < face_count; ++i )
+            {
+                if ( faces[ i ].distance < faces[ closest ].distance ) closest = i;
+            }
+
+            const Vertex w = supportOf( a, b, faces[ closest ].normal );
+            const float growth = dot( w.w, faces[ closest ].normal ) - faces[ closest ].distance;
+            if ( growth <= EPA_TOLERANCE || vertex_count == EPA_MAX_VERTICES ) break;
+
+            /*
+             the faces the new point sees are cut out, and the hole is closed with a fan from the
+             edges around it. an edge shared by two removed faces shows up once each way round.
+             */
+            uint32_t edges[ EPA_MAX_EDGES ][2];
+            uint32_t edge_count = 0;
+            bool overflow = false;
+            for ( uint32_t i = 0; i < face_count; )
+            {
+                if ( dot( faces[ i ].normal, w.w - vertices[ faces[ i ].v[0] ].w ) <= 0.f )
+                {
+                    ++i;
+                    continue;
+                }
+
+                for ( int k = 0; k < 3; ++k )
+                {
+                    const uint32_t p = faces[ i ].v[ k ];
+                    const uint32_t q = faces[ i ].v[ ( k + 1 ) % 3 ];
+                    uint32_t e = 0;
+                    while ( e < edge_count && !( edges[ e ][0] == q && edges[ e ][1] == p ) ) ++e;
+                    if ( e < edge_count )
+                    {
+                        edges[ e ][0] = edges[ edge_count - 1 ][0];
+                        edges[ e ][1] = edges[ edge_count - 1 ][1];
+                        edge_count -= 1;
+                    }
+                    else if ( edge_count < EPA_MAX_EDGES )
+                    {
+                        edges[ edge_count ][0] = p;
+                        edges[ edge_count ][1] = q;
+                        edge_count += 1;
+                    }
+                    else
+                    {
+                        overflow = true;
+                    }
+                }
+                faces[ i ] = faces[ --face_count ];
+            }
+
+            if ( overflow || face_count + edge_count > EPA_MAX_FACES ) return false;
+
+            vertices[ vertex_count ] = w;
+            for ( uint32_t e = 0; e < edge_count; ++e )
+            {
+                EpaFace face;
+                if ( makeFace( vertices, edges[ e ][0], edges[ e ][1], vertex_count, face ) )
+                {
+                    faces[ face_count++ ] = face;
+                }
+            }
+            vertex_count += 1;
+            if ( face_count == 0 ) return false;
+        }
+
+        closest = 0;
+        for ( uint32_t i = 1; i < face_count; ++i )
+        {
+            if ( faces[ i ].distance < faces[ closest ].distance ) closest = i;
+        }
+
+        // where the origin projects onto the closest face gives the deepest points of both shapes
+        const EpaFace& face = faces[ closest ];
+        Simplex projection;
+        projection.count = 3;
+        for ( uint32_t i = 0; i < 3; ++i )
+        {
+            projection.v[ i ] = vertices[ face.v[ i ] ];
+            projection.v[ i ].w = projection.v[ i ].w - face.normal * face.distance;
+        }
+        closestOnTriangle( projection );
+
+        vec3 point_a( 0.f, 0.f, 0.f );
+        vec3 point_b( 0.f, 0.f, 0.f );
+        for ( uint32_t i = 0; i < projection.count; ++i )
+        {
+            point_a += projection.v[ i ].a * projection.weights[ i ];
+            point_b += projection.v[ i ].b * projection.weights[ i ];
+        }
+
+        contact.normal = face.normal;
+        contact.depth = std::max( face.distance, 0.f );
+        contact.point = ( point_a + point_b ) * 0.5f;
+        return true;
+    }
+
+    /**
+     * the inward facing side plane of edge e of the reference face, false for an edge without length.
+     */
+    static inline bool sidePlane( const vec3* reference, uint32_t count, uint32_t e, const vec3& outward, const vec3& centroid, vec3& side )
+    {
+        const vec3& v = reference[ e ];
+        side = cross( outward, reference[ ( e + 1 ) % count ] - v );
+        if ( dot( side, side ) <= KEGE_EPSILON_F * KEGE_EPSILON_F ) return false;
+        if ( dot( side, centroid - v ) < 0.f ) side = -side;
+        return true;
+    }
+
+    /**
+     * clips the incident polygon or segment against the side planes of the reference face,
+     * Sutherland-Hodgman, and keeps the points below the face or less than margin above it.
+     */
+    static uint32_t clipToFace( const vec3* reference, uint32_t reference_count, const vec3& outward, const vec3* incident, uint32_t incident_count, float margin, vec3* points, float* depths )
+    {
+        vec3 centroid = reference[0];
+        for ( uint32_t i = 1; i < reference_count; ++i ) centroid = centroid + reference[ i ];
+        centroid = centroid / float( reference_count );
+
+        vec3 buffers[2][ CLIP_POINTS ];
+        vec3* polygon = buffers[0];
+        vec3* clipped = buffers[1];
+        uint32_t count = incident_count;
+        for ( uint32_t i = 0; i < incident_count; ++i ) polygon[ i ] = incident[ i ];
+
+        for ( uint32_t e = 0; e < reference_count && count > 0; ++e )
+        {
+            vec3 side;
+            if ( !sidePlane( reference, reference_count, e, outward, centroid, side ) ) continue;
+
+            const vec3& v = reference[ e ];
+            if ( count == 2 )
+            {
+                // a segment has one edge, not a closed loop of two
+                const float dp = dot( polygon[0] - v, side );
+                const float dq = dot( polygon[1] - v, side );
+                if ( dp < 0.f && dq < 0.f ) count = 0;
+                else if ( dp < 0.f ) polygon[0] = polygon[0] + ( polygon[1] - polygon[0] ) * ( dp / ( dp - dq ) );
+                else if ( dq < 0.f ) polygon[1] = polygon[0] + ( polygon[1] - polygon[0] ) * ( dp / ( dp - dq ) );
+                continue;
+            }
+
+            uint32_t kept = 0;
+            for ( uint32_t i = 0; i < count && kept + 2 <= CLIP_POINTS; ++i )
+            {
+                const vec3& p = polygon[ i ];
+                const vec3& q = polygon[ ( i + 1 ) % count ];
+                const float dp = dot( p - v, side );
+                const float dq = dot( q - v, side );
+                if ( dp >= 0.f ) clipped[ kept++ ] = p;
+                if ( ( dp >= 0.f ) != ( dq >= 0.f ) ) clipped[ kept++ ] = p + ( q - p ) * ( dp / ( dp - dq ) );
+            }
+            std::swap( polygon, clipped );
+            count = kept;
+        }
+
+        uint32_t result = 0;
+        for ( uint32_t i = 0; i < count; ++i )
+        {
+            const float depth = dot( reference[0] - polygon[ i ], outward );
+            if ( depth < -margin ) continue;
+            points[ result ] = polygon[ i ];
+            depths[ result ] = depth;
+            result += 1;
+        }
+        return result;
+    }
+
+    uint32_t reduceContactPoints( vec3* points, float* depths, uint32_t count, const vec3& normal )
+    {
+        if ( count <= 4 ) return count;
+
+        uint32_t deepest = 0;
+        for ( uint32_t i = 1; i < count; ++i )
+        {
+            if ( depths[ i ] > depths[ deepest ] ) deepest = i;
+        }
+
+        uint32_t far = deepest;
+        float far_distance = -1.f;
+        for ( uint32_t i = 0; i < count; ++i )
+        {
+            const float d = magnSq( points[ i ] - points[ deepest ] );
+            if ( d > far_distance )
+            {
+                far_distance = d;
+                far = i;
+            }
+        }
+
+        // the points farthest to either side of the line between the two
+        const vec3 line = points[ far ] - points[ deepest ];
+        uint32_t left = deepest;
+        uint32_t right = deepest;
+        float left_area = 0.f;
+        float right_area = 0.f;
+        for ( uint32_t i = 0; i < count; ++i )
+        {
+            const float area = dot( cross( line, points[ i ] - points[ deepest ] ), normal );
+            if ( area > left_area ) { left_area = area; left = i; }
+            if ( area < right_area ) { right_area = area; right = i; }
+        }
+
+        const uint32_t picked[4] = { deepest, far, left, right };
+        vec3 kept_points[4];
+        float kept_depths[4];
+        uint32_t n = 0;
+        for ( uint32_t i : picked )
+        {
+            bool seen = false;
+            for ( uint32_t k = 0; k < n && !seen; ++k ) seen = magnSq( kept_points[ k ] - points[ i ] ) <= 0.f;
+            if ( seen ) continue;
+            kept_points[ n ] = points[ i ];
+            kept_depths[ n ] = depths[ i ];
+            n += 1;
+        }
+        for ( uint32_t i = 0; i < n; ++i )
+        {
+            points[ i ] = kept_points[ i ];
+            depths[ i ] = kept_depths[ i ];
+        }
+        return n;
+    }
+
+    /**
+     * how far the shapes go into each other along normal.
+     */
+    static inline float overlapAlong( const ConvexSupport& a, const ConvexSupport& b, const vec3& normal )
+    {
+        return dot( a.support( normal ) - b.support( -normal ), normal );
+    }
+
+    uint32_t convexContactPoints( const ConvexSupport& a, const ConvexSupport& b, ConvexContact& contact, vec3* points, float* depths, float margin )
+    {
+        vec3 face_a[ MAX_FACE_POINTS ];
+        vec3 face_b[ MAX_FACE_POINTS ];
+        vec3 normal_a;
+        vec3 normal_b;
+        const uint32_t count_a = a.supportFace( contact.normal, face_a, normal_a );
+        const uint32_t count_b = b.supportFace( -contact.normal, face_b, normal_b );
+
+        const float facing_a = ( count_a >= 3 ) ? dot( normal_a, contact.normal ) + REFERENCE_BIAS : -1.f;
+        const float facing_b = ( count_b >= 3 ) ? -dot( normal_b, contact.normal ) : -1.f;
+
+        vec3 clipped[ CLIP_POINTS ];
+        float clipped_depths[ CLIP_POINTS ];
+        uint32_t count = 0;
+        const vec3 reference = ( facing_a >= facing_b ) ? normal_a : -normal_b;
+        const float max_depth = contact.depth + fabsf( contact.depth ) * REFERENCE_DEPTH_RATIO + REFERENCE_DEPTH_SLACK;
+        if ( std::max( facing_a, facing_b ) >= REFERENCE_COSINE && count_a >= 2 && count_b >= 2 && overlapAlong( a, b, reference ) <= max_depth )
+        {
+            if ( facing_a >= facing_b )
+            {
+                count = clipToFace( face_a, count_a, normal_a, face_b, count_b, margin, clipped, clipped_depths );
+                if ( count > 0 ) contact.normal = normal_a;
+            }
+            else
+            {
+                count = clipToFace( face_b, count_b, normal_b, face_a, count_a, margin, clipped, clipped_depths );
+                if ( count > 0 ) contact.normal = -normal_b;
+            }
+        }
+        else if ( count_a == 2 && count_b == 2 )
+        {
+            // two edges crossing, the point between their closest points
+            float s, t;
+            vec3 closest[2];
+            closestPointLineLine( Line( face_a[0], face_a[1] ), Line( face_b[0], face_b[1] ), s, t, closest );
+            clipped[0] = ( closest[0] + closest[1] ) * 0.5f;
+            clipped_depths[0] = contact.depth;
+            count = 1;
+        }
+
+        if ( count == 0 )
+        {
+            points[0] = contact.point;
+            depths[0] = contact.depth;
+            return 1;
+        }
+
+        count = reduceContactPoints( clipped, clipped_depths, count, contact.normal );
+        for ( uint32_t i = 0; i < count; ++i )
+        {
+            points[ i ] = clipped[ i ];
+            depths[ i ] = clipped_depths[ i ];
+        }
+        return count;
+    }
+
+}
@@ -0,0 +1,140 @@
+//
+//  gjk-epa.hpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef kege_gjk_epa_hpp
+#define kege_gjk_epa_hpp
+
+#include "../../collision/algorithms/utils.hpp"
+
+namespace kege::algo{
+
+    /**
+     * @brief A convex shape as GJK and EPA see it, through its support mapping.
+     */
+    struct ConvexSupport
+    {
+        /**
+         * @brief The point of the shape farthest along direction.
+         */
+        virtual vec3 support( const vec3& direction )const = 0;
+
+        /**
+         * @brief The feature of the shape facing direction the most, see Collider::supportFace().
+         */
+        virtual uint32_t supportFace( const vec3& direction, vec3* points, vec3& normal )const = 0;
+
+        /**
+         * @brief The support mapping of the core of a round shape, the point of a sphere or the
+         * segment of a capsule, that swelled by margin() is the shape.
+         */
+        virtual vec3 coreSupport( const vec3& direction )const
+        {
+            return support( direction );
+        }
+
+        /**
+         * @brief How far the surface is from the core, 0 for shapes that are their own core.
+         */
+        virtual float margin()const
+        {
+            return 0.f;
+        }
+
+        virtual ~ConvexSupport(){}
+    };
+
+    /**
+     * @brief The support mapping of a collider, in world space.
+     */
+    struct ColliderSupport : public ConvexSupport
+    {
+        vec3 support( const vec3& direction )const
+        {
+            return collider->support( direction );
+        }
+
+        uint32_t supportFace( const vec3& direction, vec3* points, vec3& normal )const
+        {
+            return collider->supportFace( direction, points, normal );
+        }
+
+        vec3 coreSupport( const vec3& direction )const;
+        float margin()const;
+
+        ColliderSupport( const Collider* collider ): collider( collider ) {}
+        const Collider* collider;
+    };
+
+    /**
+     * @brief The contact of two convex shapes that go into each other.
+     */
+    struct ConvexContact
+    {
+        /**
+         * Points from the first shape to the second, the way the second one has to move to get out.
+         */
+        vec3 normal;
+
+        /**
+         * How far the second shape has to move along the normal.
+         */
+        float depth;
+
+        /**
+         * Halfway between the deepest points of the two shapes.
+         */
+        vec3 point;
+    };
+
+    /**
+     * @brief The distance between two convex shapes, with GJK.
+     * @param closest_a, closest_b Set to the closest points of the shapes when they are apart.
+     * @return The distance, 0 when the shapes touch or overlap.
+     */
+    float gjkDistance( const ConvexSupport& a, const ConvexSupport& b, vec3& closest_a, vec3& closest_b );
+
+    /**
+     * @brief The contact of two convex shapes that are apart, but by less than margin, for
+     * speculative contacts. The depth is the negative of the distance between them.
+     * @return False if the shapes touch or are margin or more apart.
+     */
+    bool gjkSeparation( const ConvexSupport& a, const ConvexSupport& b, float margin, ConvexContact& contact );
+
+    /**
+     * @brief How far two convex shapes go into each other, GJK to find that they do and EPA to
+     * find the shortest way out.
+     *
+     * Round shapes that go less than their margins into each other are solved with GJK alone,
+     * on the distance between their cores.
+     *
+     * @return False if the shapes are apart.
+     */
+    bool gjkPenetration( const ConvexSupport& a, const ConvexSupport& b, ConvexContact& contact );
+
+    /**
+     * @brief Clips the features the shapes face each other with for the points of a contact.
+     *
+     * When one of the shapes meets the other with a face, the normal is changed to that face
+     * normal, which keeps resting contacts from rocking on the small errors of EPA. Edges, round
+     * sides and corners give the single point of the contact.
+     *
+     * @param contact The contact from gjkPenetration() or gjkSeparation(), its normal may be changed.
+     * @param points, depths Room for MAX_CONTACTS points.
+     * @param margin Points of the features that are apart by less than this are kept too, with
+     * negative depths.
+     * @return The number of points, at most four.
+     */
+    uint32_t convexContactPoints( const ConvexSupport& a, const ConvexSupport& b, ConvexContact& contact, vec3* points, float* depths, float margin = 0.f );
+
+    /**
+     * @brief Reduces contact points in place to the four that span the largest area, keeping the deepest.
+     * @return The number of points left.
+     */
+    uint32_t reduceContactPoints( vec3* points, float* depths, uint32_t count, const vec3& normal );
+
+}
+#endif /* kege_gjk_epa_hpp */
@@ -0,0 +1,742 @@
+//
+//  mesh-contacts.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#include <cfloat>
+#include <algorithm>
+#include "mesh-contacts.hpp"
+
+namespace kege::algo{
+
+    /*
+     contacts whose normals are within about 18 degrees of each other share a manifold.
+     */
+    static const float GROUP_COSINE = 0.95f;
+
+    /*
+     points closer than this to a point already in a manifold are dropped, the triangles around
+     a vertex or along an edge all report the same spot.
+     */
+    static const float DUPLICATE_DISTANCE_SQ = 1e-6f;
+
+    enum{ MAX_GROUPS = 4, MAX_GROUP_POINTS = 4, NONE = 0xFFFFFFFF };
+
+    enum Region
+    {
+        REGION_FACE,
+        REGION_VERTEX_A, REGION_VERTEX_B, REGION_VERTEX_C,
+        REGION_EDGE_AB, REGION_EDGE_BC, REGION_EDGE_CA
+    };
+
+    static inline bool edgeActive( uint32_t edges, int edge )
+    {
+        return ( ( edges >> edge ) & 1u ) != 0;
+    }
+
+    // a corner is active when either of its edges is
+    static inline bool vertexActive( uint32_t edges, int vertex )
+    {
+        return edgeActive( edges, vertex ) || edgeActive( edges, ( vertex + 2 ) % 3 );
+    }
+
+    static bool regionActive( uint32_t edges, int region )
+    {
+        if ( region >= REGION_EDGE_AB ) return edgeActive( edges, region - REGION_EDGE_AB );
+        if ( region >= REGION_VERTEX_A ) return vertexActive( edges, region - REGION_VERTEX_A );
+        return true;
+    }
+
+    /**
+     * whether the feature of the triangle farthest along axis, a corner or an edge, is active.
+     */
+    static bool nearestFeatureActive( const MeshTriangle& triangle, const vec3& axis )
+    {
+        const vec3 vertices[3] = { triangle.triangle.a, triangle.triangle.b, triangle.triangle.c };
+        float d[3];
+        float top = -FLT_MAX;
+        for ( int k = 0; k < 3; ++k )
+        {
+            d[ k ] = dot( vertices[ k ], axis );
+            top = fmaxf( top, d[ k ] );
+        }
+
+        const float tolerance = 1e-3f;
+        int touching[3];
+        int count = 0;
+        for ( int k = 0; k < 3; ++k )
+        {
+            if ( d[ k ] >= top - tolerance ) touching[ count++ ] = k;
+        }
+
+        if ( count == 1 ) return vertexActive( triangle.active_edges, touching[0] );
+        if ( count == 2 )
+        {
+            // vertices 0 and 2 share edge 2, the others edge min( k )
+            const int e = ( touching[0] == 0 && touching[1] == 2 ) ? 2 : touching[0];
+            return edgeActive( triangle.active_edges, e );
+        }
+        return true;
+    }
+
+    /**
+     * closestPointOnTriangle(), that also tells which feature of the triangle the point is on.
+     */
+    static vec3 closestPoint( const Triangle& triangle, const vec3& p, int& region )
+    {
+        const vec3& a = triangle.a;
+        const vec3& b = triangle.b;
+        const vec3& c = triangle.c;
+        const vec3 ab = b - a;
+        const vec3 ac = c - a;
+
+        const vec3 ap = p - a;
+        const float d1 = dot( ab, ap );
+        const float d2 = dot( ac, ap );
+        if ( d1 <= 0.f && d2 <= 0.f )
+        {
+            region = REGION_VERTEX_A;
+            return a;
+        }
+
+        const vec3 bp = p - b;
+        const float d3 = dot( ab, bp );
+        const float d4 = dot( ac, bp );
+        if ( d3 >= 0.f && d4 <= d3 )
+        {
+            region = REGION_VERTEX_B;
+            return b;
+        }
+
+        const vec3 cp = p - c;
+        const float d5 = dot( ab, cp );
+        const float d6 = dot( ac, cp );
+        if ( d6 >= 0.f && d5 <= d6 )
+        {
+            region = REGION_VERTEX_C;
+            return c;
+        }
+
+        const float vc = d1 * d4 - d3 * d2;
+        if ( vc <= 0.f && d1 >= 0.f && d3 <= 0.f )
+        {
+            region = REGION_EDGE_AB;
+            return a + ab * ( d1 / ( d1 - d3 ) );
+        }
+
+        const float va = d3 * d6 - d5 * d4;
+        if ( va <= 0.f && ( d4 - d3 ) >= 0.f && ( d5 - d6 ) >= 0.f )
+        {
+            region = REGION_EDGE_BC;
+            return b + ( c - b ) * ( ( d4 - d3 ) / ( ( d4 - d3 ) + ( d5 - d6 ) ) );
+        }
+
+        const float vb = d5 * d2 - d1 * d6;
+        if ( vb <= 0.f && d2 >= 0.f && d6 <= 0.f )
+        {
+            region = REGION_EDGE_CA;
+            return a + ac * ( d2 / ( d2 - d6 ) );
+        }
+
+        region = REGION_FACE;
+        const float denom = 1.f / ( va + vb + vc );
+        return a + ab * ( vb * denom ) + ac * ( vc * denom );
+    }
+
+    MeshTriangle getMeshTriangle( const ColliderMesh& mesh, uint32_t t )
+    {
+        const ColliderMesh::Triangle& source = mesh.triangles[ t ];
+        MeshTriangle triangle;
+        triangle.triangle = Triangle( mesh.vertices[ source.a ], mesh.vertices[ source.b ], mesh.vertices[ source.c ] );
+        triangle.normal = source.normal;
+        triangle.active_edges = source.active_edges;
+        triangle.index = t;
+        return triangle;
+    }
+
+    uint32_t sphereTriangleContacts( const MeshTriangle& triangle, const vec3& center, float radius, TriangleContact* contacts )
+    {
+        int region;
+        const vec3 closest = closestPoint( triangle.triangle, center, region );
+        const vec3 d = center - closest;
+        const float distance_sq = dot( d, d );
+        if ( distance_sq > radius * radius ) return 0;
+
+        // the mesh is two sided, the sphere is pushed out of whichever side its center is on
+        const float side = dot( center - triangle.triangle.a, triangle.normal );
+        const vec3 face = ( side >= 0.f ) ? triangle.normal : -triangle.normal;
+        const float distance = sqrtf( distance_sq );
+
+        TriangleContact& contact = contacts[0];
+        contact.triangle = triangle.index;
+        if ( region == REGION_FACE || distance <= KEGE_EPSILON_F || !regionActive( triangle.active_edges, region ) )
+        {
+            contact.normal = face;
+            contact.depth = radius - fabsf( side );
+            contact.point = center - face * fabsf( side );
+        }
+        else
+        {
+            contact.normal = d / distance;
+            contact.depth = radius - distance;
+            contact.point = closest;
+        }
+        return ( contact.depth > 0.f ) ? 1 : 0;
+    }
+
+    uint32_t capsuleTriangleContacts( const MeshTriangle& triangle, const Line& segment, float radius, TriangleContact* contacts )
+    {
+        uint32_t count = 0;
+        count += sphereTriangleContacts( triangle, segment.start, radius, contacts + count );
+        count += sphereTriangleContacts( triangle, segment.end, radius, contacts + count );
+
+        // the middle of the segment against the active edges, a capsule lying across a ridge
+        const vec3 vertices[3] = { triangle.triangle.a, triangle.triangle.b, triangle.triangle.c };
+        for ( int k = 0; k < 3; ++k )
+        {
+            if ( !edgeActive( triangle.active_edges, k ) ) continue;
+
+            float s, t;
+            vec3 points[2];
+            closestPointLineLine( segment, Line( vertices[ k ], vertices[ ( k + 1 ) % 3 ] ), s, t, points );
+            if ( s <= 0.f || s >= 1.f ) continue;
+
+            const vec3 d = points[0] - points[1];
+            const float distance_sq = dot( d, d );
+            if ( distance_sq > radius * radius || distance_sq <= KEGE_EPSILON_F ) continue;
+
+            // only where the edge is the nearest part of the triangle, inside the face the end spheres do it
+            int region;
+            closestPoint( triangle.triangle, points[0], region );
+            if ( region != REGION_EDGE_AB + k ) continue;
+
+            const float distance = sqrtf( distance_sq );
+            TriangleContact& contact = contacts[ count++ ];
+            contact.normal = d / distance;
+            contact.depth = radius - distance;
+            contact.point = points[1];
+        }
+
+        // the segment through the face, the end that went through is pushed back out
+        const float d0 = dot( segment.start - triangle.triangle.a, triangle.normal );
+        const float d1 = dot( segment.end - triangle.triangle.a, triangle.normal );
+        if ( d0 * d1 < 0.f )
+        {
+            const vec3 p = segment.start + ( segment.end - segment.start ) * ( d0 / ( d0 - d1 ) );
+            int region;
+            closestPoint( triangle.triangle, p, region );
+            if ( region == REGION_FACE )
+            {
+                const bool start_out = fabsf( d0 ) >= fabsf( d1 );
+                TriangleContact& contact = contacts[ count++ ];
+                contact.normal = ( ( start_out ? d0 : d1 ) > 0.f ) ? triangle.normal : -triangle.normal;
+                contact.depth = radius + fminf( fabsf( d0 ), fabsf( d1 ) );
+                contact.point = p;
+            }
+        }
+
+        for ( uint32_t i = 0; i < count; ++i )
+        {
+            contacts[ i ].triangle = triangle.index;
+        }
+        return count;
+    }
+
+    /*
+     the box or triangle a mesh triangle is tested against with the separating axis test.
+     */
+    struct Polytope
+    {
+        const OBB* box;
+        vec3 vertices[3];
+        vec3 center;
+    };
+
+    static void project( const Polytope& shape, const vec3& axis, float& min, float& max )
+    {
+        if ( shape.box )
+        {
+            const OBB& box = *shape.box;
+            const float c = dot( box.center, axis );
+            const float r =
+            box.extents.x * fabsf( dot( box.axes[0], axis ) ) +
+            box.extents.y * fabsf( dot( box.axes[1], axis ) ) +
+            box.extents.z * fabsf( dot( box.axes[2], axis ) );
+            min = c - r;
+            max = c + r;
+            return;
+        }
+
+        min = max = dot( shape.vertices[0], axis );
+        for ( int i = 1; i < 3; ++i )
+        {
+            const float d = dot( shape.vertices[ i ], axis );
+            min = fminf( min, d );
+            max = fmaxf( max, d );
+        }
+    }
+
+    // the face whose outward normal points most along direction
+    static uint32_t face( const Polytope& shape, const vec3& direction, vec3* polygon )
+    {
+        if ( !shape.box )
+        {
+            polygon[0] = shape.vertices[0];
+            polygon[1] = shape.vertices[1];
+            polygon[2] = shape.vertices[2];
+            return 3;
+        }
+
+        const OBB& box = *shape.box;
+        int j = 0;
+        float best = -1.f;
+        for ( int i = 0; i < 3; ++i )
+        {
+            const float d = fabsf( dot( box.axes[ i ], direction ) );
+            if ( d > best )
+            {
+                best = d;
+                j = i;
+            }
+        }
+
+        const int k = ( j + 1 ) % 3;
+        const int l = ( j + 2 ) % 3;
+        const float sign = ( dot( box.axes[ j ], direction ) >= 0.f ) ? 1.f : -1.f;
+        const vec3 c = box.center + box.axes[ j ] * ( sign * box.extents[ j ] );
+        const vec3 u = box.axes[ k ] * box.extents[ k ];
+        const vec3 v = box.axes[ l ] * box.extents[ l ];
+        polygon[0] = c + u + v;
+        polygon[1] = c - u + v;
+        polygon[2] = c - u - v;
+        polygon[3] = c + u - v;
+        return 4;
+    }
+
+    static vec3 edgeDirection( const Polytope& shape, int k )
+    {
+        return ( shape.box ) ? shape.box->axes[ k ] : shape.vertices[ ( k + 1 ) % 3 ] - shape.vertices[ k ];
+    }
+
+    // edge k, for a box the one of the four parallel edges that lies furthest along direction
+    static Line edge( const Polytope& shape, int k, const vec3& direction )
+    {
+        if ( !shape.box )
+        {
+            return Line( shape.vertices[ k ], shape.vertices[ ( k + 1 ) % 3 ] );
+        }
+
+        const OBB& box = *shape.box;
+        vec3 p = box.center;
+        for ( int m = 0; m < 3; ++m )
+        {
+            if ( m == k ) continue;
+            p = p + box.axes[ m ] * ( ( dot( box.axes[ m ], direction ) >= 0.f ) ? box.extents[ m ] : -box.extents[ m ] );
+        }
+        const vec3 half = box.axes[ k ] * box.extents[ k ];
+        return Line( p - half, p + half );
+    }
+
+    /**
+     * clips the incident polygon to the sides of the reference face and keeps the points behind it.
+     * `outward` is the normal of the reference face, pointing at the incident shape.
+     */
+    static uint32_t clipToFace( const vec3* reference, uint32_t reference_count, const vec3& outward, const vec3* incident, uint32_t incident_count, vec3* points, float* depths )
+    {
+        vec3 buffers[2][ 16 ];
+        vec3* polygon = buffers[0];
+        vec3* clipped = buffers[1];
+        uint32_t count = incident_count;
+        for ( uint32_t i = 0; i < incident_count; ++i ) polygon[ i ] = incident[ i ];
+
+        vec3 centroid = reference[0];
+        for ( uint32_t i = 1; i < reference_count; ++i ) centroid = centroid + reference[ i ];
+        centroid = centroid / float( reference_count );
+
+        for ( uint32_t e = 0; e < reference_count && count > 0; ++e )
+        {
+            const vec3& v = reference[ e ];
+            vec3 side = cross( outward, reference[ ( e + 1 ) % reference_count ] - v );
+            if ( dot( side, centroid - v ) < 0.f ) side = -side;
+
+            // Sutherland-Hodgman against the inward facing side plane
+            uint32_t kept = 0;
+            for ( uint32_t i = 0; i < count; ++i )
+            {
+                const vec3& p = polygon[ i ];
+                const vec3& q = polygon[ ( i + 1 ) % count ];
+                const float dp = dot( p - v, side );
+                const float dq = dot( q - v, side );
+                if ( dp >= 0.f ) clipped[ kept++ ] = p;
+                if ( ( dp >= 0.f ) != ( dq >= 0.f ) )
+                {
+                    clipped[ kept++ ] = p + ( q - p ) * ( dp / ( dp - dq ) );
+                }
+            }
+            std::swap( polygon, clipped );
+            count = kept;
+        }
+
+        uint32_t result = 0;
+        for ( uint32_t i = 0; i < count && result < MAX_TRIANGLE_CONTACTS; ++i )
+        {
+            const float depth = dot( reference[0] - polygon[ i ], outward );
+            if ( depth < 0.f ) continue;
+
+            points[ result ] = polygon[ i ];
+            depths[ result ] = depth;
+            result += 1;
+        }
+        return result;
+    }
+
+    enum AxisKind{ AXIS_TRIANGLE_FACE, AXIS_OTHER_FACE, AXIS_EDGES };
+
+    static uint32_t polytopeContacts( const MeshTriangle& triangle, const Polytope& other, TriangleContact* contacts )
+    {
+        Polytope self;
+        self.box = nullptr;
+        self.vertices[0] = triangle.triangle.a;
+        self.vertices[1] = triangle.triangle.b;
+        self.vertices[2] = triangle.triangle.c;
+        self.center = ( self.vertices[0] + self.vertices[1] + self.vertices[2] ) / 3.f;
+
+        const vec3 toward = other.center - self.center;
+        float best_score = FLT_MAX;
+        float best_depth = 0.f;
+        vec3 best_axis;
+        int best_kind = -1;
+        int best_i = 0;
+        int best_j = 0;
+
+        /*
+         every axis is turned to point from the triangle to the other shape. faces are favoured
+         over edges a little, so resting contacts do not flip between nearly equal axes.
+         */
+        auto test = [ & ]( vec3 axis, int kind, int i, int j, float bias ) -> bool
+        {
+            const float length_sq = dot( axis, axis );
+            if ( length_sq < 1e-8f ) return true;
+
+            axis = axis / sqrtf( length_sq );
+            if ( dot( axis, toward ) < 0.f ) axis = -axis;
+
+            float a_min, a_max, b_min, b_max;
+            project( self, axis, a_min, a_max );
+            project( other, axis, b_min, b_max );
+            if ( a_max < b_min || b_max < a_min ) return false;
+
+            const float depth = a_max - b_min;
+            if ( depth * bias < best_score )
+            {
+                best_score = depth * bias;
+                best_depth = depth;
+                best_axis = axis;
+                best_kind = kind;
+                best_i = i;
+                best_j = j;
+            }
+            return true;
+        };
+
+        if ( !test( triangle.normal, AXIS_TRIANGLE_FACE, 0, 0, 1.f ) ) return 0;
+
+        const int other_faces = ( other.box ) ? 3 : 1;
+        for ( int j = 0; j < other_faces; ++j )
+        {
+            const vec3 axis = ( other.box ) ? other.box->axes[ j ] : cross( other.vertices[1] - other.vertices[0], other.vertices[2] - other.vertices[0] );
+            if ( !test( axis, AXIS_OTHER_FACE, 0, j, 1.05f ) ) return 0;
+        }
+
+        for ( int i = 0; i < 3; ++i )
+        {
+            const vec3 e = edgeDirection( self, i );
+            for ( int j = 0; j < 3; ++j )
+            {
+                if ( !test( cross( e, edgeDirection( other, j ) ), AXIS_EDGES, i, j, 1.1f ) ) return 0;
+            }
+        }
+
+        /*
+         a push away from the seam between two triangles of a flat or concave surface is not
+         real, the neighbour pushes along its face. the feature of the triangle nearest the
+         other shape is found, if it is not active the face normal is used instead.
+         */
+        if ( best_kind != AXIS_TRIANGLE_FACE )
+        {
+            const bool active = nearestFeatureActive( triangle, best_axis );
+            if ( !active )
+            {
+                best_axis = ( dot( triangle.normal, toward ) >= 0.f ) ? triangle.normal : -triangle.normal;
+                float a_min, a_max, b_min, b_max;
+                project( self, best_axis, a_min, a_max );
+                project( other, best_axis, b_min, b_max );
+                best_depth = a_max - b_min;
+                best_kind = AXIS_TRIANGLE_FACE;
+            }
+        }
+
+        uint32_t count = 0;
+        if ( best_kind == AXIS_EDGES )
+        {
+            float s, t;
+            vec3 points[2];
+            closestPointLineLine( edge( self, best_i, best_axis ), edge( other, best_j, -best_axis ), s, t, points );
+            contacts[0].point = points[1];
+            contacts[0].normal = best_axis;
+            contacts[0].depth = best_depth;
+            count = 1;
+        }
+        else
+        {
+            vec3 reference[4];
+            vec3 incident[4];
+            vec3 points[ MAX_TRIANGLE_CONTACTS ];
+            float depths[ MAX_TRIANGLE_CONTACTS ];
+            if ( best_kind == AXIS_TRIANGLE_FACE )
+            {
+                const uint32_t r = face( self, best_axis, reference );
+                const uint32_t n = face( other, -best_axis, incident );
+                count = clipToFace( reference, r, best_axis, incident, n, points, depths );
+            }
+            else
+            {
+                const uint32_t r = face( other, -best_axis, reference );
+                const uint32_t n = face( self, best_axis, incident );
+                count = clipToFace( reference, r, -best_axis, incident, n, points, depths );
+            }
+
+            for ( uint32_t i = 0; i < count; ++i )
+            {
+                contacts[ i ].point = points[ i ];
+                contacts[ i ].normal = best_axis;
+                contacts[ i ].depth = depths[ i ];
+            }
+        }
+
+        for ( uint32_t i = 0; i < count; ++i )
+        {
+            contacts[ i ].triangle = triangle.index;
+        }
+        return count;
+    }
+
+    uint32_t boxTriangleContacts( const MeshTriangle& triangle, const OBB& box, TriangleContact* contacts )
+    {
+        Polytope other;
+        other.box = &box;
+        other.center = box.center;
+        return polytopeContacts( triangle, other, contacts );
+    }
+
+    uint32_t triangleTriangleContacts( const MeshTriangle& a, const MeshTriangle& b, TriangleContact* contacts )
+    {
+        Polytope other;
+        other.box = nullptr;
+        other.vertices[0] = b.triangle.a;
+        other.vertices[1] = b.triangle.b;
+        other.vertices[2] = b.triangle.c;
+        other.center = ( other.vertices[0] + other.vertices[1] + other.vertices[2] ) / 3.f;
+        return polytopeContacts( a, other, contacts );
+    }
+
+    /**
+     * a triangle as GJK sees it, with both of its sides as faces.
+     */
+    struct TriangleSupport : public ConvexSupport
+    {
+        vec3 support( const vec3& direction )const
+        {
+            const float da = dot( triangle.triangle.a, direction );
+            const float db = dot( triangle.triangle.b, direction );
+            const float dc = dot( triangle.triangle.c, direction );
+            if ( da >= db && da >= dc ) return triangle.triangle.a;
+            return ( db >= dc ) ? triangle.triangle.b : triangle.triangle.c;
+        }
+
+        uint32_t supportFace( const vec3& direction, vec3* points, vec3& normal )const
+        {
+            points[0] = triangle.triangle.a;
+            points[1] = triangle.triangle.b;
+            points[2] = triangle.triangle.c;
+            normal = ( dot( triangle.normal, direction ) >= 0.f ) ? triangle.normal : -triangle.normal;
+            return 3;
+        }
+
+        TriangleSupport( const MeshTriangle& triangle ): triangle( triangle ) {}
+        const MeshTriangle& triangle;
+    };
+
+    uint32_t convexTriangleContacts( const MeshTriangle& triangle, const ConvexSupport& other, TriangleContact* contacts, float margin )
+    {
+        const TriangleSupport self( triangle );
+
+        ConvexContact contact;
+        if ( !gjkPenetration( self, other, contact ) && !( margin > 0.f && gjkSeparation( self, other, margin, contact ) ) )
+        {
+            return 0;
+        }
+
+        if ( fabsf( dot( contact.normal, triangle.normal ) ) < 0.9999f && !nearestFeatureActive( triangle, contact.normal ) )
+        {
+            // push out along the face normal, on the side the shape is on
+            const vec3 face = ( dot( triangle.normal, contact.normal ) >= 0.f ) ? triangle.normal : -triangle.normal;
+            contact.normal = face;
+            contact.depth = dot( triangle.triangle.a, face ) - dot( other.support( -face ), face );
+            if ( contact.depth <= -margin )
+            {
+                return 0;
+            }
+        }
+
+        vec3 points[ MAX_TRIANGLE_CONTACTS ];
+        float depths[ MAX_TRIANGLE_CONTACTS ];
+        const uint32_t count = convexContactPoints( self, other, contact, points, depths, margin );
+        for ( uint32_t i = 0; i < count; ++i )
+        {
+            contacts[ i ].point = points[ i ];
+            contacts[ i ].normal = contact.normal;
+            contacts[ i ].depth = depths[ i ];
+            contacts[ i ].triangle = triangle.index;
+        }
+        return count;
+    }
+
+    /**
+     * picks the deepest point, the point furthest from it, and the points furthest to either
+     * side of the line through those two.
+     */
+    static uint32_t reduce( const std::vector< TriangleContact >& contacts, const vec3& normal, const uint32_t* members, uint32_t count, uint32_t* picked )
+    {
+        if ( count <= MAX_GROUP_POINTS )
+        {
+            for ( uint32_t i = 0; i < count; ++i ) picked[ i ] = members[ i ];
+            return count;
+        }
+
+        const vec3& p0 = contacts[ members[0] ].point;
+        uint32_t far = 1;
+        float far_distance = -1.f;
+        for ( uint32_t i = 1; i < count; ++i )
+        {
+            const float d = magnSq( contacts[ members[ i ] ].point - p0 );
+            if ( d > far_distance )
+            {
+                far_distance = d;
+                far = i;
+            }
+        }
+
+        const vec3 line = contacts[ members[ far ] ].point - p0;
+        uint32_t left = NONE;
+        uint32_t right = NONE;
+        float left_area = 0.f;
+        float right_area = 0.f;
+        for ( uint32_t i = 1; i < count; ++i )
+        {
+            if ( i == far ) continue;
+
+            const float area = dot( cross( line, contacts[ members[ i ] ].point - p0 ), normal );
+            if ( area > left_area )
+            {
+                left_area = area;
+                left = i;
+            }
+            if ( area < right_area )
+            {
+                right_area = area;
+                right = i;
+            }
+        }
+
+        uint32_t n = 0;
+        picked[ n++ ] = members[0];
+        picked[ n++ ] = members[ far ];
+        if ( left != NONE ) picked[ n++ ] = members[ left ];
+        if ( right != NONE ) picked[ n++ ] = members[ right ];
+        return n;
+    }
+
+    bool generateMeshManifolds( Rigidbody* mesh, Rigidbody* other, std::vector< TriangleContact >& contacts, kege::CollisionRegistry& collisions )
+    {
+        if ( contacts.empty() ) return false;
+
+        const ColliderMesh* collider = static_cast< const ColliderMesh* >( mesh->collider.ref() );
+        std::sort( contacts.begin(), contacts.end(), []( const TriangleContact& a, const TriangleContact& b )
+        {
+            return ( a.depth != b.depth ) ? a.depth > b.depth : a.triangle < b.triangle;
+        });
+
+        // every group takes its normal from its deepest contact, the contacts are sorted by depth
+        vec3 normals[ MAX_GROUPS ];
+        std::vector< uint32_t > members[ MAX_GROUPS ];
+        uint32_t group_count = 0;
+        for ( uint32_t i = 0; i < contacts.size(); ++i )
+        {
+            const TriangleContact& contact = contacts[ i ];
+            uint32_t g = 0;
+            while ( g < group_count && dot( contact.normal, normals[ g ] ) < GROUP_COSINE ) ++g;
+            if ( g == group_count )
+            {
+                if ( group_count == MAX_GROUPS ) continue;
+                normals[ group_count++ ] = contact.normal;
+            }
+
+            bool duplicate = false;
+            for ( uint32_t m : members[ g ] )
+            {
+                if ( magnSq( contacts[ m ].point - contact.point ) < DUPLICATE_DISTANCE_SQ )
+                {
+                    duplicate = true;
+                    break;
+                }
+            }
+            if ( !duplicate ) members[ g ].push_back( i );
+        }
+
+        uint32_t codes[ MAX_GROUPS ];
+        for ( uint32_t g = 0; g < group_count; ++g )
+        {
+            /*
+             the part keys the manifold for warm starting, so it has to stay the same while the
+             shapes touch the same way. the axis the normal points along mostly does, groups on the
+             same axis are told apart by their order.
+             */
+            const vec3& n = normals[ g ];
+            const int axis = ( fabsf( n.x ) >= fabsf( n.y ) && fabsf( n.x ) >= fabsf( n.z ) ) ? 0 : ( ( fabsf( n.y ) >= fabsf( n.z ) ) ? 1 : 2 );
+            codes[ g ] = uint32_t( axis * 2 + ( ( n[ axis ] < 0.f ) ? 1 : 0 ) );
+            uint32_t same = 0;
+            for ( uint32_t h = 0; h < g; ++h )
+            {
+                if ( codes[ h ] == codes[ g ] ) same += 1;
+            }
+
+            uint32_t picked[ MAX_GROUP_POINTS ];
+            const uint32_t count = reduce( contacts, n, members[ g ].data(), uint32_t( members[ g ].size() ), picked );
+
+            CollisionManifold* manifold = collisions.generate();
+            manifold->objects[0] = mesh;
+            manifold->objects[1] = other;
+            manifold->normal = collider->directionToWorld( n );
+            manifold->part = 1 + codes[ g ] + 6 * same;
+            manifold->contact_count = count;
+            for ( uint32_t i = 0; i < count; ++i )
+            {
+                const TriangleContact& contact = contacts[ picked[ i ] ];
+                Contact& out = manifold->contacts[ i ];
+                out.point = collider->toWorld( contact.point );
+                out.depth = contact.depth * dot( contact.normal, n );
+                /*
+                 no feature id, the triangles around a spot all report it and which one of them
+                 comes first changes. the mesh is objects[0], so the points are matched by where
+                 they lie on it.
+                 */
+                out.feature = 0;
+            }
+        }
+        return group_count > 0;
+    }
+
+}
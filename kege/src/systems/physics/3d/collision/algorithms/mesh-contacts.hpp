@@ -0,0 +1,119 @@
+//
+//  mesh-contacts.hpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef mesh_contacts_hpp
+#define mesh_contacts_hpp
+
+#include "../../collision/algorithms/utils.hpp"
+#include "../../collision/collider/rigid-shapes.hpp"
+#include "../../collision/algorithms/gjk-epa.hpp"
+
+namespace kege::algo{
+
+    /**
+     * @brief A triangle of a mesh collider, with what the contact routines need to know about it.
+     */
+    struct MeshTriangle
+    {
+        Triangle triangle;
+        vec3 normal;
+
+        /**
+         * ColliderMesh::Triangle::active_edges, bit i is the edge from vertex i to vertex i + 1.
+         */
+        uint32_t active_edges;
+        uint32_t index;
+    };
+
+    /**
+     * @brief A contact between one triangle of a mesh and another shape, in mesh space.
+     */
+    struct TriangleContact
+    {
+        /**
+         * The point where the shapes touch, on the surface of either one.
+         */
+        vec3 point;
+
+        /**
+         * Points from the triangle to the other shape.
+         */
+        vec3 normal;
+
+        float depth;
+
+        /**
+         * The index of the triangle in the mesh.
+         */
+        uint32_t triangle;
+    };
+
+    /**
+     * @brief The most contacts one triangle makes with any shape.
+     */
+    enum{ MAX_TRIANGLE_CONTACTS = 8 };
+
+    /**
+     * @brief Gets triangle t of a mesh in mesh space.
+     */
+    MeshTriangle getMeshTriangle( const ColliderMesh& mesh, uint32_t t );
+
+    /**
+     * @brief Tests a sphere against a triangle.
+     *
+     * Contacts with an edge or corner that is not active take the face normal, so shapes slide over
+     * the seams between the triangles of a flat or concave surface without catching on them.
+     *
+     * @return The number of contacts written, 0 or 1.
+     */
+    uint32_t sphereTriangleContacts( const MeshTriangle& triangle, const vec3& center, float radius, TriangleContact* contacts );
+
+    /**
+     * @brief Tests a capsule, the sphere swept along `segment`, against a triangle.
+     * @return The number of contacts written, at most MAX_TRIANGLE_CONTACTS.
+     */
+    uint32_t capsuleTriangleContacts( const MeshTriangle& triangle, const Line& segment, float radius, TriangleContact* contacts );
+
+    /**
+     * @brief Tests a box against a triangle with the separating axis test, and clips the touching
+     * features against each other for the contact points.
+     * @return The number of contacts written, at most MAX_TRIANGLE_CONTACTS.
+     */
+    uint32_t boxTriangleContacts( const MeshTriangle& triangle, const OBB& box, TriangleContact* contacts );
+
+    /**
+     * @brief Tests triangle `b` against triangle `a`, like boxTriangleContacts(). Only the edges of `a` are checked for being active.
+     * @return The number of contacts written, at most MAX_TRIANGLE_CONTACTS.
+     */
+    uint32_t triangleTriangleContacts( const MeshTriangle& a, const MeshTriangle& b, TriangleContact* contacts );
+
+    /**
+     * @brief Tests any convex shape against a triangle with GJK and EPA.
+     * @param other The support mapping of the shape in mesh space.
+     * @param margin Shapes apart from the triangle by less than this get speculative contacts,
+     * with negative depths.
+     * @return The number of contacts written, at most four.
+     */
+    uint32_t convexTriangleContacts( const MeshTriangle& triangle, const ConvexSupport& other, TriangleContact* contacts, float margin = 0.f );
+
+    /**
+     * @brief Turns the contacts of the triangles of a mesh into manifolds between the mesh and the other body.
+     *
+     * The solver takes one normal per manifold, so contacts are grouped by normal and every group
+     * becomes a manifold of its own. A box in a corner gets one for the floor and one for each wall,
+     * a box on a flat patch of many triangles a single one. Groups of more than four points are
+     * reduced to the four that span the largest area.
+     *
+     * @param mesh The body of the mesh collider, objects[0] of the manifolds.
+     * @param other The other body, objects[1].
+     * @param contacts The contacts in mesh space, reordered by the call.
+     * @return True if a manifold was made.
+     */
+    bool generateMeshManifolds( Rigidbody* mesh, Rigidbody* other, std::vector< TriangleContact >& contacts, kege::CollisionRegistry& collisions );
+
+}
+#endif /* mesh_contacts_hpp */
@@ -6,17 +6,43 @@
 //
 
 #include "mesh-vs-box.hpp"
+#include "mesh-contacts.hpp"
 
 namespace kege::algo{
 
     bool meshBoxCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions )
     {
-        return false;
+        const ColliderMesh* mesh = static_cast< const ColliderMesh* >( a->collider.ref() );
+        const OBB* box = b->collider->getBox();
+
+        OBB local;
+        local.center = mesh->toLocal( box->center );
+        local.extents = box->extents;
+        local.axes[0] = mesh->directionToLocal( box->axes[0] );
+        local.axes[1] = mesh->directionToLocal( box->axes[1] );
+        local.axes[2] = mesh->directionToLocal( box->axes[2] );
+
+        const vec3 r
+        (
+            local.extents.x * fabsf( local.axes[0].x ) + local.extents.y * fabsf( local.axes[1].x ) + local.extents.z * fabsf( local.axes[2].x ),
+            local.extents.x * fabsf( local.axes[0].y ) + local.extents.y * fabsf( local.axes[1].y ) + local.extents.z * fabsf( local.axes[2].y ),
+            local.extents.x * fabsf( local.axes[0].z ) + local.extents.y * fabsf( local.axes[1].z ) + local.extents.z * fabsf( local.axes[2].z )
+        );
+
+        std::vector< TriangleContact > contacts;
+        TriangleContact found[ MAX_TRIANGLE_CONTACTS ];
+        mesh->bvh.query( AABB( local.center - r, local.center + r ), [ & ]( uint32_t t )
+        {
+            const uint32_t count = boxTriangleContacts( getMeshTriangle( *mesh, t ), local, found );
+            contacts.insert( contacts.end(), found, found + count );
+            return true;
+        });
+        return generateMeshManifolds( a, b, contacts, collisions );
     }
 
     bool boxMeshCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions )
     {
-        return false;
+        return meshBoxCollision( b, a, collisions );
     }
 
 }
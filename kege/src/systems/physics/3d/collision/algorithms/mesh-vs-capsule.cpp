@@ -6,16 +6,39 @@
 //
 
 #include "mesh-vs-capsule.hpp"
+#include "mesh-contacts.hpp"
 
 namespace kege::algo{
 
     bool meshCapsuleCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions )
     {
-        return false;
+        const ColliderMesh* mesh = static_cast< const ColliderMesh* >( a->collider.ref() );
+        const Capsule* capsule = b->collider->getCapsule();
+
+        const vec3 half_height_vec = capsule->axes[0] * ( capsule->height * 0.5f );
+        const Line segment( mesh->toLocal( capsule->center + half_height_vec ), mesh->toLocal( capsule->center - half_height_vec ) );
+        const float radius = capsule->radius;
+
+        const vec3 r( radius, radius, radius );
+        const AABB bounds
+        (
+            vec3( fminf( segment.start.x, segment.end.x ), fminf( segment.start.y, segment.end.y ), fminf( segment.start.z, segment.end.z ) ) - r,
+            vec3( fmaxf( segment.start.x, segment.end.x ), fmaxf( segment.start.y, segment.end.y ), fmaxf( segment.start.z, segment.end.z ) ) + r
+        );
+
+        std::vector< TriangleContact > contacts;
+        TriangleContact found[ MAX_TRIANGLE_CONTACTS ];
+        mesh->bvh.query( bounds, [ & ]( uint32_t t )
+        {
+            const uint32_t count = capsuleTriangleContacts( getMeshTriangle( *mesh, t ), segment, radius, found );
+            contacts.insert( contacts.end(), found, found + count );
+            return true;
+        });
+        return generateMeshManifolds( a, b, contacts, collisions );
     }
     bool capsuleMeshCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions )
     {
-        return false;
+        return meshCapsuleCollision( b, a, collisions );
     }
 
 }
@@ -1,21 +0,0 @@
-//
-//  mesh-vs-cone.cpp
-//  flat-landscape
-//
-//  Created by Kenneth Esdaile on 4/15/25.
-//
-
-#include "mesh-vs-cone.hpp"
-
-namespace kege::algo{
-
-    bool meshConeCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions )
-    {
-        return false;
-    }
-    bool coneMeshCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions )
-    {
-        return false;
-    }
-
-}
@@ -0,0 +1,96 @@
+//
+//  mesh-vs-convex.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#include "mesh-vs-convex.hpp"
+#include "mesh-contacts.hpp"
+
+namespace kege::algo{
+
+    /**
+     * the support mapping of a collider, seen from the space of a mesh.
+     */
+    struct MeshSpaceSupport : public ConvexSupport
+    {
+        vec3 support( const vec3& direction )const
+        {
+            return mesh->toLocal( shape.support( mesh->directionToWorld( direction ) ) );
+        }
+
+        uint32_t supportFace( const vec3& direction, vec3* points, vec3& normal )const
+        {
+            const uint32_t count = shape.supportFace( mesh->directionToWorld( direction ), points, normal );
+            for ( uint32_t i = 0; i < count; ++i ) points[ i ] = mesh->toLocal( points[ i ] );
+            normal = mesh->directionToLocal( normal );
+            return count;
+        }
+
+        vec3 coreSupport( const vec3& direction )const
+        {
+            return mesh->toLocal( shape.coreSupport( mesh->directionToWorld( direction ) ) );
+        }
+
+        float margin()const
+        {
+            return shape.margin();
+        }
+
+        MeshSpaceSupport( const ColliderMesh* mesh, const Collider* collider ): mesh( mesh ), shape( collider ) {}
+        const ColliderMesh* mesh;
+        ColliderSupport shape;
+    };
+
+    static bool meshConvexContacts( Rigidbody* a, Rigidbody* b, float margin, kege::CollisionRegistry& collisions )
+    {
+        const ColliderMesh* mesh = static_cast< const ColliderMesh* >( a->collider.ref() );
+        const MeshSpaceSupport other( mesh, b->collider.ref() );
+
+        // the bounds of the shape in mesh space, from its supports along the axes, grown by the margin
+        const vec3 min
+        (
+            other.support( vec3( -1, 0, 0 ) ).x - margin,
+            other.support( vec3( 0, -1, 0 ) ).y - margin,
+            other.support( vec3( 0, 0, -1 ) ).z - margin
+        );
+        const vec3 max
+        (
+            other.support( vec3( 1, 0, 0 ) ).x + margin,
+            other.support( vec3( 0, 1, 0 ) ).y + margin,
+            other.support( vec3( 0, 0, 1 ) ).z + margin
+        );
+
+        std::vector< TriangleContact > contacts;
+        TriangleContact found[ MAX_TRIANGLE_CONTACTS ];
+        mesh->bvh.query( AABB( min, max ), [ & ]( uint32_t t )
+        {
+            const uint32_t count = convexTriangleContacts( getMeshTriangle( *mesh, t ), other, found, margin );
+            contacts.insert( contacts.end(), found, found + count );
+            return true;
+        });
+        return generateMeshManifolds( a, b, contacts, collisions );
+    }
+
+    bool meshConvexCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions )
+    {
+        return meshConvexContacts( a, b, 0.f, collisions );
+    }
+
+    bool convexMeshCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions )
+    {
+        return meshConvexContacts( b, a, 0.f, collisions );
+    }
+
+    bool meshConvexSpeculativeCollision( Rigidbody* a, Rigidbody* b, float margin, kege::CollisionRegistry& collisions )
+    {
+        return meshConvexContacts( a, b, margin, collisions );
+    }
+
+    bool convexMeshSpeculativeCollision( Rigidbody* a, Rigidbody* b, float margin, kege::CollisionRegistry& collisions )
+    {
+        return meshConvexContacts( b, a, margin, collisions );
+    }
+
+}
@@ -0,0 +1,29 @@
+//
+//  mesh-vs-convex.hpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef mesh_vs_convex_hpp
+#define mesh_vs_convex_hpp
+
+#include "../../collision/algorithms/utils.hpp"
+
+namespace kege::algo{
+
+    /**
+     * @brief Tests a mesh against any collider with a support mapping, a triangle at a time with GJK and EPA.
+     */
+    bool meshConvexCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions );
+    bool convexMeshCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions );
+
+    /**
+     * @brief Like meshConvexCollision(), with speculative contacts for the triangles the shape is
+     * less than margin away from, see convexSpeculativeCollision().
+     */
+    bool meshConvexSpeculativeCollision( Rigidbody* a, Rigidbody* b, float margin, kege::CollisionRegistry& collisions );
+    bool convexMeshSpeculativeCollision( Rigidbody* a, Rigidbody* b, float margin, kege::CollisionRegistry& collisions );
+
+}
+#endif /* mesh_vs_convex_hpp */
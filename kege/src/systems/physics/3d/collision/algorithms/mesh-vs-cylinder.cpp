@@ -1,21 +0,0 @@
-//
-//  mesh-vs-cylinder.cpp
-//  flat-landscape
-//
-//  Created by Kenneth Esdaile on 4/15/25.
-//
-
-#include "mesh-vs-cylinder.hpp"
-
-namespace kege::algo{
-
-    bool meshCylinderCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions )
-    {
-        return false;
-    }
-    bool cylinderMeshCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions )
-    {
-        return false;
-    }
-
-}
@@ -6,12 +6,43 @@
 //
 
 #include "mesh-vs-mesh.hpp"
+#include "mesh-contacts.hpp"
 
 namespace kege::algo{
 
     bool meshMeshCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions )
     {
-        return false;
+        const ColliderMesh* mesh = static_cast< const ColliderMesh* >( a->collider.ref() );
+        const ColliderMesh* other = static_cast< const ColliderMesh* >( b->collider.ref() );
+
+        // the space of the other mesh, seen from this one
+        const vec3 axes[3] =
+        {
+            mesh->directionToLocal( other->axes[0] ),
+            mesh->directionToLocal( other->axes[1] ),
+            mesh->directionToLocal( other->axes[2] )
+        };
+        const vec3 origin = mesh->toLocal( other->center );
+
+        std::vector< TriangleContact > contacts;
+        TriangleContact found[ MAX_TRIANGLE_CONTACTS ];
+        mesh->bvh.query( other->bvh, axes, origin, [ & ]( uint32_t mine, uint32_t theirs )
+        {
+            MeshTriangle triangle = getMeshTriangle( *other, theirs );
+            const vec3 corners[3] = { triangle.triangle.a, triangle.triangle.b, triangle.triangle.c };
+            triangle.triangle = Triangle
+            (
+                origin + axes[0] * corners[0].x + axes[1] * corners[0].y + axes[2] * corners[0].z,
+                origin + axes[0] * corners[1].x + axes[1] * corners[1].y + axes[2] * corners[1].z,
+                origin + axes[0] * corners[2].x + axes[1] * corners[2].y + axes[2] * corners[2].z
+            );
+            triangle.normal = axes[0] * triangle.normal.x + axes[1] * triangle.normal.y + axes[2] * triangle.normal.z;
+
+            const uint32_t count = triangleTriangleContacts( getMeshTriangle( *mesh, mine ), triangle, found );
+            contacts.insert( contacts.end(), found, found + count );
+            return true;
+        });
+        return generateMeshManifolds( a, b, contacts, collisions );
     }
 
 }
@@ -6,16 +6,33 @@
 //
 
 #include "mesh-vs-sphere.hpp"
+#include "mesh-contacts.hpp"
 
 namespace kege::algo{
 
     bool meshSphereCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions )
     {
-        return false;
+        const ColliderMesh* mesh = static_cast< const ColliderMesh* >( a->collider.ref() );
+        const Sphere* sphere = b->collider->getSphere();
+
+        const vec3 center = mesh->toLocal( sphere->center );
+        const float radius = sphere->radius;
+        const vec3 r( radius, radius, radius );
+
+        std::vector< TriangleContact > contacts;
+        TriangleContact found[ MAX_TRIANGLE_CONTACTS ];
+        mesh->bvh.query( AABB( center - r, center + r ), [ & ]( uint32_t t )
+        {
+            const uint32_t count = sphereTriangleContacts( getMeshTriangle( *mesh, t ), center, radius, found );
+            contacts.insert( contacts.end(), found, found + count );
+            return true;
+        });
+        return generateMeshManifolds( a, b, contacts, collisions );
     }
     bool sphereMeshCollision( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions )
     {
-        return false;
+        // the manifolds name the mesh first, with the normal pointing at the sphere
+        return meshSphereCollision( b, a, collisions );
     }
 
 }
@@ -40,6 +40,7 @@ namespace kege::algo{
                     {
                         collision->contacts[ collision->contact_count ].point = points[ i ];
                         collision->contacts[ collision->contact_count ].depth = abs(dist);
+                        collision->contacts[ collision->contact_count ].feature = i + 1;
                         collision->contact_count++;
                     }
                 }
@@ -99,6 +99,12 @@ namespace kege::algo{
             return false; // No intersection
         }
 
+        // An edge lying in the plane has no single crossing, 0/0 would make a NaN contact point
+        if (d[0] == d[1])
+        {
+            return false;
+        }
+
         // Find the intersection t parameter
         d[0] = d[0] / (d[0] - d[1]);
         if (d[0] < 0.0f || d[0] > 1.0f)
@@ -454,16 +460,16 @@ namespace kege::algo{
         }
 
         // Check if point is outside edge BC
-        float va = d3 * d2 - d1 * d4;
-        if (va <= 0.0f && (d4 - d3) >= 0.0f && (d1 - d2) >= 0.0f)
+        float va = d3 * d6 - d5 * d4;
+        if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
         {
-            float v = (d4 - d3) / ((d4 - d3) + (d1 - d2));
+            float v = (d4 - d3) / ((d4 - d3) + (d5 - d6));
             return b + v * (c - b);
         }
 
         // Check if point is outside edge CA
-        float vb = d1 * d6 - d5 * d2;
-        if (vb <= 0.0f && d6 >= 0.0f && d2 <= 0.0f)
+        float vb = d5 * d2 - d1 * d6;
+        if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
         {
             float v = d6 / (d6 - d2);
             return c + v * (a - c);
@@ -0,0 +1,75 @@
+//
+//  broadphase.hpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef kege_physics_broadphase_hpp
+#define kege_physics_broadphase_hpp
+
+#include <vector>
+#include "../../../../../core/memory/ref.hpp"
+#include "../../../../../core/ecs/component-cache.hpp"
+#include "../../../../../core/math/geometry/primitive-3D-shapes.hpp"
+
+namespace kege::physics{
+
+    /**
+     * @brief What a broadphase knows about one rigidbody for the current step.
+     */
+    struct BroadphaseBody
+    {
+        /**
+         * the tight world space bounds of the collider.
+         */
+        AABB bounds;
+        vec3 center;
+
+        /**
+         * the stable id of the rigidbody in its cache, used to keep state between steps.
+         */
+        ComponentID id;
+
+        /**
+         * false for bodies that are asleep or immovable, these do not move and can not start a pair
+         * with each other.
+         */
+        bool awake;
+    };
+
+    /**
+     * @brief A candidate pair, as indices into the BroadphaseBody list of the step.
+     */
+    struct BroadphasePair
+    {
+        uint32_t a;
+        uint32_t b;
+    };
+
+    /**
+     * @brief Narrows the body pairs of a step down to the ones whose bounds overlap.
+     *
+     * The CollisionDetector hands every body with bounded collider to findPairs() once per step
+     * and runs the narrowphase on the pairs it returns. Implementations may keep state between
+     * steps, keyed by BroadphaseBody::id, and may leave out pairs of two bodies that are not awake.
+     */
+    class Broadphase : public kege::RefCounter
+    {
+    public:
+
+        /**
+         * @brief Replaces `pairs` with the pairs of `bodies` whose bounds overlap, each pair once.
+         */
+        virtual void findPairs( const std::vector< BroadphaseBody >& bodies, std::vector< BroadphasePair >& pairs ) = 0;
+
+        /**
+         * @brief Drops the state kept between steps.
+         */
+        virtual void clear() = 0;
+
+        virtual ~Broadphase(){}
+    };
+
+}
+#endif /* kege_physics_broadphase_hpp */
@@ -0,0 +1,305 @@
+//
+//  dynamic-aabb-tree.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#include <cassert>
+#include <algorithm>
+#include "dynamic-aabb-tree.hpp"
+
+namespace kege::physics{
+
+    float DynamicAABBTree::margin = 0.1f;
+    float DynamicAABBTree::displacement_multiplier = 2.0f;
+
+    static inline AABB merge( const AABB& a, const AABB& b )
+    {
+        return AABB
+        (
+            vec3( std::min( a.min.x, b.min.x ), std::min( a.min.y, b.min.y ), std::min( a.min.z, b.min.z ) ),
+            vec3( std::max( a.max.x, b.max.x ), std::max( a.max.y, b.max.y ), std::max( a.max.z, b.max.z ) )
+        );
+    }
+
+    static inline bool contains( const AABB& outer, const AABB& inner )
+    {
+        return
+        outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+        inner.max.x <= outer.max.x && inner.max.y <= outer.max.y && inner.max.z <= outer.max.z;
+    }
+
+    /**
+     * half the surface area, the insertion cost heuristic only compares areas.
+     */
+    static inline float area( const AABB& box )
+    {
+        const vec3 d = box.max - box.min;
+        return d.x * d.y + d.y * d.z + d.z * d.x;
+    }
+
+    static inline AABB fatten( const AABB& bounds, const vec3& displacement )
+    {
+        const vec3 r( DynamicAABBTree::margin, DynamicAABBTree::margin, DynamicAABBTree::margin );
+        AABB box( bounds.min - r, bounds.max + r );
+
+        const vec3 d = displacement * DynamicAABBTree::displacement_multiplier;
+        if ( d.x < 0.0f ) box.min.x += d.x; else box.max.x += d.x;
+        if ( d.y < 0.0f ) box.min.y += d.y; else box.max.y += d.y;
+        if ( d.z < 0.0f ) box.min.z += d.z; else box.max.z += d.z;
+        return box;
+    }
+
+    int32_t DynamicAABBTree::insert( const AABB& bounds, uint64_t data )
+    {
+        int32_t proxy = allocate();
+        _nodes[ proxy ].box = fatten( bounds, vec3( 0.0f, 0.0f, 0.0f ) );
+        _nodes[ proxy ].data = data;
+        _nodes[ proxy ].height = 0;
+        insertLeaf( proxy );
+        _count += 1;
+        return proxy;
+    }
+
+    void DynamicAABBTree::remove( int32_t proxy )
+    {
+        assert( 0 <= proxy && proxy < int32_t( _nodes.size() ) && _nodes[ proxy ].leaf() );
+        removeLeaf( proxy );
+        release( proxy );
+        _count -= 1;
+    }
+
+    bool DynamicAABBTree::move( int32_t proxy, const AABB& bounds, const vec3& displacement )
+    {
+        if ( contains( _nodes[ proxy ].box, bounds ) )
+        {
+            return false;
+        }
+
+        removeLeaf( proxy );
+        _nodes[ proxy ].box = fatten( bounds, displacement );
+        insertLeaf( proxy );
+        return true;
+    }
+
+    int32_t DynamicAABBTree::height()const
+    {
+        return ( _root == NULL_NODE ) ? 0 : _nodes[ _root ].height;
+    }
+
+    void DynamicAABBTree::clear()
+    {
+        _nodes.clear();
+        _root = NULL_NODE;
+        _free = NULL_NODE;
+        _count = 0;
+    }
+
+    int32_t DynamicAABBTree::allocate()
+    {
+        if ( _free == NULL_NODE )
+        {
+            _nodes.push_back( Node() );
+            _free = int32_t( _nodes.size() - 1 );
+            _nodes[ _free ].parent = NULL_NODE;
+        }
+
+        int32_t node = _free;
+        _free = _nodes[ node ].parent;
+        _nodes[ node ].parent = NULL_NODE;
+        _nodes[ node ].child[0] = NULL_NODE;
+        _nodes[ node ].child[1] = NULL_NODE;
+        _nodes[ node ].height = 0;
+        _nodes[ node ].data = 0;
+        return node;
+    }
+
+    void DynamicAABBTree::release( int32_t node )
+    {
+        _nodes[ node ].parent = _free;
+        _nodes[ node ].height = -1;
+        _free = node;
+    }
+
+    void DynamicAABBTree::insertLeaf( int32_t leaf )
+    {
+        if ( _root == NULL_NODE )
+        {
+            _root = leaf;
+            _nodes[ leaf ].parent = NULL_NODE;
+            return;
+        }
+
+        /*
+         descend towards the sibling with the cheapest surface area increase. a branch is left
+         once pairing the leaf with the current node is cheaper than pushing it further down.
+         */
+        const AABB box = _nodes[ leaf ].box;
+        int32_t index = _root;
+        while ( !_nodes[ index ].leaf() )
+        {
+            const Node& node = _nodes[ index ];
+            const float node_area = area( node.box );
+            const float combined_area = area( merge( node.box, box ) );
+
+            const float cost = 2.0f * combined_area;
+            const float inheritance = 2.0f * ( combined_area - node_area );
+
+            float child_cost[2];
+            for ( int i = 0; i < 2; ++i )
+            {
+                const Node& child = _nodes[ node.child[ i ] ];
+                const float merged = area( merge( child.box, box ) );
+                child_cost[ i ] = ( child.leaf() ? merged : merged - area( child.box ) ) + inheritance;
+            }
+
+            if ( cost < child_cost[0] && cost < child_cost[1] )
+            {
+                break;
+            }
+            index = ( child_cost[0] < child_cost[1] ) ? node.child[0] : node.child[1];
+        }
+
+        const int32_t sibling = index;
+        const int32_t old_parent = _nodes[ sibling ].parent;
+        const int32_t new_parent = allocate();
+
+        _nodes[ new_parent ].parent = old_parent;
+        _nodes[ new_parent ].box = merge( box, _nodes[ sibling ].box );
+        _nodes[ new_parent ].height = _nodes[ sibling ].height + 1;
+        _nodes[ new_parent ].child[0] = sibling;
+        _nodes[ new_parent ].child[1] = leaf;
+        _nodes[ sibling ].parent = new_parent;
+        _nodes[ leaf ].parent = new_parent;
+
+        if ( old_parent != NULL_NODE )
+        {
+            Node& parent = _nodes[ old_parent ];
+            parent.child[ ( parent.child[0] == sibling ) ? 0 : 1 ] = new_parent;
+        }
+        else
+        {
+            _root = new_parent;
+        }
+
+        refit( _nodes[ leaf ].parent );
+    }
+
+    void DynamicAABBTree::removeLeaf( int32_t leaf )
+    {
+        if ( leaf == _root )
+        {
+            _root = NULL_NODE;
+            return;
+        }
+
+        const int32_t parent = _nodes[ leaf ].parent;
+        const int32_t grand_parent = _nodes[ parent ].parent;
+        const int32_t sibling = ( _nodes[ parent ].child[0] == leaf ) ? _nodes[ parent ].child[1] : _nodes[ parent ].child[0];
+
+        // the sibling takes the place of the parent
+        if ( grand_parent != NULL_NODE )
+        {
+            Node& node = _nodes[ grand_parent ];
+            node.child[ ( node.child[0] == parent ) ? 0 : 1 ] = sibling;
+            _nodes[ sibling ].parent = grand_parent;
+            release( parent );
+            refit( grand_parent );
+        }
+        else
+        {
+            _root = sibling;
+            _nodes[ sibling ].parent = NULL_NODE;
+            release( parent );
+        }
+        _nodes[ leaf ].parent = NULL_NODE;
+    }
+
+    void DynamicAABBTree::refit( int32_t index )
+    {
+        while ( index != NULL_NODE )
+        {
+            index = balance( index );
+
+            Node& node = _nodes[ index ];
+            const Node& a = _nodes[ node.child[0] ];
+            const Node& b = _nodes[ node.child[1] ];
+            node.height = 1 + std::max( a.height, b.height );
+            node.box = merge( a.box, b.box );
+
+            index = node.parent;
+        }
+    }
+
+    int32_t DynamicAABBTree::balance( int32_t a )
+    {
+        /*
+         rotates the taller grandchild up when the children of `a` differ in height by more than
+         one. returns the node that now sits where `a` was.
+
+                 a               c
+                / \             / \
+               b   c    ->     a   f
+                  / \         / \
+                 f   g       b   g
+         */
+        Node& A = _nodes[ a ];
+        if ( A.leaf() || A.height < 2 )
+        {
+            return a;
+        }
+
+        const int32_t b = A.child[0];
+        const int32_t c = A.child[1];
+        const int32_t difference = _nodes[ c ].height - _nodes[ b ].height;
+        if ( -1 <= difference && difference <= 1 )
+        {
+            return a;
+        }
+
+        // the taller child rotates up, the shorter one stays below `a`
+        const int32_t up = ( difference > 0 ) ? c : b;
+        const int32_t stay = ( difference > 0 ) ? b : c;
+        Node& U = _nodes[ up ];
+
+        const int32_t f = U.child[0];
+        const int32_t g = U.child[1];
+
+        U.child[0] = a;
+        U.parent = A.parent;
+        A.parent = up;
+
+        if ( U.parent != NULL_NODE )
+        {
+            Node& parent = _nodes[ U.parent ];
+            parent.child[ ( parent.child[0] == a ) ? 0 : 1 ] = up;
+        }
+        else
+        {
+            _root = up;
+        }
+
+        // the taller grandchild stays with `up`, the other one moves under `a`
+        const int32_t keep = ( _nodes[ f ].height > _nodes[ g ].height ) ? f : g;
+        const int32_t give = ( keep == f ) ? g : f;
+
+        U.child[1] = keep;
+        A.child[0] = stay;
+        A.child[1] = give;
+        _nodes[ give ].parent = a;
+
+        A.box = merge( _nodes[ stay ].box, _nodes[ give ].box );
+        A.height = 1 + std::max( _nodes[ stay ].height, _nodes[ give ].height );
+        U.box = merge( A.box, _nodes[ keep ].box );
+        U.height = 1 + std::max( A.height, _nodes[ keep ].height );
+        return up;
+    }
+
+    DynamicAABBTree::DynamicAABBTree()
+    :   _root( NULL_NODE )
+    ,   _free( NULL_NODE )
+    ,   _count( 0 )
+    {}
+
+}
@@ -0,0 +1,276 @@
+//
+//  dynamic-aabb-tree.hpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef dynamic_aabb_tree_hpp
+#define dynamic_aabb_tree_hpp
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include "../../../../../core/math/geometry/primitive-3D-shapes.hpp"
+
+namespace kege::physics{
+
+    /**
+     * @brief A bounding volume hierarchy over fat axis aligned boxes, kept balanced with tree rotations.
+     *
+     * Every leaf is a proxy holding a user value and an enlarged copy of the bounds it was given.
+     * Moving a proxy only touches the tree when its new bounds leave the fat bounds, so bodies that
+     * jitter or move slowly cost nothing per step. Proxies keep their id until they are removed.
+     */
+    class DynamicAABBTree
+    {
+    public:
+
+        enum{ NULL_NODE = -1 };
+
+        /**
+         * @brief Adds a proxy.
+         * @param bounds The tight bounds of the object, enlarged by `margin` inside the tree.
+         * @param data A user value returned by data().
+         * @return The proxy id.
+         */
+        int32_t insert( const AABB& bounds, uint64_t data );
+
+        /**
+         * @brief Removes a proxy. Its id may be handed out again by a later insert().
+         */
+        void remove( int32_t proxy );
+
+        /**
+         * @brief Updates the bounds of a proxy.
+         *
+         * Nothing changes while the tight bounds stay inside the fat bounds. Otherwise the proxy is
+         * reinserted with bounds enlarged by `margin` and stretched along `displacement`, the
+         * expected motion until the next step.
+         *
+         * @return True if the proxy was reinserted.
+         */
+        bool move( int32_t proxy, const AABB& bounds, const vec3& displacement );
+
+        /**
+         * @brief Calls `func( int32_t proxy )` for every proxy whose fat bounds overlap `bounds`.
+         * The query stops early when `func` returns false.
+         */
+        template< typename Func > void query( const AABB& bounds, Func&& func )const;
+
+        /**
+         * @brief Walks the proxies whose fat bounds the ray enters before `max_distance`, nearest first.
+         *
+         * `func( int32_t proxy, float& max_distance )` tests a proxy and lowers max_distance when it
+         * hits closer, which prunes the rest of the walk. Setting it below zero ends the walk.
+         */
+        template< typename Func > void raycast( const Ray& ray, float max_distance, Func&& func )const
+        {
+            sweep( ray, 0.f, max_distance, std::forward< Func >( func ) );
+        }
+
+        /**
+         * @brief raycast() with every box grown by `radius`, the walk of a sphere swept along the ray.
+         */
+        template< typename Func > void sweep( const Ray& ray, float radius, float max_distance, Func&& func )const;
+
+        /**
+         * @brief Gets the fat bounds of a proxy.
+         */
+        inline const AABB& fatBounds( int32_t proxy )const
+        {
+            return _nodes[ proxy ].box;
+        }
+
+        inline uint64_t data( int32_t proxy )const
+        {
+            return _nodes[ proxy ].data;
+        }
+
+        inline void setData( int32_t proxy, uint64_t data )
+        {
+            _nodes[ proxy ].data = data;
+        }
+
+        /**
+         * @brief Gets the height of the tree, zero for a single leaf.
+         */
+        int32_t height()const;
+
+        /**
+         * @brief Gets the number of proxies in the tree.
+         */
+        inline uint32_t count()const
+        {
+            return _count;
+        }
+
+        void clear();
+
+        DynamicAABBTree();
+
+    public:
+
+        /**
+         * @brief Distance every fat bounds extends past the tight bounds.
+         */
+        static float margin;
+
+        /**
+         * @brief How far ahead of a moving proxy its fat bounds reach, as a multiple of its displacement.
+         */
+        static float displacement_multiplier;
+
+    private:
+
+        struct Node
+        {
+            inline bool leaf()const
+            {
+                return child[0] == NULL_NODE;
+            }
+
+            AABB box;
+
+            /**
+             * the parent of a node in the tree, or the next free node while on the free list.
+             */
+            int32_t parent;
+            int32_t child[2];
+
+            /**
+             * leaves have height 0, free nodes -1.
+             */
+            int32_t height;
+            uint64_t data;
+        };
+
+        /**
+         * the distance the ray enters the box at, or a negative value if it misses it before max_distance.
+         */
+        static inline float enter( const AABB& box, float radius, const vec3& origin, const vec3& inverse, float max_distance )
+        {
+            float near = 0.f;
+            float far = max_distance;
+            for ( int i = 0; i < 3; ++i )
+            {
+                float t0 = ( box.min[ i ] - radius - origin[ i ] ) * inverse[ i ];
+                float t1 = ( box.max[ i ] + radius - origin[ i ] ) * inverse[ i ];
+                if ( t0 > t1 ) std::swap( t0, t1 );
+                // a ray along a slab face gives NaN, which neither comparison lets through
+                near = ( t0 > near ) ? t0 : near;
+                far = ( t1 < far ) ? t1 : far;
+            }
+            return ( near <= far ) ? near : -1.f;
+        }
+
+        int32_t allocate();
+        void release( int32_t node );
+        void insertLeaf( int32_t leaf );
+        void removeLeaf( int32_t leaf );
+        int32_t balance( int32_t node );
+        void refit( int32_t node );
+
+    private:
+
+        std::vector< Node > _nodes;
+        int32_t _root;
+        int32_t _free;
+        uint32_t _count;
+    };
+
+    /**
+     * @brief Checks if two boxes overlap, touching counts as overlapping.
+     */
+    inline bool overlaps( const AABB& a, const AABB& b )
+    {
+        return
+        a.min.x <= b.max.x && b.min.x <= a.max.x &&
+        a.min.y <= b.max.y && b.min.y <= a.max.y &&
+        a.min.z <= b.max.z && b.min.z <= a.max.z;
+    }
+
+
+    template< typename Func > void DynamicAABBTree::query( const AABB& bounds, Func&& func )const
+    {
+        if ( _root == NULL_NODE ) return;
+
+        /*
+         the tree is kept balanced, so its height stays far below the stack size. the AVL style
+         rotations bound it by roughly 1.44 * log2( leaves ).
+         */
+        int32_t stack[ 256 ];
+        int32_t top = 0;
+        stack[ top++ ] = _root;
+
+        while ( top > 0 )
+        {
+            const Node& node = _nodes[ stack[ --top ] ];
+            if ( !overlaps( node.box, bounds ) ) continue;
+
+            if ( node.leaf() )
+            {
+                if ( !func( int32_t( &node - _nodes.data() ) ) ) return;
+            }
+            else
+            {
+                stack[ top++ ] = node.child[0];
+                stack[ top++ ] = node.child[1];
+            }
+        }
+    }
+
+    template< typename Func > void DynamicAABBTree::sweep( const Ray& ray, float radius, float max_distance, Func&& func )const
+    {
+        if ( _root == NULL_NODE ) return;
+
+        const vec3 inverse( 1.f / ray.direction.x, 1.f / ray.direction.y, 1.f / ray.direction.z );
+        const float root = enter( _nodes[ _root ].box, radius, ray.origin, inverse, max_distance );
+        if ( root < 0.f ) return;
+
+        int32_t stack[ 256 ];
+        float distances[ 256 ];
+        int32_t top = 0;
+        stack[ top ] = _root;
+        distances[ top++ ] = root;
+
+        while ( top > 0 )
+        {
+            --top;
+            // a hit found since the node was pushed may already be closer than the node
+            if ( distances[ top ] > max_distance ) continue;
+
+            const Node& node = _nodes[ stack[ top ] ];
+            if ( node.leaf() )
+            {
+                func( stack[ top ], max_distance );
+                continue;
+            }
+
+            float first_distance = enter( _nodes[ node.child[0] ].box, radius, ray.origin, inverse, max_distance );
+            float second_distance = enter( _nodes[ node.child[1] ].box, radius, ray.origin, inverse, max_distance );
+
+            // the nearer child goes on top so it is walked first
+            int32_t first = node.child[0];
+            int32_t second = node.child[1];
+            if ( second_distance >= 0.f && ( first_distance < 0.f || second_distance < first_distance ) )
+            {
+                std::swap( first, second );
+                std::swap( first_distance, second_distance );
+            }
+
+            if ( second_distance >= 0.f )
+            {
+                stack[ top ] = second;
+                distances[ top++ ] = second_distance;
+            }
+            if ( first_distance >= 0.f )
+            {
+                stack[ top ] = first;
+                distances[ top++ ] = first_distance;
+            }
+        }
+    }
+
+}
+#endif /* dynamic_aabb_tree_hpp */
@@ -0,0 +1,312 @@
+//
+//  sweep-and-prune.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#include <algorithm>
+#include "dynamic-aabb-tree.hpp"
+#include "sweep-and-prune.hpp"
+
+namespace kege::physics{
+
+    float SweepAndPruneBroadphase::axis_hysteresis = 1.5f;
+
+    static inline float along( const vec3& v, int axis )
+    {
+        return ( axis == 0 ) ? v.x : ( axis == 1 ) ? v.y : v.z;
+    }
+
+    /**
+     * endpoints order by value, a min goes before a max of equal value so touching boxes overlap.
+     */
+    static inline bool before( float a_value, uint32_t a_key, float b_value, uint32_t b_key )
+    {
+        return a_value < b_value || ( a_value == b_value && ( a_key & 1 ) < ( b_key & 1 ) );
+    }
+
+    void SweepAndPruneBroadphase::findPairs( const std::vector< BroadphaseBody >& bodies, std::vector< BroadphasePair >& pairs )
+    {
+        pairs.clear();
+        _added.clear();
+        _step += 1;
+
+        for ( uint32_t i = 0; i < bodies.size(); ++i )
+        {
+            const BroadphaseBody& body = bodies[ i ];
+            uint32_t index;
+            auto m = _lookup.find( body.id );
+            if ( m == _lookup.end() )
+            {
+                index = allocate();
+                _lookup.emplace( body.id, index );
+                _added.push_back( index );
+                _boxes[ index ].id = body.id;
+            }
+            else
+            {
+                index = m->second;
+            }
+
+            Box& box = _boxes[ index ];
+            box.bounds = body.bounds;
+            box.body = i;
+            box.step = _step;
+            box.awake = body.awake;
+        }
+
+        removeStaleBoxes();
+
+        // inserting a few boxes into the sorted list is cheap, a crowd of new boxes is not
+        bool full_rebuild = _endpoints.empty() || _added.size() * 4 > _lookup.size();
+        chooseAxis( bodies, full_rebuild );
+
+        for ( auto& m : _lookup )
+        {
+            Box& box = _boxes[ m.second ];
+            box.lo = along( box.bounds.min, _axis );
+            box.hi = along( box.bounds.max, _axis );
+        }
+
+        if ( full_rebuild )
+        {
+            rebuild();
+        }
+        else
+        {
+            for ( Endpoint& e : _endpoints )
+            {
+                const Box& box = _boxes[ e.key >> 1 ];
+                e.value = ( e.key & 1 ) ? box.hi : box.lo;
+            }
+
+            /*
+             new boxes start past the end of the list, overlapping nothing, and are sorted into
+             place with the rest. their pairs come from the swaps like those of moving boxes.
+             */
+            for ( uint32_t index : _added )
+            {
+                _endpoints.push_back({ _boxes[ index ].lo, index * 2 });
+                _endpoints.push_back({ _boxes[ index ].hi, index * 2 + 1 });
+            }
+            sort();
+        }
+
+        for ( const Pair& pair : _pairs )
+        {
+            const Box& a = _boxes[ pair.a ];
+            const Box& b = _boxes[ pair.b ];
+            if ( !a.awake && !b.awake ) continue;
+            if ( overlaps( a.bounds, b.bounds ) )
+            {
+                pairs.push_back({ a.body, b.body });
+            }
+        }
+    }
+
+    void SweepAndPruneBroadphase::clear()
+    {
+        _boxes.clear();
+        _free_boxes.clear();
+        _lookup.clear();
+        _added.clear();
+        _endpoints.clear();
+        _pairs.clear();
+        _pair_index.clear();
+        _axis = 0;
+    }
+
+    uint32_t SweepAndPruneBroadphase::allocate()
+    {
+        if ( _free_boxes.empty() )
+        {
+            _boxes.push_back( Box() );
+            return uint32_t( _boxes.size() - 1 );
+        }
+
+        uint32_t index = _free_boxes.back();
+        _free_boxes.pop_back();
+        return index;
+    }
+
+    void SweepAndPruneBroadphase::removeStaleBoxes()
+    {
+        const uint32_t first_free = uint32_t( _free_boxes.size() );
+        for ( auto m = _lookup.begin(); m != _lookup.end(); )
+        {
+            if ( _boxes[ m->second ].step != _step )
+            {
+                _boxes[ m->second ].body = NONE;
+                _free_boxes.push_back( m->second );
+                m = _lookup.erase( m );
+            }
+            else
+            {
+                ++m;
+            }
+        }
+
+        if ( _free_boxes.size() == first_free )
+        {
+            return;
+        }
+
+        // removals are batched, one pass over the endpoints and the pairs for all of them
+        auto dead = [ this ]( uint32_t index ){ return _boxes[ index ].body == NONE; };
+        _endpoints.erase
+        (
+            std::remove_if( _endpoints.begin(), _endpoints.end(), [ & ]( const Endpoint& e ){ return dead( e.key >> 1 ); } ),
+            _endpoints.end()
+        );
+        _pairs.erase
+        (
+            std::remove_if( _pairs.begin(), _pairs.end(), [ & ]( const Pair& p ){ return dead( p.a ) || dead( p.b ); } ),
+            _pairs.end()
+        );
+
+        _pair_index.clear();
+        for ( uint32_t i = 0; i < _pairs.size(); ++i )
+        {
+            _pair_index.emplace( pairKey( _pairs[ i ].a, _pairs[ i ].b ), i );
+        }
+    }
+
+    void SweepAndPruneBroadphase::chooseAxis( const std::vector< BroadphaseBody >& bodies, bool& rebuild )
+    {
+        if ( bodies.empty() ) return;
+
+        /*
+         sweep along the axis the centers vary the most on, it separates the most boxes. the axis
+         only changes when another one is clearly better, a change re-sorts the whole list.
+         */
+        double sum[3] = { 0.0, 0.0, 0.0 };
+        double sum2[3] = { 0.0, 0.0, 0.0 };
+        for ( const BroadphaseBody& body : bodies )
+        {
+            for ( int k = 0; k < 3; ++k )
+            {
+                const double c = along( body.center, k );
+                sum[ k ] += c;
+                sum2[ k ] += c * c;
+            }
+        }
+
+        double variance[3];
+        int best = 0;
+        for ( int k = 0; k < 3; ++k )
+        {
+            const double mean = sum[ k ] / double( bodies.size() );
+            variance[ k ] = sum2[ k ] / double( bodies.size() ) - mean * mean;
+            if ( variance[ k ] > variance[ best ] ) best = k;
+        }
+
+        if ( best == _axis ) return;
+        if ( rebuild || variance[ best ] > double( axis_hysteresis ) * variance[ _axis ] )
+        {
+            _axis = best;
+            rebuild = true;
+        }
+    }
+
+    void SweepAndPruneBroadphase::rebuild()
+    {
+        _endpoints.clear();
+        _pairs.clear();
+        _pair_index.clear();
+
+        for ( auto& m : _lookup )
+        {
+            _endpoints.push_back({ _boxes[ m.second ].lo, m.second * 2 });
+            _endpoints.push_back({ _boxes[ m.second ].hi, m.second * 2 + 1 });
+        }
+        std::sort( _endpoints.begin(), _endpoints.end(), []( const Endpoint& a, const Endpoint& b )
+        {
+            return before( a.value, a.key, b.value, b.key );
+        });
+
+        // sweep the sorted list, a box overlaps every box still open when its min is reached
+        std::vector< uint32_t > open;
+        std::vector< uint32_t > slot( _boxes.size(), NONE );
+        for ( const Endpoint& e : _endpoints )
+        {
+            const uint32_t index = e.key >> 1;
+            if ( e.key & 1 )
+            {
+                const uint32_t s = slot[ index ];
+                slot[ open.back() ] = s;
+                open[ s ] = open.back();
+                open.pop_back();
+            }
+            else
+            {
+                for ( uint32_t other : open )
+                {
+                    addPair( index, other );
+                }
+                slot[ index ] = uint32_t( open.size() );
+                open.push_back( index );
+            }
+        }
+    }
+
+    void SweepAndPruneBroadphase::sort()
+    {
+        /*
+         insertion sort, an endpoint moving down swaps with every endpoint it passes. a min passing
+         a max starts the overlap of their boxes, a max passing a min ends it.
+         */
+        for ( uint32_t k = 1; k < _endpoints.size(); ++k )
+        {
+            const Endpoint e = _endpoints[ k ];
+            uint32_t j = k;
+            while ( j > 0 && before( e.value, e.key, _endpoints[ j - 1 ].value, _endpoints[ j - 1 ].key ) )
+            {
+                const Endpoint& prev = _endpoints[ j - 1 ];
+                if ( ( e.key & 1 ) == 0 && ( prev.key & 1 ) == 1 )
+                {
+                    addPair( e.key >> 1, prev.key >> 1 );
+                }
+                else if ( ( e.key & 1 ) == 1 && ( prev.key & 1 ) == 0 )
+                {
+                    removePair( e.key >> 1, prev.key >> 1 );
+                }
+                _endpoints[ j ] = prev;
+                j -= 1;
+            }
+            _endpoints[ j ] = e;
+        }
+    }
+
+    void SweepAndPruneBroadphase::addPair( uint32_t a, uint32_t b )
+    {
+        if ( _pair_index.emplace( pairKey( a, b ), uint32_t( _pairs.size() ) ).second )
+        {
+            _pairs.push_back({ a, b });
+        }
+    }
+
+    void SweepAndPruneBroadphase::removePair( uint32_t a, uint32_t b )
+    {
+        auto m = _pair_index.find( pairKey( a, b ) );
+        if ( m == _pair_index.end() )
+        {
+            return;
+        }
+
+        const uint32_t i = m->second;
+        _pair_index.erase( m );
+        if ( i + 1 != _pairs.size() )
+        {
+            _pairs[ i ] = _pairs.back();
+            _pair_index[ pairKey( _pairs[ i ].a, _pairs[ i ].b ) ] = i;
+        }
+        _pairs.pop_back();
+    }
+
+    SweepAndPruneBroadphase::SweepAndPruneBroadphase()
+    :   _axis( 0 )
+    ,   _step( 0 )
+    {}
+
+}
@@ -0,0 +1,134 @@
+//
+//  sweep-and-prune.hpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef sweep_and_prune_hpp
+#define sweep_and_prune_hpp
+
+#include <unordered_map>
+#include "broadphase.hpp"
+
+namespace kege::physics{
+
+    /**
+     * @brief Sweep and prune over one axis with a persistent pair cache.
+     *
+     * The box endpoints stay sorted along the axis the bodies are spread the most on. Each step
+     * the endpoints are re-sorted with an insertion sort, which is close to linear when bodies
+     * move little between steps, and every swap of a min and a max endpoint adds or removes the
+     * pair of their boxes from the cache. Only cached pairs whose bounds overlap on all axes are
+     * reported. Large changes, like the first step or a change of axis, rebuild the list instead.
+     */
+    class SweepAndPruneBroadphase : public Broadphase
+    {
+    public:
+
+        void findPairs( const std::vector< BroadphaseBody >& bodies, std::vector< BroadphasePair >& pairs );
+        void clear();
+
+        /**
+         * @brief Gets the number of pairs overlapping on the sweep axis, the size of the pair cache.
+         */
+        inline uint32_t cachedPairCount()const
+        {
+            return uint32_t( _pairs.size() );
+        }
+
+        /**
+         * @brief Gets the sweep axis, 0, 1 or 2 for x, y or z.
+         */
+        inline int axis()const
+        {
+            return _axis;
+        }
+
+        SweepAndPruneBroadphase();
+
+    public:
+
+        /**
+         * @brief How much larger the spread of the bodies on another axis has to be before the sweep axis changes.
+         */
+        static float axis_hysteresis;
+
+    private:
+
+        enum{ NONE = 0xFFFFFFFF };
+
+        struct Box
+        {
+            AABB bounds;
+
+            /**
+             * the extent of the box on the sweep axis.
+             */
+            float lo;
+            float hi;
+
+            ComponentID id;
+
+            /**
+             * the index of the body in the list of the current step.
+             */
+            uint32_t body;
+            uint32_t step;
+            bool awake;
+        };
+
+        /**
+         * the box and whether this is its max endpoint are packed as box * 2 + max.
+         */
+        struct Endpoint
+        {
+            float value;
+            uint32_t key;
+        };
+
+        struct Pair
+        {
+            uint32_t a;
+            uint32_t b;
+        };
+
+        uint32_t allocate();
+        void removeStaleBoxes();
+        void chooseAxis( const std::vector< BroadphaseBody >& bodies, bool& rebuild );
+        void rebuild();
+        void sort();
+
+        void addPair( uint32_t a, uint32_t b );
+        void removePair( uint32_t a, uint32_t b );
+
+        static inline uint64_t pairKey( uint32_t a, uint32_t b )
+        {
+            return ( a < b ) ? ( uint64_t( a ) << 32 ) | b : ( uint64_t( b ) << 32 ) | a;
+        }
+
+    private:
+
+        std::vector< Box > _boxes;
+        std::vector< uint32_t > _free_boxes;
+        std::unordered_map< ComponentID, uint32_t > _lookup;
+
+        /**
+         * boxes that entered this step and have no endpoints yet.
+         */
+        std::vector< uint32_t > _added;
+
+        std::vector< Endpoint > _endpoints;
+
+        /**
+         * the pairs whose boxes overlap on the sweep axis, and their index in _pairs by pair key.
+         */
+        std::vector< Pair > _pairs;
+        std::unordered_map< uint64_t, uint32_t > _pair_index;
+
+        int _axis;
+        uint32_t _step;
+    };
+
+}
+#endif /* sweep_and_prune_hpp */
@@ -0,0 +1,84 @@
+//
+//  tree-broadphase.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#include "tree-broadphase.hpp"
+
+namespace kege::physics{
+
+    void TreeBroadphase::findPairs( const std::vector< BroadphaseBody >& bodies, std::vector< BroadphasePair >& pairs )
+    {
+        pairs.clear();
+        _step += 1;
+
+        for ( uint32_t i = 0; i < bodies.size(); ++i )
+        {
+            const BroadphaseBody& body = bodies[ i ];
+            auto m = _proxies.find( body.id );
+            if ( m == _proxies.end() )
+            {
+                _proxies.emplace( body.id, Proxy{ _tree.insert( body.bounds, i ), _step, body.center } );
+                continue;
+            }
+
+            // sleeping and resting immovable bodies keep their leaf as it is
+            Proxy& proxy = m->second;
+            if ( body.awake || body.center != proxy.center )
+            {
+                _tree.move( proxy.node, body.bounds, body.center - proxy.center );
+                proxy.center = body.center;
+            }
+            _tree.setData( proxy.node, i );
+            proxy.step = _step;
+        }
+
+        // bodies that were destroyed or lost their bounded collider since the last step
+        for ( auto m = _proxies.begin(); m != _proxies.end(); )
+        {
+            if ( m->second.step != _step )
+            {
+                _tree.remove( m->second.node );
+                m = _proxies.erase( m );
+            }
+            else
+            {
+                ++m;
+            }
+        }
+
+        /*
+         a pair of two awake bodies is found from both sides and kept by the lower index, a pair
+         with one sleeping body only by the awake one.
+         */
+        for ( uint32_t i = 0; i < bodies.size(); ++i )
+        {
+            if ( !bodies[ i ].awake ) continue;
+
+            const AABB& bounds = bodies[ i ].bounds;
+            _tree.query( bounds, [ & ]( int32_t node )
+            {
+                const uint32_t j = uint32_t( _tree.data( node ) );
+                if ( j == i || ( bodies[ j ].awake && j < i ) ) return true;
+                if ( overlaps( bounds, bodies[ j ].bounds ) )
+                {
+                    pairs.push_back({ i, j });
+                }
+                return true;
+            });
+        }
+    }
+
+    void TreeBroadphase::clear()
+    {
+        _tree.clear();
+        _proxies.clear();
+    }
+
+    TreeBroadphase::TreeBroadphase()
+    :   _step( 0 )
+    {}
+
+}
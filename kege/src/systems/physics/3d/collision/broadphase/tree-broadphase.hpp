@@ -0,0 +1,56 @@
+//
+//  tree-broadphase.hpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef tree_broadphase_hpp
+#define tree_broadphase_hpp
+
+#include <unordered_map>
+#include "broadphase.hpp"
+#include "dynamic-aabb-tree.hpp"
+
+namespace kege::physics{
+
+    /**
+     * @brief Broadphase over a DynamicAABBTree. Suits scenes with many moving bodies spread in
+     * every direction. Only awake bodies search the tree, so sleeping pairs are never reported.
+     */
+    class TreeBroadphase : public Broadphase
+    {
+    public:
+
+        void findPairs( const std::vector< BroadphaseBody >& bodies, std::vector< BroadphasePair >& pairs );
+        void clear();
+
+        inline const DynamicAABBTree& tree()const
+        {
+            return _tree;
+        }
+
+        TreeBroadphase();
+
+    private:
+
+        struct Proxy
+        {
+            int32_t node;
+
+            /**
+             * the step this proxy was last seen in, proxies of bodies that are gone fall behind.
+             */
+            uint32_t step;
+            vec3 center;
+        };
+
+    private:
+
+        DynamicAABBTree _tree;
+        std::unordered_map< ComponentID, Proxy > _proxies;
+        uint32_t _step;
+    };
+
+}
+#endif /* tree_broadphase_hpp */
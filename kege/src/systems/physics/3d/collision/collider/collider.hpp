@@ -23,11 +23,17 @@ namespace kege{
         RIGID_SHAPE_CYLINDER,
         RIGID_SHAPE_CIRCLE,
         RIGID_SHAPE_MESH,
+        RIGID_SHAPE_CONVEX,
         RIGID_SHAPE_MAX_COUNT
     };
 
     struct Rigidbody;
 
+    /**
+     * @brief The most points Collider::supportFace() returns.
+     */
+    enum{ MAX_FACE_POINTS = 16 };
+
     struct Collider : public RefCounter
     {
         virtual const OBB* getBox()const{ return nullptr; }
@@ -40,6 +46,30 @@ namespace kege{
         virtual const Cone* getCone()const{ return nullptr; }
         virtual const Circle* getCircle()const{ return nullptr; }
         virtual void integrate( Rigidbody* body ){}
+
+        /**
+         * @brief Gets the point of the shape farthest along `direction`, in world space as of the
+         * last integrate(). The GJK and EPA routines only see convex shapes through this.
+         * Shapes without one, planes and meshes, return their center.
+         */
+        virtual vec3 support( const vec3& direction )const{ return vec3( 0.f, 0.f, 0.f ); }
+
+        /**
+         * @brief Gets the feature of the shape that faces `direction` the most, the one contact
+         * points are clipped from. A face is returned as a convex polygon with its outward normal,
+         * an edge as two points and anything round as the single support point.
+         * @param points Room for MAX_FACE_POINTS points.
+         * @return The number of points, 0 for shapes without features.
+         */
+        virtual uint32_t supportFace( const vec3& direction, vec3* points, vec3& normal )const{ return 0; }
+
+        /**
+         * @brief Gets the world space bounds of the shape as of its last integrate().
+         * @return False for shapes without finite bounds, such as planes. The broadphase pairs
+         * those with every other body.
+         */
+        virtual bool getBounds( AABB& bounds )const{ return false; }
+
         RigidShape getShapeType()const{ return shape_type; }
         Collider( RigidShape shape ): shape_type( shape ) {}
 
@@ -0,0 +1,268 @@
+//
+//  mesh-bvh.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#include <cfloat>
+#include <algorithm>
+#include "mesh-bvh.hpp"
+
+namespace kege::physics{
+
+    uint32_t MeshBVH::max_leaf_size = 8;
+    float MeshBVH::traversal_cost = 1.f;
+
+    static_assert( sizeof( MeshBVH::Node ) == 32, "MeshBVH::Node must stay 32 bytes" );
+
+    static inline float area( const float (&min)[3], const float (&max)[3] )
+    {
+        const float x = max[0] - min[0];
+        const float y = max[1] - min[1];
+        const float z = max[2] - min[2];
+        return x * y + y * z + z * x;
+    }
+
+    static inline void reset( float (&min)[3], float (&max)[3] )
+    {
+        for ( int k = 0; k < 3; ++k )
+        {
+            min[ k ] = FLT_MAX;
+            max[ k ] = -FLT_MAX;
+        }
+    }
+
+    static inline void grow( float (&min)[3], float (&max)[3], const float* box_min, const float* box_max )
+    {
+        for ( int k = 0; k < 3; ++k )
+        {
+            min[ k ] = std::min( min[ k ], box_min[ k ] );
+            max[ k ] = std::max( max[ k ], box_max[ k ] );
+        }
+    }
+
+    void MeshBVH::build( const vec3* vertices, const uint32_t* indices, uint32_t triangle_count )
+    {
+        clear();
+        if ( triangle_count == 0 ) return;
+
+        /*
+         the builder works on the bounds and centroids of the triangles, six and three floats per
+         triangle, and only reorders the triangle indices.
+         */
+        std::vector< float > boxes( size_t( triangle_count ) * 6 );
+        std::vector< float > centers( size_t( triangle_count ) * 3 );
+        for ( uint32_t t = 0; t < triangle_count; ++t )
+        {
+            const vec3& a = vertices[ indices[ t * 3 + 0 ] ];
+            const vec3& b = vertices[ indices[ t * 3 + 1 ] ];
+            const vec3& c = vertices[ indices[ t * 3 + 2 ] ];
+            float* box = &boxes[ size_t( t ) * 6 ];
+            for ( int k = 0; k < 3; ++k )
+            {
+                box[ k ] = std::min( { a[ k ], b[ k ], c[ k ] } );
+                box[ 3 + k ] = std::max( { a[ k ], b[ k ], c[ k ] } );
+                centers[ size_t( t ) * 3 + k ] = ( box[ k ] + box[ 3 + k ] ) * 0.5f;
+            }
+        }
+
+        _triangles.resize( triangle_count );
+        for ( uint32_t t = 0; t < triangle_count; ++t )
+        {
+            _triangles[ t ] = t;
+        }
+
+        _nodes.reserve( size_t( triangle_count ) * 2 );
+        _nodes.emplace_back();
+        Node& root = _nodes.back();
+        reset( root.min, root.max );
+        for ( uint32_t t = 0; t < triangle_count; ++t )
+        {
+            grow( root.min, root.max, &boxes[ size_t( t ) * 6 ], &boxes[ size_t( t ) * 6 + 3 ] );
+        }
+        root.index = 0;
+        root.count = triangle_count;
+
+        /*
+         nodes are split depth first, their children are appended as a pair. the depth is
+         tracked so a degenerate mesh cannot grow the tree past the query stacks.
+         */
+        std::vector< std::pair< uint32_t, uint32_t > > pending;
+        pending.push_back( { 0, 0 } );
+        while ( !pending.empty() )
+        {
+            const std::pair< uint32_t, uint32_t > next = pending.back();
+            pending.pop_back();
+            if ( next.second + 1 >= STACK_SIZE ) continue;
+
+            split( next.first, boxes, centers );
+            if ( !_nodes[ next.first ].leaf() )
+            {
+                pending.push_back( { _nodes[ next.first ].index + 1, next.second + 1 } );
+                pending.push_back( { _nodes[ next.first ].index, next.second + 1 } );
+            }
+        }
+    }
+
+    void MeshBVH::split( uint32_t index, const std::vector< float >& boxes, const std::vector< float >& centers )
+    {
+        const uint32_t first = _nodes[ index ].index;
+        const uint32_t count = _nodes[ index ].count;
+        if ( count <= 1 ) return;
+
+        float center_min[3];
+        float center_max[3];
+        reset( center_min, center_max );
+        for ( uint32_t i = first; i < first + count; ++i )
+        {
+            const float* c = &centers[ size_t( _triangles[ i ] ) * 3 ];
+            grow( center_min, center_max, c, c );
+        }
+
+        /*
+         binned SAH, the centroids are dropped into BINS slices along each axis and every border
+         between slices is scored by the area of each side times its triangle count.
+         */
+        float best_cost = FLT_MAX;
+        int best_axis = -1;
+        int best_split = 0;
+        for ( int axis = 0; axis < 3; ++axis )
+        {
+            const float extent = center_max[ axis ] - center_min[ axis ];
+            if ( extent <= 0.f ) continue;
+
+            Bin bins[ BINS ];
+            for ( Bin& bin : bins )
+            {
+                reset( bin.min, bin.max );
+                bin.count = 0;
+            }
+
+            const float scale = float( BINS ) / extent;
+            for ( uint32_t i = first; i < first + count; ++i )
+            {
+                const uint32_t t = _triangles[ i ];
+                const int b = std::min( int( ( centers[ size_t( t ) * 3 + axis ] - center_min[ axis ] ) * scale ), BINS - 1 );
+                grow( bins[ b ].min, bins[ b ].max, &boxes[ size_t( t ) * 6 ], &boxes[ size_t( t ) * 6 + 3 ] );
+                bins[ b ].count += 1;
+            }
+
+            // the area and count left of every border, then right of it on the way back
+            float left_area[ BINS - 1 ];
+            uint32_t left_count[ BINS - 1 ];
+            float min[3], max[3];
+            reset( min, max );
+            uint32_t sum = 0;
+            for ( int b = 0; b < BINS - 1; ++b )
+            {
+                if ( bins[ b ].count != 0 ) grow( min, max, bins[ b ].min, bins[ b ].max );
+                sum += bins[ b ].count;
+                left_count[ b ] = sum;
+                left_area[ b ] = ( sum != 0 ) ? area( min, max ) : 0.f;
+            }
+
+            reset( min, max );
+            sum = 0;
+            for ( int b = BINS - 1; b > 0; --b )
+            {
+                if ( bins[ b ].count != 0 ) grow( min, max, bins[ b ].min, bins[ b ].max );
+                sum += bins[ b ].count;
+                if ( sum == 0 || left_count[ b - 1 ] == 0 ) continue;
+
+                const float cost = left_area[ b - 1 ] * float( left_count[ b - 1 ] ) + area( min, max ) * float( sum );
+                if ( cost < best_cost )
+                {
+                    best_cost = cost;
+                    best_axis = axis;
+                    best_split = b;
+                }
+            }
+        }
+
+        Node& node = _nodes[ index ];
+        const float node_area = area( node.min, node.max );
+        const float leaf_cost = float( count );
+        const float split_cost = ( node_area > 0.f ) ? traversal_cost + best_cost / node_area : FLT_MAX;
+
+        uint32_t middle;
+        if ( best_axis >= 0 && ( split_cost < leaf_cost || count > max_leaf_size ) )
+        {
+            const float scale = float( BINS ) / ( center_max[ best_axis ] - center_min[ best_axis ] );
+            uint32_t* begin = &_triangles[ first ];
+            uint32_t* part = std::partition( begin, begin + count, [ & ]( uint32_t t )
+            {
+                return std::min( int( ( centers[ size_t( t ) * 3 + best_axis ] - center_min[ best_axis ] ) * scale ), BINS - 1 ) < best_split;
+            });
+            middle = first + uint32_t( part - begin );
+        }
+        else if ( count > max_leaf_size )
+        {
+            // every centroid in the same spot, the SAH cannot tell the triangles apart
+            middle = first + count / 2;
+        }
+        else
+        {
+            return;
+        }
+
+        const uint32_t left = uint32_t( _nodes.size() );
+        _nodes.resize( _nodes.size() + 2 );
+        _nodes[ index ].index = left;
+        _nodes[ index ].count = 0;
+
+        const uint32_t ranges[2][2] = { { first, middle - first }, { middle, first + count - middle } };
+        for ( int c = 0; c < 2; ++c )
+        {
+            Node& child = _nodes[ left + c ];
+            child.index = ranges[ c ][0];
+            child.count = ranges[ c ][1];
+            reset( child.min, child.max );
+            for ( uint32_t i = child.index; i < child.index + child.count; ++i )
+            {
+                const float* box = &boxes[ size_t( _triangles[ i ] ) * 6 ];
+                grow( child.min, child.max, box, box + 3 );
+            }
+        }
+    }
+
+    AABB MeshBVH::bounds()const
+    {
+        if ( _nodes.empty() ) return AABB( vec3( 0.f, 0.f, 0.f ), vec3( 0.f, 0.f, 0.f ) );
+        const Node& root = _nodes[0];
+        return AABB( vec3( root.min[0], root.min[1], root.min[2] ), vec3( root.max[0], root.max[1], root.max[2] ) );
+    }
+
+    uint32_t MeshBVH::depth()const
+    {
+        if ( _nodes.empty() ) return 0;
+
+        uint32_t deepest = 0;
+        std::vector< std::pair< uint32_t, uint32_t > > stack;
+        stack.push_back( { 0, 0 } );
+        while ( !stack.empty() )
+        {
+            const std::pair< uint32_t, uint32_t > next = stack.back();
+            stack.pop_back();
+            deepest = std::max( deepest, next.second );
+
+            const Node& node = _nodes[ next.first ];
+            if ( !node.leaf() )
+            {
+                stack.push_back( { node.index, next.second + 1 } );
+                stack.push_back( { node.index + 1, next.second + 1 } );
+            }
+        }
+        return deepest;
+    }
+
+    void MeshBVH::clear()
+    {
+        _nodes.clear();
+        _triangles.clear();
+    }
+
+    MeshBVH::MeshBVH()
+    {}
+
+}
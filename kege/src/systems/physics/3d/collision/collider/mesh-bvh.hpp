@@ -0,0 +1,324 @@
+//
+//  mesh-bvh.hpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef kege_mesh_bvh_hpp
+#define kege_mesh_bvh_hpp
+
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include "../../../../../core/math/geometry/primitive-3D-shapes.hpp"
+
+namespace kege::physics{
+
+    /**
+     * @brief A static bounding volume hierarchy over the triangles of a mesh, in mesh space.
+     *
+     * The tree is built once with the surface area heuristic and never changes, moving the mesh
+     * moves the queries into mesh space instead. Nodes are 32 bytes, two to a cache line, and the
+     * children of a node sit next to each other so a node only stores where the first one is.
+     * Leaves refer to a run of the triangle order, which the queries hand out as triangle indices.
+     */
+    class MeshBVH
+    {
+    public:
+
+        struct Node
+        {
+            inline bool leaf()const
+            {
+                return count != 0;
+            }
+
+            float min[3];
+
+            /**
+             * the first child for inner nodes, the second one is at index + 1. the first slot of
+             * the triangle order for leaves.
+             */
+            uint32_t index;
+
+            float max[3];
+
+            /**
+             * the number of triangles of a leaf, 0 for inner nodes.
+             */
+            uint32_t count;
+        };
+
+        /**
+         * @brief Builds the tree over the triangles.
+         * @param vertices The vertex positions.
+         * @param indices Three vertex indices per triangle.
+         * @param triangle_count The number of triangles.
+         */
+        void build( const vec3* vertices, const uint32_t* indices, uint32_t triangle_count );
+
+        /**
+         * @brief Calls `func( uint32_t triangle )` for every triangle whose bounds overlap `bounds`.
+         * The query stops early when `func` returns false.
+         */
+        template< typename Func > void query( const AABB& bounds, Func&& func )const;
+
+        /**
+         * @brief Walks the triangles whose bounds the ray enters before `max_distance`, nearest first.
+         *
+         * `func( uint32_t triangle, float& max_distance )` tests a triangle and lowers max_distance
+         * when it hits closer, which prunes the rest of the walk.
+         */
+        template< typename Func > void raycast( const Ray& ray, float max_distance, Func&& func )const;
+
+        /**
+         * @brief Calls `func( uint32_t mine, uint32_t theirs )` for the triangle pairs of the two trees
+         * whose bounds overlap. The query stops early when `func` returns false.
+         *
+         * @param other The other tree.
+         * @param axes The axes of the other mesh space in this mesh space.
+         * @param origin The origin of the other mesh space in this mesh space.
+         */
+        template< typename Func > void query( const MeshBVH& other, const vec3 (&axes)[3], const vec3& origin, Func&& func )const;
+
+        /**
+         * @brief Gets the bounds of every triangle, empty bounds for an empty tree.
+         */
+        AABB bounds()const;
+
+        inline const std::vector< Node >& nodes()const
+        {
+            return _nodes;
+        }
+
+        /**
+         * @brief Gets the number of levels below the root, zero for a single leaf.
+         */
+        uint32_t depth()const;
+
+        void clear();
+
+        MeshBVH();
+
+    public:
+
+        /**
+         * @brief Leaves with more triangles than this are always split.
+         */
+        static uint32_t max_leaf_size;
+
+        /**
+         * @brief The cost of visiting a node, relative to testing one triangle, used by the SAH.
+         */
+        static float traversal_cost;
+
+    private:
+
+        /**
+         * STACK_SIZE sizes the query stacks and caps the depth build() splits to, the two have to move together.
+         */
+        enum{ BINS = 16, STACK_SIZE = 64 };
+
+        struct Bin
+        {
+            float min[3];
+            float max[3];
+            uint32_t count;
+        };
+
+        void split( uint32_t node, const std::vector< float >& boxes, const std::vector< float >& centers );
+
+        static inline bool overlaps( const Node& node, const AABB& box )
+        {
+            return
+            node.min[0] <= box.max.x && box.min.x <= node.max[0] &&
+            node.min[1] <= box.max.y && box.min.y <= node.max[1] &&
+            node.min[2] <= box.max.z && box.min.z <= node.max[2];
+        }
+
+        /**
+         * the distance the ray enters the node at, or a negative value if it misses it before max_distance.
+         */
+        static inline float enter( const Node& node, const vec3& origin, const vec3& inverse, float max_distance )
+        {
+            float near = 0.f;
+            float far = max_distance;
+            for ( int i = 0; i < 3; ++i )
+            {
+                float t0 = ( node.min[ i ] - origin[ i ] ) * inverse[ i ];
+                float t1 = ( node.max[ i ] - origin[ i ] ) * inverse[ i ];
+                if ( t0 > t1 ) std::swap( t0, t1 );
+                // a ray along a slab face gives NaN, which neither comparison lets through
+                near = ( t0 > near ) ? t0 : near;
+                far = ( t1 < far ) ? t1 : far;
+            }
+            return ( near <= far ) ? near : -1.f;
+        }
+
+        /**
+         * the bounds in this space of a node of another tree.
+         */
+        static inline AABB transform( const Node& node, const vec3 (&axes)[3], const vec3& origin )
+        {
+            const vec3 center( ( node.min[0] + node.max[0] ) * 0.5f, ( node.min[1] + node.max[1] ) * 0.5f, ( node.min[2] + node.max[2] ) * 0.5f );
+            const vec3 half( ( node.max[0] - node.min[0] ) * 0.5f, ( node.max[1] - node.min[1] ) * 0.5f, ( node.max[2] - node.min[2] ) * 0.5f );
+            const vec3 c = origin + axes[0] * center.x + axes[1] * center.y + axes[2] * center.z;
+            const vec3 r
+            (
+                fabsf( axes[0].x ) * half.x + fabsf( axes[1].x ) * half.y + fabsf( axes[2].x ) * half.z,
+                fabsf( axes[0].y ) * half.x + fabsf( axes[1].y ) * half.y + fabsf( axes[2].y ) * half.z,
+                fabsf( axes[0].z ) * half.x + fabsf( axes[1].z ) * half.y + fabsf( axes[2].z ) * half.z
+            );
+            return AABB( c - r, c + r );
+        }
+
+    private:
+
+        std::vector< Node > _nodes;
+
+        /**
+         * the triangle indices in leaf order.
+         */
+        std::vector< uint32_t > _triangles;
+    };
+
+
+    template< typename Func > void MeshBVH::query( const AABB& bounds, Func&& func )const
+    {
+        if ( _nodes.empty() ) return;
+
+        /*
+         build() stops splitting at depth STACK_SIZE - 1, and a walk holds at most one node per
+         level plus the one being visited. that cap is what keeps this stack from overflowing,
+         not the triangle count, a degenerate mesh reaches it with few triangles.
+         */
+        uint32_t stack[ STACK_SIZE ];
+        uint32_t top = 0;
+        stack[ top++ ] = 0;
+
+        while ( top > 0 )
+        {
+            const Node& node = _nodes[ stack[ --top ] ];
+            if ( !overlaps( node, bounds ) ) continue;
+
+            if ( node.leaf() )
+            {
+                for ( uint32_t i = 0; i < node.count; ++i )
+                {
+                    if ( !func( _triangles[ node.index + i ] ) ) return;
+                }
+            }
+            else
+            {
+                stack[ top++ ] = node.index + 1;
+                stack[ top++ ] = node.index;
+            }
+        }
+    }
+
+    template< typename Func > void MeshBVH::raycast( const Ray& ray, float max_distance, Func&& func )const
+    {
+        if ( _nodes.empty() ) return;
+
+        const vec3 inverse( 1.f / ray.direction.x, 1.f / ray.direction.y, 1.f / ray.direction.z );
+        if ( enter( _nodes[0], ray.origin, inverse, max_distance ) < 0.f ) return;
+
+        uint32_t stack[ STACK_SIZE ];
+        float distances[ STACK_SIZE ];
+        uint32_t top = 0;
+        stack[ top ] = 0;
+        distances[ top++ ] = 0.f;
+
+        while ( top > 0 )
+        {
+            --top;
+            // a hit found since the node was pushed may already be closer than the node
+            if ( distances[ top ] > max_distance ) continue;
+
+            const Node& node = _nodes[ stack[ top ] ];
+            if ( node.leaf() )
+            {
+                for ( uint32_t i = 0; i < node.count; ++i )
+                {
+                    func( _triangles[ node.index + i ], max_distance );
+                }
+                continue;
+            }
+
+            const float near = enter( _nodes[ node.index ], ray.origin, inverse, max_distance );
+            const float far = enter( _nodes[ node.index + 1 ], ray.origin, inverse, max_distance );
+
+            // the nearer child goes on top so it is walked first
+            uint32_t first = node.index;
+            uint32_t second = node.index + 1;
+            float first_distance = near;
+            float second_distance = far;
+            if ( second_distance >= 0.f && ( first_distance < 0.f || second_distance < first_distance ) )
+            {
+                std::swap( first, second );
+                std::swap( first_distance, second_distance );
+            }
+
+            if ( second_distance >= 0.f )
+            {
+                stack[ top ] = second;
+                distances[ top++ ] = second_distance;
+            }
+            if ( first_distance >= 0.f )
+            {
+                stack[ top ] = first;
+                distances[ top++ ] = first_distance;
+            }
+        }
+    }
+
+    template< typename Func > void MeshBVH::query( const MeshBVH& other, const vec3 (&axes)[3], const vec3& origin, Func&& func )const
+    {
+        if ( _nodes.empty() || other._nodes.empty() ) return;
+
+        struct Pair
+        {
+            uint32_t mine;
+            uint32_t theirs;
+        };
+
+        // a pair only pushes two, the stack grows by one per level of either tree
+        Pair stack[ 2 * STACK_SIZE ];
+        uint32_t top = 0;
+        stack[ top++ ] = { 0, 0 };
+
+        while ( top > 0 )
+        {
+            const Pair pair = stack[ --top ];
+            const Node& mine = _nodes[ pair.mine ];
+            const Node& theirs = other._nodes[ pair.theirs ];
+            if ( !overlaps( mine, transform( theirs, axes, origin ) ) ) continue;
+
+            if ( mine.leaf() && theirs.leaf() )
+            {
+                for ( uint32_t i = 0; i < mine.count; ++i )
+                {
+                    for ( uint32_t j = 0; j < theirs.count; ++j )
+                    {
+                        if ( !func( _triangles[ mine.index + i ], other._triangles[ theirs.index + j ] ) ) return;
+                    }
+                }
+            }
+            else if ( theirs.leaf() || ( !mine.leaf() && ( mine.max[0] - mine.min[0] ) + ( mine.max[1] - mine.min[1] ) + ( mine.max[2] - mine.min[2] ) >=
+                                                         ( theirs.max[0] - theirs.min[0] ) + ( theirs.max[1] - theirs.min[1] ) + ( theirs.max[2] - theirs.min[2] ) ) )
+            {
+                // descend the larger node, so the boxes compared stay about the same size
+                stack[ top++ ] = { mine.index + 1, pair.theirs };
+                stack[ top++ ] = { mine.index, pair.theirs };
+            }
+            else
+            {
+                stack[ top++ ] = { pair.mine, theirs.index + 1 };
+                stack[ top++ ] = { pair.mine, theirs.index };
+            }
+        }
+    }
+
+}
+#endif /* kege_mesh_bvh_hpp */
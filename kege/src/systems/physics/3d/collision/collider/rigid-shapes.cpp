@@ -5,15 +5,130 @@
 //  Created by Kenneth Esdaile on 3/23/25.
 //
 
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
 #include "../../dynamics/rigidbody.hpp"
 #include "rigid-shapes.hpp"
 namespace kege{
 
+    float ColliderMesh::active_edge_cosine = 0.996f;
+
+    /**
+     * bounds of a swept sphere around the segment center +- axis * height. the collision
+     * routines treat height as the full and as the half length, the bounds take the longer one.
+     */
+    static AABB segmentBounds( const vec3& center, const vec3& axis, float height, float radius )
+    {
+        const vec3 r
+        (
+            fabsf( axis.x ) * height + radius,
+            fabsf( axis.y ) * height + radius,
+            fabsf( axis.z ) * height + radius
+        );
+        return AABB( center - r, center + r );
+    }
+
+    /*
+     round shapes hand out their flat sides as faces while the direction is within about 45
+     degrees of them, and their straight sides as edges within about 3 degrees.
+     */
+    static const float FACE_COSINE = 0.7f;
+    static const float SIDE_SINE = 0.05f;
+
+    // caps and bases are handed out as this many sided polygons
+    static const uint32_t DISC_POINTS = 8;
+
+    static inline vec3 unitOr( const vec3& v, const vec3& fallback )
+    {
+        const float length_sq = dot( v, v );
+        return ( length_sq > KEGE_EPSILON_F * KEGE_EPSILON_F ) ? v / sqrtf( length_sq ) : fallback;
+    }
+
+    /**
+     * any unit vector perpendicular to the unit vector n.
+     */
+    static inline vec3 perpendicular( const vec3& n )
+    {
+        return ( fabsf( n.x ) < 0.57f ) ? normalize( cross( n, vec3( 1.f, 0.f, 0.f ) ) ) : normalize( cross( n, vec3( 0.f, 1.f, 0.f ) ) );
+    }
+
+    /**
+     * the unit vector along the part of direction perpendicular to the unit vector axis.
+     */
+    static inline vec3 radial( const vec3& direction, const vec3& axis )
+    {
+        return unitOr( direction - axis * dot( direction, axis ), perpendicular( axis ) );
+    }
+
+    /**
+     * a polygon on the rim of a disc, starting at the rim point farthest along direction so the
+     * deepest point of a tilted disc is one of its corners.
+     */
+    static uint32_t discPoints( const vec3& center, const vec3& normal, float radius, const vec3& direction, vec3* points )
+    {
+        const vec3 u = radial( direction, normal ) * radius;
+        const vec3 v = cross( normal, u );
+        for ( uint32_t i = 0; i < DISC_POINTS; ++i )
+        {
+            const float angle = float( i ) * ( 6.28318530718f / float( DISC_POINTS ) );
+            points[ i ] = center + u * cosf( angle ) + v * sinf( angle );
+        }
+        return DISC_POINTS;
+    }
+
     void ColliderBox::integrate( Rigidbody* body )
     {
         solid.center = body->center + offset;
         solid.axes = kege::quatToM33( body->orientation );
     }
+    bool ColliderBox::getBounds( AABB& bounds )const
+    {
+        const vec3 r
+        (
+            solid.extents.x * fabsf( solid.axes[0].x ) + solid.extents.y * fabsf( solid.axes[1].x ) + solid.extents.z * fabsf( solid.axes[2].x ),
+            solid.extents.x * fabsf( solid.axes[0].y ) + solid.extents.y * fabsf( solid.axes[1].y ) + solid.extents.z * fabsf( solid.axes[2].y ),
+            solid.extents.x * fabsf( solid.axes[0].z ) + solid.extents.y * fabsf( solid.axes[1].z ) + solid.extents.z * fabsf( solid.axes[2].z )
+        );
+        bounds = AABB( solid.center - r, solid.center + r );
+        return true;
+    }
+    vec3 ColliderBox::support( const vec3& direction )const
+    {
+        vec3 point = solid.center;
+        for ( int i = 0; i < 3; ++i )
+        {
+            point += solid.axes[ i ] * ( ( dot( solid.axes[ i ], direction ) >= 0.f ) ? solid.extents[ i ] : -solid.extents[ i ] );
+        }
+        return point;
+    }
+    uint32_t ColliderBox::supportFace( const vec3& direction, vec3* points, vec3& normal )const
+    {
+        int axis = 0;
+        float best = -1.f;
+        for ( int i = 0; i < 3; ++i )
+        {
+            const float d = fabsf( dot( solid.axes[ i ], direction ) );
+            if ( d > best )
+            {
+                best = d;
+                axis = i;
+            }
+        }
+
+        const float side = ( dot( solid.axes[ axis ], direction ) >= 0.f ) ? 1.f : -1.f;
+        const vec3 u = solid.axes[ ( axis + 1 ) % 3 ] * solid.extents[ ( axis + 1 ) % 3 ];
+        const vec3 v = solid.axes[ ( axis + 2 ) % 3 ] * solid.extents[ ( axis + 2 ) % 3 ];
+        const vec3 c = solid.center + solid.axes[ axis ] * ( solid.extents[ axis ] * side );
+        normal = solid.axes[ axis ] * side;
+        points[0] = c + u + v;
+        points[1] = c - u + v;
+        points[2] = c - u - v;
+        points[3] = c + u - v;
+        return 4;
+    }
     const OBB* ColliderBox::getBox()const{
         return &solid;
     }
@@ -36,6 +151,29 @@ namespace kege{
         shape.normal = axes[2];
         shape.right = axes[0];
     }
+    bool ColliderCircle::getBounds( AABB& bounds )const
+    {
+        const vec3 r( shape.radius, shape.radius, shape.radius );
+        bounds = AABB( shape.center - r, shape.center + r );
+        return true;
+    }
+    vec3 ColliderCircle::support( const vec3& direction )const
+    {
+        return shape.center + radial( direction, shape.normal ) * shape.radius;
+    }
+    uint32_t ColliderCircle::supportFace( const vec3& direction, vec3* points, vec3& normal )const
+    {
+        const vec3 d = unitOr( direction, shape.normal );
+        const float t = dot( d, shape.normal );
+        if ( fabsf( t ) >= FACE_COSINE )
+        {
+            normal = ( t >= 0.f ) ? shape.normal : -shape.normal;
+            return discPoints( shape.center, normal, shape.radius, d, points );
+        }
+        normal = d;
+        points[0] = support( d );
+        return 1;
+    }
     const Circle* ColliderCircle::getCircle()const
     {
         return &shape;
@@ -56,6 +194,22 @@ namespace kege{
     {
         solid.center = body->center + offset;
     }
+    bool ColliderSphere::getBounds( AABB& bounds )const
+    {
+        const vec3 r( solid.radius, solid.radius, solid.radius );
+        bounds = AABB( solid.center - r, solid.center + r );
+        return true;
+    }
+    vec3 ColliderSphere::support( const vec3& direction )const
+    {
+        return solid.center + unitOr( direction, vec3( 0.f, 1.f, 0.f ) ) * solid.radius;
+    }
+    uint32_t ColliderSphere::supportFace( const vec3& direction, vec3* points, vec3& normal )const
+    {
+        normal = unitOr( direction, vec3( 0.f, 1.f, 0.f ) );
+        points[0] = solid.center + normal * solid.radius;
+        return 1;
+    }
     const Sphere* ColliderSphere::getSphere()const
     {
         return &solid;
@@ -97,6 +251,41 @@ namespace kege{
         solid.axes[0] = axes[2];
         solid.axes[1] = axes[1];
     }
+    bool ColliderCylinder::getBounds( AABB& bounds )const
+    {
+        bounds = segmentBounds( solid.center, solid.axes[0], solid.height, solid.radius );
+        return true;
+    }
+    vec3 ColliderCylinder::support( const vec3& direction )const
+    {
+        const vec3& axis = solid.axes[0];
+        const float half = ( dot( direction, axis ) >= 0.f ) ? solid.height * 0.5f : -solid.height * 0.5f;
+        return solid.center + axis * half + radial( direction, axis ) * solid.radius;
+    }
+    uint32_t ColliderCylinder::supportFace( const vec3& direction, vec3* points, vec3& normal )const
+    {
+        const vec3& axis = solid.axes[0];
+        const vec3 d = unitOr( direction, axis );
+        const float t = dot( d, axis );
+        if ( fabsf( t ) >= FACE_COSINE )
+        {
+            normal = ( t >= 0.f ) ? axis : -axis;
+            return discPoints( solid.center + normal * ( solid.height * 0.5f ), normal, solid.radius, d, points );
+        }
+
+        const vec3 r = radial( d, axis ) * solid.radius;
+        if ( fabsf( t ) <= SIDE_SINE )
+        {
+            normal = d;
+            points[0] = solid.center + r + axis * ( solid.height * 0.5f );
+            points[1] = solid.center + r - axis * ( solid.height * 0.5f );
+            return 2;
+        }
+
+        normal = d;
+        points[0] = support( d );
+        return 1;
+    }
     const Cylinder* ColliderCylinder::getCylinder()const
     {
         return &solid;
@@ -119,6 +308,32 @@ namespace kege{
         solid.axes[0] = axes[0];
         solid.axes[1] = axes[1];
     }
+    bool ColliderCapsule::getBounds( AABB& bounds )const
+    {
+        bounds = segmentBounds( solid.center, solid.axes[0], solid.height, solid.radius );
+        return true;
+    }
+    vec3 ColliderCapsule::support( const vec3& direction )const
+    {
+        const vec3& axis = solid.axes[0];
+        const float half = ( dot( direction, axis ) >= 0.f ) ? solid.height * 0.5f : -solid.height * 0.5f;
+        return solid.center + axis * half + unitOr( direction, axis ) * solid.radius;
+    }
+    uint32_t ColliderCapsule::supportFace( const vec3& direction, vec3* points, vec3& normal )const
+    {
+        const vec3& axis = solid.axes[0];
+        const vec3 d = unitOr( direction, axis );
+        normal = d;
+        if ( fabsf( dot( d, axis ) ) <= SIDE_SINE )
+        {
+            const vec3 r = radial( d, axis ) * solid.radius;
+            points[0] = solid.center + r + axis * ( solid.height * 0.5f );
+            points[1] = solid.center + r - axis * ( solid.height * 0.5f );
+            return 2;
+        }
+        points[0] = support( d );
+        return 1;
+    }
     const Capsule* ColliderCapsule::getCapsule()const
     {
         return &solid;
@@ -140,6 +355,45 @@ namespace kege{
         mat33 axes = kege::quatToM33( body->orientation );
         solid.direction = axes[1];
     }
+    bool ColliderCone::getBounds( AABB& bounds )const
+    {
+        const vec3 base = solid.apex + solid.direction * solid.height;
+        const vec3 r( solid.radius, solid.radius, solid.radius );
+        bounds = AABB
+        (
+            vec3( std::min( solid.apex.x, base.x ), std::min( solid.apex.y, base.y ), std::min( solid.apex.z, base.z ) ) - r,
+            vec3( std::max( solid.apex.x, base.x ), std::max( solid.apex.y, base.y ), std::max( solid.apex.z, base.z ) ) + r
+        );
+        return true;
+    }
+    vec3 ColliderCone::support( const vec3& direction )const
+    {
+        // the apex or a point on the rim of the base
+        const vec3 rim = solid.apex + solid.direction * solid.height + radial( direction, solid.direction ) * solid.radius;
+        return ( dot( rim - solid.apex, direction ) > 0.f ) ? rim : solid.apex;
+    }
+    uint32_t ColliderCone::supportFace( const vec3& direction, vec3* points, vec3& normal )const
+    {
+        const vec3 d = unitOr( direction, solid.direction );
+        if ( dot( d, solid.direction ) >= FACE_COSINE )
+        {
+            normal = solid.direction;
+            return discPoints( solid.apex + solid.direction * solid.height, normal, solid.radius, d, points );
+        }
+
+        // the slanted side along the line from the apex to the rim, facing d
+        const vec3 r = radial( d, solid.direction );
+        const vec3 side = unitOr( r * solid.height - solid.direction * solid.radius, r );
+        normal = d;
+        if ( dot( d, side ) >= 1.f - SIDE_SINE * SIDE_SINE * 0.5f )
+        {
+            points[0] = solid.apex;
+            points[1] = solid.apex + solid.direction * solid.height + r * solid.radius;
+            return 2;
+        }
+        points[0] = support( d );
+        return 1;
+    }
     const Cone* ColliderCone::getCone()const
     {
         return &solid;
@@ -154,6 +408,441 @@ namespace kege{
     {}
 
 
+    void ColliderMesh::integrate( Rigidbody* body )
+    {
+        center = body->center;
+        axes = kege::quatToM33( body->orientation );
+    }
+    bool ColliderMesh::getBounds( AABB& bounds )const
+    {
+        if ( triangles.empty() ) return false;
+
+        const AABB local = bvh.bounds();
+        const vec3 c = toWorld( ( local.min + local.max ) * 0.5f );
+        const vec3 h = ( local.max - local.min ) * 0.5f;
+        const vec3 r
+        (
+            h.x * fabsf( axes[0].x ) + h.y * fabsf( axes[1].x ) + h.z * fabsf( axes[2].x ),
+            h.x * fabsf( axes[0].y ) + h.y * fabsf( axes[1].y ) + h.z * fabsf( axes[2].y ),
+            h.x * fabsf( axes[0].z ) + h.y * fabsf( axes[1].z ) + h.z * fabsf( axes[2].z )
+        );
+        bounds = AABB( c - r, c + r );
+        return true;
+    }
+    kege::Triangle ColliderMesh::getTriangle( uint32_t i )const
+    {
+        const Triangle& t = triangles[ i ];
+        return kege::Triangle( vertices[ t.a ], vertices[ t.b ], vertices[ t.c ] );
+    }
+    vec3 ColliderMesh::toLocal( const vec3& point )const
+    {
+        return directionToLocal( point - center );
+    }
+    vec3 ColliderMesh::toWorld( const vec3& point )const
+    {
+        return center + directionToWorld( point );
+    }
+    vec3 ColliderMesh::directionToLocal( const vec3& direction )const
+    {
+        return vec3( dot( direction, axes[0] ), dot( direction, axes[1] ), dot( direction, axes[2] ) );
+    }
+    vec3 ColliderMesh::directionToWorld( const vec3& direction )const
+    {
+        return axes[0] * direction.x + axes[1] * direction.y + axes[2] * direction.z;
+    }
+    ColliderMesh::ColliderMesh(const std::vector<float>& positions, const std::vector<unsigned int>& indices)
+    :   Collider( RIGID_SHAPE_MESH )
+    ,   center( 0.f, 0.f, 0.f )
+    ,   axes( 1.f )
+    {
+        vertices.resize( positions.size() / 3 );
+        for ( size_t i = 0; i < vertices.size(); ++i )
+        {
+            vertices[ i ] = vec3( positions[ i * 3 + 0 ], positions[ i * 3 + 1 ], positions[ i * 3 + 2 ] );
+        }
+
+        std::vector< uint32_t > kept;
+        kept.reserve( indices.size() );
+        triangles.reserve( indices.size() / 3 );
+        for ( size_t i = 0; i + 2 < indices.size(); i += 3 )
+        {
+            const uint32_t a = indices[ i + 0 ];
+            const uint32_t b = indices[ i + 1 ];
+            const uint32_t c = indices[ i + 2 ];
+            if ( a >= vertices.size() || b >= vertices.size() || c >= vertices.size() ) continue;
+
+            const vec3 n = cross( vertices[ b ] - vertices[ a ], vertices[ c ] - vertices[ a ] );
+            const float length = sqrtf( dot( n, n ) );
+            if ( length <= KEGE_EPSILON_F ) continue;
+
+            triangles.push_back( { a, b, c, n / length, 7u } );
+            kept.push_back( a );
+            kept.push_back( b );
+            kept.push_back( c );
+        }
+
+        bvh.build( vertices.data(), kept.data(), uint32_t( triangles.size() ) );
+        findActiveEdges();
+    }
+    void ColliderMesh::findActiveEdges()
+    {
+        /*
+         vertices split for texture seams still meet, so triangles are matched up by vertex
+         position rather than by index.
+         */
+        struct PositionHash
+        {
+            size_t operator()( const vec3& p )const
+            {
+                uint32_t bits[3];
+                memcpy( bits, &p.x, sizeof( float ) );
+                memcpy( bits + 1, &p.y, sizeof( float ) );
+                memcpy( bits + 2, &p.z, sizeof( float ) );
+                return size_t( bits[0] ) * 73856093u ^ size_t( bits[1] ) * 19349663u ^ size_t( bits[2] ) * 83492791u;
+            }
+        };
+        struct PositionEqual
+        {
+            bool operator()( const vec3& a, const vec3& b )const
+            {
+                return a.x == b.x && a.y == b.y && a.z == b.z;
+            }
+        };
+
+        std::unordered_map< vec3, uint32_t, PositionHash, PositionEqual > welded;
+        std::vector< uint32_t > position( vertices.size() );
+        for ( size_t i = 0; i < vertices.size(); ++i )
+        {
+            position[ i ] = welded.emplace( vertices[ i ], uint32_t( welded.size() ) ).first->second;
+        }
+
+        // the first triangle and edge seen for every edge, until a second triangle shares it
+        const uint32_t shared = 0xFFFFFFFF;
+        std::unordered_map< uint64_t, uint32_t > owners;
+        owners.reserve( triangles.size() * 2 );
+        for ( uint32_t t = 0; t < triangles.size(); ++t )
+        {
+            const uint32_t corners[3] = { triangles[ t ].a, triangles[ t ].b, triangles[ t ].c };
+            for ( uint32_t k = 0; k < 3; ++k )
+            {
+                const uint32_t p = position[ corners[ k ] ];
+                const uint32_t q = position[ corners[ ( k + 1 ) % 3 ] ];
+                const uint64_t key = ( uint64_t( std::min( p, q ) ) << 32 ) | std::max( p, q );
+
+                auto owner = owners.emplace( key, t * 3 + k );
+                if ( owner.second ) continue;
+
+                // an edge of three or more triangles stays active on all of them
+                const uint32_t first = owner.first->second;
+                if ( first == shared ) continue;
+                owner.first->second = shared;
+
+                /*
+                 the edge is a ridge when the other triangle falls away behind the plane of this
+                 one. flat and concave edges, and ridges too shallow to catch on, are seams.
+                 */
+                const Triangle& other = triangles[ first / 3 ];
+                const uint32_t other_corners[3] = { other.a, other.b, other.c };
+                const vec3& opposite = vertices[ other_corners[ ( first % 3 + 2 ) % 3 ] ];
+                const vec3& on_edge = vertices[ corners[ k ] ];
+
+                const bool ridge = dot( opposite - on_edge, triangles[ t ].normal ) < -KEGE_EPSILON_F;
+                const bool shallow = dot( triangles[ t ].normal, other.normal ) > active_edge_cosine;
+                if ( !ridge || shallow )
+                {
+                    triangles[ t ].active_edges &= ~( 1u << k );
+                    triangles[ first / 3 ].active_edges &= ~( 1u << ( first % 3 ) );
+                }
+            }
+        }
+    }
+    ColliderMesh::ColliderMesh()
+    :   Collider( RIGID_SHAPE_MESH )
+    ,   center( 0.f, 0.f, 0.f )
+    ,   axes( 1.f )
+    {}
+
+
+    /**
+     * a triangle of the hull while it is built, wound counter clockwise seen from outside.
+     */
+    struct HullTriangle
+    {
+        uint32_t v[3];
+        vec3 normal;
+        float distance;
+    };
+
+    static HullTriangle hullTriangle( const std::vector< vec3 >& points, uint32_t a, uint32_t b, uint32_t c )
+    {
+        HullTriangle t = { { a, b, c }, normalize( cross( points[ b ] - points[ a ], points[ c ] - points[ a ] ) ), 0.f };
+        t.distance = dot( t.normal, points[ a ] );
+        return t;
+    }
+
+    /**
+     * incremental hull, every point outside the hull so far replaces the triangles it sees with
+     * a fan from the horizon around them to itself.
+     */
+    static bool buildHull( const std::vector< vec3 >& points, std::vector< HullTriangle >& hull, float& tolerance )
+    {
+        const uint32_t count = uint32_t( points.size() );
+        if ( count < 4 ) return false;
+
+        vec3 lo = points[0];
+        vec3 hi = points[0];
+        for ( const vec3& p : points )
+        {
+            lo = vec3( std::min( lo.x, p.x ), std::min( lo.y, p.y ), std::min( lo.z, p.z ) );
+            hi = vec3( std::max( hi.x, p.x ), std::max( hi.y, p.y ), std::max( hi.z, p.z ) );
+        }
+        tolerance = 1e-5f * sqrtf( dot( hi - lo, hi - lo ) );
+        if ( tolerance <= 0.f ) return false;
+
+        // the starting tetrahedron, from points as far from each other as can be found quickly
+        uint32_t corner[4] = { 0, 0, 0, 0 };
+        float best = 0.f;
+        for ( uint32_t i = 1; i < count; ++i )
+        {
+            const float d = dot( points[ i ] - points[0], points[ i ] - points[0] );
+            if ( d > best ) { best = d; corner[1] = i; }
+        }
+        best = 0.f;
+        const vec3 line = points[ corner[1] ] - points[0];
+        for ( uint32_t i = 1; i < count; ++i )
+        {
+            const vec3 c = cross( points[ i ] - points[0], line );
+            const float d = dot( c, c );
+            if ( d > best ) { best = d; corner[2] = i; }
+        }
+        best = 0.f;
+        const vec3 n = normalize( cross( line, points[ corner[2] ] - points[0] ) );
+        for ( uint32_t i = 1; i < count; ++i )
+        {
+            const float d = fabsf( dot( points[ i ] - points[0], n ) );
+            if ( d > best ) { best = d; corner[3] = i; }
+        }
+        if ( best <= tolerance || corner[1] == 0 || corner[2] == 0 ) return false;
+
+        const vec3 inside = ( points[ corner[0] ] + points[ corner[1] ] + points[ corner[2] ] + points[ corner[3] ] ) * 0.25f;
+        const uint32_t start[4][3] = { { 0, 1, 2 }, { 0, 3, 1 }, { 1, 3, 2 }, { 2, 3, 0 } };
+        hull.clear();
+        for ( const auto& f : start )
+        {
+            HullTriangle t = hullTriangle( points, corner[ f[0] ], corner[ f[1] ], corner[ f[2] ] );
+            if ( dot( t.normal, inside ) - t.distance > 0.f )
+            {
+                t = hullTriangle( points, corner[ f[0] ], corner[ f[2] ], corner[ f[1] ] );
+            }
+            hull.push_back( t );
+        }
+
+        std::vector< HullTriangle > kept;
+        std::unordered_set< uint64_t > edges;
+        for ( uint32_t i = 0; i < count; ++i )
+        {
+            const vec3& p = points[ i ];
+            kept.clear();
+            edges.clear();
+            for ( const HullTriangle& t : hull )
+            {
+                if ( dot( t.normal, p ) - t.distance > tolerance )
+                {
+                    for ( int k = 0; k < 3; ++k )
+                    {
+                        edges.insert( uint64_t( t.v[ k ] ) << 32 | t.v[ ( k + 1 ) % 3 ] );
+                    }
+                }
+                else
+                {
+                    kept.push_back( t );
+                }
+            }
+            if ( kept.size() == hull.size() ) continue;
+
+            // an edge of a visible triangle is on the horizon when its twin is not visible too
+            for ( const uint64_t edge : edges )
+            {
+                const uint32_t a = uint32_t( edge >> 32 );
+                const uint32_t b = uint32_t( edge & 0xFFFFFFFFu );
+                if ( edges.find( uint64_t( b ) << 32 | a ) == edges.end() )
+                {
+                    kept.push_back( hullTriangle( points, a, b, i ) );
+                }
+            }
+            hull.swap( kept );
+        }
+        return hull.size() >= 4;
+    }
+
+    void ColliderConvex::integrate( Rigidbody* body )
+    {
+        center = body->center;
+        axes = kege::quatToM33( body->orientation );
+    }
+    bool ColliderConvex::getBounds( AABB& bounds )const
+    {
+        if ( vertices.empty() ) return false;
+
+        const vec3 c = toWorld( ( local_min + local_max ) * 0.5f );
+        const vec3 h = ( local_max - local_min ) * 0.5f;
+        const vec3 r
+        (
+            h.x * fabsf( axes[0].x ) + h.y * fabsf( axes[1].x ) + h.z * fabsf( axes[2].x ),
+            h.x * fabsf( axes[0].y ) + h.y * fabsf( axes[1].y ) + h.z * fabsf( axes[2].y ),
+            h.x * fabsf( axes[0].z ) + h.y * fabsf( axes[1].z ) + h.z * fabsf( axes[2].z )
+        );
+        bounds = AABB( c - r, c + r );
+        return true;
+    }
+    vec3 ColliderConvex::support( const vec3& direction )const
+    {
+        if ( vertices.empty() ) return center;
+
+        // hulls are small, a scan beats walking the edges
+        const vec3 d = directionToLocal( direction );
+        uint32_t best = 0;
+        float farthest = dot( vertices[0], d );
+        for ( uint32_t i = 1; i < vertices.size(); ++i )
+        {
+            const float distance = dot( vertices[ i ], d );
+            if ( distance > farthest )
+            {
+                farthest = distance;
+                best = i;
+            }
+        }
+        return toWorld( vertices[ best ] );
+    }
+    uint32_t ColliderConvex::supportFace( const vec3& direction, vec3* points, vec3& normal )const
+    {
+        if ( faces.empty() ) return 0;
+
+        const vec3 d = directionToLocal( direction );
+        uint32_t best = 0;
+        float facing = dot( faces[0].normal, d );
+        for ( uint32_t i = 1; i < faces.size(); ++i )
+        {
+            const float f = dot( faces[ i ].normal, d );
+            if ( f > facing )
+            {
+                facing = f;
+                best = i;
+            }
+        }
+
+        // faces with more corners than fit hand out every other one or so, still in order
+        const Face& face = faces[ best ];
+        const uint32_t count = std::min( face.count, uint32_t( MAX_FACE_POINTS ) );
+        for ( uint32_t i = 0; i < count; ++i )
+        {
+            points[ i ] = toWorld( vertices[ face_vertices[ face.first + i * face.count / count ] ] );
+        }
+        normal = directionToWorld( face.normal );
+        return count;
+    }
+    vec3 ColliderConvex::toLocal( const vec3& point )const
+    {
+        return directionToLocal( point - center );
+    }
+    vec3 ColliderConvex::toWorld( const vec3& point )const
+    {
+        return center + directionToWorld( point );
+    }
+    vec3 ColliderConvex::directionToLocal( const vec3& direction )const
+    {
+        return vec3( dot( direction, axes[0] ), dot( direction, axes[1] ), dot( direction, axes[2] ) );
+    }
+    vec3 ColliderConvex::directionToWorld( const vec3& direction )const
+    {
+        return axes[0] * direction.x + axes[1] * direction.y + axes[2] * direction.z;
+    }
+    ColliderConvex::ColliderConvex( const std::vector< vec3 >& points )
+    :   Collider( RIGID_SHAPE_CONVEX )
+    ,   local_min( 0.f, 0.f, 0.f )
+    ,   local_max( 0.f, 0.f, 0.f )
+    ,   center( 0.f, 0.f, 0.f )
+    ,   axes( 1.f )
+    {
+        std::vector< HullTriangle > hull;
+        float tolerance;
+        if ( !buildHull( points, hull, tolerance ) ) return;
+
+        // coplanar triangles are merged into one face
+        std::vector< std::vector< uint32_t > > corners;
+        std::vector< vec3 > sums;
+        std::vector< uint32_t > face_of( hull.size() );
+        for ( uint32_t t = 0; t < hull.size(); ++t )
+        {
+            uint32_t f = 0;
+            for ( ; f < corners.size(); ++f )
+            {
+                const vec3 n = normalize( sums[ f ] );
+                if ( dot( n, hull[ t ].normal ) > 0.9999f && fabsf( dot( n, points[ corners[ f ][0] ] ) - hull[ t ].distance ) <= tolerance * 10.f ) break;
+            }
+            if ( f == corners.size() )
+            {
+                corners.emplace_back();
+                sums.push_back( vec3( 0.f, 0.f, 0.f ) );
+            }
+            sums[ f ] += hull[ t ].normal;
+            for ( uint32_t v : hull[ t ].v )
+            {
+                if ( std::find( corners[ f ].begin(), corners[ f ].end(), v ) == corners[ f ].end() ) corners[ f ].push_back( v );
+            }
+        }
+
+        std::unordered_map< uint32_t, uint32_t > remap;
+        for ( uint32_t f = 0; f < corners.size(); ++f )
+        {
+            std::vector< uint32_t >& ring = corners[ f ];
+            const vec3 normal = normalize( sums[ f ] );
+
+            // the corners go in order of their angle around the middle of the face
+            vec3 middle( 0.f, 0.f, 0.f );
+            for ( uint32_t v : ring ) middle += points[ v ];
+            middle = middle / float( ring.size() );
+            const vec3 u = normalize( points[ ring[0] ] - middle );
+            const vec3 w = cross( normal, u );
+            std::sort( ring.begin(), ring.end(), [ & ]( uint32_t a, uint32_t b )
+            {
+                return atan2f( dot( points[ a ] - middle, w ), dot( points[ a ] - middle, u ) ) < atan2f( dot( points[ b ] - middle, w ), dot( points[ b ] - middle, u ) );
+            });
+
+            Face face;
+            face.normal = normal;
+            face.first = uint32_t( face_vertices.size() );
+            face.count = uint32_t( ring.size() );
+            for ( uint32_t v : ring )
+            {
+                auto found = remap.find( v );
+                if ( found == remap.end() )
+                {
+                    found = remap.insert( { v, uint32_t( vertices.size() ) } ).first;
+                    vertices.push_back( points[ v ] );
+                }
+                face_vertices.push_back( found->second );
+            }
+            face.distance = dot( normal, vertices[ face_vertices[ face.first ] ] );
+            faces.push_back( face );
+        }
+
+        local_min = local_max = vertices[0];
+        for ( const vec3& v : vertices )
+        {
+            local_min = vec3( std::min( local_min.x, v.x ), std::min( local_min.y, v.y ), std::min( local_min.z, v.z ) );
+            local_max = vec3( std::max( local_max.x, v.x ), std::max( local_max.y, v.y ), std::max( local_max.z, v.z ) );
+        }
+    }
+    ColliderConvex::ColliderConvex()
+    :   Collider( RIGID_SHAPE_CONVEX )
+    ,   local_min( 0.f, 0.f, 0.f )
+    ,   local_max( 0.f, 0.f, 0.f )
+    ,   center( 0.f, 0.f, 0.f )
+    ,   axes( 1.f )
+    {}
+
+
     kege::mat33 computeBoxInverseTensor( const kege::vec3& size, float mass )
     {
         float m = mass / 12.0;
@@ -222,5 +911,48 @@ namespace kege{
         return kege::mat33( inverse_tensor_value );
     }
 
+    kege::mat33 computeConvexInverseTensor( const ColliderConvex& hull, float mass )
+    {
+        /*
+         the hull is cut into tetrahedra from the origin to each triangle of the face fans. each
+         adds det/6 to the volume and det/120 * ( sum of v v^T + s s^T ) to the second moment,
+         with v the corners of the triangle and s their sum.
+         */
+        float volume = 0.f;
+        float moment[3][3] = {};
+        for ( const ColliderConvex::Face& face : hull.faces )
+        {
+            const vec3& a = hull.vertices[ hull.face_vertices[ face.first ] ];
+            for ( uint32_t i = 1; i + 1 < face.count; ++i )
+            {
+                const vec3& b = hull.vertices[ hull.face_vertices[ face.first + i ] ];
+                const vec3& c = hull.vertices[ hull.face_vertices[ face.first + i + 1 ] ];
+                const float det = dot( a, cross( b, c ) );
+                const vec3 s = a + b + c;
+                volume += det / 6.f;
+                for ( int j = 0; j < 3; ++j )
+                {
+                    for ( int k = 0; k < 3; ++k )
+                    {
+                        moment[ j ][ k ] += det / 120.f * ( a[ j ] * a[ k ] + b[ j ] * b[ k ] + c[ j ] * c[ k ] + s[ j ] * s[ k ] );
+                    }
+                }
+            }
+        }
+        if ( volume <= 0.f ) return kege::mat33( 0.f );
+
+        const float density = mass / volume;
+        const float trace = moment[0][0] + moment[1][1] + moment[2][2];
+        kege::mat33 inertia( 1.0 );
+        for ( int j = 0; j < 3; ++j )
+        {
+            for ( int k = 0; k < 3; ++k )
+            {
+                inertia[ j ][ k ] = density * ( ( j == k ? trace : 0.f ) - moment[ j ][ k ] );
+            }
+        }
+        return kege::inverse( inertia );
+    }
+
 
 }
@@ -9,6 +9,7 @@
 #define rigid_shapes_hpp
 
 #include "collider.hpp"
+#include "mesh-bvh.hpp"
 #include "../../../../-/component-dependencies.hpp"
 
 namespace kege{
@@ -16,7 +17,10 @@ namespace kege{
     struct ColliderBox : public Collider
     {
         void integrate( Rigidbody* body );
+        bool getBounds( AABB& bounds )const;
         const kege::OBB* getBox()const;
+        vec3 support( const vec3& direction )const;
+        uint32_t supportFace( const vec3& direction, vec3* points, vec3& normal )const;
         ColliderBox( const kege::OBB& box );
         ColliderBox();
         kege::OBB solid;
@@ -26,7 +30,10 @@ namespace kege{
     struct ColliderSphere : public Collider
     {
         void integrate( Rigidbody* body );
+        bool getBounds( AABB& bounds )const;
         const Sphere* getSphere()const;
+        vec3 support( const vec3& direction )const;
+        uint32_t supportFace( const vec3& direction, vec3* points, vec3& normal )const;
         ColliderSphere( const Sphere& sphere );
         ColliderSphere();
         Sphere solid;
@@ -36,7 +43,10 @@ namespace kege{
     struct ColliderCircle : public Collider
     {
         void integrate( Rigidbody* body );
+        bool getBounds( AABB& bounds )const;
         const Circle* getCircle()const;
+        vec3 support( const vec3& direction )const;
+        uint32_t supportFace( const vec3& direction, vec3* points, vec3& normal )const;
 
         ColliderCircle( const Circle& shape );
         ColliderCircle();
@@ -59,7 +69,10 @@ namespace kege{
     struct ColliderCylinder : public Collider
     {
         void integrate( Rigidbody* body );
+        bool getBounds( AABB& bounds )const;
         const Cylinder* getCylinder()const;
+        vec3 support( const vec3& direction )const;
+        uint32_t supportFace( const vec3& direction, vec3* points, vec3& normal )const;
 
         ColliderCylinder( const Cylinder& shape );
         ColliderCylinder();
@@ -68,7 +81,10 @@ namespace kege{
     struct ColliderCapsule : public Collider
     {
         void integrate( Rigidbody* body );
+        bool getBounds( AABB& bounds )const;
         const Capsule* getCapsule()const;
+        vec3 support( const vec3& direction )const;
+        uint32_t supportFace( const vec3& direction, vec3* points, vec3& normal )const;
 
         ColliderCapsule( const Capsule& shape );
         ColliderCapsule();
@@ -77,7 +93,10 @@ namespace kege{
     struct ColliderCone : public Collider
     {
         void integrate( Rigidbody* body );
+        bool getBounds( AABB& bounds )const;
         const Cone* getCone()const;
+        vec3 support( const vec3& direction )const;
+        uint32_t supportFace( const vec3& direction, vec3* points, vec3& normal )const;
 
         ColliderCone( const Cone& shape );
         ColliderCone();
@@ -86,21 +105,129 @@ namespace kege{
 
 
 
+    /**
+     * @brief A triangle mesh collider, meant for static level geometry.
+     *
+     * The triangles stay in mesh space with a MeshBVH over them. Collision routines and rays are
+     * brought into mesh space instead of moving the triangles, the mesh space follows the center
+     * and orientation of the body.
+     */
     struct ColliderMesh : public Collider
     {
         struct Triangle
         {
             uint32_t a,b,c;
             vec3 normal;
+
+            /**
+             * bit i is set when the edge from vertex i to vertex i + 1 is active, an open edge or
+             * a ridge between two triangles. shapes touching an edge that is not active, a seam in
+             * a flat or concave part of the surface, are pushed along the face normal instead.
+             */
+            uint32_t active_edges;
         };
 
+        /**
+         * @param vertices Three floats per vertex.
+         * @param indices Three vertex indices per triangle. Triangles without area are dropped.
+         */
         ColliderMesh(const std::vector<float>& vertices, const std::vector<unsigned int>& indices);
         ColliderMesh();
 
         void integrate( Rigidbody* body );
+        bool getBounds( AABB& bounds )const;
+
+        /**
+         * @brief Gets triangle i in mesh space.
+         */
+        kege::Triangle getTriangle( uint32_t i )const;
+
+        /**
+         * @brief Sets Triangle::active_edges from how the triangles meet.
+         */
+        void findActiveEdges();
+
+        /**
+         * @brief Converts between world space and mesh space.
+         */
+        vec3 toLocal( const vec3& point )const;
+        vec3 toWorld( const vec3& point )const;
+        vec3 directionToLocal( const vec3& direction )const;
+        vec3 directionToWorld( const vec3& direction )const;
 
         std::vector< Triangle > triangles;
         std::vector< fvec3 > vertices;
+        physics::MeshBVH bvh;
+
+        /**
+         * @brief Ridges whose triangle normals are closer than this, about 5 degrees, are not active.
+         */
+        static float active_edge_cosine;
+
+        /**
+         * the origin and axes of mesh space in world space, as of the last integrate().
+         */
+        vec3 center;
+        mat33 axes;
+    };
+
+
+    /**
+     * @brief A convex hull collider, the hull of a set of points given around the body center.
+     *
+     * The hull is built once when the collider is made. Coplanar triangles of the hull are merged
+     * back into polygons, so the contact clipping gets whole faces to work with. Like ColliderMesh,
+     * the points stay in hull space, which follows the center and orientation of the body.
+     */
+    struct ColliderConvex : public Collider
+    {
+        struct Face
+        {
+            vec3 normal;
+            float distance;
+
+            /**
+             * the run of face_vertices holding the corners of the face, in order around it.
+             */
+            uint32_t first;
+            uint32_t count;
+        };
+
+        /**
+         * @param points The points to wrap, relative to the body center. Points inside the hull
+         * are dropped. Points that do not span a volume leave the hull empty.
+         */
+        ColliderConvex( const std::vector< vec3 >& points );
+        ColliderConvex();
+
+        void integrate( Rigidbody* body );
+        bool getBounds( AABB& bounds )const;
+        vec3 support( const vec3& direction )const;
+        uint32_t supportFace( const vec3& direction, vec3* points, vec3& normal )const;
+
+        /**
+         * @brief Converts between world space and hull space.
+         */
+        vec3 toLocal( const vec3& point )const;
+        vec3 toWorld( const vec3& point )const;
+        vec3 directionToLocal( const vec3& direction )const;
+        vec3 directionToWorld( const vec3& direction )const;
+
+        std::vector< vec3 > vertices;
+        std::vector< Face > faces;
+        std::vector< uint32_t > face_vertices;
+
+        /**
+         * the bounds of the hull in hull space.
+         */
+        vec3 local_min;
+        vec3 local_max;
+
+        /**
+         * the origin and axes of hull space in world space, as of the last integrate().
+         */
+        vec3 center;
+        mat33 axes;
     };
 
 
@@ -109,6 +236,11 @@ namespace kege{
     kege::mat33 computeCylinderInverseTensor( float radius, float height, float mass );
     kege::mat33 computeCapsuleInverseTensor( float radius, float height, float mass );
     kege::mat33 computeSphereInverseTensor( float radius, float mass );
+
+    /**
+     * @brief The inverse inertia of a solid hull of uniform density, about the origin of hull space.
+     */
+    kege::mat33 computeConvexInverseTensor( const ColliderConvex& hull, float mass );
     
 }
 #endif /* rigid_shapes_hpp */
@@ -48,6 +48,8 @@
 
 namespace kege{
 
+    float CollisionRegistry::match_distance = 0.05f;
+
     CollisionManifold* CollisionRegistry::operator[](uint32_t i)
     {
         return &_collisions[i];
@@ -61,12 +63,49 @@ namespace kege{
 
     void CollisionRegistry::reset()
     {
+        /*
+         the manifolds of this step become the previous ones, and the storage of the previous
+         ones is reused for the next step.
+         */
+        std::swap( _collisions, _previous );
+        if ( _collisions.size() < _previous.size() )
+        {
+            _collisions.resize( _previous.size() );
+        }
+
+        _previous_lookup.clear();
+        for ( uint32_t i = 0; i < _count; ++i )
+        {
+            bool swapped;
+            const Key key = keyOf( &_previous[ i ], swapped );
+            _previous_lookup.emplace( key, Previous{ i, swapped } );
+        }
         _count = 0;
     }
 
     CollisionManifold* CollisionRegistry::generate()
     {
-        return &_collisions[ _count++ ];
+        if ( _count == _collisions.size() )
+        {
+            _collisions.emplace_back();
+        }
+
+        /*
+         storage is reused, routines that do not set feature ids must not see stale ones, and a
+         manifold restore() is not run on must not warm start from another pair's impulses.
+         */
+        CollisionManifold* manifold = &_collisions[ _count++ ];
+        for ( uint32_t i = 0; i < MAX_CONTACTS; ++i )
+        {
+            Contact& contact = manifold->contacts[ i ];
+            contact.feature = 0;
+            contact.impulse = 0.f;
+            contact.tangent_impulse[0] = 0.f;
+            contact.tangent_impulse[1] = 0.f;
+        }
+        manifold->contact_count = 0;
+        manifold->part = 0;
+        return manifold;
     }
 
     uint32_t CollisionRegistry::count()const
@@ -74,6 +113,94 @@ namespace kege{
         return _count;
     }
 
+    void CollisionRegistry::restore( CollisionManifold* manifold )
+    {
+        bool swapped;
+        const CollisionManifold* previous = nullptr;
+        auto m = _previous_lookup.find( keyOf( manifold, swapped ) );
+        if ( m != _previous_lookup.end() )
+        {
+            previous = &_previous[ m->second.index ];
+        }
+
+        /*
+         the broadphase does not promise an order. when the pair comes the other way around the
+         last anchors are relative to the second body, and feature ids, which are made from the
+         features of the first and second shape, do not compare.
+         */
+        const bool flipped = ( previous != nullptr && m->second.swapped != swapped );
+        const vec3 origin = ( flipped ) ? manifold->objects[1]->center : manifold->objects[0]->center;
+
+        const float max_distance_sq = match_distance * match_distance;
+        for ( uint32_t i = 0; i < manifold->contact_count; ++i )
+        {
+            Contact& contact = manifold->contacts[ i ];
+            contact.anchor = contact.point - manifold->objects[0]->center;
+            contact.impulse = 0.f;
+            contact.tangent_impulse[0] = 0.f;
+            contact.tangent_impulse[1] = 0.f;
+
+            if ( previous == nullptr ) continue;
+
+            int match = -1;
+            float closest = max_distance_sq;
+            for ( uint32_t j = 0; j < previous->contact_count; ++j )
+            {
+                const Contact& old = previous->contacts[ j ];
+                if ( !flipped && contact.feature != 0 && old.feature != 0 )
+                {
+                    if ( contact.feature == old.feature )
+                    {
+                        match = j;
+                        break;
+                    }
+                    continue;
+                }
+
+                const float distance = magnSq( contact.point - origin - old.anchor );
+                if ( distance <= closest )
+                {
+                    closest = distance;
+                    match = j;
+                }
+            }
+
+            if ( match >= 0 )
+            {
+                const Contact& old = previous->contacts[ match ];
+                contact.impulse = old.impulse;
+                contact.tangent_impulse[0] = old.tangent_impulse[0];
+                contact.tangent_impulse[1] = old.tangent_impulse[1];
+
+                /*
+                 the impulses act on the other body now. the normal impulse is along the flipped
+                 normal and keeps its sign. the friction basis of the solver is built from the
+                 normal, its first tangent flips with the normal and its second does not, so the
+                 friction impulse, which has to turn around, keeps its first part and flips its
+                 second.
+                 */
+                if ( flipped )
+                {
+                    contact.tangent_impulse[1] = -contact.tangent_impulse[1];
+                }
+            }
+        }
+    }
+
+    void CollisionRegistry::clear()
+    {
+        _count = 0;
+        _previous_lookup.clear();
+    }
+
+    CollisionRegistry::Key CollisionRegistry::keyOf( const CollisionManifold* manifold, bool& swapped )
+    {
+        const Collider* a = manifold->objects[0]->collider.ref();
+        const Collider* b = manifold->objects[1]->collider.ref();
+        swapped = std::less< const Collider* >()( b, a );
+        return ( swapped ) ? Key{ b, a, manifold->part } : Key{ a, b, manifold->part };
+    }
+
     CollisionRegistry::CollisionRegistry()
     :   _count( 0 )
     {
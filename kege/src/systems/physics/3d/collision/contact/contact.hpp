@@ -8,6 +8,7 @@
 #ifndef collision_manager_hpp
 #define collision_manager_hpp
 
+#include <unordered_map>
 #include "../../../../-/component-dependencies.hpp"
 #include "../collider/collider.hpp"
 #include "../../dynamics/rigidbody.hpp"
@@ -31,6 +32,13 @@ namespace kege
          */
         float depth;
 
+        /**
+         * Identifies the pair of shape features that produced the point, so the point can be
+         * found again next step. 0 when the collision routine does not tell, the point is then
+         * matched by position.
+         */
+        uint32_t feature;
+
 
         /**
          * The rest of the member are cached, this save cpu us from re-computing it every solver that requires this info
@@ -58,10 +66,38 @@ namespace kege
 
 
         /**
-         * The computed impulse calculated for the this contact
+         * The normal impulse accumulated over the solver iterations. It is carried over to the
+         * matching contact of the next step to warm start the solver.
          */
         float impulse;
 
+        /**
+         * The friction impulse accumulated along each tangent, carried over like impulse
+         */
+        float tangent_impulse[2];
+
+        /**
+         * The friction directions, perpendicular to the normal and to each other
+         */
+        vec3 tangent[2];
+
+        /**
+         * The inverse of the effective mass along the normal and along each tangent
+         */
+        float normal_mass;
+        float tangent_mass[2];
+
+        /**
+         * The separating speed the solver aims for along the normal, from restitution
+         */
+        float velocity_bias;
+
+        /**
+         * The point relative to the first body center when the contact was made, used to
+         * match the contact with the one of the previous step
+         */
+        vec3  anchor;
+
         /**
          * The computed dot product between the relative velocity and the contact normal
          */
@@ -99,26 +135,102 @@ namespace kege
          * The contact normal
          */
         vec3 normal;
+
+        /**
+         * Tells apart several manifolds of the same pair of bodies, as a mesh gives one per
+         * direction it pushes in. 0 for shapes that only make one.
+         */
+        uint32_t part = 0;
     };
 
 
+    /**
+     * @brief Holds the manifolds of the current step and keeps those of the previous one.
+     *
+     * Manifolds are keyed by the colliders of their bodies, in either order, and their part.
+     * restore() finds the manifold of the same pair from the previous step and hands the
+     * accumulated impulses of its contacts over to the matching new contacts, so the solver
+     * starts from last step's answer instead of zero.
+     */
     class CollisionRegistry
     {
     public:
 
         CollisionManifold* operator[](uint32_t i);
         void resize(uint32_t size);
+
+        /**
+         * @brief Ends the step. The current manifolds become the previous ones and the count goes to zero.
+         */
         void reset();
 
+        /**
+         * @brief Adds a manifold, growing the storage when it is full.
+         */
         CollisionManifold* generate();
         uint32_t count()const;
 
+        /**
+         * @brief Carries the accumulated impulses of the matching previous contacts over to a new manifold.
+         *
+         * Contacts match when their feature ids agree, or when either has no feature id and they
+         * lie within `match_distance` of each other relative to the first body. Unmatched contacts
+         * start with zero impulse. When the pair comes in the other order than last step, the
+         * normal is flipped, the contacts are matched by position and the impulses turned around.
+         */
+        void restore( CollisionManifold* manifold );
+
+        /**
+         * @brief Drops the current and previous manifolds.
+         */
+        void clear();
+
         CollisionRegistry();
 
+    public:
+
+        static float match_distance;
+
+    private:
+
+        struct Key
+        {
+            inline bool operator ==( const Key& k )const
+            {
+                return a == k.a && b == k.b && part == k.part;
+            }
+
+            const Collider* a;
+            const Collider* b;
+            uint32_t part;
+        };
+
+        struct KeyHash
+        {
+            inline size_t operator()( const Key& k )const
+            {
+                return std::hash< const void* >()( k.a ) ^ ( std::hash< const void* >()( k.b ) * 31 ) ^ ( size_t( k.part ) * 0x9E3779B9u );
+            }
+        };
+
+        struct Previous
+        {
+            uint32_t index;
+            bool swapped;
+        };
+
+        /**
+         * the key has the lower collider first, swapped tells whether the manifold has them the other way.
+         */
+        static Key keyOf( const CollisionManifold* manifold, bool& swapped );
+
     private:
 
         std::vector< CollisionManifold > _collisions;
         uint32_t _count;
+
+        std::vector< CollisionManifold > _previous;
+        std::unordered_map< Key, Previous, KeyHash > _previous_lookup;
     };
 
 }
@@ -0,0 +1,48 @@
+//
+//  rayhit-convex.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#include <cfloat>
+#include <algorithm>
+#include "rayhit-convex.hpp"
+
+namespace kege::algo{
+
+    bool rayhitConvex( const Ray& ray, const ColliderConvex& hull, RayHit* out_hit )
+    {
+        // the ray goes into hull space, the rotation keeps distances the same
+        const vec3 origin = hull.toLocal( ray.origin );
+        const vec3 direction = hull.directionToLocal( ray.direction );
+
+        // the ray is clipped to the inside of every face plane
+        float enter = 0.f;
+        float leave = FLT_MAX;
+        for ( const ColliderConvex::Face& face : hull.faces )
+        {
+            const float distance = face.distance - dot( face.normal, origin );
+            const float speed = dot( face.normal, direction );
+            if ( fabsf( speed ) < 1e-8f )
+            {
+                if ( distance < 0.f ) return false;
+                continue;
+            }
+
+            const float t = distance / speed;
+            if ( speed < 0.f ) enter = std::max( enter, t );
+            else leave = std::min( leave, t );
+            if ( enter > leave ) return false;
+        }
+
+        if ( out_hit )
+        {
+            out_hit->hit = true;
+            out_hit->distance = enter;
+            out_hit->point = ray.origin + ray.direction * enter;
+        }
+        return true;
+    }
+
+}
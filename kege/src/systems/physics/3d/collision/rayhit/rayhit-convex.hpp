@@ -0,0 +1,20 @@
+//
+//  rayhit-convex.hpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef rayhit_convex_hpp
+#define rayhit_convex_hpp
+
+#include "../../collision/algorithms/utils.hpp"
+#include "../../collision/collider/rigid-shapes.hpp"
+
+namespace kege::algo{
+
+    // Tests ray against a convex hull collider, a ray that starts inside hits at distance 0
+    bool rayhitConvex(const Ray& ray, const ColliderConvex& hull, RayHit* out_hit);
+
+}
+#endif /* rayhit_convex_hpp */
@@ -5,8 +5,10 @@
 //  Created by Kenneth Esdaile on 4/15/25.
 //
 
+#include <cfloat>
 #include "rayhit-mesh.hpp"
 #include "rayhit-plane.hpp"
+#include "rayhit-triangle.hpp"
 
 namespace kege::algo{
 
@@ -74,4 +76,31 @@ namespace kege::algo{
         return false;
     }
 
+    bool rayhitMesh(const Ray& ray, const ColliderMesh& mesh, RayHit* out_hit)
+    {
+        // the ray goes into mesh space, the rotation keeps distances the same
+        const Ray local( mesh.toLocal( ray.origin ), mesh.directionToLocal( ray.direction ) );
+
+        bool found = false;
+        float nearest = FLT_MAX;
+        mesh.bvh.raycast( local, nearest, [ & ]( uint32_t t, float& max_distance )
+        {
+            RayHit hit;
+            if ( rayhitTriangle( local, mesh.getTriangle( t ), &hit ) && hit.distance < max_distance )
+            {
+                max_distance = hit.distance;
+                nearest = hit.distance;
+                found = true;
+            }
+        });
+
+        if ( found && out_hit )
+        {
+            out_hit->hit = true;
+            out_hit->distance = nearest;
+            out_hit->point = ray.origin + ray.direction * nearest;
+        }
+        return found;
+    }
+
 }
@@ -9,11 +9,15 @@
 #define rayhit_mesh_hpp
 
 #include "../../collision/algorithms/utils.hpp"
+#include "../../collision/collider/rigid-shapes.hpp"
 
 namespace kege::algo{
 
     // Tests ray against a polygon (flat and assumed convex)
     bool rayhitPolygon(const Ray& ray, const Polygon& polygon, RayHit* out_hit);
 
+    // Tests ray against the triangles of a mesh collider, reports the nearest hit
+    bool rayhitMesh(const Ray& ray, const ColliderMesh& mesh, RayHit* out_hit);
+
 }
 #endif /* rayhit_mesh_hpp */
@@ -54,7 +54,12 @@ namespace kege::algo{
 
     bool rayVsMesh( const Ray& ray, const Collider* collider, RayHit* hit )
     {
-        return {};
+        return rayhitMesh( ray, *static_cast< const ColliderMesh* >( collider ), hit );
+    }
+
+    bool rayVsConvex( const Ray& ray, const Collider* collider, RayHit* hit )
+    {
+        return rayhitConvex( ray, *static_cast< const ColliderConvex* >( collider ), hit );
     }
 
     bool rayVsCircle( const Ray& ray, const Collider* collider, RayHit* hit )
@@ -78,5 +83,6 @@ namespace kege::algo{
         rayhit_function_table[ RIGID_SHAPE_MESH           ] = rayVsMesh;
         rayhit_function_table[ RIGID_SHAPE_CONE           ] = rayVsCone;
         rayhit_function_table[ RIGID_SHAPE_CIRCLE         ] = rayVsCircle;
+        rayhit_function_table[ RIGID_SHAPE_CONVEX         ] = rayVsConvex;
     }
 }
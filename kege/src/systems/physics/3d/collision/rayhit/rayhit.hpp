@@ -21,6 +21,7 @@
 #include "../../collision/rayhit/rayhit-capsule.hpp"
 #include "../../collision/rayhit/rayhit-cylinder.hpp"
 #include "../../collision/rayhit/rayhit-triangle.hpp"
+#include "../../collision/rayhit/rayhit-convex.hpp"
 
 namespace kege::algo{
 
@@ -38,6 +39,8 @@ namespace kege::algo{
 
     bool rayVsMesh( const Ray& ray, const Collider* collider, RayHit* hit );
 
+    bool rayVsConvex( const Ray& ray, const Collider* collider, RayHit* hit );
+
     bool rayVsPolygon( const Ray& ray, const Collider* collider, RayHit* hit );
 
     bool rayhit( const Ray& ray, const Collider* collider, RayHit* result );
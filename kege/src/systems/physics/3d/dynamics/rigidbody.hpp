@@ -60,9 +60,11 @@ namespace kege{
         float           frames_since_move;
         float           body;     // Tracks current body (linear and angular combined)
         bool            grounded;
-        bool            is_awake;   // Indicates if the body is awake
+        uint32_t        island;     // the sleeping island of the body plus one, 0 while awake
+        bool            is_awake = true; // Indicates if the body is awake
         bool            sleepable;  // If the body is allowed to sleep
         bool            anti_gravity; // If the body is not affected by gravity
+        bool            continuous_collision = false; // If the body gets speculative contacts, so it can not pass through thin colliders
     };
 
 
@@ -0,0 +1,160 @@
+//
+//  body-arrays.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#include "body-arrays.hpp"
+#include "../../../../core/task/parallel-for.hpp"
+
+namespace kege::physics{
+
+    void BodyArrays::gather( const ComponentCacheT< Rigidbody >& bodies )
+    {
+        resize( bodies.size() );
+
+        BodyArrays& s = *this;
+        kege::parallelFor( 0, _count, [ &s, &bodies ]( uint32_t first, uint32_t last )
+        {
+            for ( uint32_t i = first; i < last; ++i )
+            {
+                /*
+                 the kernels leave inactive lanes as they are and scatter() skips them, their
+                 other fields are not needed.
+                 */
+                const Rigidbody& body = *bodies.at( i );
+                s[ ACTIVE ][ i ] = ( body.is_awake && !body.immovable ) ? 1.f : 0.f;
+                if ( s[ ACTIVE ][ i ] == 0.f ) continue;
+
+                s[ POSITION_X ][ i ] = body.center.x;
+                s[ POSITION_Y ][ i ] = body.center.y;
+                s[ POSITION_Z ][ i ] = body.center.z;
+                s[ VELOCITY_X ][ i ] = body.linear.velocity.x;
+                s[ VELOCITY_Y ][ i ] = body.linear.velocity.y;
+                s[ VELOCITY_Z ][ i ] = body.linear.velocity.z;
+                s[ FORCE_X ][ i ] = body.linear.forces.x;
+                s[ FORCE_Y ][ i ] = body.linear.forces.y;
+                s[ FORCE_Z ][ i ] = body.linear.forces.z;
+                s[ INVMASS ][ i ] = float( body.linear.invmass );
+                s[ ANGULAR_VELOCITY_X ][ i ] = body.angular.velocity.x;
+                s[ ANGULAR_VELOCITY_Y ][ i ] = body.angular.velocity.y;
+                s[ ANGULAR_VELOCITY_Z ][ i ] = body.angular.velocity.z;
+                s[ TORQUE_X ][ i ] = body.angular.torques.x;
+                s[ TORQUE_Y ][ i ] = body.angular.torques.y;
+                s[ TORQUE_Z ][ i ] = body.angular.torques.z;
+
+                const mat33& inertia = body.angular.inertia_inverse;
+                s[ INERTIA_XX ][ i ] = inertia.a00;
+                s[ INERTIA_XY ][ i ] = inertia.a01;
+                s[ INERTIA_XZ ][ i ] = inertia.a02;
+                s[ INERTIA_YX ][ i ] = inertia.a10;
+                s[ INERTIA_YY ][ i ] = inertia.a11;
+                s[ INERTIA_YZ ][ i ] = inertia.a12;
+                s[ INERTIA_ZX ][ i ] = inertia.a20;
+                s[ INERTIA_ZY ][ i ] = inertia.a21;
+                s[ INERTIA_ZZ ][ i ] = inertia.a22;
+
+                s[ ORIENTATION_X ][ i ] = body.orientation.x;
+                s[ ORIENTATION_Y ][ i ] = body.orientation.y;
+                s[ ORIENTATION_Z ][ i ] = body.orientation.z;
+                s[ ORIENTATION_W ][ i ] = body.orientation.w;
+                s[ LINEAR_DAMPING ][ i ] = body.linear.damping;
+                s[ ANGULAR_DAMPING ][ i ] = body.angular.damping;
+            }
+        });
+    }
+
+    void BodyArrays::scatter( ComponentCacheT< Rigidbody >& bodies )const
+    {
+        const BodyArrays& s = *this;
+        kege::parallelFor( 0, _count, [ &s, &bodies ]( uint32_t first, uint32_t last )
+        {
+            for ( uint32_t i = first; i < last; ++i )
+            {
+                if ( s[ ACTIVE ][ i ] == 0.f ) continue;
+
+                Rigidbody& body = *bodies.at( i );
+                body.prev = body.center;
+                body.center = vec3( s[ POSITION_X ][ i ], s[ POSITION_Y ][ i ], s[ POSITION_Z ][ i ] );
+                body.linear.velocity = vec3( s[ VELOCITY_X ][ i ], s[ VELOCITY_Y ][ i ], s[ VELOCITY_Z ][ i ] );
+                body.angular.velocity = vec3( s[ ANGULAR_VELOCITY_X ][ i ], s[ ANGULAR_VELOCITY_Y ][ i ], s[ ANGULAR_VELOCITY_Z ][ i ] );
+                body.orientation = quat( s[ ORIENTATION_X ][ i ], s[ ORIENTATION_Y ][ i ], s[ ORIENTATION_Z ][ i ], s[ ORIENTATION_W ][ i ] );
+            }
+        });
+    }
+
+    void BodyArrays::gatherVelocities( const ComponentCacheT< Rigidbody >& bodies )
+    {
+        BodyArrays& s = *this;
+        kege::parallelFor( 0, _count, [ &s, &bodies ]( uint32_t first, uint32_t last )
+        {
+            for ( uint32_t i = first; i < last; ++i )
+            {
+                const Rigidbody& body = *bodies.at( i );
+                s[ VELOCITY_X ][ i ] = body.linear.velocity.x;
+                s[ VELOCITY_Y ][ i ] = body.linear.velocity.y;
+                s[ VELOCITY_Z ][ i ] = body.linear.velocity.z;
+                s[ ANGULAR_VELOCITY_X ][ i ] = body.angular.velocity.x;
+                s[ ANGULAR_VELOCITY_Y ][ i ] = body.angular.velocity.y;
+                s[ ANGULAR_VELOCITY_Z ][ i ] = body.angular.velocity.z;
+
+                // bodies woken since the last gather() have no damping in here yet
+                s[ LINEAR_DAMPING ][ i ] = body.linear.damping;
+                s[ ANGULAR_DAMPING ][ i ] = body.angular.damping;
+                s[ ACTIVE ][ i ] = ( body.is_awake && !body.immovable ) ? 1.f : 0.f;
+            }
+        });
+    }
+
+    void BodyArrays::scatterVelocities( ComponentCacheT< Rigidbody >& bodies )const
+    {
+        const BodyArrays& s = *this;
+        kege::parallelFor( 0, _count, [ &s, &bodies ]( uint32_t first, uint32_t last )
+        {
+            for ( uint32_t i = first; i < last; ++i )
+            {
+                if ( s[ ACTIVE ][ i ] == 0.f ) continue;
+
+                Rigidbody& body = *bodies.at( i );
+                body.linear.velocity = vec3( s[ VELOCITY_X ][ i ], s[ VELOCITY_Y ][ i ], s[ VELOCITY_Z ][ i ] );
+                body.angular.velocity = vec3( s[ ANGULAR_VELOCITY_X ][ i ], s[ ANGULAR_VELOCITY_Y ][ i ], s[ ANGULAR_VELOCITY_Z ][ i ] );
+            }
+        });
+    }
+
+    void BodyArrays::resize( uint32_t count )
+    {
+        const uint32_t stride = ( count + LANES - 1 ) / LANES * LANES;
+        if ( stride != _stride || _base == nullptr )
+        {
+            /*
+             one block for every field, over-allocated by a lane so the base can be moved up to
+             a 32 byte boundary. the stride is a multiple of 8 floats, every field stays aligned.
+             */
+            _storage.assign( size_t( stride ) * MAX_FIELDS + LANES, 0.f );
+            const uintptr_t address = reinterpret_cast< uintptr_t >( _storage.data() );
+            _base = _storage.data() + ( ( 32 - address % 32 ) % 32 ) / sizeof( float );
+            _stride = stride;
+
+            // the padding never moves, a unit orientation keeps the kernels free of NaNs there
+            for ( uint32_t i = 0; i < stride; ++i )
+            {
+                ( *this )[ ORIENTATION_W ][ i ] = 1.f;
+            }
+        }
+        _count = count;
+
+        for ( uint32_t i = count; i < stride; ++i )
+        {
+            ( *this )[ ACTIVE ][ i ] = 0.f;
+        }
+    }
+
+    BodyArrays::BodyArrays()
+    :   _base( nullptr )
+    ,   _count( 0 )
+    ,   _stride( 0 )
+    {}
+
+}
@@ -0,0 +1,126 @@
+//
+//  body-arrays.hpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef kege_physics_body_arrays_hpp
+#define kege_physics_body_arrays_hpp
+
+#include <vector>
+#include "../dynamics/rigidbody.hpp"
+#include "../../../../core/ecs/component-cache.hpp"
+
+namespace kege::physics{
+
+    /**
+     * @brief The motion state of the rigidbodies as one float array per field.
+     *
+     * The integration and damping kernels touch a few fields of every body. Stored this way each
+     * field of 8 neighbouring bodies is one aligned 32 byte load, instead of a few floats picked out
+     * of a Rigidbody that spans several cache lines. Rigidbody stays the component the rest of the
+     * engine reads and writes, gather() copies it in and scatter() copies the results back.
+     *
+     * Index i is the body at position i of the dense rigidbody range. Every array is padded to a
+     * multiple of LANES, the padding is inactive and kernels may run over it.
+     */
+    class BodyArrays
+    {
+    public:
+
+        enum Field
+        {
+            POSITION_X, POSITION_Y, POSITION_Z,
+            VELOCITY_X, VELOCITY_Y, VELOCITY_Z,
+            FORCE_X, FORCE_Y, FORCE_Z,
+            INVMASS,
+            ANGULAR_VELOCITY_X, ANGULAR_VELOCITY_Y, ANGULAR_VELOCITY_Z,
+            TORQUE_X, TORQUE_Y, TORQUE_Z,
+
+            /**
+             * the inverse inertia tensor, INERTIA_XY is row x column y of torque * inertia_inverse.
+             */
+            INERTIA_XX, INERTIA_XY, INERTIA_XZ,
+            INERTIA_YX, INERTIA_YY, INERTIA_YZ,
+            INERTIA_ZX, INERTIA_ZY, INERTIA_ZZ,
+
+            ORIENTATION_X, ORIENTATION_Y, ORIENTATION_Z, ORIENTATION_W,
+            LINEAR_DAMPING, ANGULAR_DAMPING,
+
+            /**
+             * 1 for awake movable bodies, 0 for sleeping and immovable bodies and the padding.
+             */
+            ACTIVE,
+            MAX_FIELDS
+        };
+
+        /**
+         * the number of bodies the widest kernel handles at once, the arrays are aligned and padded to it.
+         */
+        enum{ LANES = 8 };
+
+        /**
+         * @brief Copies every field of the active bodies in, resizing the arrays to the body count.
+         * Inactive bodies only get their ACTIVE flag, the rest of their lanes keep old values.
+         */
+        void gather( const ComponentCacheT< Rigidbody >& bodies );
+
+        /**
+         * @brief Copies position, velocities and orientation of the active bodies back out.
+         */
+        void scatter( ComponentCacheT< Rigidbody >& bodies )const;
+
+        /**
+         * @brief Copies only the velocities, damping and ACTIVE flag in. The other fields keep the
+         * values of the last gather(), the body count must not have changed since.
+         */
+        void gatherVelocities( const ComponentCacheT< Rigidbody >& bodies );
+
+        /**
+         * @brief Copies only the linear and angular velocities of the active bodies back out.
+         */
+        void scatterVelocities( ComponentCacheT< Rigidbody >& bodies )const;
+
+        inline float* operator[]( Field field )
+        {
+            return _base + size_t( field ) * _stride;
+        }
+
+        inline const float* operator[]( Field field )const
+        {
+            return _base + size_t( field ) * _stride;
+        }
+
+        /**
+         * @brief Gets the number of bodies.
+         */
+        inline uint32_t size()const
+        {
+            return _count;
+        }
+
+        /**
+         * @brief Gets the length of every array, size() rounded up to a multiple of LANES.
+         */
+        inline uint32_t stride()const
+        {
+            return _stride;
+        }
+
+        BodyArrays();
+
+    private:
+
+        void resize( uint32_t count );
+
+    private:
+
+        std::vector< float > _storage;
+        float* _base;
+        uint32_t _count;
+        uint32_t _stride;
+    };
+
+}
+#endif /* kege_physics_body_arrays_hpp */
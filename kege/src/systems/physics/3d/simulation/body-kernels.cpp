@@ -0,0 +1,132 @@
+//
+//  body-kernels.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#include <cmath>
+#include "body-kernels.hpp"
+
+#if defined( KEGE_PHYSICS_NO_SIMD ) && !defined( KEGE_NO_SIMD )
+#define KEGE_NO_SIMD
+#endif
+#include "../../../../core/math/algebra/lanes.hpp"
+
+namespace kege::physics{
+
+    using namespace kege::simd;
+
+    /**
+     * the velocity components the old per-body integrator snapped to zero, kept so resting bodies
+     * stop the same way.
+     */
+    static const float SMALL_VELOCITY = 1e-4f;
+
+    void integrateBodies( BodyArrays& s, uint32_t first, uint32_t last, float time_step )
+    {
+        const lanes h = splat( time_step );
+        const lanes half = splat( 0.5f );
+        const lanes small = splat( SMALL_VELOCITY );
+
+        for ( uint32_t i = first; i < last; i += WIDTH )
+        {
+            // sleeping and immovable bodies integrate with a zero step and keep their state
+            const lanes step = mul( load( s[ BodyArrays::ACTIVE ] + i ), h );
+
+            /*
+             linear, semi-implicit euler. the velocity takes the acceleration of the forces, the
+             position moves by the new velocity.
+             */
+            const lanes invmass = load( s[ BodyArrays::INVMASS ] + i );
+            lanes vx = add( load( s[ BodyArrays::VELOCITY_X ] + i ), mul( mul( load( s[ BodyArrays::FORCE_X ] + i ), invmass ), step ) );
+            lanes vy = add( load( s[ BodyArrays::VELOCITY_Y ] + i ), mul( mul( load( s[ BodyArrays::FORCE_Y ] + i ), invmass ), step ) );
+            lanes vz = add( load( s[ BodyArrays::VELOCITY_Z ] + i ), mul( mul( load( s[ BodyArrays::FORCE_Z ] + i ), invmass ), step ) );
+            vx = keepAbove( vx, small );
+            vy = keepAbove( vy, small );
+            vz = keepAbove( vz, small );
+            store( s[ BodyArrays::VELOCITY_X ] + i, vx );
+            store( s[ BodyArrays::VELOCITY_Y ] + i, vy );
+            store( s[ BodyArrays::VELOCITY_Z ] + i, vz );
+            store( s[ BodyArrays::POSITION_X ] + i, add( load( s[ BodyArrays::POSITION_X ] + i ), mul( vx, step ) ) );
+            store( s[ BodyArrays::POSITION_Y ] + i, add( load( s[ BodyArrays::POSITION_Y ] + i ), mul( vy, step ) ) );
+            store( s[ BodyArrays::POSITION_Z ] + i, add( load( s[ BodyArrays::POSITION_Z ] + i ), mul( vz, step ) ) );
+
+            // angular acceleration, torque * inertia_inverse
+            const lanes tx = load( s[ BodyArrays::TORQUE_X ] + i );
+            const lanes ty = load( s[ BodyArrays::TORQUE_Y ] + i );
+            const lanes tz = load( s[ BodyArrays::TORQUE_Z ] + i );
+            const lanes ax = add( add( mul( tx, load( s[ BodyArrays::INERTIA_XX ] + i ) ), mul( ty, load( s[ BodyArrays::INERTIA_XY ] + i ) ) ), mul( tz, load( s[ BodyArrays::INERTIA_XZ ] + i ) ) );
+            const lanes ay = add( add( mul( tx, load( s[ BodyArrays::INERTIA_YX ] + i ) ), mul( ty, load( s[ BodyArrays::INERTIA_YY ] + i ) ) ), mul( tz, load( s[ BodyArrays::INERTIA_YZ ] + i ) ) );
+            const lanes az = add( add( mul( tx, load( s[ BodyArrays::INERTIA_ZX ] + i ) ), mul( ty, load( s[ BodyArrays::INERTIA_ZY ] + i ) ) ), mul( tz, load( s[ BodyArrays::INERTIA_ZZ ] + i ) ) );
+
+            lanes wx = keepAbove( add( load( s[ BodyArrays::ANGULAR_VELOCITY_X ] + i ), mul( ax, step ) ), small );
+            lanes wy = keepAbove( add( load( s[ BodyArrays::ANGULAR_VELOCITY_Y ] + i ), mul( ay, step ) ), small );
+            lanes wz = keepAbove( add( load( s[ BodyArrays::ANGULAR_VELOCITY_Z ] + i ), mul( az, step ) ), small );
+            store( s[ BodyArrays::ANGULAR_VELOCITY_X ] + i, wx );
+            store( s[ BodyArrays::ANGULAR_VELOCITY_Y ] + i, wy );
+            store( s[ BodyArrays::ANGULAR_VELOCITY_Z ] + i, wz );
+
+            /*
+             the orientation follows dq/dt = 0.5 * (w, 0) * q, then is normalized. inactive lanes
+             add nothing and are written back unchanged.
+             */
+            const lanes qx = load( s[ BodyArrays::ORIENTATION_X ] + i );
+            const lanes qy = load( s[ BodyArrays::ORIENTATION_Y ] + i );
+            const lanes qz = load( s[ BodyArrays::ORIENTATION_Z ] + i );
+            const lanes qw = load( s[ BodyArrays::ORIENTATION_W ] + i );
+            const lanes k = mul( half, step );
+            lanes nx = add( qx, mul( k, sub( add( mul( wx, qw ), mul( wy, qz ) ), mul( wz, qy ) ) ) );
+            lanes ny = add( qy, mul( k, sub( add( mul( wy, qw ), mul( wz, qx ) ), mul( wx, qz ) ) ) );
+            lanes nz = add( qz, mul( k, sub( add( mul( wz, qw ), mul( wx, qy ) ), mul( wy, qx ) ) ) );
+            lanes nw = sub( qw, mul( k, add( add( mul( wx, qx ), mul( wy, qy ) ), mul( wz, qz ) ) ) );
+
+            const lanes length = root( add( add( mul( nx, nx ), mul( ny, ny ) ), add( mul( nz, nz ), mul( nw, nw ) ) ) );
+            store( s[ BodyArrays::ORIENTATION_X ] + i, divide( nx, length ) );
+            store( s[ BodyArrays::ORIENTATION_Y ] + i, divide( ny, length ) );
+            store( s[ BodyArrays::ORIENTATION_Z ] + i, divide( nz, length ) );
+            store( s[ BodyArrays::ORIENTATION_W ] + i, divide( nw, length ) );
+        }
+    }
+
+    void dampenBodies( BodyArrays& s, uint32_t first, uint32_t last, float time_step )
+    {
+        /*
+         pow() has no vector form here. bodies mostly share a damping value, the factor of the
+         previous body is reused while the value repeats.
+         */
+        alignas( 32 ) float linear[ WIDTH ];
+        alignas( 32 ) float angular[ WIDTH ];
+        float linear_damping = -1.f, linear_factor = 1.f;
+        float angular_damping = -1.f, angular_factor = 1.f;
+
+        for ( uint32_t i = first; i < last; i += WIDTH )
+        {
+            for ( uint32_t j = 0; j < WIDTH; ++j )
+            {
+                const float active = s[ BodyArrays::ACTIVE ][ i + j ];
+                const float ld = s[ BodyArrays::LINEAR_DAMPING ][ i + j ];
+                const float ad = s[ BodyArrays::ANGULAR_DAMPING ][ i + j ];
+                if ( ld != linear_damping ) { linear_damping = ld; linear_factor = std::pow( ld, time_step ); }
+                if ( ad != angular_damping ) { angular_damping = ad; angular_factor = std::pow( ad, time_step ); }
+                linear[ j ] = ( active != 0.f ) ? linear_factor : 1.f;
+                angular[ j ] = ( active != 0.f ) ? angular_factor : 1.f;
+            }
+
+            const lanes l = load( linear );
+            const lanes a = load( angular );
+            store( s[ BodyArrays::VELOCITY_X ] + i, mul( load( s[ BodyArrays::VELOCITY_X ] + i ), l ) );
+            store( s[ BodyArrays::VELOCITY_Y ] + i, mul( load( s[ BodyArrays::VELOCITY_Y ] + i ), l ) );
+            store( s[ BodyArrays::VELOCITY_Z ] + i, mul( load( s[ BodyArrays::VELOCITY_Z ] + i ), l ) );
+            store( s[ BodyArrays::ANGULAR_VELOCITY_X ] + i, mul( load( s[ BodyArrays::ANGULAR_VELOCITY_X ] + i ), a ) );
+            store( s[ BodyArrays::ANGULAR_VELOCITY_Y ] + i, mul( load( s[ BodyArrays::ANGULAR_VELOCITY_Y ] + i ), a ) );
+            store( s[ BodyArrays::ANGULAR_VELOCITY_Z ] + i, mul( load( s[ BodyArrays::ANGULAR_VELOCITY_Z ] + i ), a ) );
+        }
+    }
+
+    const char* bodyKernelInstructionSet()
+    {
+        return instructionSet();
+    }
+
+}
@@ -0,0 +1,38 @@
+//
+//  body-kernels.hpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef kege_physics_body_kernels_hpp
+#define kege_physics_body_kernels_hpp
+
+#include "body-arrays.hpp"
+
+namespace kege::physics{
+
+    /**
+     * @brief Integrates forces and torques into the velocities, and the velocities into the
+     * positions and orientations, of the bodies in [first, last).
+     *
+     * The kernels process 8 bodies per instruction with AVX, 4 with SSE2 and one at a time
+     * otherwise, picked when the engine is compiled. Defining KEGE_PHYSICS_NO_SIMD, or
+     * KEGE_NO_SIMD for the whole engine, forces the scalar path. `first` and `last` must be
+     * multiples of BodyArrays::LANES or the stride.
+     */
+    void integrateBodies( BodyArrays& bodies, uint32_t first, uint32_t last, float time_step );
+
+    /**
+     * @brief Scales the velocities of the bodies in [first, last) by their damping to the power
+     * of `time_step`. Same range rules as integrateBodies().
+     */
+    void dampenBodies( BodyArrays& bodies, uint32_t first, uint32_t last, float time_step );
+
+    /**
+     * @brief Gets the name of the instruction set the kernels were compiled for.
+     */
+    const char* bodyKernelInstructionSet();
+
+}
+#endif /* kege_physics_body_kernels_hpp */
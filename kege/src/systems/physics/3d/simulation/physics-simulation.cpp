@@ -10,9 +10,11 @@
 #include "../simulators/collision-detector.hpp"
 #include "../simulators/net-force-zeroer.hpp"
 #include "../simulators/motion-dampener.hpp"
+#include "../simulators/sleep-system.hpp"
 #include "../simulators/grounded-detector.hpp"
 #include "../simulators/contact-impulse-solver.hpp"
 #include "../simulators/collision-position-solver.hpp"
+#include "../collision/broadphase/tree-broadphase.hpp"
 
 #include "physics-simulation.hpp"
 
@@ -34,6 +36,16 @@ namespace kege::physics{
         return *_rigidbodies;
     }
 
+    void Simulation::setBroadphase( Broadphase* broadphase )
+    {
+        _broadphase = broadphase;
+    }
+
+    Broadphase* Simulation::getBroadphase()
+    {
+        return _broadphase.ref();
+    }
+
 //    Rigidbody* Simulation::getRigidbody( Key id )
 //    {
 //        return &_rigidbodies[ id._index ];
@@ -47,11 +59,66 @@ namespace kege::physics{
 //        return {};
 //    }
 
+    BodyArrays& Simulation::bodyArrays()
+    {
+        return _body_arrays;
+    }
+
     kege::CollisionRegistry& Simulation::getCollisionRegistry()
     {
         return _collisions;
     }
 
+    void Simulation::setIterations( int iterations )
+    {
+        _iterations = std::max( iterations, 1 );
+    }
+
+    int Simulation::getIterations()const
+    {
+        return _iterations;
+    }
+
+    void Simulation::setParallelContacts( bool enable )
+    {
+        if ( _contact_solver ) _contact_solver->setParallel( enable );
+    }
+
+    bool Simulation::getParallelContacts()const
+    {
+        return _contact_solver && _contact_solver->getParallel();
+    }
+
+    bool Simulation::raycast( const Ray& ray, float max_distance, QueryHit& hit, ComponentID ignore )
+    {
+        return _scene_query.raycast( ray, max_distance, hit, ignore );
+    }
+
+    uint32_t Simulation::raycastAll( const Ray& ray, float max_distance, std::vector< QueryHit >& hits, ComponentID ignore )
+    {
+        return _scene_query.raycastAll( ray, max_distance, hits, ignore );
+    }
+
+    uint32_t Simulation::raycast( const QueryRay* rays, uint32_t count, QueryHit* hits, bool parallel )
+    {
+        return _scene_query.raycast( rays, count, hits, parallel );
+    }
+
+    bool Simulation::sphereCast( const Sphere& sphere, const vec3& direction, float max_distance, QueryHit& hit, ComponentID ignore )
+    {
+        return _scene_query.sphereCast( sphere, direction, max_distance, hit, ignore );
+    }
+
+    uint32_t Simulation::overlapSphere( const Sphere& sphere, std::vector< ComponentID >& bodies )
+    {
+        return _scene_query.overlapSphere( sphere, bodies );
+    }
+
+    uint32_t Simulation::overlapBox( const OBB& box, std::vector< ComponentID >& bodies )
+    {
+        return _scene_query.overlapBox( box, bodies );
+    }
+
     void Simulation::update( Stage stage, double dms )
     {
         for ( Ref< Simulator >& simulator : _simulators[ stage ] )
@@ -69,6 +136,21 @@ namespace kege::physics{
             update( ON_UPDATE, time_step );
         }
         update( POST_UPDATE, dms );
+        _scene_query.invalidate();
+
+        /*
+         the simulators write the bodies through the dense range, which does not stamp. mark
+         the bodies that could have moved so changed< Rigidbody >() views pick them up.
+         */
+        ComponentCacheT< Rigidbody >& bodies = *_rigidbodies;
+        for ( uint32_t i = 0; i < bodies.size(); ++i )
+        {
+            const Rigidbody& body = *bodies.at( i );
+            if ( body.is_awake && !body.immovable )
+            {
+                bodies.markChanged( i );
+            }
+        }
     }
 
     bool Simulation::initialize( ComponentCacheT< Rigidbody >* rigidbodies )
@@ -79,17 +161,23 @@ namespace kege::physics{
         }
         
         _rigidbodies = rigidbodies;
+        // the simulators walk the rigidbody cache directly, keep them out of archetype chunks
+        _rigidbodies->pin();
         _collisions.resize( 500 );
 
         addSimulator( PRE_UPDATE,  new ForceApplier() );
         addSimulator( ON_UPDATE,   new ForceIntegrator() );
         addSimulator( ON_UPDATE,   new CollisionDetector() );
-        addSimulator( ON_UPDATE,   new ContactImpulseSolver() );
-        addSimulator( ON_UPDATE,   new PositionCorrectionSolver() );
+        // the impulse solver pushes penetrating contacts apart itself, a separate position pass would correct twice
+        _contact_solver = new ContactImpulseSolver();
+        addSimulator( ON_UPDATE,   _contact_solver );
         addSimulator( POST_UPDATE, new NetForceZeroer() );
         addSimulator( POST_UPDATE, new MotionDampener() );
+        addSimulator( POST_UPDATE, new SleepSystem() );
         addSimulator( POST_UPDATE, new GroundedDetector() );
 
+        _broadphase = new TreeBroadphase();
+        _scene_query.initialize( rigidbodies );
         _iterations = 4;
         return true;
     }
@@ -100,8 +188,11 @@ namespace kege::physics{
         {
             _simulators[ i ].clear();
         }
+        _broadphase.clear();
+        _scene_query.clear();
+        _collisions.clear();
         _rigidbodies = nullptr;
-        //_collisions.clear();
+        _contact_solver = nullptr;
     }
 
     Simulation::~Simulation()
@@ -110,7 +201,9 @@ namespace kege::physics{
     }
 
     Simulation::Simulation()
-    :   _iterations( 0 )
+    :   _rigidbodies( nullptr )
+    ,   _iterations( 0 )
+    ,   _contact_solver( nullptr )
     {}
 
 }
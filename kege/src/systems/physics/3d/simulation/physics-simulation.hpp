@@ -10,10 +10,15 @@
 
 #include "../simulators/simulator.hpp"
 #include "../dynamics/rigidbody.hpp"
+#include "../collision/broadphase/broadphase.hpp"
+#include "body-arrays.hpp"
+#include "scene-query.hpp"
 #include "../../../../core/ecs/component-cache.hpp"
 
 namespace kege::physics{
 
+    class ContactImpulseSolver;
+
 //    class Key
 //    {
 //        Rigidbody* operator ->();
@@ -35,10 +40,74 @@ namespace kege::physics{
 
         ComponentCacheT< Rigidbody >& rigidbodies();
 
+        /**
+         * @brief Gets the structure-of-arrays copy of the body motion state the integration and
+         * damping kernels work in. Rigidbody stays the authoritative view between simulators.
+         */
+        BodyArrays& bodyArrays();
+
+        /**
+         * @brief Sets the broadphase the CollisionDetector uses to find candidate pairs.
+         *
+         * initialize() installs a TreeBroadphase. Swap in a SweepAndPruneBroadphase for scenes whose
+         * bodies are spread along one axis and move little, or pass null to test every pair.
+         */
+        void setBroadphase( Broadphase* broadphase );
+        Broadphase* getBroadphase();
+
 //        Rigidbody* getRigidbody( Key id );
 //        void deleteRigidbody( Key id );
 //        Key createRigidbody();
 
+        /**
+         * @brief Sets the number of substeps the ON_UPDATE simulators run per simulate() call.
+         *
+         * Substeps keep fast bodies from passing through thin colliders at the cost of the whole
+         * pipeline. Setting Rigidbody::continuous_collision on the fast bodies instead lets most
+         * scenes run with a single one.
+         */
+        void setIterations( int iterations );
+        int getIterations()const;
+
+        /**
+         * @brief Solves the contacts in colored batches on the job workers, off by default.
+         *
+         * The contacts are then visited in color order instead of registry order, which changes
+         * the result against the serial solve but not with the number of workers. It pays off
+         * from a few hundred manifolds on machines with spare cores, see ContactImpulseSolver::setParallel().
+         */
+        void setParallelContacts( bool enable );
+        bool getParallelContacts()const;
+
+        /**
+         * @brief Finds the nearest collider a ray hits before max_distance.
+         * @param ignore A rigidbody the ray goes through, such as the one casting it, 0 for none.
+         * @see SceneQuery
+         */
+        bool raycast( const Ray& ray, float max_distance, QueryHit& hit, ComponentID ignore = 0 );
+
+        /**
+         * @brief Finds every collider a ray hits before max_distance, nearest first.
+         */
+        uint32_t raycastAll( const Ray& ray, float max_distance, std::vector< QueryHit >& hits, ComponentID ignore = 0 );
+
+        /**
+         * @brief Casts a batch of rays, on the job workers when parallel is set.
+         * @return The number of rays that hit something.
+         */
+        uint32_t raycast( const QueryRay* rays, uint32_t count, QueryHit* hits, bool parallel = true );
+
+        /**
+         * @brief Sweeps a sphere along direction, the nearest collider it touches before max_distance.
+         */
+        bool sphereCast( const Sphere& sphere, const vec3& direction, float max_distance, QueryHit& hit, ComponentID ignore = 0 );
+
+        /**
+         * @brief Finds the rigidbodies whose colliders touch a sphere or a box.
+         */
+        uint32_t overlapSphere( const Sphere& sphere, std::vector< ComponentID >& bodies );
+        uint32_t overlapBox( const OBB& box, std::vector< ComponentID >& bodies );
+
         void simulate( double dms );
         bool initialize( ComponentCacheT< Rigidbody >* components );
         void shutdown();
@@ -54,9 +123,17 @@ namespace kege::physics{
 
         std::vector< Ref< Simulator > > _simulators[ MAX_STAGES ];
         ComponentCacheT< Rigidbody >* _rigidbodies;
+        Ref< Broadphase > _broadphase;
+        BodyArrays _body_arrays;
+        SceneQuery _scene_query;
         kege::CollisionRegistry _collisions;
         int _iterations;
 
+        /**
+         * the contact solver initialize() installs, owned by _simulators.
+         */
+        ContactImpulseSolver* _contact_solver;
+
         friend class System;
     };
 }
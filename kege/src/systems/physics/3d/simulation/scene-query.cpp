@@ -0,0 +1,574 @@
+//
+//  scene-query.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#include <atomic>
+#include <algorithm>
+#include "../collision/rayhit/rayhit.hpp"
+#include "../collision/algorithms/gjk-epa.hpp"
+#include "../collision/algorithms/mesh-contacts.hpp"
+#include "../../../../core/task/parallel-for.hpp"
+#include "scene-query.hpp"
+
+namespace kege::physics{
+
+    float SceneQuery::sweep_tolerance = 0.001f;
+    uint32_t SceneQuery::batch_size = 64;
+
+    /**
+     * the most steps a sweep takes toward a collider before it gives up on a grazing miss.
+     */
+    enum{ MAX_SWEEP_STEPS = 32 };
+
+    /**
+     * a point as a shape GJK can measure the distance to, the center of a query sphere.
+     */
+    struct PointSupport : public algo::ConvexSupport
+    {
+        vec3 support( const vec3& direction )const
+        {
+            return point;
+        }
+
+        uint32_t supportFace( const vec3& direction, vec3* points, vec3& normal )const
+        {
+            normal = direction;
+            points[0] = point;
+            return 1;
+        }
+
+        PointSupport( const vec3& point ): point( point ) {}
+        vec3 point;
+    };
+
+    /**
+     * the core of a collider, round shapes are measured from it and less their margin.
+     */
+    struct ColliderCore : public algo::ConvexSupport
+    {
+        vec3 support( const vec3& direction )const
+        {
+            return shape.coreSupport( direction );
+        }
+
+        uint32_t supportFace( const vec3& direction, vec3* points, vec3& normal )const
+        {
+            normal = direction;
+            points[0] = shape.coreSupport( direction );
+            return 1;
+        }
+
+        ColliderCore( const Collider* collider ): shape( collider ) {}
+        algo::ColliderSupport shape;
+    };
+
+    struct BoxSupport : public algo::ConvexSupport
+    {
+        vec3 support( const vec3& direction )const
+        {
+            vec3 point = box.center;
+            for ( int i = 0; i < 3; ++i )
+            {
+                point += box.axes[ i ] * ( ( dot( direction, box.axes[ i ] ) >= 0.f ) ? box.extents[ i ] : -box.extents[ i ] );
+            }
+            return point;
+        }
+
+        uint32_t supportFace( const vec3& direction, vec3* points, vec3& normal )const
+        {
+            normal = direction;
+            points[0] = support( direction );
+            return 1;
+        }
+
+        BoxSupport( const OBB& box ): box( box ) {}
+        const OBB& box;
+    };
+
+    /**
+     * the bounds of a box in the space of a mesh, and the box itself.
+     */
+    static AABB toMeshSpace( const ColliderMesh* mesh, const OBB& box, OBB& local )
+    {
+        local.center = mesh->toLocal( box.center );
+        local.extents = box.extents;
+        local.axes[0] = mesh->directionToLocal( box.axes[0] );
+        local.axes[1] = mesh->directionToLocal( box.axes[1] );
+        local.axes[2] = mesh->directionToLocal( box.axes[2] );
+
+        const vec3 r
+        (
+            local.extents.x * fabsf( local.axes[0].x ) + local.extents.y * fabsf( local.axes[1].x ) + local.extents.z * fabsf( local.axes[2].x ),
+            local.extents.x * fabsf( local.axes[0].y ) + local.extents.y * fabsf( local.axes[1].y ) + local.extents.z * fabsf( local.axes[2].y ),
+            local.extents.x * fabsf( local.axes[0].z ) + local.extents.y * fabsf( local.axes[1].z ) + local.extents.z * fabsf( local.axes[2].z )
+        );
+        return AABB( local.center - r, local.center + r );
+    }
+
+    bool SceneQuery::raycast( const Ray& ray, float max_distance, QueryHit& hit, ComponentID ignore )
+    {
+        sync();
+        return castRay( ray, max_distance, hit, ignore );
+    }
+
+    uint32_t SceneQuery::raycastAll( const Ray& ray, float max_distance, std::vector< QueryHit >& hits, ComponentID ignore )
+    {
+        sync();
+        hits.clear();
+
+        const float length = magn( ray.direction );
+        if ( length <= 0.f ) return 0;
+        const Ray unit( ray.origin, ray.direction / length );
+
+        QueryHit hit;
+        for ( ComponentID id : _unbounded )
+        {
+            if ( testRay( unit, max_distance, id, ignore, hit ) ) hits.push_back( hit );
+        }
+
+        // max_distance is left as it is, so every collider along the ray is walked
+        _tree.raycast( unit, max_distance, [ & ]( int32_t proxy, float& distance )
+        {
+            if ( testRay( unit, distance, _tree.data( proxy ), ignore, hit ) ) hits.push_back( hit );
+        });
+
+        std::sort( hits.begin(), hits.end(), []( const QueryHit& a, const QueryHit& b )
+        {
+            return a.distance < b.distance;
+        });
+        return uint32_t( hits.size() );
+    }
+
+    uint32_t SceneQuery::raycast( const QueryRay* rays, uint32_t count, QueryHit* hits, bool parallel )
+    {
+        sync();
+
+        std::atomic< uint32_t > found( 0 );
+        auto cast = [ this, rays, hits, &found ]( uint32_t first, uint32_t last )
+        {
+            uint32_t n = 0;
+            for ( uint32_t i = first; i < last; ++i )
+            {
+                n += castRay( rays[ i ].ray, rays[ i ].max_distance, hits[ i ], rays[ i ].ignore ) ? 1 : 0;
+            }
+            found += n;
+        };
+
+        if ( parallel )
+        {
+            kege::parallelFor( 0, count, batch_size, cast );
+        }
+        else
+        {
+            cast( 0, count );
+        }
+        return found;
+    }
+
+    bool SceneQuery::sphereCast( const Sphere& sphere, const vec3& direction, float max_distance, QueryHit& hit, ComponentID ignore )
+    {
+        sync();
+        hit.body = 0;
+
+        const float length = magn( direction );
+        if ( length <= 0.f ) return false;
+        const vec3 unit = direction / length;
+
+        QueryHit found;
+        auto test = [ & ]( ComponentID id, float& distance )
+        {
+            if ( id != ignore && testSphereCast( sphere, unit, distance, id, found ) )
+            {
+                hit = found;
+                distance = found.distance;
+            }
+        };
+
+        for ( ComponentID id : _unbounded )
+        {
+            test( id, max_distance );
+        }
+        _tree.sweep( Ray( sphere.center, unit ), sphere.radius, max_distance, [ & ]( int32_t proxy, float& distance )
+        {
+            test( _tree.data( proxy ), distance );
+        });
+        return hit.body != 0;
+    }
+
+    uint32_t SceneQuery::overlapSphere( const Sphere& sphere, std::vector< ComponentID >& bodies )
+    {
+        sync();
+        bodies.clear();
+
+        for ( ComponentID id : _unbounded )
+        {
+            if ( testSphere( sphere, id ) ) bodies.push_back( id );
+        }
+
+        const vec3 r( sphere.radius, sphere.radius, sphere.radius );
+        _tree.query( AABB( sphere.center - r, sphere.center + r ), [ & ]( int32_t proxy )
+        {
+            const ComponentID id = _tree.data( proxy );
+            if ( testSphere( sphere, id ) ) bodies.push_back( id );
+            return true;
+        });
+        return uint32_t( bodies.size() );
+    }
+
+    uint32_t SceneQuery::overlapBox( const OBB& box, std::vector< ComponentID >& bodies )
+    {
+        sync();
+        bodies.clear();
+
+        for ( ComponentID id : _unbounded )
+        {
+            if ( testBox( box, id ) ) bodies.push_back( id );
+        }
+
+        _tree.query( algo::obb_to_aabb( box ), [ & ]( int32_t proxy )
+        {
+            const ComponentID id = _tree.data( proxy );
+            if ( testBox( box, id ) ) bodies.push_back( id );
+            return true;
+        });
+        return uint32_t( bodies.size() );
+    }
+
+    void SceneQuery::invalidate()
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _stale = true;
+    }
+
+    void SceneQuery::initialize( const ComponentCacheT< Rigidbody >* rigidbodies )
+    {
+        clear();
+        _rigidbodies = rigidbodies;
+        algo::initializeRayHitFunctionTable();
+    }
+
+    void SceneQuery::clear()
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _tree.clear();
+        _proxies.clear();
+        _unbounded.clear();
+        _rigidbodies = nullptr;
+        _stale = true;
+    }
+
+    void SceneQuery::sync()
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        if ( _rigidbodies == nullptr ) return;
+
+        // bodies move when the simulation steps, and are added, removed or teleported between frames
+        if ( _stale || _tick != ComponentCache::changeTick() || _body_count != _rigidbodies->size() )
+        {
+            refresh();
+        }
+    }
+
+    void SceneQuery::refresh()
+    {
+        const ComponentCacheT< Rigidbody >& bodies = *_rigidbodies;
+        _unbounded.clear();
+        _step += 1;
+
+        for ( uint32_t i = 0; i < bodies.size(); ++i )
+        {
+            const Rigidbody& body = *bodies.at( i );
+            if ( !body.collider ) continue;
+
+            const ComponentID id = bodies.idAt( i );
+            AABB bounds;
+            if ( !body.collider->getBounds( bounds ) )
+            {
+                _unbounded.push_back( id );
+                continue;
+            }
+
+            auto m = _proxies.find( id );
+            if ( m == _proxies.end() )
+            {
+                _proxies.emplace( id, Proxy{ _tree.insert( bounds, id ), _step, body.center } );
+                continue;
+            }
+
+            // sleeping and resting immovable bodies keep their leaf as it is
+            Proxy& proxy = m->second;
+            if ( ( body.is_awake && !body.immovable ) || body.center != proxy.center )
+            {
+                _tree.move( proxy.node, bounds, body.center - proxy.center );
+                proxy.center = body.center;
+            }
+            proxy.step = _step;
+        }
+
+        // bodies that were destroyed or lost their bounded collider since the last refresh
+        for ( auto m = _proxies.begin(); m != _proxies.end(); )
+        {
+            if ( m->second.step != _step )
+            {
+                _tree.remove( m->second.node );
+                m = _proxies.erase( m );
+            }
+            else
+            {
+                ++m;
+            }
+        }
+
+        _tick = ComponentCache::changeTick();
+        _body_count = bodies.size();
+        _stale = false;
+    }
+
+    bool SceneQuery::castRay( const Ray& ray, float max_distance, QueryHit& hit, ComponentID ignore )const
+    {
+        hit.body = 0;
+
+        const float length = magn( ray.direction );
+        if ( length <= 0.f ) return false;
+        const Ray unit( ray.origin, ray.direction / length );
+
+        QueryHit found;
+        for ( ComponentID id : _unbounded )
+        {
+            if ( testRay( unit, max_distance, id, ignore, found ) )
+            {
+                hit = found;
+                max_distance = found.distance;
+            }
+        }
+
+        _tree.raycast( unit, max_distance, [ & ]( int32_t proxy, float& distance )
+        {
+            if ( testRay( unit, distance, _tree.data( proxy ), ignore, found ) )
+            {
+                hit = found;
+                distance = found.distance;
+            }
+        });
+        return hit.body != 0;
+    }
+
+    bool SceneQuery::testRay( const Ray& ray, float max_distance, ComponentID id, ComponentID ignore, QueryHit& hit )const
+    {
+        if ( id == ignore ) return false;
+
+        const Rigidbody* body = _rigidbodies->get( id );
+        if ( body == nullptr || !body->collider ) return false;
+
+        algo::RayHit result;
+        if ( !algo::rayhit( ray, body->collider.ref(), &result ) ) return false;
+        if ( result.distance < 0.f || result.distance > max_distance ) return false;
+
+        hit.body = id;
+        hit.distance = result.distance;
+        hit.point = result.point;
+        return true;
+    }
+
+    bool SceneQuery::testSphereCast( const Sphere& sphere, const vec3& direction, float max_distance, ComponentID id, QueryHit& hit )const
+    {
+        const Rigidbody* body = _rigidbodies->get( id );
+        if ( body == nullptr || !body->collider ) return false;
+        const Collider* collider = body->collider.ref();
+
+        switch ( collider->shape_type )
+        {
+            case RIGID_SHAPE_PLANE:
+            {
+                const Plane* plane = collider->getPlane();
+                const float height = dot( plane->normal, sphere.center ) - plane->distance - sphere.radius;
+                float distance = 0.f;
+                if ( height > 0.f )
+                {
+                    const float speed = dot( plane->normal, direction );
+                    if ( speed >= 0.f ) return false;
+                    distance = height / -speed;
+                    if ( distance > max_distance ) return false;
+                }
+                hit.body = id;
+                hit.distance = distance;
+                const vec3 center = sphere.center + direction * distance;
+                hit.point = center - plane->normal * ( dot( plane->normal, center ) - plane->distance );
+                return true;
+            }
+
+            case RIGID_SHAPE_MESH:
+            {
+                // the sphere is walked toward every triangle its path reaches, like the convex shapes below
+                const ColliderMesh* mesh = static_cast< const ColliderMesh* >( collider );
+                const vec3 start = mesh->toLocal( sphere.center );
+                const vec3 heading = mesh->directionToLocal( direction );
+                const vec3 end = start + heading * max_distance;
+                const vec3 min( fminf( start.x, end.x ), fminf( start.y, end.y ), fminf( start.z, end.z ) );
+                const vec3 max( fmaxf( start.x, end.x ), fmaxf( start.y, end.y ), fmaxf( start.z, end.z ) );
+                const vec3 r( sphere.radius, sphere.radius, sphere.radius );
+
+                float nearest = max_distance;
+                bool found = false;
+                vec3 point;
+                mesh->bvh.query( AABB( min - r, max + r ), [ & ]( uint32_t t )
+                {
+                    const Triangle triangle = mesh->getTriangle( t );
+                    float distance = 0.f;
+                    for ( int i = 0; i < MAX_SWEEP_STEPS && distance <= nearest; ++i )
+                    {
+                        const vec3 center = start + heading * distance;
+                        const vec3 closest = algo::closestPointOnTriangle( triangle, center );
+                        const float length = magn( center - closest );
+                        const float gap = length - sphere.radius;
+                        if ( gap <= sweep_tolerance )
+                        {
+                            nearest = distance;
+                            point = closest;
+                            found = true;
+                            break;
+                        }
+
+                        const float closing = dot( heading, closest - center ) / length;
+                        if ( closing <= 0.f ) break;
+                        distance += gap / closing;
+                    }
+                    return true;
+                });
+
+                if ( !found ) return false;
+                hit.body = id;
+                hit.distance = nearest;
+                hit.point = mesh->toWorld( point );
+                return true;
+            }
+
+            default:
+            {
+                /*
+                 the distance from a point to a convex shape is convex along a line, so a newton step
+                 on it never passes the contact. the sphere moves by its distance to the collider over
+                 the speed it closes in at, until the distance is within sweep_tolerance. a sphere
+                 that stops closing in has passed the collider.
+                 */
+                const ColliderCore core( collider );
+                const float margin = core.shape.margin();
+                float distance = 0.f;
+                for ( int i = 0; i < MAX_SWEEP_STEPS; ++i )
+                {
+                    const vec3 center = sphere.center + direction * distance;
+                    vec3 closest_a, closest_b;
+                    const float cores = algo::gjkDistance( PointSupport( center ), core, closest_a, closest_b );
+                    const float gap = cores - sphere.radius - margin;
+                    if ( gap <= sweep_tolerance )
+                    {
+                        hit.body = id;
+                        hit.distance = distance;
+                        hit.point = ( cores > 0.f ) ? closest_b + ( closest_a - closest_b ) * ( margin / cores ) : center;
+                        return true;
+                    }
+
+                    const float closing = dot( direction, closest_b - closest_a ) / cores;
+                    if ( closing <= 0.f ) return false;
+                    distance += gap / closing;
+                    if ( distance > max_distance ) return false;
+                }
+                return false;
+            }
+        }
+    }
+
+    bool SceneQuery::testSphere( const Sphere& sphere, ComponentID id )const
+    {
+        const Rigidbody* body = _rigidbodies->get( id );
+        if ( body == nullptr || !body->collider ) return false;
+        const Collider* collider = body->collider.ref();
+
+        switch ( collider->shape_type )
+        {
+            case RIGID_SHAPE_PLANE:
+            {
+                const Plane* plane = collider->getPlane();
+                return dot( plane->normal, sphere.center ) - plane->distance <= sphere.radius;
+            }
+
+            case RIGID_SHAPE_MESH:
+            {
+                const ColliderMesh* mesh = static_cast< const ColliderMesh* >( collider );
+                const vec3 center = mesh->toLocal( sphere.center );
+                const vec3 r( sphere.radius, sphere.radius, sphere.radius );
+
+                bool touches = false;
+                mesh->bvh.query( AABB( center - r, center + r ), [ & ]( uint32_t t )
+                {
+                    const vec3 closest = algo::closestPointOnTriangle( mesh->getTriangle( t ), center );
+                    touches = magnSq( center - closest ) <= sphere.radius * sphere.radius;
+                    return !touches;
+                });
+                return touches;
+            }
+
+            default:
+            {
+                const ColliderCore core( collider );
+                vec3 closest_a, closest_b;
+                return algo::gjkDistance( PointSupport( sphere.center ), core, closest_a, closest_b ) <= sphere.radius + core.shape.margin();
+            }
+        }
+    }
+
+    bool SceneQuery::testBox( const OBB& box, ComponentID id )const
+    {
+        const Rigidbody* body = _rigidbodies->get( id );
+        if ( body == nullptr || !body->collider ) return false;
+        const Collider* collider = body->collider.ref();
+
+        switch ( collider->shape_type )
+        {
+            case RIGID_SHAPE_PLANE:
+            {
+                const Plane* plane = collider->getPlane();
+                const float radius =
+                box.extents.x * fabsf( dot( plane->normal, box.axes[0] ) ) +
+                box.extents.y * fabsf( dot( plane->normal, box.axes[1] ) ) +
+                box.extents.z * fabsf( dot( plane->normal, box.axes[2] ) );
+                return dot( plane->normal, box.center ) - plane->distance <= radius;
+            }
+
+            case RIGID_SHAPE_MESH:
+            {
+                const ColliderMesh* mesh = static_cast< const ColliderMesh* >( collider );
+                OBB local;
+                const AABB bounds = toMeshSpace( mesh, box, local );
+
+                bool touches = false;
+                algo::TriangleContact found[ algo::MAX_TRIANGLE_CONTACTS ];
+                mesh->bvh.query( bounds, [ & ]( uint32_t t )
+                {
+                    touches = algo::boxTriangleContacts( algo::getMeshTriangle( *mesh, t ), local, found ) > 0;
+                    return !touches;
+                });
+                return touches;
+            }
+
+            default:
+            {
+                const ColliderCore core( collider );
+                vec3 closest_a, closest_b;
+                return algo::gjkDistance( BoxSupport( box ), core, closest_a, closest_b ) <= core.shape.margin();
+            }
+        }
+    }
+
+    SceneQuery::SceneQuery()
+    :   _rigidbodies( nullptr )
+    ,   _step( 0 )
+    ,   _tick( 0 )
+    ,   _body_count( 0 )
+    ,   _stale( true )
+    {}
+
+}
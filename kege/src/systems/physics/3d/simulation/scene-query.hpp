@@ -0,0 +1,174 @@
+//
+//  scene-query.hpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+
+#ifndef kege_scene_query_hpp
+#define kege_scene_query_hpp
+
+#include <mutex>
+#include <unordered_map>
+#include "../dynamics/rigidbody.hpp"
+#include "../collision/broadphase/dynamic-aabb-tree.hpp"
+#include "../../../../core/ecs/component-cache.hpp"
+
+namespace kege::physics{
+
+    /**
+     * @brief What a scene query hit.
+     */
+    struct QueryHit
+    {
+        /**
+         * the rigidbody that was hit, 0 for none. rigidbodies().owner( body ) is its entity.
+         */
+        ComponentID body;
+
+        /**
+         * how far along the query the hit is, 0 for a query that starts inside the collider.
+         */
+        float distance;
+        vec3 point;
+    };
+
+    /**
+     * @brief One ray of a batched raycast.
+     */
+    struct QueryRay
+    {
+        Ray ray;
+        float max_distance;
+
+        /**
+         * a rigidbody the ray goes through, like the one casting it. 0 ignores none.
+         */
+        ComponentID ignore = 0;
+    };
+
+    /**
+     * @brief Answers raycasts, sweeps and overlap tests against the colliders of the rigidbodies.
+     *
+     * Keeps a DynamicAABBTree of its own over the collider bounds, so a query only tests the
+     * colliders its bounds reach. Colliders without bounds, such as planes, are tested by every
+     * query. The tree is brought up to date by the first query after the bodies could have changed,
+     * once per frame at most, so thousands of queries share the cost.
+     *
+     * Queries may run on many threads at once, but not while the simulation steps. Callers that
+     * run as entity systems should declare that they read Rigidbody.
+     */
+    class SceneQuery
+    {
+    public:
+
+        /**
+         * @brief Finds the nearest collider a ray hits before max_distance.
+         * @param ray The direction does not have to be normalized, distances are in world units.
+         * @param ignore A rigidbody the ray goes through, 0 for none.
+         */
+        bool raycast( const Ray& ray, float max_distance, QueryHit& hit, ComponentID ignore = 0 );
+
+        /**
+         * @brief Finds every collider a ray hits before max_distance.
+         * @param hits Replaced by the hits, nearest first.
+         * @return The number of hits.
+         */
+        uint32_t raycastAll( const Ray& ray, float max_distance, std::vector< QueryHit >& hits, ComponentID ignore = 0 );
+
+        /**
+         * @brief Casts many rays at once, the nearest hit of each.
+         *
+         * @param hits Room for `count` results, a ray that hits nothing gets a body of 0.
+         * @param parallel Splits the rays into batches on the job workers.
+         * @return The number of rays that hit something.
+         */
+        uint32_t raycast( const QueryRay* rays, uint32_t count, QueryHit* hits, bool parallel = true );
+
+        /**
+         * @brief Sweeps a sphere along direction, the nearest collider it touches before max_distance.
+         * The point of the hit is on the collider.
+         */
+        bool sphereCast( const Sphere& sphere, const vec3& direction, float max_distance, QueryHit& hit, ComponentID ignore = 0 );
+
+        /**
+         * @brief Finds the rigidbodies whose colliders touch a sphere.
+         * @param bodies Replaced by the ids of the rigidbodies.
+         * @return The number of rigidbodies.
+         */
+        uint32_t overlapSphere( const Sphere& sphere, std::vector< ComponentID >& bodies );
+
+        /**
+         * @brief Finds the rigidbodies whose colliders touch a box.
+         * @param bodies Replaced by the ids of the rigidbodies.
+         * @return The number of rigidbodies.
+         */
+        uint32_t overlapBox( const OBB& box, std::vector< ComponentID >& bodies );
+
+        /**
+         * @brief Marks the tree as out of date, the simulation calls it after every step.
+         */
+        void invalidate();
+
+        void initialize( const ComponentCacheT< Rigidbody >* rigidbodies );
+        void clear();
+
+        SceneQuery();
+
+    public:
+
+        /**
+         * @brief Sweeps stop once they are closer than this to a collider.
+         */
+        static float sweep_tolerance;
+
+        /**
+         * @brief Batched raycasts split into batches of this many rays.
+         */
+        static uint32_t batch_size;
+
+    private:
+
+        struct Proxy
+        {
+            int32_t node;
+
+            /**
+             * the refresh this proxy was last seen in, proxies of bodies that are gone fall behind.
+             */
+            uint32_t step;
+            vec3 center;
+        };
+
+        /**
+         * brings the tree up to date if the bodies could have changed since the last refresh.
+         */
+        void sync();
+        void refresh();
+
+        bool castRay( const Ray& ray, float max_distance, QueryHit& hit, ComponentID ignore )const;
+        bool testRay( const Ray& ray, float max_distance, ComponentID id, ComponentID ignore, QueryHit& hit )const;
+        bool testSphereCast( const Sphere& sphere, const vec3& direction, float max_distance, ComponentID id, QueryHit& hit )const;
+        bool testSphere( const Sphere& sphere, ComponentID id )const;
+        bool testBox( const OBB& box, ComponentID id )const;
+
+    private:
+
+        const ComponentCacheT< Rigidbody >* _rigidbodies;
+        DynamicAABBTree _tree;
+        std::unordered_map< ComponentID, Proxy > _proxies;
+
+        /**
+         * the rigidbodies with colliders that have no bounds.
+         */
+        std::vector< ComponentID > _unbounded;
+
+        std::mutex _mutex;
+        uint32_t _step;
+        uint32_t _tick;
+        uint32_t _body_count;
+        bool _stale;
+    };
+
+}
+#endif /* kege_scene_query_hpp */
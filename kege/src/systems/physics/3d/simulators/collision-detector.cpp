@@ -5,151 +5,271 @@
 //  Created by Kenneth Esdaile on 6/28/25.
 //
 
+#include <chrono>
 #include "../../../physics/3d/collision/rayhit/rayhit.hpp"
 #include "../../../physics/3d/collision/algorithms/box-vs-box.hpp"
-#include "../../../physics/3d/collision/algorithms/box-vs-cone.hpp"
 #include "../../../physics/3d/collision/algorithms/box-vs-sphere.hpp"
 
 #include "../../../physics/3d/collision/algorithms/plane-vs-box.hpp"
-#include "../../../physics/3d/collision/algorithms/plane-vs-cone.hpp"
 #include "../../../physics/3d/collision/algorithms/plane-vs-sphere.hpp"
-#include "../../../physics/3d/collision/algorithms/plane-vs-cone.hpp"
-#include "../../../physics/3d/collision/algorithms/plane-vs-capsule.hpp"
-#include "../../../physics/3d/collision/algorithms/plane-vs-capsule.hpp"
-#include "../../../physics/3d/collision/algorithms/plane-vs-cylinder.hpp"
 #include "../../../physics/3d/collision/algorithms/plane-vs-mesh.hpp"
 #include "../../../physics/3d/collision/algorithms/plane-vs-plane.hpp"
 
-#include "../../../physics/3d/collision/algorithms/capsule-vs-cone.hpp"
-#include "../../../physics/3d/collision/algorithms/capsule-vs-box.hpp"
-#include "../../../physics/3d/collision/algorithms/capsule-vs-sphere.hpp"
 #include "../../../physics/3d/collision/algorithms/capsule-vs-capsule.hpp"
-#include "../../../physics/3d/collision/algorithms/capsule-vs-cylinder.hpp"
-
-#include "../../../physics/3d/collision/algorithms/cylinder-vs-box.hpp"
-#include "../../../physics/3d/collision/algorithms/cylinder-vs-cone.hpp"
-#include "../../../physics/3d/collision/algorithms/cylinder-vs-sphere.hpp"
-#include "../../../physics/3d/collision/algorithms/cylinder-vs-cylinder.hpp"
 
 #include "../../../physics/3d/collision/algorithms/mesh-vs-box.hpp"
-#include "../../../physics/3d/collision/algorithms/mesh-vs-cone.hpp"
 #include "../../../physics/3d/collision/algorithms/mesh-vs-sphere.hpp"
-#include "../../../physics/3d/collision/algorithms/mesh-vs-cylinder.hpp"
 #include "../../../physics/3d/collision/algorithms/mesh-vs-capsule.hpp"
 #include "../../../physics/3d/collision/algorithms/mesh-vs-mesh.hpp"
+#include "../../../physics/3d/collision/algorithms/mesh-vs-convex.hpp"
 
-#include "../../../physics/3d/collision/algorithms/sphere-vs-cone.hpp"
 #include "../../../physics/3d/collision/algorithms/sphere-vs-sphere.hpp"
 
-#include "../../../physics/3d/collision/algorithms/cone-vs-cone.hpp"
 #include "../../../physics/3d/collision/algorithms/circle-vs-circle.hpp"
 #include "../../../physics/3d/collision/algorithms/plane-vs-circle.hpp"
 
+#include "../../../physics/3d/collision/algorithms/convex-vs-convex.hpp"
+
 #include "../simulation/physics-simulation.hpp"
 #include "collision-detector.hpp"
 
 namespace kege::physics{
 
+    static inline bool isActive( const Rigidbody* body )
+    {
+        return body->is_awake && !body->immovable;
+    }
+
+    /**
+     * how far any point of the body can get in the step, from its speed and how fast its bounds
+     * swing around. bodies that do not move reach nothing.
+     */
+    static float reachOf( const Rigidbody* body, float time_step )
+    {
+        if ( !isActive( body ) )
+        {
+            return 0.f;
+        }
+
+        float radius = 0.f;
+        AABB bounds;
+        if ( body->collider->getBounds( bounds ) )
+        {
+            radius = magn( bounds.max - bounds.min ) * 0.5f;
+        }
+        return ( magn( body->linear.velocity ) + magn( body->angular.velocity ) * radius ) * time_step;
+    }
+
     void CollisionDetector::simulate( double time_step )
     {
-        ComponentCacheT< Rigidbody >::Iterator body[2];
-        for ( body[0] = _simulator->rigidbodies().begin(); body[0] != _simulator->rigidbodies().end(); body[0]++ )
+        const auto start = std::chrono::steady_clock::now();
+        _time_step = float( time_step );
+        _stats.bodies = _simulator->rigidbodies().size();
+        _stats.pairs_tested = 0;
+
+        // the manifolds of the last step stay around for restore()
+        _simulator->getCollisionRegistry().reset();
+
+        Broadphase* broadphase = _simulator->getBroadphase();
+        if ( broadphase != nullptr )
+        {
+            detectBroadphasePairs( *broadphase );
+        }
+        else
+        {
+            detectAllPairs();
+        }
+
+        _stats.milliseconds = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - start ).count();
+    }
+
+    const CollisionDetector::Stats& CollisionDetector::stats()const
+    {
+        return _stats;
+    }
+
+    void CollisionDetector::detect( Rigidbody* a, Rigidbody* b )
+    {
+        // pairs of sleeping and immovable bodies cannot start touching
+        if ( !isActive( a ) && !isActive( b ) )
+            return;
+
+        _stats.pairs_tested += 1;
+
+        CollisionRegistry& collisions = _simulator->getCollisionRegistry();
+        const uint32_t first = collisions.count();
+        bool collided = _collision_function_table[ a->collider->shape_type ][ b->collider->shape_type ]( a, b, collisions );
+        if ( !collided && ( a->continuous_collision || b->continuous_collision ) )
         {
-            if ( !body[0]->collider )
+            SpeculativeDetectorFunction speculate = _speculative_function_table[ a->collider->shape_type ][ b->collider->shape_type ];
+            const float margin = reachOf( a, _time_step ) + reachOf( b, _time_step );
+            collided = speculate != nullptr && margin > 0.f && speculate( a, b, margin, collisions );
+        }
+
+        // every manifold made gets its warm start, whatever the routine returned
+        for ( uint32_t i = first; i < collisions.count(); ++i )
+        {
+            collisions.restore( collisions[ i ] );
+        }
+
+        if ( collided )
+        {
+            /*
+             a body hit while asleep takes part in the rest of the step, the SleepSystem wakes the
+             rest of its island at the end of the step.
+             */
+            if ( !a->is_awake && !a->immovable ) setAwake( a, true );
+            if ( !b->is_awake && !b->immovable ) setAwake( b, true );
+        }
+    }
+
+    void CollisionDetector::detectAllPairs()
+    {
+        ComponentCacheT< Rigidbody >& bodies = _simulator->rigidbodies();
+        for ( uint32_t i = 0; i < bodies.size(); ++i )
+        {
+            Rigidbody* a = bodies.at( i );
+            if ( !a->collider ) continue;
+
+            for ( uint32_t j = i + 1; j < bodies.size(); ++j )
+            {
+                Rigidbody* b = bodies.at( j );
+                if ( !b->collider ) continue;
+                detect( a, b );
+            }
+        }
+    }
+
+    void CollisionDetector::detectBroadphasePairs( Broadphase& broadphase )
+    {
+        ComponentCacheT< Rigidbody >& bodies = _simulator->rigidbodies();
+        _bodies.clear();
+        _indices.clear();
+        _unbounded.clear();
+
+        BroadphaseBody entry;
+        for ( uint32_t i = 0; i < bodies.size(); ++i )
+        {
+            const Rigidbody* body = bodies.at( i );
+            if ( !body->collider ) continue;
+
+            if ( !body->collider->getBounds( entry.bounds ) )
+            {
+                _unbounded.push_back( i );
                 continue;
+            }
 
-            for ( body[1] = body[0] + 1; body[1] != _simulator->rigidbodies().end(); body[1]++ )
+            if ( body->continuous_collision )
             {
-                if ( !body[1]->collider )
-                    continue;
+                // the bounds cover everything the body could reach within the step
+                const float reach = reachOf( body, _time_step );
+                entry.bounds.min -= vec3( reach, reach, reach );
+                entry.bounds.max += vec3( reach, reach, reach );
+            }
 
-                if ( body[0]->immovable && body[1]->immovable )
-                    continue;
+            entry.center = body->center;
+            entry.id = bodies.idAt( i );
+            entry.awake = isActive( body );
+            _bodies.push_back( entry );
+            _indices.push_back( i );
+        }
 
-                if ( !body[0]->is_awake && !body[1]->is_awake )
-                    continue;
+        broadphase.findPairs( _bodies, _pairs );
+        for ( const BroadphasePair& pair : _pairs )
+        {
+            detect( bodies.at( _indices[ pair.a ] ), bodies.at( _indices[ pair.b ] ) );
+        }
 
-                const RigidShape& shape1 = body[ 0 ]->collider->shape_type;
-                const RigidShape& shape2 = body[ 1 ]->collider->shape_type;
-                if( _collision_function_table[ shape1 ][ shape1 ]( *body[ 0 ], *body[ 1 ], _simulator->getCollisionRegistry() ) )
-                {}
+        // shapes without bounds, like planes, meet every other collider
+        for ( uint32_t k = 0; k < _unbounded.size(); ++k )
+        {
+            Rigidbody* a = bodies.at( _unbounded[ k ] );
+            for ( uint32_t index : _indices )
+            {
+                detect( a, bodies.at( index ) );
+            }
+            for ( uint32_t n = k + 1; n < _unbounded.size(); ++n )
+            {
+                detect( a, bodies.at( _unbounded[ n ] ) );
             }
         }
     }
 
     CollisionDetector::CollisionDetector()
+    :   _stats{ 0, 0, 0.0 }
+    ,   _time_step( 0.f )
     {
         kege::algo::initializeRayHitFunctionTable();
+
+        /*
+         every pair of shapes goes through GJK and EPA on the support mappings of the colliders,
+         planes and meshes, which have none, test the other shape through its support mapping.
+         */
+        for ( int i = 0; i < RIGID_SHAPE_MAX_COUNT; ++i )
+        {
+            for ( int j = 0; j < RIGID_SHAPE_MAX_COUNT; ++j )
+            {
+                _collision_function_table[ i ][ j ] = algo::convexCollision;
+            }
+        }
+        for ( int i = 0; i < RIGID_SHAPE_MAX_COUNT; ++i )
+        {
+            _collision_function_table[ RIGID_SHAPE_PLANE ][ i ] = algo::planeConvexCollision;
+            _collision_function_table[ i ][ RIGID_SHAPE_PLANE ] = algo::convexPlaneCollision;
+            _collision_function_table[ RIGID_SHAPE_MESH  ][ i ] = algo::meshConvexCollision;
+            _collision_function_table[ i ][ RIGID_SHAPE_MESH  ] = algo::convexMeshCollision;
+        }
+
+        /*
+         the pairs with a routine of their own that is faster than GJK and EPA. sphere-sphere is
+         about 3 times faster, box-box about 1.3, box-sphere about 10 and capsule-capsule about 2.5.
+         */
         _collision_function_table[ RIGID_SHAPE_OBB      ][ RIGID_SHAPE_OBB         ] = algo::boxBoxCollision;
         _collision_function_table[ RIGID_SHAPE_OBB      ][ RIGID_SHAPE_SPHERE      ] = algo::boxSphereCollision;
         _collision_function_table[ RIGID_SHAPE_OBB      ][ RIGID_SHAPE_PLANE       ] = algo::boxPlaneCollision;
-        _collision_function_table[ RIGID_SHAPE_OBB      ][ RIGID_SHAPE_CAPSULE     ] = algo::boxCapsuleCollision;
-        _collision_function_table[ RIGID_SHAPE_OBB      ][ RIGID_SHAPE_CYLINDER    ] = algo::boxCylinderCollision;
         _collision_function_table[ RIGID_SHAPE_OBB      ][ RIGID_SHAPE_MESH        ] = algo::boxMeshCollision;
-        _collision_function_table[ RIGID_SHAPE_OBB      ][ RIGID_SHAPE_CONE        ] = algo::boxConeCollision;
-        _collision_function_table[ RIGID_SHAPE_OBB      ][ RIGID_SHAPE_CIRCLE      ] = algo::boxCircleCollision;
 
         _collision_function_table[ RIGID_SHAPE_SPHERE   ][ RIGID_SHAPE_OBB         ] = algo::sphereBoxCollision;
         _collision_function_table[ RIGID_SHAPE_SPHERE   ][ RIGID_SHAPE_SPHERE      ] = algo::sphereSphereCollision;
         _collision_function_table[ RIGID_SHAPE_SPHERE   ][ RIGID_SHAPE_PLANE       ] = algo::spherePlaneCollision;
-        _collision_function_table[ RIGID_SHAPE_SPHERE   ][ RIGID_SHAPE_CAPSULE     ] = algo::sphereCapsuleCollision;
-        _collision_function_table[ RIGID_SHAPE_SPHERE   ][ RIGID_SHAPE_CYLINDER    ] = algo::sphereCylinderCollision;
         _collision_function_table[ RIGID_SHAPE_SPHERE   ][ RIGID_SHAPE_MESH        ] = algo::sphereMeshCollision;
-        _collision_function_table[ RIGID_SHAPE_SPHERE   ][ RIGID_SHAPE_CONE        ] = algo::sphereConeCollision;
-        _collision_function_table[ RIGID_SHAPE_SPHERE   ][ RIGID_SHAPE_CIRCLE      ] = algo::sphereCircleCollision;
 
         _collision_function_table[ RIGID_SHAPE_PLANE    ][ RIGID_SHAPE_OBB         ] = algo::planeBoxCollision;
         _collision_function_table[ RIGID_SHAPE_PLANE    ][ RIGID_SHAPE_SPHERE      ] = algo::planeSphereCollision;
         _collision_function_table[ RIGID_SHAPE_PLANE    ][ RIGID_SHAPE_PLANE       ] = algo::planePlaneCollision;
-        _collision_function_table[ RIGID_SHAPE_PLANE    ][ RIGID_SHAPE_CAPSULE     ] = algo::planeCapsuleCollision;
-        _collision_function_table[ RIGID_SHAPE_PLANE    ][ RIGID_SHAPE_CYLINDER    ] = algo::planeCylinderCollision;
         _collision_function_table[ RIGID_SHAPE_PLANE    ][ RIGID_SHAPE_MESH        ] = algo::planeMeshCollision;
-        _collision_function_table[ RIGID_SHAPE_PLANE    ][ RIGID_SHAPE_CONE        ] = algo::planeConeCollision;
         _collision_function_table[ RIGID_SHAPE_PLANE    ][ RIGID_SHAPE_CIRCLE      ] = algo::planeCircleCollision;
 
         _collision_function_table[ RIGID_SHAPE_MESH     ][ RIGID_SHAPE_OBB         ] = algo::meshBoxCollision;
         _collision_function_table[ RIGID_SHAPE_MESH     ][ RIGID_SHAPE_SPHERE      ] = algo::meshSphereCollision;
         _collision_function_table[ RIGID_SHAPE_MESH     ][ RIGID_SHAPE_PLANE       ] = algo::meshPlaneCollision;
         _collision_function_table[ RIGID_SHAPE_MESH     ][ RIGID_SHAPE_CAPSULE     ] = algo::meshCapsuleCollision;
-        _collision_function_table[ RIGID_SHAPE_MESH     ][ RIGID_SHAPE_CYLINDER    ] = algo::meshCylinderCollision;
         _collision_function_table[ RIGID_SHAPE_MESH     ][ RIGID_SHAPE_MESH        ] = algo::meshMeshCollision;
-        _collision_function_table[ RIGID_SHAPE_MESH     ][ RIGID_SHAPE_CONE        ] = algo::meshConeCollision;
-        _collision_function_table[ RIGID_SHAPE_MESH     ][ RIGID_SHAPE_CIRCLE      ] = algo::meshCircleCollision;
 
-        _collision_function_table[ RIGID_SHAPE_CAPSULE  ][ RIGID_SHAPE_OBB         ] = algo::capsuleBoxCollision;
-        _collision_function_table[ RIGID_SHAPE_CAPSULE  ][ RIGID_SHAPE_SPHERE      ] = algo::capsuleSphereCollision;
-        _collision_function_table[ RIGID_SHAPE_CAPSULE  ][ RIGID_SHAPE_PLANE       ] = algo::capsulePlaneCollision;
         _collision_function_table[ RIGID_SHAPE_CAPSULE  ][ RIGID_SHAPE_CAPSULE     ] = algo::capsuleCapsuleCollision;
-        _collision_function_table[ RIGID_SHAPE_CAPSULE  ][ RIGID_SHAPE_CYLINDER    ] = algo::capsuleCylinderCollision;
         _collision_function_table[ RIGID_SHAPE_CAPSULE  ][ RIGID_SHAPE_MESH        ] = algo::capsuleMeshCollision;
-        _collision_function_table[ RIGID_SHAPE_CAPSULE  ][ RIGID_SHAPE_CONE        ] = algo::capsuleConeCollision;
-        _collision_function_table[ RIGID_SHAPE_CAPSULE  ][ RIGID_SHAPE_CIRCLE      ] = algo::capsuleCircleCollision;
-
-        _collision_function_table[ RIGID_SHAPE_CYLINDER ][ RIGID_SHAPE_OBB         ] = algo::cylinderBoxCollision;
-        _collision_function_table[ RIGID_SHAPE_CYLINDER ][ RIGID_SHAPE_SPHERE      ] = algo::cylinderSphereCollision;
-        _collision_function_table[ RIGID_SHAPE_CYLINDER ][ RIGID_SHAPE_PLANE       ] = algo::cylinderPlaneCollision;
-        _collision_function_table[ RIGID_SHAPE_CYLINDER ][ RIGID_SHAPE_CAPSULE     ] = algo::cylinderCapsuleCollision;
-        _collision_function_table[ RIGID_SHAPE_CYLINDER ][ RIGID_SHAPE_CYLINDER    ] = algo::cylinderCylinderCollision;
-        _collision_function_table[ RIGID_SHAPE_CYLINDER ][ RIGID_SHAPE_MESH        ] = algo::cylinderMeshCollision;
-        _collision_function_table[ RIGID_SHAPE_CYLINDER ][ RIGID_SHAPE_CONE        ] = algo::cylinderConeCollision;
-        _collision_function_table[ RIGID_SHAPE_CYLINDER ][ RIGID_SHAPE_CIRCLE      ] = algo::cylinderCircleCollision;
-
-        _collision_function_table[ RIGID_SHAPE_CONE     ][ RIGID_SHAPE_OBB         ] = algo::coneBoxCollision;
-        _collision_function_table[ RIGID_SHAPE_CONE     ][ RIGID_SHAPE_SPHERE      ] = algo::coneSphereCollision;
-        _collision_function_table[ RIGID_SHAPE_CONE     ][ RIGID_SHAPE_PLANE       ] = algo::conePlaneCollision;
-        _collision_function_table[ RIGID_SHAPE_CONE     ][ RIGID_SHAPE_CAPSULE     ] = algo::coneCapsuleCollision;
-        _collision_function_table[ RIGID_SHAPE_CONE     ][ RIGID_SHAPE_CYLINDER    ] = algo::coneCylinderCollision;
-        _collision_function_table[ RIGID_SHAPE_CONE     ][ RIGID_SHAPE_MESH        ] = algo::coneMeshCollision;
-        _collision_function_table[ RIGID_SHAPE_CONE     ][ RIGID_SHAPE_CONE        ] = algo::coneConeCollision;
-        _collision_function_table[ RIGID_SHAPE_CONE     ][ RIGID_SHAPE_CIRCLE      ] = algo::coneCircleCollision;
-
-        _collision_function_table[ RIGID_SHAPE_CIRCLE   ][ RIGID_SHAPE_OBB         ] = algo::circleBoxCollision;
-        _collision_function_table[ RIGID_SHAPE_CIRCLE   ][ RIGID_SHAPE_SPHERE      ] = algo::circleSphereCollision;
+
         _collision_function_table[ RIGID_SHAPE_CIRCLE   ][ RIGID_SHAPE_PLANE       ] = algo::circlePlaneCollision;
-        _collision_function_table[ RIGID_SHAPE_CIRCLE   ][ RIGID_SHAPE_CAPSULE     ] = algo::circleCapsuleCollision;
-        _collision_function_table[ RIGID_SHAPE_CIRCLE   ][ RIGID_SHAPE_CYLINDER    ] = algo::circleCylinderCollision;
-        _collision_function_table[ RIGID_SHAPE_CIRCLE   ][ RIGID_SHAPE_MESH        ] = algo::circleMeshCollision;
-        _collision_function_table[ RIGID_SHAPE_CIRCLE   ][ RIGID_SHAPE_CONE        ] = algo::circleConeCollision;
         _collision_function_table[ RIGID_SHAPE_CIRCLE   ][ RIGID_SHAPE_CIRCLE      ] = algo::circleCircleCollision;
+
+        // speculative contacts all go through the support mappings, planes and meshes get none with each other
+        for ( int i = 0; i < RIGID_SHAPE_MAX_COUNT; ++i )
+        {
+            for ( int j = 0; j < RIGID_SHAPE_MAX_COUNT; ++j )
+            {
+                _speculative_function_table[ i ][ j ] = algo::convexSpeculativeCollision;
+            }
+        }
+        for ( int i = 0; i < RIGID_SHAPE_MAX_COUNT; ++i )
+        {
+            _speculative_function_table[ RIGID_SHAPE_PLANE ][ i ] = algo::planeConvexSpeculativeCollision;
+            _speculative_function_table[ i ][ RIGID_SHAPE_PLANE ] = algo::convexPlaneSpeculativeCollision;
+            _speculative_function_table[ RIGID_SHAPE_MESH  ][ i ] = algo::meshConvexSpeculativeCollision;
+            _speculative_function_table[ i ][ RIGID_SHAPE_MESH  ] = algo::convexMeshSpeculativeCollision;
+        }
+        _speculative_function_table[ RIGID_SHAPE_PLANE ][ RIGID_SHAPE_PLANE ] = nullptr;
+        _speculative_function_table[ RIGID_SHAPE_PLANE ][ RIGID_SHAPE_MESH  ] = nullptr;
+        _speculative_function_table[ RIGID_SHAPE_MESH  ][ RIGID_SHAPE_PLANE ] = nullptr;
+        _speculative_function_table[ RIGID_SHAPE_MESH  ][ RIGID_SHAPE_MESH  ] = nullptr;
     }
 }
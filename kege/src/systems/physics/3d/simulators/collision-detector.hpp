@@ -9,19 +9,80 @@
 #define collision_detector_hpp
 
 #include "../simulators/simulator.hpp"
+#include "../collision/broadphase/broadphase.hpp"
 
 namespace kege::physics{
 
     typedef bool (*CollisionDetectorFunction)( Rigidbody* a, Rigidbody* b, kege::CollisionRegistry& collisions );
+    typedef bool (*SpeculativeDetectorFunction)( Rigidbody* a, Rigidbody* b, float margin, kege::CollisionRegistry& collisions );
 
+    /**
+     * @brief Finds the colliding body pairs and records their contacts.
+     *
+     * The Broadphase of the Simulation first narrows the candidates down to bodies whose bounds
+     * overlap, only those pairs reach the shape specific routines of the collision function table.
+     * Colliders without finite bounds are paired with every body. Without a broadphase every body
+     * is tested against every other body.
+     *
+     * Bodies with Rigidbody::continuous_collision set have their bounds swept over the distance
+     * they can cover in the step. Their pairs that do not touch go through the speculative
+     * function table, which makes contacts with negative depths for shapes that are closer than
+     * that distance, the ContactImpulseSolver then keeps the bodies from closing more than the gap.
+     */
     struct CollisionDetector : public Simulator
     {
     public:
 
+        struct Stats
+        {
+            uint32_t bodies;
+
+            /**
+             * pairs handed to the collision function table.
+             */
+            uint32_t pairs_tested;
+            double milliseconds;
+        };
+
         void simulate( double time_step );
+
+        /**
+         * @brief Gets the numbers of the last simulate() call.
+         */
+        const Stats& stats()const;
+
         CollisionDetector();
 
         CollisionDetectorFunction _collision_function_table[ RIGID_SHAPE_MAX_COUNT ][ RIGID_SHAPE_MAX_COUNT ];
+
+        /**
+         * null for the pairs of shapes that have no speculative routine, planes and meshes with each other.
+         */
+        SpeculativeDetectorFunction _speculative_function_table[ RIGID_SHAPE_MAX_COUNT ][ RIGID_SHAPE_MAX_COUNT ];
+
+    private:
+
+        void detect( Rigidbody* a, Rigidbody* b );
+        void detectAllPairs();
+        void detectBroadphasePairs( Broadphase& broadphase );
+
+    private:
+
+        /**
+         * the bodies handed to the broadphase, their dense rigidbody index, the pairs it found,
+         * and the bodies whose colliders have no finite bounds.
+         */
+        std::vector< BroadphaseBody > _bodies;
+        std::vector< uint32_t > _indices;
+        std::vector< BroadphasePair > _pairs;
+        std::vector< uint32_t > _unbounded;
+
+        Stats _stats;
+
+        /**
+         * the length of the step being detected, speculative margins are the distances bodies cover in it.
+         */
+        float _time_step;
     };
 
 }
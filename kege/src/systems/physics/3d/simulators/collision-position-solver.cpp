@@ -67,7 +67,8 @@ namespace kege::physics{
 
             for (int j = 0; j < collision->contact_count; ++j)
             {
-                correction  = collision->contacts[j].depth / (inv_mass_sum + bias);
+                // speculative contacts have negative depths, there is nothing to push out
+                correction  = fmaxf( collision->contacts[j].depth, 0.f ) / (inv_mass_sum + bias);
                 correction /= float(collision->contact_count);
                 correction *= correction_scale;
                 //correction  = std::min(correction, max_correction);
@@ -116,7 +117,7 @@ namespace kege::physics{
             correction = {0.f, 0.f, 0.f};
             for (int j = 0; j < collision->contact_count; ++j)
             {
-                correction += collision->normal * collision->contacts[j].depth;
+                correction += collision->normal * fmaxf( collision->contacts[j].depth, 0.f );
             }
             correction /= (collision->contact_count != 0) ? float(collision->contact_count): 1.f;
             correction *= correction_scale;
@@ -7,194 +7,370 @@
 
 #include "contact-impulse-solver.hpp"
 #include "../simulation/physics-simulation.hpp"
+#include "../../../../core/task/parallel-for.hpp"
 
 namespace kege::physics{
 
-    void ContactImpulseSolver::resolveImpulse( double time_step, CollisionRegistry& collision_manager )
+    float ContactImpulseSolver::restitution_threshold = 1.0f;
+    float ContactImpulseSolver::baumgarte = 0.05f;
+    float ContactImpulseSolver::penetration_slop = 0.01f;
+    uint32_t ContactImpulseSolver::parallel_threshold = 256;
+
+    /**
+     * the offset of the contact from the body center. immovable bodies and planes do not turn,
+     * their offset is left at zero.
+     */
+    static inline vec3 offsetOf( const Rigidbody* body, const vec3& point )
     {
-        CollisionState state;
-        CollisionManifold* collision;
-        Rigidbody* a;
-        Rigidbody* b;
+        if ( body->immovable || body->collider->shape_type == RIGID_SHAPE_PLANE )
+        {
+            return vec3{0,0,0};
+        }
+        return point - body->center;
+    }
 
-        vec3 impulse;
+    static inline vec3 velocityAt( const Rigidbody* body, const vec3& r )
+    {
+        if ( body->immovable )
+        {
+            return vec3{0,0,0};
+        }
+        return body->linear.velocity + cross( body->angular.velocity, r );
+    }
 
-        for (int k = 0; k < collision_manager.count(); k++)
+    /**
+     * how much the velocity of the body at r changes along dir for a unit impulse along dir.
+     */
+    static inline float inverseMassAlong( const Rigidbody* body, const vec3& r, const vec3& dir )
+    {
+        if ( body->immovable )
         {
-            collision = collision_manager[ k ];
-            a = collision_manager[ k ]->objects[0];
-            b = collision_manager[ k ]->objects[1];
-            setCollisionState( collision, &state );
+            return 0.f;
+        }
+        return float( body->linear.invmass ) + dot( dir, cross( body->angular.inertia_inverse * cross( r, dir ), r ) );
+    }
 
-            if ( state.inv_mass_sum > 0.f )
-            {
-                for (int i = 0; i < collision->contact_count; ++i)
-                {
-                    computeRelativeVelocity( collision->contacts[i], &state );
-                    if ( state.v_dot_n < 0 )
-                    {
-                        impulse = getNormalImpulse( a, b, &state );
-                        impulse /= float( collision->contact_count );
-
-                        if ( !a->immovable )
-                        {
-                            applyLinearImpulse( a, -impulse );
-                            applyAngularImpulse( a, state.relative_position[0], -impulse );
-                        }
-                        if ( !b->immovable )
-                        {
-                            applyLinearImpulse( b, impulse );
-                            applyAngularImpulse( b, state.relative_position[1], impulse );
-                        }
-
-                        impulse = getFrictionImpulse( a, b, &state );
-                        impulse /= float( collision->contact_count );
-
-                        if ( !a->immovable )
-                        {
-                            applyLinearImpulse( a, -impulse );
-                            applyAngularImpulse( a, state.relative_position[0], -impulse );
-                        }
-                        if ( !b->immovable )
-                        {
-                            applyLinearImpulse( b, impulse );
-                            applyAngularImpulse( b, state.relative_position[1], impulse );
-                        }
-                    }
-                }
-            }
+    static inline void applyImpulse( Rigidbody* body, const vec3& r, const vec3& impulse )
+    {
+        if ( !body->immovable )
+        {
+            applyLinearImpulse( body, impulse );
+            applyAngularImpulse( body, r, impulse );
         }
     }
 
-    void ContactImpulseSolver::setCollisionState( CollisionManifold* collision, CollisionState* state )
-    {
-        state->contact_count = collision->contact_count;
-        state->normal = collision->normal;
-        state->immovable[0] = collision->objects[0]->immovable;
-        state->immovable[1] = collision->objects[1]->immovable;
-        state->shape[0] = collision->objects[0]->collider->shape_type;
-        state->shape[1] = collision->objects[1]->collider->shape_type;
-        /**
-         * To maintain stability in the system, it's crucial to store the initial values
-         * of the objects' states (e.g., position, velocity, orientation) before resolving
-         * each contact point. This ensures that all contact points are resolved using the
-         * initial state data, rather than the updated state data that may have changed
-         * after resolving previous contact points.
-         *
-         * If the updated state data is used, it can lead to instabilities in the system,
-         * such as:
-         *
-         *  • Drifting: objects slowly moving away from their intended positions
-         *  • Vibration: objects oscillating or wobbling uncontrollably
-         *  • Gittery motion: objects exhibiting jerky or unpredictable motion
-         *
-         * By using the initial state data, you can ensure a more consistent and stable
-         * resolution of contact points, which is essential for maintaining a realistic
-         * and predictable simulation.
+    static inline float invert( float k )
+    {
+        return ( k > 0.f ) ? 1.f / k : 0.f;
+    }
+
+    /**
+     * the effective masses, tangent basis and target separation speed of the contacts of one
+     * manifold. reads the bodies, writes only the contacts.
+     */
+    static void prepareManifold( CollisionManifold* collision, double time_step )
+    {
+        const Rigidbody* a = collision->objects[0];
+        const Rigidbody* b = collision->objects[1];
+
+        // the combined friction and restitution of the two objects
+        const float friction = sqrtf( a->friction * b->friction );
+        const float restitution = fminf( a->cor, b->cor );
+
+        const vec3 n = collision->normal;
+
+        /*
+         a fixed basis around the normal, so the friction impulses carried over from the
+         previous step still point the same way.
          */
-        state->angular_velocity[0] = collision->objects[0]->angular.velocity;
-        state->linear_velocity[0] = collision->objects[0]->linear.velocity;
-        state->center[0] = collision->objects[0]->center;
+        vec3 t0 = ( fabsf( n.x ) >= 0.57735f ) ? vec3{ n.y, -n.x, 0.f } : vec3{ 0.f, n.z, -n.y };
+        t0 = normalize( t0 );
+        const vec3 t1 = cross( n, t0 );
+
+        for ( uint32_t i = 0; i < collision->contact_count; ++i )
+        {
+            Contact& contact = collision->contacts[ i ];
+            contact.normal = n;
+            contact.friction = friction;
+            contact.restitution = restitution;
+            contact.tangent[0] = t0;
+            contact.tangent[1] = t1;
 
-        state->angular_velocity[1] = collision->objects[1]->angular.velocity;
-        state->linear_velocity[1] = collision->objects[1]->linear.velocity;
-        state->center[1] = collision->objects[1]->center;
+            const vec3& ra = contact.relative_position[0] = offsetOf( a, contact.point );
+            const vec3& rb = contact.relative_position[1] = offsetOf( b, contact.point );
 
-        // compute friction between the two objects
-        state->friction = sqrtf( collision->objects[0]->friction * collision->objects[1]->friction);
-        state->static_friction = 0.75 * state->friction;
+            contact.normal_mass = invert( inverseMassAlong( a, ra, n ) + inverseMassAlong( b, rb, n ) );
+            contact.tangent_mass[0] = invert( inverseMassAlong( a, ra, t0 ) + inverseMassAlong( b, rb, t0 ) );
+            contact.tangent_mass[1] = invert( inverseMassAlong( a, ra, t1 ) + inverseMassAlong( b, rb, t1 ) );
 
-        // compute coefficient of restitution between the two objects
-        state->restitution = fminf( collision->objects[0]->cor, collision->objects[1]->cor);
+            contact.relative_velocity = velocityAt( b, rb ) - velocityAt( a, ra );
+            contact.v_dot_n = dot( contact.relative_velocity, n );
+            /*
+             the speed the contact should separate at. a bounce for fast approaches, and
+             a push that removes a fraction of the penetration beyond the slop every step.
+             */
+            const float bounce = ( contact.v_dot_n < -ContactImpulseSolver::restitution_threshold ) ? -restitution * contact.v_dot_n : 0.f;
+            if ( contact.depth < 0.f )
+            {
+                /*
+                 a speculative contact, the bodies are still apart and may close the gap within the
+                 step but no more. they are let in by half the slop, so the next step still finds
+                 them touching. when they would close the gap they bounce, early by at most the gap,
+                 the way contacts found late bounce from as deep as the bodies got.
+                 */
+                const float gap = ( contact.depth - ContactImpulseSolver::penetration_slop * 0.5f ) / float( time_step );
+                contact.velocity_bias = ( contact.v_dot_n < gap && bounce > 0.f ) ? bounce : gap;
+                continue;
+            }
+            const float push = ContactImpulseSolver::baumgarte * fmaxf( contact.depth - ContactImpulseSolver::penetration_slop, 0.f ) / float( time_step );
+            contact.velocity_bias = fmaxf( bounce, push );
+        }
+    }
+
+    static void warmStartManifold( CollisionManifold* collision )
+    {
+        Rigidbody* a = collision->objects[0];
+        Rigidbody* b = collision->objects[1];
+
+        for ( uint32_t i = 0; i < collision->contact_count; ++i )
+        {
+            const Contact& contact = collision->contacts[ i ];
+            const vec3 impulse =
+            contact.normal * contact.impulse +
+            contact.tangent[0] * contact.tangent_impulse[0] +
+            contact.tangent[1] * contact.tangent_impulse[1];
 
-        // compute the inverse mass sum. immovable object should not contribute
-        state->inv_mass_sum = 0;
-        if ( !collision->objects[0]->immovable ) state->inv_mass_sum += collision->objects[0]->linear.invmass;
-        if ( !collision->objects[1]->immovable ) state->inv_mass_sum += collision->objects[1]->linear.invmass;
-        //if ( !collision->objects[0]->immovable ) setAwake( collision->objects[0], true );
-        //if ( !collision->objects[1]->immovable ) setAwake( collision->objects[1], true );
+            applyImpulse( a, contact.relative_position[0], -impulse );
+            applyImpulse( b, contact.relative_position[1], impulse );
+        }
     }
 
-    void ContactImpulseSolver::computeRelativeVelocity( const Contact& contact, CollisionState* state )
+    static void solveManifold( CollisionManifold* collision )
     {
-        state->relative_position[0] = vec3{0,0,0};
-        state->relative_position[1] = vec3{0,0,0};
-        vec3 v[2], p[2];
-        v[0] = vec3{0,0,0};
-        v[1] = vec3{0,0,0};
+        Rigidbody* a = collision->objects[0];
+        Rigidbody* b = collision->objects[1];
 
-        if ( !state->immovable[0] )
+        for ( uint32_t i = 0; i < collision->contact_count; ++i )
         {
-            v[0] = state->linear_velocity[0];
+            Contact& contact = collision->contacts[ i ];
+            const vec3& ra = contact.relative_position[0];
+            const vec3& rb = contact.relative_position[1];
+
+            /*
+             friction first, bounded by the normal impulse accumulated so far. each tangent
+             is clamped on its own, a box approximation of the friction cone.
+             */
+            const float max_friction = contact.friction * contact.impulse;
+            for (int t = 0; t < 2; ++t)
+            {
+                const vec3 dv = velocityAt( b, rb ) - velocityAt( a, ra );
+                float lambda = -dot( dv, contact.tangent[ t ] ) * contact.tangent_mass[ t ];
+
+                const float total = clamp( contact.tangent_impulse[ t ] + lambda, -max_friction, max_friction );
+                lambda = total - contact.tangent_impulse[ t ];
+                contact.tangent_impulse[ t ] = total;
+
+                const vec3 impulse = contact.tangent[ t ] * lambda;
+                applyImpulse( a, ra, -impulse );
+                applyImpulse( b, rb, impulse );
+            }
 
-            if ( state->shape[0] != RIGID_SHAPE_PLANE )
-                state->relative_position[0] = contact.point - state->center[0];
+            // the normal impulse, the accumulated total may only push the bodies apart
+            const vec3 dv = velocityAt( b, rb ) - velocityAt( a, ra );
+            float lambda = -( dot( dv, contact.normal ) - contact.velocity_bias ) * contact.normal_mass;
+
+            const float total = fmaxf( contact.impulse + lambda, 0.f );
+            lambda = total - contact.impulse;
+            contact.impulse = total;
+
+            const vec3 impulse = contact.normal * lambda;
+            applyImpulse( a, ra, -impulse );
+            applyImpulse( b, rb, impulse );
         }
+    }
 
-        if ( !state->immovable[1] )
+    void ContactImpulseSolver::simulate( double dms )
+    {
+        CollisionRegistry& collisions = _simulator->getCollisionRegistry();
+        if ( _parallel && collisions.count() >= parallel_threshold )
         {
-            v[1] = state->linear_velocity[1];
+            color( collisions );
+            solveInBatches( collisions, dms );
+            return;
+        }
 
-            if ( state->shape[1] != RIGID_SHAPE_PLANE )
-                state->relative_position[1] = contact.point - state->center[1];
+        prepare( collisions, dms );
+        if ( _warm_starting )
+        {
+            warmStart( collisions );
         }
 
-        p[0] = v[0] + cross( state->angular_velocity[0], state->relative_position[0] );
-        p[1] = v[1] + cross( state->angular_velocity[1], state->relative_position[1] );
-        state->relative_velocity = p[1] - p[0];
+        for ( uint32_t i = 0; i < _update_iterations; i++ )
+        {
+            solve( collisions );
+        }
+    }
+
+    void ContactImpulseSolver::setIterations( uint32_t iterations )
+    {
+        _update_iterations = iterations;
+    }
+
+    uint32_t ContactImpulseSolver::getIterations()const
+    {
+        return _update_iterations;
+    }
 
-        state->v_dot_n = dot(state->relative_velocity, state->normal);
+    void ContactImpulseSolver::setWarmStarting( bool enable )
+    {
+        _warm_starting = enable;
+    }
+
+    bool ContactImpulseSolver::getWarmStarting()const
+    {
+        return _warm_starting;
     }
 
-    vec3 ContactImpulseSolver::getNormalImpulse( Rigidbody* a, Rigidbody* b, CollisionState* state )
+    void ContactImpulseSolver::setParallel( bool enable )
     {
-        float numerator = -(1.0f + state->restitution) * state->v_dot_n;
-        vec3 p0 = cross( a->angular.inertia_inverse * cross( state->relative_position[0], state->normal), state->relative_position[0] );
-        vec3 p1 = cross( b->angular.inertia_inverse * cross( state->relative_position[1], state->normal), state->relative_position[1] );
-        float denominator = state->inv_mass_sum + dot( state->normal, p0 + p1);
-        state->j = (CMP(denominator, 0.0f)) ? 0.0f : (numerator / denominator);
-        return state->j * state->normal;
+        _parallel = enable;
     }
 
-    vec3 ContactImpulseSolver::getFrictionImpulse( Rigidbody* a, Rigidbody* b, CollisionState* state )
+    bool ContactImpulseSolver::getParallel()const
     {
-        kege::vec3 tangent = state->relative_velocity - (state->normal * state->v_dot_n);
-        float tangent_speed = magn( tangent );
-        if (tangent_speed < 1e-4) return vec3{0,0,0};
+        return _parallel;
+    }
 
-        float static_threshold = state->j * state->static_friction;
+    uint32_t ContactImpulseSolver::getColorCount()const
+    {
+        return _color_count;
+    }
 
-        // Check for static vs. kinetic friction
-        if (tangent_speed < static_threshold)
+    void ContactImpulseSolver::prepare( CollisionRegistry& collisions, double time_step )
+    {
+        for ( uint32_t k = 0; k < collisions.count(); k++ )
         {
-            // Apply full static friction to zero out tangent speed
-            return -tangent;
+            prepareManifold( collisions[ k ], time_step );
         }
-        else // kinetic friction
+    }
+
+    void ContactImpulseSolver::warmStart( CollisionRegistry& collisions )
+    {
+        for ( uint32_t k = 0; k < collisions.count(); k++ )
         {
-            tangent = tangent / tangent_speed; // normalize tangent
-            float numerator = -dot( state->relative_velocity, tangent);
-            vec3 p0 = cross( a->angular.inertia_inverse * cross( state->relative_position[0], tangent), state->relative_position[0] );
-            vec3 p1 = cross( a->angular.inertia_inverse * cross( state->relative_position[1], tangent), state->relative_position[1] );
-            float denominator = state->inv_mass_sum + dot(tangent, p0 + p1);
-            float jt = (CMP(denominator, 0.0f)) ? 0.0f : numerator / denominator;
-            
-            jt = clamp(jt, -state->j * state->friction, state->j * state->friction);
+            warmStartManifold( collisions[ k ] );
+        }
+    }
 
-            // the friction impulse
-            return tangent * jt;
+    void ContactImpulseSolver::solve( CollisionRegistry& collisions )
+    {
+        for ( uint32_t k = 0; k < collisions.count(); k++ )
+        {
+            solveManifold( collisions[ k ] );
         }
     }
 
-    void ContactImpulseSolver::simulate( double dms )
+    void ContactImpulseSolver::color( CollisionRegistry& collisions )
+    {
+        ComponentCacheT< Rigidbody >& bodies = _simulator->rigidbodies();
+        const Rigidbody* first = bodies.data();
+        const uint32_t count = collisions.count();
+
+        /*
+         greedy coloring in registry order, every manifold takes the lowest color neither of its
+         bodies has yet. immovable bodies are never written, they do not take colors. manifolds
+         whose bodies have used up every color go to the last batch, which runs on one thread.
+         */
+        _body_colors.assign( bodies.size(), 0 );
+        _colors.resize( count );
+        uint32_t sizes[ MAX_COLORS + 1 ] = {};
+        _color_count = 0;
+        for ( uint32_t k = 0; k < count; ++k )
+        {
+            const Rigidbody* a = collisions[ k ]->objects[0];
+            const Rigidbody* b = collisions[ k ]->objects[1];
+            uint64_t* a_colors = a->immovable ? nullptr : &_body_colors[ a - first ];
+            uint64_t* b_colors = b->immovable ? nullptr : &_body_colors[ b - first ];
+
+            const uint64_t used = ( a_colors ? *a_colors : 0 ) | ( b_colors ? *b_colors : 0 );
+            uint32_t c = 0;
+            while ( c < MAX_COLORS && ( used & ( uint64_t( 1 ) << c ) ) ) ++c;
+
+            if ( c < MAX_COLORS )
+            {
+                if ( a_colors ) *a_colors |= uint64_t( 1 ) << c;
+                if ( b_colors ) *b_colors |= uint64_t( 1 ) << c;
+                _color_count = std::max( _color_count, c + 1 );
+            }
+            _colors[ k ] = c;
+            sizes[ c ] += 1;
+        }
+
+        // sort the manifolds by color, keeping registry order within a color
+        _batch_offsets[ 0 ] = 0;
+        for ( uint32_t c = 0; c <= MAX_COLORS; ++c )
+        {
+            _batch_offsets[ c + 1 ] = _batch_offsets[ c ] + sizes[ c ];
+        }
+
+        uint32_t cursor[ MAX_COLORS + 1 ];
+        std::copy( _batch_offsets, _batch_offsets + MAX_COLORS + 1, cursor );
+        _batches.resize( count );
+        for ( uint32_t k = 0; k < count; ++k )
+        {
+            _batches[ cursor[ _colors[ k ] ]++ ] = k;
+        }
+    }
+
+    void ContactImpulseSolver::solveInBatches( CollisionRegistry& collisions, double time_step )
     {
-        for (int i = 0; i < _update_iterations; i++)
+        // preparing writes only the contacts, every manifold can go at once
+        kege::parallelFor( 0, collisions.count(), [ &collisions, time_step ]( uint32_t first, uint32_t last )
+        {
+            for ( uint32_t k = first; k < last; ++k )
+            {
+                prepareManifold( collisions[ k ], time_step );
+            }
+        });
+
+        /*
+         the manifolds of one color share no movable body, so a batch gives the same result on
+         any number of threads. the batches run one after another in color order.
+         */
+        auto each_batch = [ this, &collisions ]( void (*func)( CollisionManifold* ) )
+        {
+            for ( uint32_t c = 0; c < _color_count; ++c )
+            {
+                kege::parallelFor( _batch_offsets[ c ], _batch_offsets[ c + 1 ], [ this, &collisions, func ]( uint32_t first, uint32_t last )
+                {
+                    for ( uint32_t i = first; i < last; ++i )
+                    {
+                        func( collisions[ _batches[ i ] ] );
+                    }
+                });
+            }
+
+            for ( uint32_t i = _batch_offsets[ MAX_COLORS ]; i < _batch_offsets[ MAX_COLORS + 1 ]; ++i )
+            {
+                func( collisions[ _batches[ i ] ] );
+            }
+        };
+
+        if ( _warm_starting )
+        {
+            each_batch( warmStartManifold );
+        }
+
+        for ( uint32_t i = 0; i < _update_iterations; i++ )
         {
-            resolveImpulse( dms, _simulator->getCollisionRegistry() );
+            each_batch( solveManifold );
         }
     }
 
     ContactImpulseSolver::ContactImpulseSolver()
     :   _update_iterations( 8 )
+    ,   _color_count( 0 )
+    ,   _warm_starting( true )
+    ,   _parallel( false )
     {}
 }
@@ -12,47 +12,103 @@
 
 namespace kege::physics{
 
-    struct CollisionState
-    {
-        vec3 relative_velocity;
-        vec3 normal;
-        vec3 angular_velocity[2];
-        vec3 linear_velocity[2];
-        vec3 center[2];
-        vec3 relative_position[2];
-
-        RigidShape shape[2];
-        bool immovable[2];
-
-        float static_friction;
-        float friction;
-        float inv_mass_sum;
-        float restitution;
-        float v_dot_n;
-        float j;
-
-        uint32_t contact_count;
-    };
-
+    /**
+     * @brief Resolves contact velocities with sequential impulses.
+     *
+     * Every iteration visits each contact in turn and applies the change of impulse that stops
+     * it from approaching along the normal, and sliding within the friction cone, given the
+     * velocities left by the contacts before it. The impulses are accumulated per contact and
+     * clamped as totals, the normal impulse never pulls and the friction impulse never exceeds
+     * friction times the normal impulse. The totals of the previous step are applied up front
+     * (warm starting), resting contacts start from their answer instead of zero and stacks
+     * settle in few iterations.
+     *
+     * In parallel mode the manifolds are colored so that no two manifolds of a color share a
+     * movable body, and each color is solved as one batch on the job workers. The contacts are
+     * visited in color order instead of registry order, the result does not depend on the number
+     * of threads. Parallel mode is opt-in, turn it on with Simulation::setParallelContacts() or
+     * setParallel() on a solver added by hand.
+     */
     class ContactImpulseSolver : public Simulator
     {
     public:
 
-        void resolveImpulse( double time_step, CollisionRegistry& collision_manager );
+        void simulate( double dms )override;
+
+        /**
+         * @brief Sets the number of passes over the contacts per simulate() call.
+         */
+        void setIterations( uint32_t iterations );
+        uint32_t getIterations()const;
 
-        void setCollisionState( CollisionManifold* collision, CollisionState* state );
+        void setWarmStarting( bool enable );
+        bool getWarmStarting()const;
 
-        void computeRelativeVelocity( const Contact& contact, CollisionState* state );
-        vec3 getFrictionImpulse( Rigidbody* a, Rigidbody* b, CollisionState* state );
-        vec3 getNormalImpulse( Rigidbody* a, Rigidbody* b, CollisionState* state );
+        /**
+         * @brief Solves the manifolds in colored batches on the job workers. Steps with fewer
+         * than parallel_threshold manifolds still run on the calling thread. Off by default.
+         */
+        void setParallel( bool enable );
+        bool getParallel()const;
 
-        void simulate( double dms )override;
+        /**
+         * @brief Gets the number of colors the manifolds of the last parallel step took.
+         */
+        uint32_t getColorCount()const;
 
         ContactImpulseSolver();
 
+    private:
+
+        void prepare( CollisionRegistry& collisions, double time_step );
+        void warmStart( CollisionRegistry& collisions );
+        void solve( CollisionRegistry& collisions );
+
+        void color( CollisionRegistry& collisions );
+        void solveInBatches( CollisionRegistry& collisions, double time_step );
+
     public:
 
+        /**
+         * @brief Approach speeds below this do not bounce, restitution on resting contacts only adds jitter.
+         */
+        static float restitution_threshold;
+
+        /**
+         * @brief The fraction of the penetration beyond penetration_slop the solver pushes out per step.
+         */
+        static float baumgarte;
+        static float penetration_slop;
+
+        /**
+         * @brief The fewest manifolds a step needs before parallel mode hands it to the workers.
+         */
+        static uint32_t parallel_threshold;
+
+    private:
+
+        /**
+         * the colors a body can take, one bit each in a uint64_t.
+         */
+        enum{ MAX_COLORS = 64 };
+
+        /**
+         * per body, the colors its manifolds took. per manifold, its color.
+         */
+        std::vector< uint64_t > _body_colors;
+        std::vector< uint32_t > _colors;
+
+        /**
+         * the manifold indices sorted by color, color c spans [_batch_offsets[c], _batch_offsets[c + 1]).
+         * the batch at MAX_COLORS holds the manifolds that found no color.
+         */
+        std::vector< uint32_t > _batches;
+        uint32_t _batch_offsets[ MAX_COLORS + 2 ];
+
         uint32_t _update_iterations;
+        uint32_t _color_count;
+        bool _warm_starting;
+        bool _parallel;
     };
 }
 #endif /* kege_contact_impulse_solver_hpp */
@@ -28,7 +28,7 @@ namespace kege::physics{
 
             for (ComponentCacheT< Rigidbody >::Iterator body = _simulator->rigidbodies().begin(); body != _simulator->rigidbodies().end(); body++ )
             {
-                if ( !body->immovable )
+                if ( !body->immovable && body->is_awake )
                 {
                     force->apply( dms, *body );
                 }
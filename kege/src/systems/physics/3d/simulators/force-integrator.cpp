@@ -7,81 +7,41 @@
 
 #include "force-integrator.hpp"
 #include "../simulation/physics-simulation.hpp"
+#include "../simulation/body-kernels.hpp"
+#include "../../../../core/task/parallel-for.hpp"
 
 namespace kege::physics{
 
     void ForceIntegrator::simulate( double time_step )
     {
-        for (ComponentCacheT< Rigidbody >::Iterator body = _simulator->rigidbodies().begin(); body != _simulator->rigidbodies().end(); body++ )
+        /*
+         the motion state goes through the simulation's BodyArrays, where the kernel integrates
+         a vector of bodies per instruction. batches are whole vectors so no two workers share one.
+         */
+        ComponentCacheT< Rigidbody >& bodies = _simulator->rigidbodies();
+        BodyArrays& arrays = _simulator->bodyArrays();
+        arrays.gather( bodies );
+
+        const float h = float( time_step );
+        const uint32_t grain = ( std::max( ParallelFor::grain, 1u ) + BodyArrays::LANES - 1 ) / BodyArrays::LANES * BodyArrays::LANES;
+        kege::parallelFor( 0, arrays.stride(), grain, [ &arrays, h ]( uint32_t first, uint32_t last )
         {
-            if ( body->sleepable )
-            {
-                if ( !body->is_awake )
-                {
-                    return;
-                };
-            }
+            integrateBodies( arrays, first, last, h );
+        });
+        arrays.scatter( bodies );
 
-            if ( !body->immovable )
+        // every body only touches its own collider
+        kege::parallelFor( 0, bodies.size(), [ &bodies ]( uint32_t first, uint32_t last )
+        {
+            for ( uint32_t i = first; i < last; ++i )
             {
-                /**
-                 * compute the Linear Acceleration by integrating the forces acting on the object
-                 */
-                body->linear.acceleration = body->linear.forces * body->linear.invmass;
-
-                /**
-                 * update the linear velocity by acceleration
-                 */
-                body->linear.velocity += body->linear.acceleration * time_step;
-                zeroSmallComponents( body->linear.velocity, 1e-4f );
-
-                /**
-                 * update the objects position
-                 */
-                body->prev = body->center;
-                body->center += body->linear.velocity * time_step;
-
-                /**
-                 * Angular acceleration is not directly the amount of rotation, it represents the
-                 * rate of change of angular velocity. Angular Acceleration tells you how much the
-                 * angular velocity changes.
-                 */
-                kege::vec3 acceleration = body->angular.torques * body->angular.inertia_inverse;
-
-                /**
-                 * Angular velocity is then used to determine how much the object rotates during
-                 * the current time step. This is what is used to update the orientation. Here,
-                 * the (angular_velocity_step) is the amount of rotation that happens during this
-                 * small time interval.
-                 */
-                body->angular.velocity += time_step * acceleration;
-                zeroSmallComponents( body->angular.velocity, 1e-4f );
-
-                /**
-                 * The angle of rotation is the magnitude of the angular velocity vector multiplied
-                 * by the time step. Compute the magnitude (the amount of rotation for this step)
-                 */
-                float angle = magnSq( body->angular.velocity );
-
-                if (angle > 1e-4f)
+                Rigidbody& body = *bodies.at( i );
+                if ( body.is_awake && body.collider )
                 {
-                    angle = time_step * sqrt( angle );
-                    kege::quat angular_change = kege::quat( angle, body->angular.velocity / angle );
-
-                    /**
-                     * The orientation (quaternion) is updated based on how much the object rotates
-                     * in the current time step:
-                     */
-                    body->orientation += angular_change * body->orientation * 0.5f;
-                    body->orientation = kege::normalize( body->orientation );
+                    body.collider->integrate( &body );
                 }
             }
-
-            if ( body->collider )
-            {
-                body->collider->integrate( *body );
-            }
-        }
+        });
     }
 
 }
@@ -24,6 +24,8 @@ namespace kege::physics{
 
             for (int j = 0; j < collision->contact_count; ++j)
             {
+                // speculative contacts are not touching yet
+                if ( collision->contacts[j].depth < 0.f ) continue;
                 if ( !a->immovable ) testGrounded( a, b, collision->contacts[j].point );
                 if ( !b->immovable ) testGrounded( b, a, collision->contacts[j].point );
             }
@@ -7,16 +7,35 @@
 
 #include "motion-dampener.hpp"
 #include "../simulation/physics-simulation.hpp"
+#include "../simulation/body-kernels.hpp"
+#include "../../../../core/task/parallel-for.hpp"
 
 namespace kege::physics{
 
     void MotionDampener::simulate( double dms )
     {
-        for (ComponentCacheT< Rigidbody >::Iterator body = _simulator->rigidbodies().begin(); body != _simulator->rigidbodies().end(); body++ )
+        /*
+         the damping factors are applied in the BodyArrays, the ForceIntegrator filled the other
+         fields this step, only the velocities the solvers changed since are copied in again.
+         */
+        ComponentCacheT< Rigidbody >& bodies = _simulator->rigidbodies();
+        BodyArrays& arrays = _simulator->bodyArrays();
+        if ( arrays.size() == bodies.size() )
         {
-            body->angular.velocity *= pow( body->angular.damping, dms );
-            body->linear.velocity *= pow( body->linear.damping, dms );
+            arrays.gatherVelocities( bodies );
         }
+        else
+        {
+            arrays.gather( bodies );
+        }
+
+        const float h = float( dms );
+        const uint32_t grain = ( std::max( ParallelFor::grain, 1u ) + BodyArrays::LANES - 1 ) / BodyArrays::LANES * BodyArrays::LANES;
+        kege::parallelFor( 0, arrays.stride(), grain, [ &arrays, h ]( uint32_t first, uint32_t last )
+        {
+            dampenBodies( arrays, first, last, h );
+        });
+        arrays.scatterVelocities( bodies );
     }
 
 }
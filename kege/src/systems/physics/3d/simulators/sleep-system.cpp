@@ -5,82 +5,187 @@
 //  Created by Kenneth Esdaile on 3/20/25.
 //
 
+#include <algorithm>
 #include "sleep-system.hpp"
+#include "../simulation/physics-simulation.hpp"
 
-// namespace kege{
-
-//     void SleepSystem::operator()( const WakeSleepableObjects& )
-//     {
-//         _wake_sleepable_objects = true;
-//     }
-
-//     void SleepSystem::update( double dms )
-//     {
-//         if ( !_entities ) return;
-
-//         kege::Rigidbody* body;
-//         for ( kege::Entity& entity : *_entities )
-//         {
-//             body = entity.get< kege::Rigidbody >();
-//             if ( body->immovable )
-//             {
-//                 continue;
-//             }
-
-//             zeroSmallComponents( body->angular.velocity );
-//             zeroSmallComponents( body->linear.velocity );
-//             if ( body->sleepable )
-//             {
-//                 if ( _wake_sleepable_objects )
-//                 {
-//                     body->frames_since_move = 0;
-//                     body->is_awake = true;
-//                 }
-                
-//                 // Calculate body as a combination of linear and angular velocities
-//                 float current_motion = magnSq( body->linear.velocity ) + magnSq( body->angular.velocity );
-
-//                 // Use a bias to smoothly transition the body value
-//                 body->body = _sleep_motion_bias * body->body + (1.0f - _sleep_motion_bias) * current_motion;
-
-//                 //float mag = magn( body->linear.velocity );
-//                 // Check if the body should be put to sleep // Only sleep after inactivity for N frames
-//                 if ( body->body < _sleep_threshold && body->frames_since_move > 16 )
-//                 //if ( mag < 1.76 && body->frames_since_move > 16 )
-//                 {
-//                     std::cout << "object->setAwake( false )\n";
-//                     //object->setAwake( false );
-//                     body->is_awake = false;
-//                     body->linear.velocity = {0.f,0.f,0.f};
-//                     body->angular.velocity = {0.f,0.f,0.f};
-//                 }
-//                 else
-//                 {
-//                     body->frames_since_move++;
-//                 }
-//             }
-//         }
-//         _wake_sleepable_objects = false;
-//     }
-
-//     bool SleepSystem::initialize()
-//     {
-//         _signature = kege::createEntitySignature< kege::Rigidbody, kege::Transform >();
-//         _comm.add< const WakeSleepableObjects&, SleepSystem>( this );
-//         return EntitySystem::initialize();
-//     }
-
-//     void SleepSystem::shutdown()
-//     {
-//         _comm.remove< const WakeSleepableObjects&, SleepSystem>( this );
-//         return EntitySystem::shutdown();
-//     }
-
-//     SleepSystem::SleepSystem( kege::Engine* engine )
-//     :   kege::EntitySystem( manager, "sleep-system", REQUIRE_UPDATE )
-//     ,   _sleep_threshold( 0.0005 )
-//     ,   _sleep_motion_bias( 0.98f )
-//     ,   _wake_sleepable_objects( false )
-//     {}
-
-// }
+namespace kege::physics{
+
+    float SleepSystem::sleep_threshold = 0.0025f;
+    float SleepSystem::motion_bias = 0.9f;
+    float SleepSystem::frames_to_sleep = 30.f;
+
+    void SleepSystem::simulate( double dms )
+    {
+        ComponentCacheT< Rigidbody >& bodies = _simulator->rigidbodies();
+        CollisionRegistry& collisions = _simulator->getCollisionRegistry();
+        Rigidbody* first = bodies.data();
+        const uint32_t count = bodies.size();
+
+        releaseDestroyed();
+
+        _parent.resize( count );
+        for ( uint32_t i = 0; i < count; ++i )
+        {
+            _parent[ i ] = i;
+
+            // woken from outside, by setAwake() or by a contact in the CollisionDetector
+            Rigidbody& body = first[ i ];
+            if ( body.is_awake && body.island != 0 )
+            {
+                wakeIsland( body.island );
+            }
+        }
+
+        for ( uint32_t i = 0; i < collisions.count(); ++i )
+        {
+            const CollisionManifold* manifold = collisions[ i ];
+            Rigidbody* a = manifold->objects[ 0 ];
+            Rigidbody* b = manifold->objects[ 1 ];
+            if ( a->immovable || b->immovable ) continue;
+
+            if ( !a->is_awake && a->island != 0 ) wakeIsland( a->island );
+            if ( !b->is_awake && b->island != 0 ) wakeIsland( b->island );
+            unite( uint32_t( a - first ), uint32_t( b - first ) );
+        }
+
+        /*
+         the linear speed comes from how far the body moved in the last substep. a resting body
+         leaves the solver with the velocity that cancels the gravity of the next substep, its
+         velocity is never zero but it does not move.
+
+         the speed is smoothed over a few steps, a body that passes through rest for one step,
+         like at the top of a bounce, does not count as resting.
+         */
+        const float substeps_per_second = float( double( _simulator->getIterations() ) / dms );
+        for ( uint32_t i = 0; i < count; ++i )
+        {
+            Rigidbody& body = first[ i ];
+            if ( body.immovable || !body.is_awake ) continue;
+
+            const vec3 velocity = ( body.center - body.prev ) * substeps_per_second;
+            const float motion = magnSq( velocity ) + magnSq( body.angular.velocity );
+            body.body = motion_bias * body.body + ( 1.f - motion_bias ) * motion;
+            if ( body.sleepable && body.body < sleep_threshold )
+            {
+                body.frames_since_move += 1.f;
+            }
+            else
+            {
+                body.frames_since_move = 0.f;
+            }
+        }
+
+        // an island is as restless as its most restless body
+        _rest.assign( count, frames_to_sleep );
+        _slot.assign( count, NONE );
+        _island_count = 0;
+        for ( uint32_t i = 0; i < count; ++i )
+        {
+            const Rigidbody& body = first[ i ];
+            if ( body.immovable || !body.is_awake ) continue;
+
+            const uint32_t root = find( i );
+            if ( root == i ) _island_count += 1;
+            _rest[ root ] = fminf( _rest[ root ], body.frames_since_move );
+        }
+
+        for ( uint32_t i = 0; i < count; ++i )
+        {
+            Rigidbody& body = first[ i ];
+            if ( body.immovable || !body.is_awake ) continue;
+
+            const uint32_t root = find( i );
+            if ( _rest[ root ] < frames_to_sleep ) continue;
+
+            uint32_t& slot = _slot[ root ];
+            if ( slot == NONE )
+            {
+                if ( _free_islands.empty() )
+                {
+                    _islands.emplace_back();
+                    slot = uint32_t( _islands.size() - 1 );
+                }
+                else
+                {
+                    slot = _free_islands.back();
+                    _free_islands.pop_back();
+                }
+            }
+
+            _islands[ slot ].push_back( bodies.idAt( i ) );
+            body.island = slot + 1;
+            setAwake( &body, false );
+        }
+    }
+
+    uint32_t SleepSystem::islandCount()const
+    {
+        return _island_count;
+    }
+
+    uint32_t SleepSystem::sleepingIslandCount()const
+    {
+        return uint32_t( _islands.size() - _free_islands.size() );
+    }
+
+    uint32_t SleepSystem::find( uint32_t i )
+    {
+        while ( _parent[ i ] != i )
+        {
+            _parent[ i ] = _parent[ _parent[ i ] ];
+            i = _parent[ i ];
+        }
+        return i;
+    }
+
+    void SleepSystem::unite( uint32_t a, uint32_t b )
+    {
+        a = find( a );
+        b = find( b );
+        if ( a != b )
+        {
+            _parent[ b ] = a;
+        }
+    }
+
+    void SleepSystem::wakeIsland( uint32_t island )
+    {
+        ComponentCacheT< Rigidbody >& bodies = _simulator->rigidbodies();
+        std::vector< ComponentID >& members = _islands[ island - 1 ];
+        for ( ComponentID id : members )
+        {
+            // bodies destroyed while asleep leave stale ids behind
+            Rigidbody* body = bodies.get( id );
+            if ( body == nullptr || body->island != island ) continue;
+
+            body->island = 0;
+            body->frames_since_move = 0.f;
+            setAwake( body, true );
+            body->body = 2.f * sleep_threshold;
+        }
+        members.clear();
+        _free_islands.push_back( island - 1 );
+    }
+
+    void SleepSystem::releaseDestroyed()
+    {
+        const ComponentCacheT< Rigidbody >& bodies = _simulator->rigidbodies();
+        for ( uint32_t slot = 0; slot < _islands.size(); ++slot )
+        {
+            std::vector< ComponentID >& members = _islands[ slot ];
+            if ( members.empty() ) continue;
+
+            members.erase( std::remove_if( members.begin(), members.end(), [ &bodies ]( ComponentID id ){ return !bodies.isvalid( id ); } ), members.end() );
+            if ( members.empty() )
+            {
+                _free_islands.push_back( slot );
+            }
+        }
+    }
+
+    SleepSystem::SleepSystem()
+    :   _island_count( 0 )
+    {}
+
+}
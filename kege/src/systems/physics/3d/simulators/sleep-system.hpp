@@ -8,28 +8,95 @@
 #ifndef sleep_system_hpp
 #define sleep_system_hpp
 
-// #include "entity-system.hpp"
-// #include "rigidbody.hpp"
+#include "simulator.hpp"
+#include "../dynamics/rigidbody.hpp"
+#include "../../../../core/ecs/component-cache.hpp"
 
-// namespace kege{
+namespace kege::physics{
 
-//     struct WakeSleepableObjects{};
+    /**
+     * @brief Puts islands of resting bodies to sleep and wakes them as a whole.
+     *
+     * Every step the movable bodies are joined into islands with a union-find over the contact
+     * manifolds, immovable bodies do not join islands so the ground does not merge everything.
+     * An island falls asleep once every body in it has been at rest for frames_to_sleep steps,
+     * and none of them is non-sleepable. A sleeping body is skipped by the integrator, the force
+     * applier and the broadphase, and pairs of sleeping and immovable bodies are not tested.
+     *
+     * The members of a sleeping island are remembered, so when anything wakes one of them, a
+     * contact with an awake body or setAwake(), the rest of the island wakes with it.
+     */
+    class SleepSystem : public Simulator
+    {
+    public:
 
-//     class SleepSystem : public kege::EntitySystem
-//     {
-//     public:
+        void simulate( double dms )override;
 
-//         void operator()( const WakeSleepableObjects& );
-//         void update( double dms );
-//         bool initialize();
-//         void shutdown();
+        /**
+         * @brief Gets the number of islands built in the last step, awake and falling asleep.
+         */
+        uint32_t islandCount()const;
 
-//         SleepSystem( kege::Engine* engine );
+        /**
+         * @brief Gets the number of islands that are asleep.
+         */
+        uint32_t sleepingIslandCount()const;
 
-//         float _sleep_threshold;     // Velocity threshold to enter sleep
-//         float _sleep_motion_bias;   // Damping factor for the body calculation
-//         bool _wake_sleepable_objects;
-//     };
+        SleepSystem();
 
-// }
+    public:
+
+        /**
+         * @brief Bodies whose smoothed squared speed, linear plus angular, stays below this are at rest.
+         */
+        static float sleep_threshold;
+
+        /**
+         * @brief How much of the smoothed speed carries over per step, higher values ignore short jitter.
+         */
+        static float motion_bias;
+
+        /**
+         * @brief The number of steps every body of an island has to rest before the island sleeps.
+         */
+        static float frames_to_sleep;
+
+    private:
+
+        enum{ NONE = 0xFFFFFFFF };
+
+        uint32_t find( uint32_t i );
+        void unite( uint32_t a, uint32_t b );
+        void wakeIsland( uint32_t island );
+
+        /**
+         * drop the members destroyed while asleep and free the islands left without any, nothing
+         * else would ever wake them.
+         */
+        void releaseDestroyed();
+
+    private:
+
+        /**
+         * the union-find forest over the dense rigidbody range of the step.
+         */
+        std::vector< uint32_t > _parent;
+
+        /**
+         * per island root, the shortest rest of its bodies and the sleeping island it goes into.
+         */
+        std::vector< float > _rest;
+        std::vector< uint32_t > _slot;
+
+        /**
+         * the members of the sleeping islands, Rigidbody::island is the index in here plus one.
+         * free islands are the empty ones.
+         */
+        std::vector< std::vector< ComponentID > > _islands;
+        std::vector< uint32_t > _free_islands;
+
+        uint32_t _island_count;
+    };
+
+}
 #endif /* sleep_system_hpp */
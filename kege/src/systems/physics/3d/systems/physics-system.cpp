@@ -25,6 +25,7 @@ namespace kege{
 
         _simulation.initialize( rigidbodies );
         _signature = kege::createEntitySignature< kege::Rigidbody, kege::Transform >();
+        _writes = kege::createEntitySignature< kege::Rigidbody >();
         return EntitySystem::initialize();
     }
 
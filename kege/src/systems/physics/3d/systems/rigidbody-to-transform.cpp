@@ -11,25 +11,31 @@ namespace kege{
 
     RigidbodyToTransform::RigidbodyToTransform( kege::Engine* engine )
     :   kege::EntitySystem( engine, "rigidbody-to-transform", REQUIRE_UPDATE )
+    ,   _change_tick( 0 )
     {
         _signature = createEntitySignature< kege::Rigidbody, kege::Transform >();
     }
 
     void RigidbodyToTransform::update( double dms )
     {
-        for (kege::Entity entity : *_entities )
+        /*
+         only bodies written since the tick of the last copy. a body written later in that same
+         tick is copied twice, which is harmless, sleeping and immovable bodies are skipped.
+         */
+        kege::EntityViewT< const kege::Rigidbody, kege::Transform >( _entities ).changed< kege::Rigidbody >( _change_tick ).parallelEach([]( const kege::Rigidbody& rigidbody, kege::Transform& transform )
         {
-            kege::Rigidbody* rigidbody = entity.get< kege::Rigidbody >();
-            kege::Transform* transform = entity.get< kege::Transform >();
-
-            transform->position = rigidbody->center;
-            transform->orientation = rigidbody->orientation;
-        }
+            transform.position = rigidbody.center;
+            transform.orientation = rigidbody.orientation;
+        });
+        _change_tick = kege::ComponentCache::changeTick();
     }
 
     bool RigidbodyToTransform::initialize()
     {
         _signature = kege::createEntitySignature< kege::Rigidbody, kege::Transform >();
+        _reads = kege::createEntitySignature< kege::Rigidbody >();
+        _writes = kege::createEntitySignature< kege::Transform >();
+        _change_tick = 0;
         return EntitySystem::initialize();
     }
 
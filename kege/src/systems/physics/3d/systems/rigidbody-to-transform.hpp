@@ -21,6 +21,13 @@ namespace kege{
         void update( double dms );
         bool initialize();
         void shutdown();
+
+    private:
+
+        /**
+         * @brief The first change tick the next update has not seen yet.
+         */
+        uint32_t _change_tick;
     };
 
 }
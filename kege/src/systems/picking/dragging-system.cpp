@@ -118,7 +118,10 @@ namespace kege{
     :   kege::EntitySystem( engine, "entity-dragging-system", REQUIRE_UPDATE | REQUIRE_INPUT )
     ,   _drag_entity( false )
     ,   _selected_entity({})
-    {}
+    {
+        _reads = kege::createEntitySignature< kege::Transform >();
+        _writes = kege::createEntitySignature< kege::Rigidbody >();
+    }
 
     KEGE_REGISTER_SYSTEM( EntityDraggingSystem, "entity-dragging" );
 }
@@ -32,48 +32,33 @@ namespace kege{
         kege::vec3 ray = _engine->scene()->getSceneRay();
         kege::vec3 origin = _engine->scene()->getCameraEntity().get< kege::Transform >()->position;
 
-        std::vector< std::pair< kege::Entity, double > > selections;
+        if ( _physics == nullptr )
+        {
+            return;
+        }
 
-        // test ray against entities. store the entities hit by the ray, also store the distance from origin
+        // the hits along the ray, nearest first. planes are left out, the ground is not selectable.
+        physics::Simulation& simulation = _physics->getPhysicsSimulation();
+        const ComponentCacheT< Rigidbody >& bodies = simulation.rigidbodies();
+        std::vector< physics::QueryHit > hits;
+        simulation.raycastAll( { origin, ray }, FLT_MAX, hits );
 
-        for ( kege::Entity& entity : *_entities )
+        for ( const physics::QueryHit& hit : hits )
         {
-            kege::Rigidbody* body = entity.get< kege::Rigidbody >();
-            if( body->collider )
+            const kege::Rigidbody* body = bodies.get( hit.body );
+            if ( body->collider->shape_type != RIGID_SHAPE_PLANE )
             {
-                if( body->collider->shape_type != RIGID_SHAPE_PLANE )
-                {
-                    kege::algo::RayHit result;
-                    if( kege::algo::rayhit({origin, ray}, body->collider.ref(), &result ) )
-                    {
-                        selections.push_back({ entity, kege::magn( body->center - origin ) });
-                    }
-                }
+                // select the closest entity.
+                _comm.broadcast< const MsgEntitySelection& >({ kege::Entity( bodies.owner( hit.body ) ) });
+                break;
             }
         }
-
-        if ( !selections.empty() )
-        {
-            // sort entity fromt closest to farest from origin.
-            std::sort
-            (
-                selections.begin(),
-                selections.end(),
-                []( const std::pair< kege::Entity, double >& a, const std::pair< kege::Entity, double >& b )
-                {
-                    return a.second < b.second;
-                }
-            );
-
-            // select the closest entity.
-            _comm.broadcast< const MsgEntitySelection& >({ selections[0].first });
-            //std::cout <<"entity: "<< selections[0].first <<"\n";
-        }
     }
     
     bool EntitySelectionSystem::initialize()
     {
         _comm.add< const MappedInputs&, EntitySelectionSystem >( this );
+        _physics = dynamic_cast< kege::PhysicsSystem* >( _engine->esm()->getSystem( "physics-system" ) );
         return kege::EntitySystem::initialize();
     }
 
@@ -86,6 +71,7 @@ namespace kege{
     EntitySelectionSystem::EntitySelectionSystem( kege::Engine* engine )
     :   kege::EntitySystem( engine, "entity-selection-system", REQUIRE_UPDATE | REQUIRE_INPUT )
     ,   _make_selection( false )
+    ,   _physics( nullptr )
     {
         _signature = kege::createEntitySignature< kege::Rigidbody, kege::Transform >();
     }
@@ -9,7 +9,7 @@
 #define selection_system_hpp
 
 #include "../-/system-dependencies.hpp"
-#include "../physics/3d/collision/rayhit/rayhit.hpp"
+#include "../physics/3d/systems/physics-system.hpp"
 
 namespace kege{
 
@@ -24,6 +24,11 @@ namespace kege{
         
         EntitySelectionSystem( kege::Engine* engine );
         bool _make_selection;
+
+        /**
+         * the selection ray is cast through the scene queries of its simulation.
+         */
+        kege::PhysicsSystem* _physics;
     };
 
     struct MsgEntitySelection
@@ -11,24 +11,22 @@ namespace kege{
 
     void UpdateDecayOverTime::update( double dms )
     {
-        std::vector< kege::Entity > dead_entities;
-        for ( kege::Entity& entity : *_entities )
+        // expired entities are destroyed when the scene plays its command buffer back
+        kege::EntityCommandBuffer& commands = _engine->scene()->getCommandBuffer();
+        kege::EntityViewT< DecayOverTime >( _entities ).parallelEach([ dms, &commands ]( kege::Entity entity, DecayOverTime& decay )
         {
-            DecayOverTime* decay = entity.get< DecayOverTime >();
-            decay->lifespand -= dms;
-            if ( decay->lifespand <= 0 )
+            decay.lifespand -= dms;
+            if ( decay.lifespand <= 0 )
             {
-                dead_entities.push_back( entity );
+                commands.destroy( entity );
             }
-        }
-        for ( kege::Entity& entity : dead_entities )
-        {
-            _engine->scene()->remove( entity );
-        }
+        });
     }
+
     bool UpdateDecayOverTime::initialize()
     {
         _signature = createEntitySignature< DecayOverTime >();
+        _writes = createEntitySignature< DecayOverTime >();
         return EntitySystem::initialize();
     }
 
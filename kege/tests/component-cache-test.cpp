@@ -0,0 +1,71 @@
+//
+//  component-cache-test.cpp
+//  KE-GE
+//
+//  Created by Kenneth Esdaile on 10/17/26.
+//
+//  Checks that ComponentCacheT rejects the ids of retired handles and ComponentID 0.
+//
+//  usage: component-cache-test, exits with 1 on the first failed check
+//
+
+#include <cstdio>
+#include "../src/core/ecs/component-cache.hpp"
+
+#define KEGE_CHECK( condition ) if ( !( condition ) ){ printf( "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition ); return 1; }
+
+namespace kege::test{
+
+    struct Health
+    {
+        float value = 100.f;
+    };
+
+    int retiredHandles()
+    {
+        typedef ComponentCacheT< Health > Cache;
+
+        // every handle retires after its third use
+        const uint32_t max_generation = Cache::max_generation;
+        Cache::max_generation = 3;
+
+        Cache cache;
+        ComponentID ids[ 3 ];
+        for ( uint32_t generation = 0; generation < 3; ++generation )
+        {
+            ids[ generation ] = cache.create( 1 );
+            KEGE_CHECK( cache.isvalid( ids[ generation ] ) );
+            cache.erase( ids[ generation ] );
+        }
+
+        // handle 0 is retired now, the generation 0 id every retired handle matches must not pass
+        KEGE_CHECK( cache.get( 0 ) == nullptr );
+        KEGE_CHECK( !cache.isvalid( 0 ) );
+        KEGE_CHECK( cache.owner( 0 ) == 0 );
+        KEGE_CHECK( cache.version( 0 ) == 0 );
+        for ( ComponentID id : ids )
+        {
+            KEGE_CHECK( !cache.isvalid( id ) );
+            KEGE_CHECK( cache.get( id ) == nullptr );
+        }
+
+        // the retired handle is not reused
+        ComponentID fresh = cache.create( 2 );
+        KEGE_CHECK( ( fresh & Cache::HANDLE_INDEX_MASK ) != 0 );
+        KEGE_CHECK( cache.owner( fresh ) == 2 );
+        KEGE_CHECK( cache.isvalid( fresh ) );
+        cache.erase( ids[ 2 ] );
+        KEGE_CHECK( cache.size() == 1 );
+
+        Cache::max_generation = max_generation;
+        return 0;
+    }
+
+}
+
+int main()
+{
+    if ( kege::test::retiredHandles() != 0 ) return 1;
+    printf( "component-cache-test passed\n" );
+    return 0;
+}